@@ -0,0 +1,172 @@
+/// \file AiBench.cpp
+/// \brief AI scheduler benchmark.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+
+#include "Bench.h"
+#include "LevelData.h"
+#include "LosBatch.h"
+#include "AiScheduler.h"
+
+/// Run shooters on a map under the AI scheduler for a range of budgets, as
+/// the object manager does: the shooters picked each frame ask for line of
+/// sight to the player, the batch answers them, and the rest keep their old
+/// answers. The shooters stand on random open tiles, and the player walks
+/// back and forth along the row that it starts on, with a 1024 by 768 view
+/// around it. For each budget the time used and the number of shooters
+/// picked each frame are given, with how many frames old the answers of the
+/// shooters on screen and off it were on average and at worst, and how many
+/// answers were wrong because they were old. Run from the folder that
+/// contains `Media`.
+/// \param argc Number of arguments.
+/// \param argv Optional map file, shooters, and frames.
+/// \return 0 on success.
+
+int AiBench(int argc, char* argv[]){
+  const char* map = argc > 0? argv[0]: "Media/Maps/level_one.txt";
+  const size_t n = argc > 1? std::max<size_t>(1, (size_t)atol(argv[1])): 1000;
+  const size_t frames = argc > 2? std::max<size_t>(1, (size_t)atol(argv[2])): 600;
+  const float t = TILE_SIZE; //tile size
+  const float r = 32.0f; //player radius
+  const float speed = 8.0f; //player speed in pixels per frame
+
+  CLevelData level(t);
+  std::vector<std::string> rows;
+
+  if(!level.Load(map) || !ReadMapRows(map, rows)){
+    printf("Cannot load %s.\n", map);
+    return 1;
+  } //if
+
+  CLosBatch batch(16.0f*t);
+
+  for(const BoundingBox& b: level.GetWalls())
+    batch.AddWall(b.Center.x - b.Extents.x, b.Center.y - b.Extents.y,
+      b.Center.x + b.Extents.x, b.Center.y + b.Extents.y);
+
+  batch.Evaluate(); //make the columns
+
+  std::vector<float> open; //centers of open tiles, x then y
+
+  for(size_t i=0; i<rows.size(); i++)
+    for(size_t j=0; j<rows[i].size(); j++)
+      if(rows[i][j] != 'W'){
+        open.push_back(t*(j + 0.5f));
+        open.push_back(t*(rows.size() - i - 0.5f));
+      } //if
+
+  if(open.empty() || level.GetSpawns().empty()){
+    printf("%s has no open tiles or no player.\n", map);
+    return 1;
+  } //if
+
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<size_t> pick(0, open.size()/2 - 1);
+  std::vector<float> pos(2*n); //shooter positions, x then y
+
+  for(size_t i=0; i<n; i++){
+    const size_t k = pick(rng); //open tile
+    pos[2*i] = open[2*k];
+    pos[2*i + 1] = open[2*k + 1];
+  } //for
+
+  const float start = level.GetSpawns()[0].m_vPos.x; //player first
+  const float y = level.GetSpawns()[0].m_vPos.y; //player height
+  const float width = t*level.GetWidth(); //map width
+
+  printf("%s, %zu shooters, %zu frames\n", map, n, frames);
+  printf("budget/us  used/us  max/us  picked  age on  max on  age off  max off  wrong\n");
+
+  for(float budget: {25.0f, 50.0f, 100.0f, 200.0f, 400.0f, 1e9f}){
+    CAiScheduler sched;
+    sched.SetBudget(budget);
+
+    std::vector<size_t> age(n, 0); //frames since each shooter thought
+    std::vector<uint8_t> sees(n, 0); //answer each shooter has
+    std::vector<uint32_t> cand; //shooter of each candidate
+    double used = 0.0, maxUsed = 0.0, picked = 0.0; //time and picks
+    double ageOn = 0.0, ageOff = 0.0; //sum of answer ages
+    size_t maxOn = 0, maxOff = 0, on = 0, off = 0, wrong = 0; //counts
+    float x = start; //player position
+    float dx = speed; //player velocity
+
+    for(size_t f=0; f<frames; f++){
+      x += dx;
+      if(x < 0.0f || x > width)dx = -dx;
+
+      sched.Begin();
+      cand.clear();
+
+      for(size_t i=0; i<n; i++){
+        const bool view = fabsf(pos[2*i] - x) <= 512.0f + r &&
+          fabsf(pos[2*i + 1] - y) <= 384.0f + r; //on screen
+        const float u = pos[2*i] - x, v = pos[2*i + 1] - y; //to player
+        const float w = view? 4.0f: u*u + v*v < 1024.0f*1024.0f? 2.0f: 1.0f; //weight
+
+        sched.Add(age[i], w);
+        cand.push_back((uint32_t)i);
+      } //for
+
+      const size_t k = sched.Pick(); //number picked
+      batch.Clear();
+
+      for(size_t j=0; j<k; j++){
+        const size_t i = cand[sched.GetChosen(j)]; //shooter
+        batch.Add(pos[2*i], pos[2*i + 1], x, y, r);
+      } //for
+
+      batch.Evaluate(1);
+
+      for(size_t i=0; i<n; i++)
+        age[i]++;
+
+      for(size_t j=0; j<k; j++){
+        const size_t i = cand[sched.GetChosen(j)]; //shooter
+        sees[i] = batch.GetResult(j)? 1: 0;
+        age[i] = 0;
+      } //for
+
+      sched.End();
+
+      used += sched.GetTimeUsed();
+      maxUsed = std::max(maxUsed, (double)sched.GetTimeUsed());
+      picked += k;
+
+      for(size_t i=0; i<n; i++){ //check against the truth, untimed
+        const bool view = fabsf(pos[2*i] - x) <= 512.0f + r &&
+          fabsf(pos[2*i + 1] - y) <= 384.0f + r; //on screen
+
+        if(view){
+          ageOn += age[i];
+          maxOn = std::max(maxOn, age[i]);
+          on++;
+        } //if
+
+        else{
+          ageOff += age[i];
+          maxOff = std::max(maxOff, age[i]);
+          off++;
+        } //else
+
+        if(batch.Test(pos[2*i], pos[2*i + 1], x, y, r) != (sees[i] != 0))
+          wrong++;
+      } //for
+    } //for
+
+    char s[16]; //budget
+    if(budget < 1e8f)snprintf(s, sizeof(s), "%.0f", budget);
+    else snprintf(s, sizeof(s), "none");
+
+    printf("%9s %8.1f %7.1f %7.1f %7.2f %7zu %8.2f %8zu %5.2f%%\n", s,
+      used/frames, maxUsed, picked/frames, on? ageOn/on: 0.0, maxOn,
+      off? ageOff/off: 0.0, maxOff, 100.0*wrong/((double)n*frames));
+  } //for
+
+  return 0;
+} //AiBench
@@ -0,0 +1,50 @@
+/// \file AtlasTool.cpp
+/// \brief Tool for packing sprites into an atlas with CSpriteAtlas.
+
+#include <cstdio>
+
+#include "Bench.h"
+#include "SpriteAtlas.h"
+
+/// Pack the sprites named in a settings file into an atlas, or report that
+/// the atlas is up to date if no image has changed since it was last packed,
+/// then print the pages and how much of them is used. Run from the folder
+/// that contains `Media`.
+/// \param argc Number of arguments.
+/// \param argv Optional settings file name and atlas manifest name.
+/// \return 0 on success.
+
+int AtlasTool(int argc, char* argv[]){
+  const char* settings = argc > 0? argv[0]: "Media/XML/gamesettings.xml";
+  const char* manifest = argc > 1? argv[1]: "Media/Images/atlas.xml";
+
+  CStopwatch timer;
+  CSpriteAtlas atlas;
+  bool repacked = false;
+
+  if(!atlas.Build(settings, manifest, repacked)){
+    printf("Cannot build %s from %s.\n", manifest, settings);
+    return 1;
+  } //if
+
+  printf("%s %s in %.1f ms\n", manifest, repacked? "packed": "up to date",
+    1000.0*timer.GetTime());
+
+  size_t used = 0, total = 0; //texels
+
+  for(size_t i=0; i<atlas.GetNumPages(); i++){
+    const SAtlasPage& p = atlas.GetPage(i);
+    printf("  %s %dx%d\n", atlas.GetPagePath(i).c_str(), p.m_nWidth, p.m_nHeight);
+    total += (size_t)p.m_nWidth*p.m_nHeight;
+  } //for
+
+  for(size_t i=0; i<atlas.GetNumRegions(); i++){
+    const SAtlasRegion& r = atlas.GetRegion(i);
+    used += (size_t)r.m_nWidth*r.m_nHeight;
+  } //for
+
+  printf("%zu frames on %zu pages, %.1f%% of texels used\n", atlas.GetNumRegions(),
+    atlas.GetNumPages(), total? 100.0*used/total: 0.0);
+
+  return 0;
+} //AtlasTool
@@ -0,0 +1,61 @@
+/// \file Bench.h
+/// \brief Interface for the benchmark and tool commands.
+
+#ifndef __L4RC_BENCH_BENCH_H__
+#define __L4RC_BENCH_BENCH_H__
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+static const float TILE_SIZE = 32.0f; ///< Tile width and height in pixels, the size of the game's tile sprite.
+
+int EnvBench(int, char*[]); ///< Batched environment stepping benchmark.
+int RasterBench(int, char*[]); ///< Observation rasterizer benchmark.
+int RenderBench(int, char*[]); ///< Software renderer benchmark.
+int DrawStats(int, char*[]); ///< Draw recording statistics.
+int DrawDiff(int, char*[]); ///< Draw recording comparison.
+int AtlasTool(int, char*[]); ///< Sprite atlas packer.
+int StartupBench(int, char*[]); ///< Sprite loading benchmark.
+int MapStats(int, char*[]); ///< Map statistics and load times.
+int MapGenTool(int, char*[]); ///< Stress level generator.
+int SweepBench(int, char*[]); ///< Map size scaling sweep.
+int FlowBench(int, char*[]); ///< Flow field benchmark.
+int PathBench(int, char*[]); ///< Path finder benchmark.
+int HierPathBench(int, char*[]); ///< Hierarchical path finder benchmark.
+int LosBench(int, char*[]); ///< Batched line of sight benchmark.
+int AiBench(int, char*[]); ///< AI scheduler benchmark.
+int SpawnBench(int, char*[]); ///< Lazy spawning benchmark.
+int StaticBench(int, char*[]); ///< Static object grid benchmark.
+
+bool ReadMapRows(const char*, std::vector<std::string>&); ///< Read the rows of a map file.
+uint32_t AStar(const std::vector<std::string>&, uint32_t, uint32_t, size_t&); ///< Plain A* path cost.
+
+/// \brief Wall clock stopwatch.
+///
+/// A stopwatch for timing the benchmarks, started when constructed.
+
+class CStopwatch{
+  private:
+    std::chrono::steady_clock::time_point m_tStart; ///< Start time.
+
+  public:
+    CStopwatch(): m_tStart(std::chrono::steady_clock::now()){}; ///< Constructor.
+
+    /// Get the time since the stopwatch was started or restarted.
+    /// \return Elapsed time in seconds.
+
+    const double GetTime() const{
+      return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - m_tStart).count();
+    } //GetTime
+
+    /// Restart the stopwatch.
+
+    void Restart(){
+      m_tStart = std::chrono::steady_clock::now();
+    } //Restart
+}; //CStopwatch
+
+#endif //__L4RC_BENCH_BENCH_H__
@@ -0,0 +1,114 @@
+/// \file DrawTools.cpp
+/// \brief Tools for draw recordings made by CDrawRecorder.
+
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+#include "Bench.h"
+#include "DrawRecorder.h"
+
+/// Print the draws per frame of a recording by sprite index, as the mean
+/// over all frames and the largest in any one frame, followed by the busiest
+/// frames.
+/// \param argc Number of arguments.
+/// \param argv Name of the recording file.
+/// \return 0 on success.
+
+int DrawStats(int argc, char* argv[]){
+  if(argc < 1){
+    printf("usage: drawstats <recording>\n");
+    return 1;
+  } //if
+
+  CDrawRecorder rec;
+
+  if(!rec.Load(argv[0])){
+    printf("Cannot read %s.\n", argv[0]);
+    return 1;
+  } //if
+
+  const size_t frames = rec.GetNumFrames();
+  const size_t sprites = rec.GetNumSprites();
+
+  std::vector<size_t> totals, sum(sprites, 0), peak(sprites, 0);
+  std::vector<std::pair<size_t, size_t>> busiest; //draws, frame
+  size_t draws = 0;
+
+  for(size_t f=0; f<frames; f++){
+    rec.GetTotals(f, totals);
+
+    for(size_t s=0; s<sprites; s++){
+      sum[s] += totals[s];
+      peak[s] = std::max(peak[s], totals[s]);
+    } //for
+
+    draws += rec.GetNumRecords(f);
+    busiest.push_back(std::make_pair(rec.GetNumRecords(f), f));
+  } //for
+
+  printf("%s: %zu frames, %zu draws, %.1f draws per frame\n", argv[0], frames,
+    draws, frames? (double)draws/frames: 0.0);
+  printf("%8s %10s %10s %10s\n", "sprite", "total", "mean", "max");
+
+  for(size_t s=0; s<sprites; s++)
+    if(sum[s] > 0)
+      printf("%8zu %10zu %10.1f %10zu\n", s, sum[s], (double)sum[s]/frames, peak[s]);
+
+  const size_t n = std::min<size_t>(5, busiest.size());
+  std::partial_sort(busiest.begin(), busiest.begin() + n, busiest.end(),
+    [](const std::pair<size_t, size_t>& a, const std::pair<size_t, size_t>& b){
+      return a.first > b.first;});
+
+  printf("busiest frames:");
+  for(size_t i=0; i<n; i++)
+    printf(" %zu (%zu draws)", busiest[i].second, busiest[i].first);
+  printf("\n");
+
+  return 0;
+} //DrawStats
+
+/// Compare two recordings of the same play-through, for example from two
+/// builds, and report frames whose draws changed and the change in total
+/// draws by sprite index.
+/// \param argc Number of arguments.
+/// \param argv Names of the old and new recording files.
+/// \return 0 if the recordings match, 2 if they differ, 1 on error.
+
+int DrawDiff(int argc, char* argv[]){
+  if(argc < 2){
+    printf("usage: drawdiff <old recording> <new recording>\n");
+    return 1;
+  } //if
+
+  CDrawRecorder a, b;
+
+  for(int i=0; i<2; i++)
+    if(!(i == 0? a: b).Load(argv[i])){
+      printf("Cannot read %s.\n", argv[i]);
+      return 1;
+    } //if
+
+  SDrawDiff diff;
+  CDrawRecorder::Diff(a, b, diff);
+
+  printf("frames: %zu vs %zu, %zu compared\n", a.GetNumFrames(), b.GetNumFrames(), diff.m_nFrames);
+  printf("draws: %zu vs %zu (%+lld)\n", diff.m_nDrawsA, diff.m_nDrawsB,
+    (long long)diff.m_nDrawsB - (long long)diff.m_nDrawsA);
+  printf("frames with a different draw count: %zu\n", diff.m_nCountChanged);
+  printf("frames with different draws: %zu\n", diff.m_nContentChanged);
+
+  if(diff.m_nFirstChanged != SIZE_MAX)
+    printf("first frame that differs: %zu\n", diff.m_nFirstChanged);
+
+  for(size_t s=0; s<diff.m_vecSpriteDelta.size(); s++)
+    if(diff.m_vecSpriteDelta[s] != 0)
+      printf("  sprite %zu: %+lld draws%s\n", s, diff.m_vecSpriteDelta[s],
+        diff.m_vecSpriteDelta[s] > 0? " (regression)": "");
+
+  const bool same = a.GetNumFrames() == b.GetNumFrames() &&
+    diff.m_nFirstChanged == SIZE_MAX;
+
+  printf(same? "recordings match\n": "recordings differ\n");
+  return same? 0: 2;
+} //DrawDiff
@@ -0,0 +1,62 @@
+/// \file EnvBench.cpp
+/// \brief Benchmark for the batched headless environment CEnvBatch.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <random>
+#include <exception>
+
+#include "Bench.h"
+#include "EnvBatch.h"
+
+/// Step batches of 1, 8 and 64 environments with random actions and report
+/// the aggregate number of environment steps per second. The actions are
+/// generated before the clock starts so that only stepping is timed.
+/// \param argc Number of arguments.
+/// \param argv Optional map file name and number of steps per batch.
+/// \return 0 on success.
+
+int EnvBench(int argc, char* argv[]){
+  const char* map = argc > 0? argv[0]: "Media/Maps/level_one.txt";
+  const size_t steps = argc > 1? (size_t)atol(argv[1]): 20000;
+
+  const size_t sizes[] = {1, 8, 64};
+  const size_t nPatterns = 256; //number of distinct action rows
+
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<int> pick(0, (int)eEnvAction::Size - 1);
+
+  printf("map %s, %zu steps per batch\n", map, steps);
+  printf("%8s %14s %14s %10s\n", "envs", "steps/s", "env steps/s", "episodes");
+
+  for(size_t n: sizes){
+    try{
+      CEnvBatch batch(map, n);
+
+      std::vector<uint8_t> actions(nPatterns*n);
+      for(uint8_t& a: actions)a = (uint8_t)pick(rng);
+
+      size_t episodes = 0;
+      CStopwatch timer;
+
+      for(size_t s=0; s<steps; s++){
+        batch.Step(&actions[(s%nPatterns)*n]);
+
+        const uint8_t* done = batch.GetDones();
+        for(size_t e=0; e<n; e++)
+          episodes += done[e];
+      } //for
+
+      const double t = timer.GetTime();
+      printf("%8zu %14.0f %14.0f %10zu\n", n, steps/t, steps*n/t, episodes);
+    } //try
+
+    catch(const std::exception& e){
+      printf("%s\n", e.what());
+      return 1;
+    } //catch
+  } //for
+
+  return 0;
+} //EnvBench
@@ -0,0 +1,109 @@
+/// \file FlowBench.cpp
+/// \brief Flow field benchmark.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+
+#include "Bench.h"
+#include "FlowField.h"
+
+/// Time the flow field on a map with many chasers. The target jumps to a
+/// random open tile every frame, so every frame has a search, which is the
+/// worst case. Each frame every chaser looks up its direction and takes a
+/// step. The search time is also what it would cost each chaser to search
+/// for itself.
+/// \param argc Number of arguments.
+/// \param argv Optional map file, number of chasers, and frames.
+/// \return 0 on success.
+
+int FlowBench(int argc, char* argv[]){
+  const char* map = argc > 0? argv[0]: "Media/Maps/level_one.txt";
+  const size_t chasers = argc > 1? std::max<size_t>(1, (size_t)atol(argv[1])): 10000;
+  const size_t frames = argc > 2? std::max<size_t>(1, (size_t)atol(argv[2])): 200;
+  const float t = TILE_SIZE; //tile size
+
+  std::vector<std::string> rows;
+
+  if(!ReadMapRows(map, rows)){
+    printf("Cannot read %s.\n", map);
+    return 1;
+  } //if
+
+  const size_t w = rows[0].size(), h = rows.size(); //map size in tiles
+  std::vector<const char*> ptr; //row pointers
+
+  for(std::string& row: rows){
+    row.resize(w, 'F');
+    ptr.push_back(row.c_str());
+  } //for
+
+  std::vector<float> open; //centers of open tiles, x then y
+
+  for(size_t i=0; i<h; i++)
+    for(size_t j=0; j<w; j++)
+      if(rows[i][j] != 'W'){
+        open.push_back(t*(j + 0.5f));
+        open.push_back(t*(h - i - 0.5f));
+      } //if
+
+  if(open.empty()){
+    printf("%s has no open tiles.\n", map);
+    return 1;
+  } //if
+
+  const size_t tiles = open.size()/2; //number of open tiles
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<size_t> pick(0, tiles - 1);
+
+  std::vector<float> pos(2*chasers); //chaser positions
+
+  for(size_t i=0; i<chasers; i++){
+    const size_t n = pick(rng);
+    pos[2*i] = open[2*n];
+    pos[2*i + 1] = open[2*n + 1];
+  } //for
+
+  std::vector<size_t> targets(frames); //target tile each frame
+  for(size_t& n: targets)n = pick(rng);
+
+  CFlowField field;
+  CStopwatch timer;
+  field.SetMap(ptr.data(), w, h, t);
+  const double tSetMap = timer.GetTime();
+
+  double tSearch = 0.0, tLookup = 0.0; //total times
+  size_t moving = 0; //chaser steps taken
+
+  for(size_t f=0; f<frames; f++){
+    timer.Restart();
+    field.Update(open[2*targets[f]], open[2*targets[f] + 1]);
+    tSearch += timer.GetTime();
+
+    timer.Restart();
+
+    for(size_t i=0; i<chasers; i++){
+      float dx, dy; //direction
+
+      if(field.GetDirection(pos[2*i], pos[2*i + 1], dx, dy)){
+        pos[2*i] += 4.0f*dx;
+        pos[2*i + 1] += 4.0f*dy;
+        moving++;
+      } //if
+    } //for
+
+    tLookup += timer.GetTime();
+  } //for
+
+  printf("%s: %zux%zu tiles, %zu open, %zu chasers, %zu frames\n", map, w, h, tiles, chasers, frames);
+  printf("set map %.3f ms, %zu searches\n", 1000.0*tSetMap, field.GetNumSearches());
+  printf("search %.3f ms per frame\n", 1000.0*tSearch/frames);
+  printf("lookup and step %.1f ns per chaser, %.3f ms per frame, %.1f%% moving\n",
+    1.0e9*tLookup/(frames*chasers), 1000.0*tLookup/frames, 100.0*moving/(frames*chasers));
+  printf("one search per chaser would be %.1f ms per frame\n", 1000.0*tSearch/frames*chasers);
+
+  return 0;
+} //FlowBench
@@ -0,0 +1,151 @@
+/// \file HierPathBench.cpp
+/// \brief Hierarchical path finder benchmark.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+
+#include "Bench.h"
+#include "HierPathFinder.h"
+#include "MapGenerator.h"
+
+/// Time hierarchical path finding on a wide generated map against plain A*.
+/// For each query that is the time to plan the waypoints, the time until an
+/// agent can take its first step, which is the plan and the first leg, and
+/// the time to turn every leg into tiles. The cost of the tiles is compared
+/// with the shortest path found by A*. Then some tiles are changed one at a
+/// time to time the partial rebuild against making the whole thing again.
+/// \param argc Number of arguments.
+/// \param argv Optional map width and height, number of queries, seed, and
+/// cluster size.
+/// \return 0 on success.
+
+int HierPathBench(int argc, char* argv[]){
+  const size_t width = argc > 0? std::max<size_t>(16, (size_t)atol(argv[0])): 10000;
+  const size_t height = argc > 1? std::max<size_t>(16, (size_t)atol(argv[1])): 256;
+  const size_t queries = argc > 2? std::max<size_t>(1, (size_t)atol(argv[2])): 50;
+  const uint32_t seed = argc > 3? (uint32_t)atol(argv[3]): 1;
+  const size_t cluster = argc > 4? std::max<size_t>(2, (size_t)atol(argv[4])): 16;
+
+  SMapGenDesc d;
+  d.m_nWidth = width;
+  d.m_nHeight = height;
+  d.m_nSeed = seed;
+
+  CMapGenerator gen;
+  gen.Generate(d);
+  const std::vector<std::string>& rows = gen.GetRows(); //shorthand
+
+  const size_t w = rows[0].size(), h = rows.size(); //map size
+  std::vector<const char*> ptr; //row pointers
+  std::vector<uint32_t> open; //open tiles
+
+  for(size_t i=0; i<h; i++){
+    ptr.push_back(rows[i].c_str());
+
+    for(size_t j=0; j<w; j++)
+      if(rows[i][j] != 'W')open.push_back((uint32_t)(i*w + j));
+  } //for
+
+  //pick queries at least a quarter of the map apart
+
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> pick(0, open.size() - 1);
+  std::vector<std::pair<uint32_t, uint32_t>> pairs; //start and goal tiles
+
+  while(pairs.size() < queries){
+    const uint32_t s = open[pick(rng)], g = open[pick(rng)];
+    const size_t dx = std::abs((int)(s%w) - (int)(g%w)), dy = std::abs((int)(s/w) - (int)(g/w));
+    if(dx + dy >= w/4)pairs.push_back({s, g});
+  } //while
+
+  printf("%zux%zu map, seed %u, %zu queries, %zux%zu clusters\n", w, h, seed, queries,
+    cluster, cluster);
+
+  CHierPathFinder finder;
+  CStopwatch timer;
+  finder.SetMap(ptr.data(), w, h, cluster);
+  const double tBuild = timer.GetTime();
+
+  printf("build   %8.3f ms, %zu clusters, %zu nodes, %zu links, %.2f MB\n", 1000.0*tBuild,
+    finder.GetNumClusters(), finder.GetNumNodes(), finder.GetNumEdges(),
+    finder.GetMemory()/1048576.0);
+
+  double tPlan = 0.0, tFirst = 0.0, tRefine = 0.0, tAStar = 0.0; //total times
+  double tWorst = 0.0, over = 0.0, overMax = 0.0; //worst first step time, excess cost
+  size_t found = 0, waypoints = 0, expanded = 0, missed = 0, broken = 0; //counts
+  std::vector<uint32_t> path, leg;
+
+  for(const auto& q: pairs){
+    timer.Restart();
+    const bool ok = finder.FindPath(q.first, q.second, path);
+    const double t = timer.GetTime(); //time to plan
+    tPlan += t;
+
+    uint32_t cost = 0; //cost of tiles
+    uint32_t prev = q.first; //previous tile
+
+    for(size_t i=1; ok && i<path.size(); i++){
+      timer.Restart();
+      if(!finder.RefineLeg(path[i - 1], path[i], leg))broken++;
+      const double tLeg = timer.GetTime(); //time for this leg
+      tRefine += tLeg;
+
+      if(i == 1){
+        tFirst += t + tLeg;
+        tWorst = std::max(tWorst, t + tLeg);
+      } //if
+
+      for(uint32_t n: leg){
+        const uint32_t dx = std::abs((int)(n%w) - (int)(prev%w)), dy = std::abs((int)(n/w) - (int)(prev/w));
+        if(std::max(dx, dy) != 1 || rows[n/w][n%w] == 'W')broken++;
+        cost += dx != 0 && dy != 0? 14: 10;
+        prev = n;
+      } //for
+    } //for
+
+    size_t n = 0; //tiles expanded by A*
+    timer.Restart();
+    const uint32_t best = AStar(rows, q.first, q.second, n);
+    tAStar += timer.GetTime();
+    expanded += n;
+
+    if(ok != (best != 0))missed++;
+
+    if(ok && best != 0){
+      found++;
+      waypoints += path.size();
+      over += (double)cost/best - 1.0;
+      overMax = std::max(overMax, (double)cost/best - 1.0);
+    } //if
+  } //for
+
+  printf("hpa     %8.3f ms to plan, %.3f ms to first step (%.3f worst), %.3f ms to refine all\n",
+    1000.0*tPlan/queries, 1000.0*tFirst/queries, 1000.0*tWorst, 1000.0*(tPlan + tRefine)/queries);
+  printf("        %zu found, %.1f waypoints per path, %.2f%% longer than shortest (%.2f%% worst), %zu broken\n",
+    found, found? (double)waypoints/found: 0.0, 100.0*(found? over/found: 0.0), 100.0*overMax, broken);
+  printf("a*      %8.3f ms per query, %.0f tiles expanded, %.2f MB of costs, %zu disagreements\n",
+    1000.0*tAStar/queries, (double)expanded/queries, w*h*sizeof(uint32_t)/1048576.0, missed);
+
+  //change tiles one at a time
+
+  const size_t edits = 100; //number of tiles to change
+  const size_t rebuilt = finder.GetNumRebuilt(); //clusters rebuilt so far
+
+  timer.Restart();
+
+  for(size_t k=0; k<edits; k++){
+    const uint32_t n = open[pick(rng)]; //tile to close and open again
+    finder.SetOpen(n/w, n%w, false);
+    finder.SetOpen(n/w, n%w, true);
+  } //for
+
+  printf("edit    %8.3f ms per tile change, %.1f clusters linked again, against %.3f ms to make it all\n",
+    1000.0*timer.GetTime()/(2*edits), (double)(finder.GetNumRebuilt() - rebuilt)/(2*edits),
+    1000.0*tBuild);
+
+  return 0;
+} //HierPathBench
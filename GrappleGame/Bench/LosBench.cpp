@@ -0,0 +1,120 @@
+/// \file LosBench.cpp
+/// \brief Batched line of sight benchmark.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+
+#include "Bench.h"
+#include "LevelData.h"
+#include "LosBatch.h"
+
+/// Time line of sight queries from many shooters to the player on a map,
+/// asked one at a time against every wall as `CTileManager::Visible()` does,
+/// and as a batch on one thread and on every core. The shooters stand on
+/// random open tiles. The batch answers are checked against the ones asked
+/// one at a time, and the average number of walls that the batch tested for
+/// each query is given. Run from the folder that contains `Media`.
+/// \param argc Number of arguments.
+/// \param argv Optional map file, frames, and player radius.
+/// \return 0 on success.
+
+int LosBench(int argc, char* argv[]){
+  const char* map = argc > 0? argv[0]: "Media/Maps/level_one.txt";
+  const size_t frames = argc > 1? std::max<size_t>(1, (size_t)atol(argv[1])): 20;
+  const float r = argc > 2? (float)atof(argv[2]): 32.0f;
+  const float t = TILE_SIZE; //tile size
+
+  CLevelData level(t);
+  std::vector<std::string> rows;
+
+  if(!level.Load(map) || !ReadMapRows(map, rows)){
+    printf("Cannot load %s.\n", map);
+    return 1;
+  } //if
+
+  CLosBatch batch(16.0f*t);
+
+  for(const BoundingBox& b: level.GetWalls())
+    batch.AddWall(b.Center.x - b.Extents.x, b.Center.y - b.Extents.y,
+      b.Center.x + b.Extents.x, b.Center.y + b.Extents.y);
+
+  batch.Evaluate(); //make the columns, as the tile manager does on level load
+
+  std::vector<float> open; //centers of open tiles, x then y
+
+  for(size_t i=0; i<rows.size(); i++)
+    for(size_t j=0; j<rows[i].size(); j++)
+      if(rows[i][j] != 'W'){
+        open.push_back(t*(j + 0.5f));
+        open.push_back(t*(rows.size() - i - 0.5f));
+      } //if
+
+  if(open.empty() || level.GetSpawns().empty()){
+    printf("%s has no open tiles or no player.\n", map);
+    return 1;
+  } //if
+
+  const Vector2 player = level.GetSpawns()[0].m_vPos; //player first
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<size_t> pick(0, open.size()/2 - 1);
+
+  printf("%s, %zux%zu tiles, %zu walls, %zu frames\n", map, level.GetWidth(),
+    level.GetHeight(), batch.GetNumWalls(), frames);
+  printf("shooters    one/ms  batch/ms threads/ms  visible  tests  wrong\n");
+
+  for(size_t n: {10, 100, 1000, 10000}){
+    std::vector<float> pos(2*n); //shooter positions, x then y
+
+    for(size_t i=0; i<n; i++){
+      const size_t k = pick(rng); //open tile
+      pos[2*i] = open[2*k];
+      pos[2*i + 1] = open[2*k + 1];
+    } //for
+
+    std::vector<uint8_t> one(n); //answers one at a time
+    CStopwatch timer;
+
+    for(size_t f=0; f<frames; f++)
+      for(size_t i=0; i<n; i++)
+        one[i] = batch.Test(pos[2*i], pos[2*i + 1], player.x, player.y, r)? 1: 0;
+
+    const double tOne = timer.GetTime();
+    double tBatch[2] = {0.0, 0.0}; //batch times on one thread and every core
+
+    for(size_t k=0; k<2; k++){
+      timer.Restart();
+
+      for(size_t f=0; f<frames; f++){
+        batch.Clear();
+
+        for(size_t i=0; i<n; i++)
+          batch.Add(pos[2*i], pos[2*i + 1], player.x, player.y, r);
+
+        batch.Evaluate(k == 0? 1: 0);
+      } //for
+
+      tBatch[k] = timer.GetTime();
+    } //for
+
+    size_t visible = 0, wrong = 0; //counts
+
+    for(size_t i=0; i<n; i++){
+      if(one[i])visible++;
+      if(batch.GetResult(i) != (one[i] != 0))wrong++;
+    } //for
+
+    const double q = (double)n*frames; //number of queries
+
+    printf("%8zu %9.0f %9.0f %10.0f %7.1f%% %6.1f %6zu\n", n, q/(1000.0*tOne),
+      q/(1000.0*tBatch[0]), q/(1000.0*tBatch[1]), 100.0*visible/n,
+      (double)batch.GetNumTests()/n, wrong);
+  } //for
+
+  printf("%zu walls in the columns, counting repeats and padding\n", batch.GetGridSize());
+  if(batch.IsDirect())printf("too few walls to group queries, so batches test every wall\n");
+  return 0;
+} //LosBench
@@ -0,0 +1,91 @@
+/// \file Main.cpp
+/// \brief Every program has to have a main.
+///
+/// The benchmark program is a console application that runs one of the
+/// benchmark or tool commands named on the command line. It should be run
+/// from the folder that contains `Media` so that relative paths work.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "Bench.h"
+
+/// \brief A benchmark or tool command.
+
+struct SCommand{
+  const char* m_pName; ///< Name typed on the command line.
+  int (*m_pFunc)(int, char*[]); ///< Function that runs it.
+  const char* m_pHelp; ///< One line of help text.
+}; //SCommand
+
+static const SCommand g_sCommands[] = {
+  {"envs", EnvBench, "envs [map] [steps] - batched headless environment steps per second"},
+  {"raster", RasterBench, "raster [map] [objects] [reps] - time to rasterize a 64x64x8 observation"},
+  {"render", RenderBench, "render [map] [frames] [prefix] - software renderer frames per second, saves PNGs"},
+  {"drawstats", DrawStats, "drawstats <recording> - draws per frame by sprite in a draw recording"},
+  {"drawdiff", DrawDiff, "drawdiff <old> <new> - compare two draw recordings"},
+  {"startup", StartupBench, "startup [threads] [cache folder] [reps] - sprite loading time, cold and warm"},
+  {"atlas", AtlasTool, "atlas [settings] [manifest] - pack sprites into an atlas if images changed"},
+  {"mapgen", MapGenTool, "mapgen <map> [width] [height] [seed] [scale] [walls] - generate a stress level"},
+  {"sweep", SweepBench, "sweep [steps] [envs] [seed] - how load and frame work scale with generated map size"},
+  {"maps", MapStats, "maps [folder] [reps] [tile size] - map statistics and load times as JSON"},
+  {"flow", FlowBench, "flow [map] [chasers] [frames] - flow field search and per-chaser lookup time"},
+  {"paths", PathBench, "paths [size] [queries] [seed] [budget] - jump point search against A* on a generated map"},
+  {"hpa", HierPathBench, "hpa [width] [height] [queries] [seed] [cluster] - hierarchical paths against A* on a wide map"},
+  {"los", LosBench, "los [map] [frames] [radius] - line of sight queries per ms for 10 to 10000 shooters"},
+  {"ai", AiBench, "ai [map] [shooters] [frames] - answer age and time used under a range of AI budgets"},
+  {"spawns", SpawnBench, "spawns [frames] [seed] - lazy spawning cost and live objects as map population grows"},
+  {"statics", StaticBench, "statics [folder] [reps] - collision pairs per frame with and without the static object grid"},
+}; //g_sCommands
+
+/// Read the rows of a map file in the `LoadMap` glyph format, dropping any
+/// carriage returns.
+/// \param filename Name of the map file.
+/// \param rows [out] The rows, top row first.
+/// \return true if the file was read and is not empty.
+
+bool ReadMapRows(const char* filename, std::vector<std::string>& rows){
+  std::ifstream input(filename, std::ios::binary);
+  std::string row;
+
+  rows.clear();
+
+  while(std::getline(input, row)){
+    if(!row.empty() && row.back() == '\r')row.pop_back();
+    if(!row.empty())rows.push_back(row);
+  } //while
+
+  return !rows.empty();
+} //ReadMapRows
+
+/// Print the list of commands.
+
+static void Usage(){
+  printf("usage: Bench <command> [args]\n");
+
+  for(const SCommand& c: g_sCommands)
+    printf("  %s\n", c.m_pHelp);
+} //Usage
+
+/// \brief The main entry point for this application.
+///
+/// Find the command named by the first argument and pass the rest of the
+/// arguments to it.
+/// \param argc Number of arguments.
+/// \param argv Arguments.
+/// \return 0 If the command succeeds, otherwise an error code.
+
+int main(int argc, char* argv[]){
+  if(argc < 2){
+    Usage();
+    return 1;
+  } //if
+
+  for(const SCommand& c: g_sCommands)
+    if(strcmp(argv[1], c.m_pName) == 0)
+      return c.m_pFunc(argc - 2, argv + 2);
+
+  Usage();
+  return 1;
+} //main
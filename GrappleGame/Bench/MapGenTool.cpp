@@ -0,0 +1,171 @@
+/// \file MapGenTool.cpp
+/// \brief Stress level generator and scaling sweep.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <random>
+#include <exception>
+#include <filesystem>
+
+#include "Bench.h"
+#include "MapGenerator.h"
+#include "LevelData.h"
+#include "EnvBatch.h"
+
+/// Generate a stress level and save it. The entity counts are the default
+/// densities times a scale, and the wall density is the chance of a loose
+/// wall tile in open space.
+/// \param argc Number of arguments.
+/// \param argv Map file name, then optional width, height, seed, entity
+/// scale, and wall density.
+/// \return 0 on success.
+
+int MapGenTool(int argc, char* argv[]){
+  if(argc < 1){
+    printf("usage: mapgen <map> [width] [height] [seed] [scale] [walls]\n");
+    return 1;
+  } //if
+
+  SMapGenDesc d;
+  d.m_nWidth = argc > 1? (size_t)atol(argv[1]): 256;
+  d.m_nHeight = argc > 2? (size_t)atol(argv[2]): 64;
+  d.m_nSeed = argc > 3? (uint32_t)atol(argv[3]): 1;
+  d.ScaleCounts(argc > 4? (float)atof(argv[4]): 1.0f);
+  if(argc > 5)d.m_fWallDensity = (float)atof(argv[5]);
+
+  CMapGenerator gen;
+  gen.Generate(d);
+
+  if(!gen.Save(argv[0])){
+    printf("Cannot write %s.\n", argv[0]);
+    return 1;
+  } //if
+
+  printf("%s: %zux%zu, seed %u, %zu wall tiles\n", argv[0], gen.GetRows()[0].size(),
+    gen.GetRows().size(), d.m_nSeed, gen.GetCount('W'));
+
+  for(char c: d.m_strGlyphs)
+    printf("  %c %zu\n", c, gen.GetCount(c));
+
+  return 0;
+} //MapGenTool
+
+/// One frame of the game's wall collision done the way the object manager
+/// does it, every object against every wall with a circle and box overlap
+/// test, without the response. This is the part of the frame that grows
+/// with the map.
+/// \param level The level.
+/// \param r Object radius.
+/// \return Number of overlaps, so that the work isn't optimized away.
+
+static size_t CollideAll(const CLevelData& level, float r){
+  size_t hits = 0;
+
+  for(const SSpawn& s: level.GetSpawns())
+    for(const BoundingBox& b: level.GetWalls()){
+      const float dx = std::max(0.0f, std::fabs(s.m_vPos.x - b.Center.x) - b.Extents.x);
+      const float dy = std::max(0.0f, std::fabs(s.m_vPos.y - b.Center.y) - b.Extents.y);
+      hits += dx*dx + dy*dy <= r*r;
+    } //for
+
+  return hits;
+} //CollideAll
+
+/// Generate stress levels of growing size and report how the work scales:
+/// the time to generate, load, and parse each one, its walls and objects,
+/// the time for one frame of brute-force object-wall collision and the
+/// number of overlaps it found, and the time per step of the headless runner
+/// `CEnvBatch`, which simulates the player only. The map is written to the
+/// temporary folder.
+/// \param argc Number of arguments.
+/// \param argv Optional number of runner steps, environments, and seed.
+/// \return 0 on success.
+
+int SweepBench(int argc, char* argv[]){
+  const size_t steps = argc > 0? (size_t)atol(argv[0]): 2000;
+  const size_t envs = argc > 1? std::max<size_t>(1, (size_t)atol(argv[1])): 8;
+  const uint32_t seed = argc > 2? (uint32_t)atol(argv[2]): 1;
+
+  const size_t sizes[][2] = {{64, 32}, {256, 64}, {512, 128}, {1024, 256}, {2048, 512}, {4096, 1024}};
+  const std::string file = (std::filesystem::temp_directory_path()/"sweep_map.txt").string();
+
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<int> pick(0, (int)eEnvAction::Size - 1);
+
+  std::vector<uint8_t> actions(256*envs); //random actions, made before timing
+  for(uint8_t& a: actions)a = (uint8_t)pick(rng);
+
+  printf("seed %u, %zu runner steps of %zu envs\n", seed, steps, envs);
+  printf("%11s %8s %8s %8s %8s %12s %8s %10s %10s\n", "size", "gen ms", "load ms",
+    "walls", "objects", "obj x wall", "overlaps", "collide ms", "step us");
+
+  for(const auto& sz: sizes){
+    SMapGenDesc d;
+    d.m_nWidth = sz[0];
+    d.m_nHeight = sz[1];
+    d.m_nSeed = seed;
+    d.ScaleCounts(1.0f);
+
+    CStopwatch timer;
+    CMapGenerator gen;
+    gen.Generate(d);
+    const double tGen = timer.GetTime();
+
+    if(!gen.Save(file.c_str())){
+      printf("Cannot write %s.\n", file.c_str());
+      return 1;
+    } //if
+
+    timer.Restart();
+    CLevelData level(TILE_SIZE);
+    level.Load(file.c_str());
+    const double tLoad = timer.GetTime();
+
+    if(!level.IsLoaded()){
+      printf("%s\n", level.GetError().c_str());
+      return 1;
+    } //if
+
+    size_t reps = 0; //collision frames, up to 5 in half a second
+    size_t hits = 0;
+    timer.Restart();
+
+    while(reps == 0 || (reps < 5 && timer.GetTime() < 0.5)){
+      hits += CollideAll(level, 32.0f);
+      reps++;
+    } //while
+
+    const double tCollide = timer.GetTime()/reps;
+
+    double tStep = 0.0; //runner time per step
+
+    try{
+      CEnvBatch batch(file.c_str(), envs);
+      timer.Restart();
+
+      for(size_t s=0; s<steps; s++)
+        batch.Step(&actions[(s%256)*envs]);
+
+      tStep = timer.GetTime()/steps;
+    } //try
+
+    catch(const std::exception& e){
+      printf("%s\n", e.what());
+      return 1;
+    } //catch
+
+    const size_t objects = level.GetSpawns().size();
+    const size_t walls = level.GetWalls().size();
+    const std::string name = std::to_string(sz[0]) + "x" + std::to_string(sz[1]);
+
+    printf("%11s %8.2f %8.2f %8zu %8zu %12zu %8zu %10.3f %10.2f\n", name.c_str(),
+      1000.0*tGen, 1000.0*tLoad, walls, objects, objects*walls, hits/reps,
+      1000.0*tCollide, 1.0e6*tStep);
+  } //for
+
+  std::filesystem::remove(file);
+  return 0;
+} //SweepBench
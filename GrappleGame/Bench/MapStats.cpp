@@ -0,0 +1,145 @@
+/// \file MapStats.cpp
+/// \brief Tool for map statistics and load times.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <map>
+#include <algorithm>
+#include <filesystem>
+
+#include "Bench.h"
+#include "MediaUtil.h"
+#include "LevelData.h"
+
+/// Get the name of a kind of object for the statistics.
+/// \param t Sprite type of the object.
+/// \return Its name.
+
+static const char* SpawnName(eSprite t){
+  switch(t){
+    case eSprite::Standright: return "player";
+    case eSprite::Turret:     return "turret";
+    case eSprite::Door:       return "door";
+    case eSprite::Star:       return "star";
+    case eSprite::Bat:        return "bat";
+    case eSprite::Swooper:    return "swooper";
+    case eSprite::HealthPack: return "healthpack";
+    case eSprite::OneUp:      return "oneup";
+    case eSprite::Shotgun:    return "shotgun";
+    case eSprite::Creeper:    return "creeper";
+    default:                  return "other";
+  } //switch
+} //SpawnName
+
+/// Load every map in a folder with `CLevelData`, which is what
+/// `CTileManager` uses, and print statistics for each as JSON. For each map
+/// that is its size in tiles and bytes, the number of wall AABBs, the number
+/// of spike and launch pad tiles, the number of objects of each kind, and
+/// the average time to read the file and to load it, the difference being
+/// parse time. The per-frame work is estimated as the number of object-wall
+/// tests, since the object manager tests each object against every wall, and
+/// the most line of sight wall tests, since each turret and bat asks for
+/// line of sight once a frame and the batch tests at most every wall for it.
+/// Creepers follow the flow field instead. Levels are loaded with a
+/// navigation graph for the turret's movement profile, so the load time
+/// includes making it, and its size is given as the number of standing
+/// places and links of each kind. Run from the folder that contains `Media`.
+/// \param argc Number of arguments.
+/// \param argv Optional map folder, repetitions, and tile size.
+/// \return 0 on success.
+
+int MapStats(int argc, char* argv[]){
+  const char* folder = argc > 0? argv[0]: "Media/Maps";
+  const size_t reps = argc > 1? std::max<size_t>(1, (size_t)atol(argv[1])): 10;
+  const float tilesize = argc > 2? (float)atof(argv[2]): TILE_SIZE;
+
+  std::vector<std::string> files; //map files, sorted
+
+  std::error_code err;
+  for(const auto& entry: std::filesystem::directory_iterator(folder, err)){
+    const std::string ext = entry.path().extension().string();
+    if(ext == ".txt" || ext == ".png")
+      files.push_back(entry.path().generic_string());
+  } //for
+
+  if(files.empty()){
+    fprintf(stderr, "No maps in %s.\n", folder);
+    return 1;
+  } //if
+
+  std::sort(files.begin(), files.end());
+
+  printf("{\n  \"folder\": \"%s\",\n  \"reps\": %zu,\n  \"tilesize\": %g,\n  \"maps\": [",
+    FixPath(folder).c_str(), reps, tilesize);
+
+  for(size_t f=0; f<files.size(); f++){
+    const std::string& file = files[f]; //shorthand
+    const bool image = file.size() > 4 && file.compare(file.size() - 4, 4, ".png") == 0;
+
+    double read = 0.0, load = 0.0; //total times in seconds
+    CLevelData level(tilesize, std::vector<SNavProfile>(1));
+    std::string contents;
+
+    for(size_t r=0; r<reps; r++){
+      CStopwatch timer;
+      ReadFile(file, contents);
+      read += timer.GetTime();
+
+      timer.Restart();
+      if(image)level.LoadFromImageFile(file.c_str());
+      else level.Load(file.c_str());
+      load += timer.GetTime();
+    } //for
+
+    printf("%s\n    {\n      \"file\": \"%s\",\n", f > 0? ",": "", file.c_str());
+
+    if(!level.IsLoaded()){
+      printf("      \"error\": \"%s\"\n    }", level.GetError().c_str());
+      continue;
+    } //if
+
+    //count objects by kind
+
+    std::map<std::string, size_t> kinds; //number of objects of each kind
+    size_t los = 0; //objects that check line of sight
+
+    for(const SSpawn& s: level.GetSpawns()){
+      kinds[SpawnName(s.m_eSprite)]++;
+
+      if(s.m_eSprite == eSprite::Turret || s.m_eSprite == eSprite::Bat)los++;
+    } //for
+
+    const size_t objects = level.GetSpawns().size() + 1; //and the grappler
+    const size_t walls = level.GetWalls().size();
+    size_t hazards = 0, pads = 0; //tiles with properties
+
+    for(uint8_t p: level.GetTileProps()){
+      if(p & (uint8_t)eTileProp::Hazard)hazards++;
+      if(p & (uint8_t)eTileProp::Bounce)pads++;
+    } //for
+
+    printf("      \"width\": %zu,\n      \"height\": %zu,\n      \"bytes\": %zu,\n",
+      level.GetWidth(), level.GetHeight(), level.GetMemory());
+    printf("      \"walls\": %zu,\n      \"tiles\": {\"hazard\": %zu, \"bounce\": %zu},\n"
+      "      \"objects\": %zu,\n      \"spawns\": {", walls, hazards, pads, objects);
+
+    for(auto i=kinds.begin(); i!=kinds.end(); i++)
+      printf("%s\"%s\": %zu", i == kinds.begin()? "": ", ", i->first.c_str(), i->second);
+
+    printf("},\n      \"read_ms\": %.4f,\n      \"load_ms\": %.4f,\n      \"parse_ms\": %.4f,\n",
+      1000.0*read/reps, 1000.0*load/reps, 1000.0*std::max(0.0, load - read)/reps);
+    printf("      \"collision_tests_per_frame\": %zu,\n      \"los_tests_per_frame\": %zu,\n",
+      objects*walls, los*walls);
+
+    const CNavGraph* nav = level.GetNavGraph(SNavProfile()); //navigation graph
+    printf("      \"nav_nodes\": %zu,\n      \"nav_links\": {\"walk\": %zu, \"jump\": %zu, "
+      "\"fall\": %zu, \"launch\": %zu}\n    }", nav->GetNumNodes(),
+      nav->GetNumLinks(eNavLink::Walk), nav->GetNumLinks(eNavLink::Jump),
+      nav->GetNumLinks(eNavLink::Fall), nav->GetNumLinks(eNavLink::Launch));
+  } //for
+
+  printf("\n  ]\n}\n");
+  return 0;
+} //MapStats
@@ -0,0 +1,193 @@
+/// \file PathBench.cpp
+/// \brief Path finder benchmark.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <random>
+#include <queue>
+#include <functional>
+#include <algorithm>
+
+#include "Bench.h"
+#include "PathFinder.h"
+#include "MapGenerator.h"
+
+/// Plain A* over the 8-neighbors of each tile with the same costs and corner
+/// rule as `CPathFinder`, for comparison. Also used by the hierarchical
+/// path finder benchmark.
+/// \param rows The map.
+/// \param start Index of start tile.
+/// \param goal Index of goal tile.
+/// \param expanded [out] Number of tiles taken off the open list.
+/// \return Cost of the shortest path, 0 if there is none.
+
+uint32_t AStar(const std::vector<std::string>& rows, uint32_t start, uint32_t goal,
+  size_t& expanded)
+{
+  const int w = (int)rows[0].size(), h = (int)rows.size(); //map size
+  auto open = [&](int x, int y){
+    return x >= 0 && y >= 0 && x < w && y < h && rows[y][x] != 'W';
+  }; //open
+
+  const int gx = goal%w, gy = goal/w; //goal column and row
+  auto heuristic = [&](int x, int y){
+    const uint32_t dx = std::abs(gx - x), dy = std::abs(gy - y);
+    return 10*std::max(dx, dy) + 4*std::min(dx, dy);
+  }; //heuristic
+
+  std::vector<uint32_t> cost(w*h, UINT32_MAX);
+  std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> heap;
+  cost[start] = 0;
+  heap.push((uint64_t)heuristic(start%w, start/w) << 32 | start);
+  expanded = 0;
+
+  while(!heap.empty()){
+    const uint64_t top = heap.top(); heap.pop();
+    const uint32_t n = (uint32_t)top; //tile
+    const int x = n%w, y = n/w; //its column and row
+    if((top >> 32) != cost[n] + heuristic(x, y))continue; //stale
+
+    expanded++;
+    if(n == goal)return cost[n];
+
+    for(int dy=-1; dy<=1; dy++)
+      for(int dx=-1; dx<=1; dx++){
+        if((dx == 0 && dy == 0) || !open(x + dx, y + dy))continue;
+        if(dx != 0 && dy != 0 && (!open(x + dx, y) || !open(x, y + dy)))continue;
+
+        const uint32_t m = (y + dy)*w + x + dx; //neighbor
+        const uint32_t c = cost[n] + (dx != 0 && dy != 0? 14: 10); //cost through n
+
+        if(c < cost[m]){
+          cost[m] = c;
+          heap.push((uint64_t)(c + heuristic(x + dx, y + dy)) << 32 | m);
+        } //if
+      } //for
+  } //while
+
+  return 0;
+} //AStar
+
+/// Time Jump Point Search on a generated map against plain A*, then time
+/// the same queries again from the path cache, then make them as a crowd of
+/// agents would, a few per frame under the search budget.
+/// \param argc Number of arguments.
+/// \param argv Optional map size, number of queries, seed, and budget.
+/// \return 0 on success.
+
+int PathBench(int argc, char* argv[]){
+  const size_t size = argc > 0? std::max<size_t>(16, (size_t)atol(argv[0])): 2000;
+  const size_t queries = argc > 1? std::max<size_t>(1, (size_t)atol(argv[1])): 50;
+  const uint32_t seed = argc > 2? (uint32_t)atol(argv[2]): 1;
+  const size_t budget = argc > 3? std::max<size_t>(1, (size_t)atol(argv[3])): 8;
+
+  SMapGenDesc d;
+  d.m_nWidth = d.m_nHeight = size;
+  d.m_nSeed = seed;
+
+  CMapGenerator gen;
+  gen.Generate(d);
+  const std::vector<std::string>& rows = gen.GetRows(); //shorthand
+
+  const size_t w = rows[0].size(), h = rows.size(); //map size
+  std::vector<const char*> ptr; //row pointers
+  std::vector<uint32_t> open; //open tiles
+
+  for(size_t i=0; i<h; i++){
+    ptr.push_back(rows[i].c_str());
+
+    for(size_t j=0; j<w; j++)
+      if(rows[i][j] != 'W')open.push_back((uint32_t)(i*w + j));
+  } //for
+
+  //pick queries at least half the map apart
+
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> pick(0, open.size() - 1);
+  std::vector<std::pair<uint32_t, uint32_t>> pairs; //start and goal tiles
+
+  while(pairs.size() < queries){
+    const uint32_t s = open[pick(rng)], g = open[pick(rng)];
+    const size_t dx = std::abs((int)(s%w) - (int)(g%w)), dy = std::abs((int)(s/w) - (int)(g/w));
+    if(dx + dy >= size/2)pairs.push_back({s, g});
+  } //while
+
+  CPathFinder finder;
+  finder.SetMap(ptr.data(), w, h);
+  finder.SetBudget(SIZE_MAX);
+  finder.SetCacheSize(queries);
+
+  printf("%zux%zu map, seed %u, %zu queries\n", w, h, seed, queries);
+
+  double tJps = 0.0, tMax = 0.0, tAStar = 0.0; //times
+  size_t found = 0, points = 0, expanded = 0, mismatches = 0; //counts
+  std::vector<uint32_t> path;
+
+  for(const auto& q: pairs){
+    CStopwatch timer;
+    const ePathResult r = finder.FindPath(q.first, q.second, path);
+    const double t = timer.GetTime();
+    tJps += t;
+    tMax = std::max(tMax, t);
+
+    uint32_t cost = 0; //cost of JPS path
+
+    if(r == ePathResult::Found){
+      found++;
+      points += path.size();
+
+      for(size_t i=1; i<path.size(); i++){
+        const uint32_t dx = std::abs((int)(path[i]%w) - (int)(path[i - 1]%w));
+        const uint32_t dy = std::abs((int)(path[i]/w) - (int)(path[i - 1]/w));
+        cost += 10*std::max(dx, dy) + 4*std::min(dx, dy);
+      } //for
+    } //if
+
+    size_t n = 0; //tiles expanded by A*
+    timer.Restart();
+    mismatches += AStar(rows, q.first, q.second, n) != cost;
+    tAStar += timer.GetTime();
+    expanded += n;
+  } //for
+
+  printf("jps     %8.3f ms per query, %.3f ms worst, %zu found, %.1f jump points per path\n",
+    1000.0*tJps/queries, 1000.0*tMax, found, found? (double)points/found: 0.0);
+  printf("a*      %8.3f ms per query, %.0f tiles expanded, %zu cost mismatches\n",
+    1000.0*tAStar/queries, (double)expanded/queries, mismatches);
+
+  //the same queries again, all from the cache
+
+  CStopwatch timer;
+  for(const auto& q: pairs)finder.FindPath(q.first, q.second, path);
+  printf("cached  %8.3f us per query, %zu hits\n", 1.0e6*timer.GetTime()/queries, finder.GetNumHits());
+
+  //a crowd asking for new paths every frame under the budget
+
+  finder.ClearCache();
+  finder.SetBudget(budget);
+
+  std::vector<bool> done(queries, false);
+  size_t left = queries, frames = 0; //queries not yet answered, frames taken
+  double tFrame = 0.0; //worst frame time
+
+  while(left > 0){
+    finder.BeginFrame();
+    timer.Restart();
+
+    for(size_t i=0; i<queries; i++)
+      if(!done[i] && finder.FindPath(pairs[i].first, pairs[i].second, path) != ePathResult::Deferred){
+        done[i] = true;
+        left--;
+      } //if
+
+    tFrame = std::max(tFrame, timer.GetTime());
+    frames++;
+  } //while
+
+  printf("budget  %zu searches per frame: %zu frames, %.3f ms worst frame, %zu deferrals\n",
+    budget, frames, 1000.0*tFrame, finder.GetNumDeferred());
+
+  return 0;
+} //PathBench
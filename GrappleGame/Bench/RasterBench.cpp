@@ -0,0 +1,71 @@
+/// \file RasterBench.cpp
+/// \brief Benchmark for the observation rasterizer CObsRaster.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <random>
+
+#include "Bench.h"
+#include "ObsRaster.h"
+
+/// Rasterize 64x64x8 observations of a map with a crowd of objects while the
+/// camera pans across it, and report the average time per observation. The
+/// map rows are read straight into `char*` rows just like `m_chMap`.
+/// \param argc Number of arguments.
+/// \param argv Optional map file name, number of objects and repetitions.
+/// \return 0 on success.
+
+int RasterBench(int argc, char* argv[]){
+  const char* map = argc > 0? argv[0]: "Media/Maps/momentum_testing.txt";
+  const size_t nObjects = argc > 1? (size_t)atol(argv[1]): 256;
+  const size_t reps = argc > 2? (size_t)atol(argv[2]): 100000;
+  const float t = TILE_SIZE; //tile size
+
+  std::vector<std::string> rows;
+  if(!ReadMapRows(map, rows)){
+    printf("Map %s not found.\n", map);
+    return 1;
+  } //if
+
+  const size_t h = rows.size();
+  const size_t w = rows[0].size();
+
+  std::vector<const char*> chMap(h);
+  for(size_t i=0; i<h; i++)
+    chMap[i] = rows[i].c_str();
+
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<float> fx(0.0f, w*t), fy(0.0f, h*t);
+  std::uniform_int_distribution<int> fc(1, (int)eObsChannel::Size - 1);
+
+  std::vector<SObsObject> obj(nObjects);
+
+  for(SObsObject& o: obj){
+    o.m_fX = fx(rng);
+    o.m_fY = fy(rng);
+    o.m_eChannel = (eObsChannel)fc(rng);
+  } //for
+
+  CObsRaster raster(64, 64);
+  std::vector<uint8_t> buffer(raster.GetSize());
+  size_t checksum = 0; //stops the optimizer from skipping work
+
+  CStopwatch timer;
+
+  for(size_t k=0; k<reps; k++){
+    const float x = (k%w)*t; //pan across the map
+    const float y = ((k/w)%h)*t;
+    raster.Rasterize(chMap.data(), w, h, t, x, y, obj.data(), obj.size(), buffer.data());
+    checksum += buffer[k%buffer.size()];
+  } //for
+
+  const double dt = timer.GetTime();
+
+  printf("map %s (%zux%zu), %zu objects, %zu bytes per observation\n",
+    map, w, h, nObjects, raster.GetSize());
+  printf("%.3f us per observation (checksum %zu)\n", 1e6*dt/reps, checksum);
+
+  return 0;
+} //RasterBench
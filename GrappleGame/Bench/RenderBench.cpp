@@ -0,0 +1,204 @@
+/// \file RenderBench.cpp
+/// \brief Benchmark for the software sprite renderer CSoftRenderer.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "Bench.h"
+#include "SoftRenderer.h"
+#include "DrawQueue.h"
+
+/// \brief Sprites used by the benchmark.
+///
+/// The benchmark can't use `eSprite` without the Engine, so it has its own
+/// list of the sprites that the map glyphs need. `Size` must be last.
+
+enum class eBenchSprite: unsigned{
+  Tile, Player, Turret, Spike, Door, Star, Bat, LaunchPad, HealthPack, OneUp,
+  Line, HealthBar_Green, HealthBar_Red,
+  Size //MUST BE LAST
+}; //eBenchSprite
+
+/// \brief Position, as `Vector2` and `Vector3` have.
+
+struct SBenchVec{
+  float x = 0.0f; ///< x coordinate.
+  float y = 0.0f; ///< y coordinate.
+  float z = 0.0f; ///< z coordinate.
+
+  SBenchVec(){}; ///< Default constructor.
+  SBenchVec(float a, float b, float c=0.0f): x(a), y(b), z(c){}; ///< Constructor.
+}; //SBenchVec
+
+/// \brief Color, as `XMVECTORF32` has.
+
+struct SBenchColor{
+  float f[4] = {1.0f, 1.0f, 1.0f, 1.0f}; ///< RGBA, white by default.
+}; //SBenchColor
+
+/// \brief Sprite descriptor with the members of `LSpriteDesc2D`.
+
+struct SBenchDesc{
+  unsigned m_nSpriteIndex = 0; ///< Sprite index.
+  unsigned m_nCurrentFrame = 0; ///< Frame number.
+  SBenchVec m_vPos; ///< Position.
+  float m_fRoll = 0.0f; ///< Orientation.
+  float m_fXScale = 1.0f; ///< Horizontal scale.
+  float m_fYScale = 1.0f; ///< Vertical scale.
+  SBenchVec m_f4Tint = SBenchVec(1.0f, 1.0f, 1.0f); ///< Tint, RGB.
+  float m_fAlpha = 1.0f; ///< Alpha.
+}; //SBenchDesc
+
+/// Render frames of a map with the software renderer while the camera pans
+/// across it, queueing tiles the way `CTileManager::Draw` does, then objects
+/// and health bars, in a `CDrawQueue`, then flushing the queue and drawing
+/// screen text. Report frames per second and the sprite runs per frame
+/// before and after sorting. The first and last frames are saved as PNG
+/// files and the time to save is reported separately. Run from the folder
+/// that contains `Media`.
+/// \param argc Number of arguments.
+/// \param argv Optional map file name, number of frames, and PNG file prefix.
+/// \return 0 on success.
+
+int RenderBench(int argc, char* argv[]){
+  const char* map = argc > 0? argv[0]: "Media/Maps/momentum_testing.txt";
+  const size_t frames = argc > 1? (size_t)atol(argv[1]): 600;
+  const std::string prefix = argc > 2? argv[2]: "render";
+
+  std::vector<std::string> rows;
+  if(!ReadMapRows(map, rows)){
+    printf("Map %s not found.\n", map);
+    return 1;
+  } //if
+
+  CStopwatch timer;
+
+  CSoftRenderer renderer;
+  renderer.Initialize(eBenchSprite::Size);
+
+  static const struct{eBenchSprite m_eSprite; const char* m_pName;} sprites[] = {
+    {eBenchSprite::Tile, "tile"}, {eBenchSprite::Player, "player"},
+    {eBenchSprite::Turret, "turret"}, {eBenchSprite::Spike, "spike"},
+    {eBenchSprite::Door, "door"}, {eBenchSprite::Star, "star"},
+    {eBenchSprite::Bat, "bat"}, {eBenchSprite::LaunchPad, "launchpad"},
+    {eBenchSprite::HealthPack, "healthpack"}, {eBenchSprite::OneUp, "oneup"},
+    {eBenchSprite::Line, "greenline"}, {eBenchSprite::HealthBar_Green, "healthbar_green"},
+    {eBenchSprite::HealthBar_Red, "healthbar_red"},
+  }; //sprites
+
+  for(auto& s: sprites)
+    if(!renderer.Load(s.m_eSprite, s.m_pName))
+      printf("Sprite %s not loaded.\n", s.m_pName);
+
+  printf("loaded settings and %zu sprites from %zu texture pages in %.1f ms\n",
+    sizeof(sprites)/sizeof(sprites[0]), renderer.GetNumPages(), 1000.0*timer.GetTime());
+
+  //objects from map glyphs
+
+  const float t = renderer.GetWidth(eBenchSprite::Tile); //tile size
+  const size_t w = rows[0].size(), h = rows.size();
+
+  std::vector<SBenchDesc> objects;
+
+  for(size_t i=0; i<h; i++)
+    for(size_t j=0; j<rows[i].size(); j++){
+      SBenchDesc d;
+      d.m_vPos = SBenchVec((j + 0.5f)*t, (h - 1 - i + 0.5f)*t);
+
+      switch(rows[i][j]){
+        case 'P': d.m_nSpriteIndex = (unsigned)eBenchSprite::Player; break;
+        case 'T': d.m_nSpriteIndex = (unsigned)eBenchSprite::Turret; d.m_fRoll = 0.5f*(float)j; break;
+        case 'S': d.m_nSpriteIndex = (unsigned)eBenchSprite::Spike; break;
+        case 'D': d.m_nSpriteIndex = (unsigned)eBenchSprite::Door; break;
+        case 'I': d.m_nSpriteIndex = (unsigned)eBenchSprite::Star; break;
+        case 'B': d.m_nSpriteIndex = (unsigned)eBenchSprite::Bat; d.m_f4Tint = SBenchVec(1.0f, 0.5f, 0.5f); break;
+        case 'L': d.m_nSpriteIndex = (unsigned)eBenchSprite::LaunchPad; break;
+        case 'H': d.m_nSpriteIndex = (unsigned)eBenchSprite::HealthPack; break;
+        case 'O': d.m_nSpriteIndex = (unsigned)eBenchSprite::OneUp; d.m_fAlpha = 0.5f; break;
+        default: continue;
+      } //switch
+
+      objects.push_back(d);
+    } //for
+
+  //render
+
+  const SBenchColor white;
+  double saveTime = 0.0;
+  size_t instances = 0, unsorted = 0, batches = 0; //totals over all frames
+  CDrawQueue queue;
+  char text[64];
+
+  timer.Restart();
+
+  for(size_t k=0; k<frames; k++){
+    const float s = frames > 1? (float)k/(frames - 1): 0.0f; //pan from left to right
+    renderer.SetCameraPos(SBenchVec(0.5f*renderer.GetFrameWidth() + s*(w*t - renderer.GetFrameWidth()),
+      0.5f*h*t));
+
+    renderer.BeginFrame();
+
+    const SBenchVec campos = renderer.GetCameraPos();
+    const int left = std::max(0, (int)((campos.x - 0.5f*renderer.GetFrameWidth())/t) - 1);
+    const int right = std::min((int)w - 1, (int)((campos.x + 0.5f*renderer.GetFrameWidth())/t) + 1);
+
+    SBenchDesc tile;
+    tile.m_nSpriteIndex = (unsigned)eBenchSprite::Tile;
+
+    for(size_t i=0; i<h; i++)
+      for(int j=left; j<=right && j<(int)rows[i].size(); j++){
+        tile.m_vPos = SBenchVec((j + 0.5f)*t, (h - 1 - i + 0.5f)*t);
+        tile.m_nCurrentFrame = rows[i][j] == 'W'? 1: 0; //objects stand on floor
+        queue.Add(&tile, eDrawLayer::Background);
+      } //for
+
+    for(SBenchDesc& d: objects){
+      queue.Add(&d, eDrawLayer::Objects, 0.5f*t);
+
+      if(d.m_nSpriteIndex == (unsigned)eBenchSprite::Turret){ //health bar
+        const SBenchVec p0(d.m_vPos.x - 35.0f, d.m_vPos.y + 60.0f);
+        const SBenchVec p1(d.m_vPos.x + 10.0f, d.m_vPos.y + 60.0f);
+        const SBenchVec p2(d.m_vPos.x + 35.0f, d.m_vPos.y + 60.0f);
+        queue.AddLine(eBenchSprite::HealthBar_Green, p0, p1, renderer.GetWidth(eBenchSprite::HealthBar_Green), eDrawLayer::Overlay);
+        queue.AddLine(eBenchSprite::HealthBar_Red, p2, p1, renderer.GetWidth(eBenchSprite::HealthBar_Red), eDrawLayer::Overlay);
+      } //if
+    } //for
+
+    queue.Flush<SBenchDesc>(&renderer);
+
+    instances += queue.GetNumInstances();
+    unsorted += queue.GetNumUnsortedBatches();
+    batches += queue.GetNumBatches();
+    queue.Clear();
+
+    snprintf(text, sizeof(text), "Frame %zu", k);
+    renderer.DrawScreenText(text, SBenchVec(30.0f, 30.0f), white);
+
+    renderer.EndFrame();
+
+    if(k == 0 || k + 1 == frames){
+      CStopwatch saveTimer;
+      const std::string filename = prefix + std::to_string(k) + ".png";
+
+      if(!renderer.SavePNG(filename.c_str()))
+        printf("Cannot write %s.\n", filename.c_str());
+
+      saveTime += saveTimer.GetTime();
+    } //if
+  } //for
+
+  const double dt = timer.GetTime() - saveTime;
+
+  printf("map %s (%zux%zu), %zu objects, %dx%d framebuffer\n", map, w, h,
+    objects.size(), renderer.GetFrameWidth(), renderer.GetFrameHeight());
+  printf("%zu frames in %.3f s, %.1f frames/s, %.3f ms per frame\n",
+    frames, dt, frames/dt, 1000.0*dt/frames);
+  printf("%.1f sprites, %.1f runs unsorted, %.1f runs sorted per frame\n",
+    (double)instances/frames, (double)unsorted/frames, (double)batches/frames);
+  printf("%.1f ms per PNG\n", 1000.0*saveTime/(frames > 1? 2: 1));
+
+  return 0;
+} //RenderBench
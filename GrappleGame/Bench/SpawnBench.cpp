@@ -0,0 +1,181 @@
+/// \file SpawnBench.cpp
+/// \brief Lazy spawning benchmark.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <filesystem>
+
+#include "Bench.h"
+#include "LevelData.h"
+#include "MapGenerator.h"
+#include "SpawnTable.h"
+
+/// Get the distance from a point to a rectangle the size of the window
+/// centered on the camera.
+/// \param p Point.
+/// \param cx Camera horizontal position.
+/// \param cy Camera vertical position.
+/// \return Distance from the rectangle, 0 if the point is inside it.
+
+static float ViewDistance(const Vector2& p, float cx, float cy){
+  const float dx = std::max(0.0f, fabsf(p.x - cx) - 512.0f);
+  const float dy = std::max(0.0f, fabsf(p.y - cy) - 384.0f);
+  return sqrtf(dx*dx + dy*dy);
+} //ViewDistance
+
+/// Check that a record stored into a cell that has never been looked at
+/// ends up dormant in that cell and is counted right. Storing it there makes
+/// the records of that cell, which moves the records in memory, so this is
+/// worth running under a memory checker.
+/// \return true if the check passes.
+
+static bool CheckStore(){
+  const size_t n = 64; //spawns in the second cell, enough to move the records
+  std::vector<SSpawn> spawns(n + 1);
+  SSpawnCells cells;
+
+  cells.m_fCellSize = 100.0f;
+  cells.m_nWide = 2;
+  cells.m_nHigh = 1;
+  cells.m_vecFirst = {0, 1, (uint32_t)n + 1};
+  cells.m_vecCounts.assign((size_t)eSprite::Size + 1, 0);
+  cells.m_vecCounts[(size_t)eSprite::Bat] = (uint32_t)n + 1;
+
+  for(size_t i=0; i<=n; i++){
+    spawns[i].m_eSprite = eSprite::Bat;
+    spawns[i].m_vPos = Vector2(i == 0? 50.0f: 150.0f, 50.0f);
+    cells.m_vecSpawns.push_back((uint32_t)i);
+  } //for
+
+  CSpawnTable table;
+  table.Set(spawns, cells);
+
+  std::vector<uint32_t> found; //records in the first cell
+  table.Find(Vector2(0.0f, 0.0f), Vector2(50.0f, 50.0f), found);
+  if(found.size() != 1)return false;
+
+  table.Wake(found[0]);
+  SSpawnRecord r = table.GetRecord(found[0]); //state of its object
+  r.m_vPos = Vector2(150.0f, 50.0f); //into the second cell, not looked at yet
+  table.Store(found[0], r);
+
+  table.Find(Vector2(100.0f, 0.0f), Vector2(150.0f, 50.0f), found);
+
+  return found.size() == n + 1 &&
+    std::find(found.begin(), found.end(), 0) != found.end() &&
+    table.GetRecord(0).m_eState == eSpawnState::Dormant &&
+    table.GetNumActive() == 0 && table.GetNumMade() == n + 1 &&
+    table.GetNumDormant() == n + 1 && table.GetNumDormant(eSprite::Bat) == n + 1;
+} //CheckStore
+
+/// Generate maps of growing size and population, and for each one time
+/// setting the spawn table as the tile manager does on level start, then pan
+/// a 1024 by 768 camera along the bottom of the map and back, making the
+/// objects whose records come within 2048 pixels of the view and storing
+/// those that get more than 2176 pixels away, as the object manager does.
+/// Objects don't move. The number of objects that would be made at level
+/// start without lazy spawning is given for comparison, with the largest
+/// and average number of objects made at one time, the number made over the
+/// whole pan, the number of spawn records made, and the time per frame taken
+/// to find, make, and store them. Making an object is counted but not timed,
+/// since it needs the renderer. First `CheckStore()` is run, and nothing is
+/// timed if it fails.
+/// \param argc Number of arguments.
+/// \param argv Optional frames and seed.
+/// \return 0 on success.
+
+int SpawnBench(int argc, char* argv[]){
+  const size_t frames = argc > 0? std::max<size_t>(2, (size_t)atol(argv[0])): 2000;
+  const uint32_t seed = argc > 1? (uint32_t)atol(argv[1]): 1;
+  const float t = TILE_SIZE; //tile size
+  const float near = 2048.0f; //made within this distance of the view
+  const float far = near + 128.0f; //stored beyond this distance from the view
+
+  if(!CheckStore()){
+    printf("Storing into a new cell failed.\n");
+    return 1;
+  } //if
+
+  const size_t sizes[][2] = {{256, 64}, {1024, 256}, {4096, 1024}};
+  const std::string file = (std::filesystem::temp_directory_path()/"spawn_map.txt").string();
+
+  printf("seed %u, %zu frames\n", seed, frames);
+  printf("%11s %6s %8s %9s %7s %7s %7s %8s %9s\n", "size", "scale", "spawns",
+    "start us", "max", "mean", "made", "records", "frame us");
+
+  for(const auto& sz: sizes)
+    for(float scale: {1.0f, 4.0f}){
+      SMapGenDesc d;
+      d.m_nWidth = sz[0];
+      d.m_nHeight = sz[1];
+      d.m_nSeed = seed;
+      d.ScaleCounts(scale);
+
+      CMapGenerator gen;
+      gen.Generate(d);
+
+      CLevelData level(t);
+
+      if(!gen.Save(file.c_str()) || !level.Load(file.c_str())){
+        printf("%s\n", level.GetError().c_str());
+        return 1;
+      } //if
+
+      const std::vector<SSpawn>& spawns = level.GetSpawns(); //player first
+      const float w = t*level.GetWidth(), h = t*level.GetHeight(); //world size
+      CSpawnTable table;
+
+      CStopwatch timer;
+      table.Set(spawns, level.GetSpawnCells());
+      const double tStart = timer.GetTime();
+
+      std::vector<uint32_t> active; //records made
+      std::vector<uint32_t> found; //records near the view
+      size_t made = 0, most = 0; //counts
+      double sum = 0.0; //sum of objects made per frame
+      const float cy = std::min(h, 768.0f)/2; //camera height
+      timer.Restart();
+
+      for(size_t f=0; f<frames; f++){
+        const float u = 2.0f*f/(frames - 1); //0 to 2 and back
+        const float cx = 512.0f + (w - 1024.0f)*(u <= 1.0f? u: 2.0f - u); //camera
+
+        for(size_t i=0; i<active.size();){ //store far objects
+          const SSpawnRecord& r = table.GetRecord(active[i]); //shorthand
+
+          if(ViewDistance(r.m_vPos, cx, cy) > far){
+            table.Store(active[i], r);
+            active[i] = active.back();
+            active.pop_back();
+          } //if
+
+          else i++;
+        } //for
+
+        table.Find(Vector2(cx - 512.0f - near, cy - 384.0f - near),
+          Vector2(cx + 512.0f + near, cy + 384.0f + near), found);
+
+        for(uint32_t n: found) //make near objects
+          if(ViewDistance(table.GetRecord(n).m_vPos, cx, cy) <= near){
+            table.Wake(n);
+            active.push_back(n);
+            made++;
+          } //if
+
+        most = std::max(most, active.size());
+        sum += active.size();
+      } //for
+
+      const double tFrame = timer.GetTime()/frames;
+
+      printf("%5zux%-5zu %6.0f %8zu %9.1f %7zu %7.0f %7zu %8zu %9.2f\n", sz[0], sz[1],
+        scale, table.GetNumRecords(), 1e6*tStart, most, sum/frames, made,
+        table.GetNumMade(), 1e6*tFrame);
+    } //for
+
+  return 0;
+} //SpawnBench
@@ -0,0 +1,103 @@
+/// \file StartupBench.cpp
+/// \brief Benchmark for sprite loading at startup.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+
+#include "Bench.h"
+#include "MediaUtil.h"
+#include "ImageCache.h"
+#include "SpriteRegistry.h"
+#include "SpriteAtlas.h"
+#include "SoftRenderer.h"
+
+/// Time the software renderer's startup, from reading the settings to having
+/// every sprite tag in the settings loaded through a `CSpriteRegistry`, with
+/// images decoded one at a time, in parallel, in parallel with a cold image
+/// cache, and in parallel with a warm image cache. Sprites that are in the
+/// atlas, if there is one, need no images of their own. A cold cache has
+/// both the sprite images and the atlas pages evicted before each
+/// repetition. Cache hits and misses are averaged over the repetitions. Run
+/// from the folder that contains `Media`.
+/// \param argc Number of arguments.
+/// \param argv Optional number of threads, cache folder, and repetitions.
+/// \return 0 on success.
+
+int StartupBench(int argc, char* argv[]){
+  const size_t threads = argc > 0? (size_t)atol(argv[0]): 0;
+  const char* folder = argc > 1? argv[1]: "Media/Cache";
+  const size_t reps = argc > 2? std::max<size_t>(1, (size_t)atol(argv[2])): 5;
+  const char* settings = "Media/XML/gamesettings.xml";
+
+  std::string s, tag, name, file, ext, value;
+  if(!ReadFile(settings, s)){
+    printf("Cannot read %s.\n", settings);
+    return 1;
+  } //if
+
+  //every sprite tag and image file in the settings
+
+  std::string path;
+  if(GetTag(s, "<sprites", tag) && GetAttribute(tag, "path", value))
+    path = FixPath(value) + "/";
+
+  CSpriteRegistry registry;
+  std::vector<SImageData> images; //sprite images
+
+  for(size_t pos=0; NextTag(s, "<sprite", pos, tag);){
+    if(!GetAttribute(tag, "name", name) || !GetAttribute(tag, "file", file))continue;
+
+    const size_t frames = GetAttribute(tag, "frames", value)? (size_t)atoi(value.c_str()): 1;
+    if(!GetAttribute(tag, "ext", ext))ext.clear();
+
+    registry.Add(registry.GetSize(), name.c_str());
+
+    for(size_t f=0; f<frames; f++){
+      images.push_back(SImageData());
+      images.back().m_strFile = path + (frames > 1? file + std::to_string(f) + "." + ext: file);
+    } //for
+  } //for
+
+  std::vector<SImageData> evict(images); //sprite images and atlas pages, for evicting from the cache
+  CSpriteAtlas atlas;
+
+  if(GetTag(s, "<atlas", tag) && GetAttribute(tag, "file", value) &&
+    atlas.Load(FixPath(value).c_str()))
+    for(size_t i=0; i<atlas.GetNumPages(); i++){
+      evict.push_back(SImageData());
+      evict.back().m_strFile = atlas.GetPagePath(i);
+    } //for
+
+  static const struct{const char* m_pName; size_t m_nThreads; bool m_bCache; bool m_bCold;} modes[] = {
+    {"serial", 1, false, false}, {"parallel", threads, false, false},
+    {"parallel, cold cache", threads, true, true}, {"parallel, warm cache", threads, true, false},
+  }; //modes
+
+  printf("%zu sprites, %zu images\n", registry.GetSize(), images.size());
+
+  for(auto& m: modes){
+    CImageCache cache(m.m_bCache? folder: "", m.m_nThreads);
+    double total = 0.0;
+    size_t decoded = 0, pages = 0;
+
+    for(size_t r=0; r<reps; r++){
+      if(m.m_bCold)cache.Evict(evict);
+
+      CStopwatch timer;
+      CSoftRenderer renderer(settings, &cache);
+      renderer.Initialize(registry.GetSize());
+      decoded = renderer.Prefetch(registry.GetNames());
+      registry.Load<size_t>(&renderer);
+      total += timer.GetTime();
+      pages = renderer.GetNumPages();
+    } //for
+
+    printf("%-22s %2zu threads %7.2f ms, %zu images decoded, %zu pages, %.1f cache hits, %.1f misses\n",
+      m.m_pName, cache.GetThreads(), 1000.0*total/reps, decoded, pages,
+      (double)cache.GetHits()/reps, (double)cache.GetMisses()/reps);
+  } //for
+
+  return 0;
+} //StartupBench
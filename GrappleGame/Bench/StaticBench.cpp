@@ -0,0 +1,147 @@
+/// \file StaticBench.cpp
+/// \brief Static object grid benchmark.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <filesystem>
+
+#include "Bench.h"
+#include "LevelData.h"
+#include "StaticGrid.h"
+
+/// Determine whether a kind of object never moves, as its constructor says.
+/// \param t Sprite type of the object.
+/// \return true if it is static.
+
+static bool IsStatic(eSprite t){
+  switch(t){
+    case eSprite::Door:
+    case eSprite::Star:
+    case eSprite::HealthPack:
+    case eSprite::OneUp:
+    case eSprite::Shotgun: return true;
+    default: return false;
+  } //switch
+} //IsStatic
+
+/// Load every map in a folder and, with every object on it made and awake,
+/// count and time the pairs of objects looked at for collisions in a frame,
+/// first the old way with every object against every other one, and then
+/// with the static objects in a `CStaticGrid` and each moving object
+/// against the other moving ones and the static ones that the grid finds
+/// around it, or every static one if there are too few for the grid to
+/// pay, as `CObjectManager::BroadPhase` does. The player and its grappler are both at the player's spawn,
+/// and every object has a radius of half a tile. The number of overlapping
+/// pairs with a moving object in them found each way is given as a check
+/// that none are missed, with the time taken to fill the grid. Run from the
+/// folder that contains `Media`.
+/// \param argc Number of arguments.
+/// \param argv Optional folder and repetitions.
+/// \return 0 on success.
+
+int StaticBench(int argc, char* argv[]){
+  const char* folder = argc > 0? argv[0]: "Media/Maps";
+  const size_t reps = argc > 1? std::max<size_t>(1, (size_t)atol(argv[1])): 1000;
+  const float t = TILE_SIZE; //tile size
+  const float r = 0.5f*t; //object radius
+
+  std::vector<std::string> files; //map files, sorted
+
+  std::error_code err;
+  for(const auto& entry: std::filesystem::directory_iterator(folder, err))
+    if(entry.path().extension() == ".txt")
+      files.push_back(entry.path().generic_string());
+
+  if(files.empty()){
+    printf("No maps in %s.\n", folder);
+    return 1;
+  } //if
+
+  std::sort(files.begin(), files.end());
+
+  printf("%zu reps\n", reps);
+  printf("%-26s %6s %6s %8s %8s %8s %8s %7s %7s %8s\n", "map", "moving", "static",
+    "old prs", "new prs", "old us", "new us", "old hit", "new hit", "fill us");
+
+  for(const std::string& file: files){
+    CLevelData level(t);
+    if(!level.Load(file.c_str()))continue;
+
+    std::vector<Vector2> moving, statics; //object positions
+
+    for(const SSpawn& s: level.GetSpawns())
+      (IsStatic(s.m_eSprite)? statics: moving).push_back(s.m_vPos);
+
+    if(!level.GetSpawns().empty())
+      moving.push_back(level.GetSpawns()[0].m_vPos); //grappler, at the player
+
+    std::vector<Vector2> all(moving); //every object
+    all.insert(all.end(), statics.begin(), statics.end());
+
+    const size_t n = all.size(), m = moving.size(); //shorthands
+    const float d2 = 4.0f*r*r; //squared distance at which two objects touch
+    size_t oldHits = 0, newHits = 0, newPairs = 0; //counts
+
+    CStopwatch timer;
+
+    for(size_t k=0; k<reps; k++){ //every object against every other one
+      oldHits = 0;
+
+      for(size_t i=0; i<n; i++)
+        for(size_t j=i + 1; j<n; j++)
+          if(Vector2::DistanceSquared(all[i], all[j]) < d2 && i < m)
+            oldHits++; //static pairs do nothing
+    } //for
+
+    const double tOld = timer.GetTime()/reps;
+
+    CStaticGrid grid;
+    timer.Restart();
+    grid.Set(t*level.GetWidth(), t*level.GetHeight(), 2.0f*t);
+
+    for(const Vector2& p: statics)
+      grid.Insert(p, r);
+
+    const double tFill = timer.GetTime();
+
+    std::vector<uint32_t> near; //static objects near a moving one
+    timer.Restart();
+
+    for(size_t k=0; k<reps; k++){ //moving objects against the rest
+      newHits = 0;
+      newPairs = m*(m - 1)/2;
+
+      for(size_t i=0; i<m; i++)
+        for(size_t j=i + 1; j<m; j++)
+          if(Vector2::DistanceSquared(moving[i], moving[j]) < d2)
+            newHits++;
+
+      if(grid.IsWorthQuerying())
+        for(const Vector2& p: moving){
+          newPairs += grid.Query(p, r, near);
+          newHits += near.size();
+        } //for
+
+      else{ //as the object manager does with few static objects
+        newPairs += m*statics.size();
+
+        for(const Vector2& p: moving)
+          for(const Vector2& q: statics)
+            if(Vector2::DistanceSquared(p, q) < d2)
+              newHits++;
+      } //else
+    } //for
+
+    const double tNew = timer.GetTime()/reps;
+    const std::string name = std::filesystem::path(file).filename().string();
+
+    printf("%-26s %6zu %6zu %8zu %8zu %8.2f %8.2f %7zu %7zu %8.1f\n", name.c_str(), m,
+      statics.size(), n*(n - 1)/2, newPairs, 1e6*tOld, 1e6*tNew, oldHits, newHits,
+      1e6*tFill);
+  } //for
+
+  return 0;
+} //StaticBench
@@ -0,0 +1,132 @@
+/// \file AiScheduler.cpp
+/// \brief Code for the AI scheduler CAiScheduler.
+
+#include <algorithm>
+
+#include "AiScheduler.h"
+
+static const float SMOOTHING = 0.25f; ///< Weight of the latest frame in the cost per update.
+
+/// Set the number of microseconds that updates may take each frame.
+/// \param t Microseconds per frame.
+
+void CAiScheduler::SetBudget(float t){
+  m_fBudget = std::max(0.0f, t);
+} //SetBudget
+
+/// Start a new frame with no candidates.
+
+void CAiScheduler::Begin(){
+  m_vecCandidates.clear();
+  m_nChosen = 0;
+  m_fTimeUsed = 0.0f;
+} //Begin
+
+/// Add a candidate for an update. Candidates are numbered in the order that
+/// they are added, starting at 0.
+/// \param age Number of frames since its last update.
+/// \param weight How much it matters, 1 for an enemy that doesn't stand out.
+
+void CAiScheduler::Add(size_t age, float weight){
+  SCandidate c;
+  c.m_nIndex = (uint32_t)m_vecCandidates.size();
+  c.m_fPriority = (age + 1)*weight;
+  m_vecCandidates.push_back(c);
+} //Add
+
+/// Pick the candidates to update this frame, as many as fit in the budget at
+/// the estimated cost per update, or all of them until the cost has been
+/// measured, and at least one. The highest priority ones are put first, in
+/// no particular order. Start the clock on the updates.
+/// \return Number of candidates picked.
+
+const size_t CAiScheduler::Pick(){
+  const size_t n = m_vecCandidates.size(); //number of candidates
+  m_nChosen = n;
+
+  if(m_fCost > 0.0f)
+    m_nChosen = std::min(n, std::max<size_t>(1, (size_t)(m_fBudget/m_fCost)));
+
+  if(m_nChosen < n)
+    std::nth_element(m_vecCandidates.begin(), m_vecCandidates.begin() + m_nChosen,
+      m_vecCandidates.end(), [](const SCandidate& a, const SCandidate& b){
+        return a.m_fPriority > b.m_fPriority;
+      });
+
+  m_nUpdates += m_nChosen;
+  m_nDeferred += n - m_nChosen;
+  m_tStart = Clock::now();
+
+  return m_nChosen;
+} //Pick
+
+/// Get a candidate picked for an update this frame.
+/// \param i Index less than the number picked.
+/// \return Number of the candidate, in the order that it was added.
+
+const size_t CAiScheduler::GetChosen(size_t i) const{
+  return m_vecCandidates[i].m_nIndex;
+} //GetChosen
+
+/// Stop the clock on this frame's updates and fold the time taken for each
+/// into the estimated cost per update.
+
+void CAiScheduler::End(){
+  const std::chrono::duration<float, std::micro> t = Clock::now() - m_tStart;
+  m_fTimeUsed = t.count();
+
+  if(m_nChosen > 0){
+    const float c = m_fTimeUsed/m_nChosen; //cost per update this frame
+    m_fCost = m_fCost > 0.0f? m_fCost + SMOOTHING*(c - m_fCost): c;
+    m_fCost = std::max(m_fCost, 1e-3f); //keep it measured
+  } //if
+} //End
+
+/// Reader function for the budget.
+/// \return Microseconds per frame.
+
+const float CAiScheduler::GetBudget() const{
+  return m_fBudget;
+} //GetBudget
+
+/// Reader function for the estimated cost of an update.
+/// \return Smoothed microseconds per update, 0 if not yet measured.
+
+const float CAiScheduler::GetCost() const{
+  return m_fCost;
+} //GetCost
+
+/// Reader function for the time taken by this frame's updates.
+/// \return Microseconds between `Pick()` and `End()`.
+
+const float CAiScheduler::GetTimeUsed() const{
+  return m_fTimeUsed;
+} //GetTimeUsed
+
+/// Reader function for the number of candidates.
+/// \return Number of candidates added this frame.
+
+const size_t CAiScheduler::GetNumCandidates() const{
+  return m_vecCandidates.size();
+} //GetNumCandidates
+
+/// Reader function for the number of candidates picked.
+/// \return Number of candidates picked this frame.
+
+const size_t CAiScheduler::GetNumChosen() const{
+  return m_nChosen;
+} //GetNumChosen
+
+/// Reader function for the number of updates.
+/// \return Number of updates made over all frames.
+
+const size_t CAiScheduler::GetNumUpdates() const{
+  return m_nUpdates;
+} //GetNumUpdates
+
+/// Reader function for the number of deferred updates.
+/// \return Number of updates deferred over all frames.
+
+const size_t CAiScheduler::GetNumDeferred() const{
+  return m_nDeferred;
+} //GetNumDeferred
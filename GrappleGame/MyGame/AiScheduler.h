@@ -0,0 +1,65 @@
+/// \file AiScheduler.h
+/// \brief Interface for the AI scheduler CAiScheduler.
+
+#ifndef __L4RC_GAME_AISCHEDULER_H__
+#define __L4RC_GAME_AISCHEDULER_H__
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/// \brief The AI scheduler.
+///
+/// CAiScheduler spreads the costly part of enemy updates, looking around and
+/// making decisions, over frames so that it takes no more than a fixed
+/// number of microseconds each frame. Each frame the enemies that want an
+/// update are added as candidates with the number of frames since their
+/// last update and a weight, which is higher for enemies that matter more,
+/// such as those on screen. The scheduler picks the candidates with the
+/// highest weight times age, as many as the budget allows at the cost per
+/// update measured in earlier frames, and the rest are deferred. An enemy
+/// that is deferred gets older, so every enemy is updated sooner or later.
+/// At least one candidate is picked every frame.
+
+class CAiScheduler{
+  private:
+    using Clock = std::chrono::high_resolution_clock; ///< Clock for timing updates.
+
+    /// \brief An enemy that wants an update.
+
+    struct SCandidate{
+      uint32_t m_nIndex = 0; ///< Order in which it was added.
+      float m_fPriority = 0.0f; ///< Weight times age.
+    }; //SCandidate
+
+    float m_fBudget = 500.0f; ///< Microseconds per frame.
+    float m_fCost = 0.0f; ///< Smoothed microseconds per update, 0 until measured.
+
+    std::vector<SCandidate> m_vecCandidates; ///< This frame's candidates.
+    size_t m_nChosen = 0; ///< Number of candidates picked this frame.
+    Clock::time_point m_tStart; ///< When the picked updates started.
+
+    float m_fTimeUsed = 0.0f; ///< Microseconds taken by this frame's updates.
+    size_t m_nUpdates = 0; ///< Number of updates made.
+    size_t m_nDeferred = 0; ///< Number of updates deferred.
+
+  public:
+    void SetBudget(float); ///< Set microseconds per frame.
+
+    void Begin(); ///< Start a new frame.
+    void Add(size_t, float); ///< Add a candidate.
+    const size_t Pick(); ///< Pick candidates and start the clock.
+    const size_t GetChosen(size_t) const; ///< Get a picked candidate.
+    void End(); ///< Stop the clock.
+
+    const float GetBudget() const; ///< Get microseconds per frame.
+    const float GetCost() const; ///< Get estimated microseconds per update.
+    const float GetTimeUsed() const; ///< Get microseconds taken this frame.
+    const size_t GetNumCandidates() const; ///< Get number of candidates this frame.
+    const size_t GetNumChosen() const; ///< Get number picked this frame.
+    const size_t GetNumUpdates() const; ///< Get number of updates made.
+    const size_t GetNumDeferred() const; ///< Get number of updates deferred.
+}; //CAiScheduler
+
+#endif //__L4RC_GAME_AISCHEDULER_H__
@@ -6,13 +6,66 @@
 #include "Helpers.h"
 #include "Particle.h"
 #include "ParticleEngine.h"
+#include "SpawnTable.h"
 
 CBat::CBat(const Vector2& p) : CObject(eSprite::Bat, p) {
     m_bStatic = false;
+    m_bThinks = true;
     t = m_pTimer->GetTime();
     tAir = m_pTimer->GetTime();
+    m_fPathTime = t - repathTime;
 } //constructor
 
+/// Ask the tile manager whether the player can be seen. The answer is ready
+/// when the bat thinks.
+
+void CBat::perceive() {
+    if (m_pPlayer) { //safety
+        const float r = ((CBat*)m_pPlayer)->m_fRadius; //player radius
+        m_nLosQuery = m_pTileManager->AddLosQuery(m_vPos, m_pPlayer->m_vPos, r);
+    }
+    else m_nLosQuery = SIZE_MAX;
+} //perceive
+
+/// Remember whether the player could be seen, and chase the player if not
+/// too near and not too far. Both hold until the AI scheduler next picks
+/// this bat to think.
+
+void CBat::think() {
+    m_bSeesPlayer = m_pTileManager->GetLos(m_nLosQuery);
+    m_bChase = false;
+
+    if (m_pPlayer) {
+        const float distance = Vector2::Distance(m_vPos, m_pPlayer->GetPos());
+        m_bChase = distance > chaseMin && distance < chaseMax;
+    }
+} //think
+
+/// Keep the bat's position, orientation, and health in its spawn record
+/// when it is stored away.
+/// \param r [out] The spawn record.
+
+void CBat::SaveSpawn(SSpawnRecord& r) const {
+    CObject::SaveSpawn(r);
+    r.m_nHealth = m_nHealth;
+    r.m_bChanged = m_nHealth != m_nMaxHealth;
+} //SaveSpawn
+
+/// Get back the bat's position, orientation, and health from its spawn
+/// record, with the health bar and tint to match.
+/// \param r The spawn record.
+
+void CBat::LoadSpawn(const SSpawnRecord& r) {
+    CObject::LoadSpawn(r);
+
+    if (r.m_bChanged && r.m_nHealth > 0) {
+        m_nHealth = r.m_nHealth;
+        m_bHealthPercent = (float)m_nHealth / m_nMaxHealth;
+        const float f = 0.5f + 0.5f * (float)m_nHealth / m_nMaxHealth; //health fraction
+        m_f4Tint = XMFLOAT4(1.0f, f, f, 0); //redden the sprite to indicate damage
+    }
+} //LoadSpawn
+
 /// Rotate the turret and fire the gun at at the closest available target if
 /// there is one, and rotate the turret at a constant speed otherwise.
 
@@ -34,7 +87,6 @@ void CBat::move() {
     }
 
     if (m_pPlayer) { //safety
-        const float r = ((CBat*)m_pPlayer)->m_fRadius; //player radius
         Vector2 direction = m_vPos - m_pPlayer->m_vPos;
         direction.Normalize();
         float dot = direction.Dot(view);
@@ -49,7 +101,7 @@ void CBat::move() {
 
         m_fRoll = (flipAim) ? M_PI : 0.0f;
 
-        if (m_pTileManager->Visible(m_vPos, m_pPlayer->m_vPos, r) && m_pGunFireEvent->Triggered() && dot < 0.0f)
+        if (m_bSeesPlayer && m_pGunFireEvent->Triggered() && dot < 0.0f)
         {//player visible
           //RotateTowards(m_pPlayer->m_vPos);
             m_pObjectManager->FireGun(this, eSprite::Bullet2);
@@ -57,6 +109,13 @@ void CBat::move() {
         }
         //else m_fRotSpeed = 0.4f; //no target visible, so scan
     } //if
+    if (m_pPlayer && m_bChase) { //chase the player along a path around the walls
+        if (FollowPath(m_pPlayer->GetPos())) {
+            t = m_pTimer->GetTime(); //restart the hover timer
+            return;
+        }
+    }
+
     if (m_pTimer->GetTime() - t > 1.0f)
     {
         if (flip)
@@ -75,6 +134,49 @@ void CBat::move() {
     m_vPos += Vector2(0, -1) * m_vVelocity.y * delta;
 } //move
 
+/// Fly along a path toward a target, asking the tile manager for a new path
+/// every so often since the target moves. A query that is deferred because
+/// enough searches have been made this frame is made again next frame, and
+/// in the meantime the bat keeps to its old path.
+/// \param target Target position.
+/// \return true if the bat moved along a path.
+
+bool CBat::FollowPath(const Vector2& target) {
+    const float now = m_pTimer->GetTime();
+
+    if (now - m_fPathTime > repathTime) {
+        switch (m_pTileManager->FindPath(m_vPos, target, m_vecPath)) {
+            case ePathResult::Found:
+                m_nWaypoint = 0;
+                m_fPathTime = now;
+                break;
+
+            case ePathResult::None:
+                m_vecPath.clear();
+                m_fPathTime = now;
+                break;
+
+            case ePathResult::Deferred: break; //try again next frame
+        }
+    }
+
+    if (m_nWaypoint >= m_vecPath.size())
+        return false; //no path or reached the end of it
+
+    const Vector2 v = m_vecPath[m_nWaypoint] - m_vPos; //to next point
+    const float d = v.Length(); //distance to next point
+    const float step = chaseSpeed * m_pTimer->GetFrameTime(); //distance to move
+
+    if (d <= step) {
+        m_vPos = m_vecPath[m_nWaypoint++];
+    }
+    else {
+        m_vPos += v * (step / d);
+    }
+
+    return true;
+} //FollowPath
+
 /// Rotate the turret towards a point and file the gun if it is facing
 /// sufficiently close to it.
 /// \param pos Target point.
@@ -125,7 +227,19 @@ void CBat::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
         } //else
     } //if
 
-    if (pObj && pObj->isSpike())
+    CObject::CollisionResponse(norm, d, pObj);
+} //CollisionResponse
+
+/// Response to touching a tile. A spike kills it outright, then
+/// `CObject::TileResponse` backs it off.
+/// \param norm Collision normal.
+/// \param d Overlap distance.
+/// \param props The tile's `eTileProp` flags.
+
+void CBat::TileResponse(const Vector2& norm, float d, uint8_t props) {
+    if (m_bDead)return; //already dead, bail out 
+
+    if (props & (uint8_t)eTileProp::Hazard)
     {
         m_pAudio->play(eSound::Boom); //explosion
         m_bHealthPercent = 0.0f;
@@ -133,8 +247,8 @@ void CBat::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
         DeathFX(); //particle effects
     }
 
-    CObject::CollisionResponse(norm, d, pObj);
-} //CollisionResponse
+    CObject::TileResponse(norm, d, props);
+} //TileResponse
 
 /// Perform a particle effect to mark the death of the turret.
 
@@ -148,7 +262,7 @@ void CBat::DeathFX() {
     d.m_fScaleInFrac = 0.5f;
     d.m_fFadeOutFrac = 0.8f;
     d.m_fScaleOutFrac = 0;
-    m_pParticleEngine->create(d);
+    m_pObjectManager->CreateParticle(d);
 
     d.m_nSpriteIndex = (UINT)eSprite::Spark;
     d.m_fLifeSpan = 0.5f;
@@ -157,5 +271,5 @@ void CBat::DeathFX() {
     d.m_fScaleOutFrac = 0.3f;
     d.m_fFadeOutFrac = 0.5f;
     d.m_f4Tint = XMFLOAT4(Colors::Orange);
-    m_pParticleEngine->create(d);
+    m_pObjectManager->CreateParticle(d);
 } //DeathFX
\ No newline at end of file
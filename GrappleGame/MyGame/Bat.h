@@ -2,6 +2,9 @@
 #ifndef __L4RC_GAME_BAT_H__
 #define __L4RC_GAME_BAT_H__
 
+#include <vector>
+#include <cstdint>
+
 #include "Object.h"
 
 class CBat : public CObject {
@@ -16,6 +19,7 @@ protected:
 
     void RotateTowards(const Vector2&); ///< Swivel towards position.
     virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
+    virtual void TileResponse(const Vector2&, float, uint8_t); ///< Response to touching a tile.
     virtual void DeathFX(); ///< Death special effects.
     bool flip = true;
     bool flipAim = true;
@@ -23,8 +27,27 @@ protected:
     float tAir;
     bool start = true;
     bool inAir = true;
+
+    const float chaseSpeed = 120.0f; ///< Speed along a path.
+    const float chaseMin = 256.0f; ///< Hover when at least this close to the player.
+    const float chaseMax = 1024.0f; ///< Chase when at most this far from the player.
+    const float repathTime = 0.5f; ///< Time between path queries.
+
+    std::vector<Vector2> m_vecPath; ///< Path to the player.
+    size_t m_nWaypoint = 0; ///< Index of next point on path.
+    float m_fPathTime = 0.0f; ///< Time of last path query.
+
+    size_t m_nLosQuery = SIZE_MAX; ///< Line of sight query to the player.
+    bool m_bSeesPlayer = false; ///< Whether the player was visible when it last thought.
+    bool m_bChase = false; ///< Whether it decided to chase the player.
+
+    bool FollowPath(const Vector2&); ///< Fly along a path to a target.
 public:
     CBat(const Vector2& p); ///< Constructor.
+    virtual void perceive(); ///< Look for the player.
+    virtual void think(); ///< Decide whether to shoot and chase.
+    virtual void SaveSpawn(SSpawnRecord&) const; ///< Keep state in a spawn record.
+    virtual void LoadSpawn(const SSpawnRecord&); ///< Get state from a spawn record.
     virtual void move(); ///< Move turret.
 };
 
@@ -6,6 +6,7 @@
 #include "Particle.h"
 #include "ParticleEngine.h"
 #include "Helpers.h"
+#include "ObjectManager.h"
 
 /// Create and initialize a bullet object given its initial position.
 /// \param t Sprite type of bullet.
@@ -46,6 +47,20 @@ void CBullet::CollisionResponse(const Vector2& norm, float d, CObject* pObj){
   } //if
 } //CollisionResponse
 
+/// Response to touching a tile with a spike on it, which a bullet dies on as
+/// it does on any solid object. Bullets fly over launch pads and through
+/// sensors such as pickups and doors.
+/// \param norm Collision normal.
+/// \param d Overlap distance.
+/// \param props The tile's `eTileProp` flags.
+
+void CBullet::TileResponse(const Vector2& norm, float d, uint8_t props){
+  if(!m_bDead){
+    m_bDead = true; //mark object for deletion
+    DeathFX();
+  } //if
+} //TileResponse
+
 /// Create a smoke particle effect to mark the death of the bullet.
 
 void CBullet::DeathFX(){
@@ -59,5 +74,5 @@ void CBullet::DeathFX(){
   d.m_fFadeOutFrac = 0.8f;
   d.m_fScaleOutFrac = d.m_fFadeOutFrac;
 
-  m_pParticleEngine->create(d); //create particle
+  m_pObjectManager->CreateParticle(d); //create particle
 } //DeathFX
\ No newline at end of file
@@ -15,6 +15,7 @@ class CBullet: public CObject{
   protected:
     virtual void CollisionResponse(const Vector2&, float,
       CObject* = nullptr); ///< Collision response.
+    virtual void TileResponse(const Vector2&, float, uint8_t); ///< Response to touching a tile.
     virtual void DeathFX(); ///< Death special effects.
 
   public:
@@ -5,15 +5,20 @@
 /// for CCommon's static member variables.
 
 #include "Common.h"
+#include "FrameStats.h"
 
 LSpriteRenderer* CCommon::m_pRenderer = nullptr;
 CObjectManager* CCommon::m_pObjectManager = nullptr;
 LParticleEngine2D* CCommon::m_pParticleEngine = nullptr;
 CTileManager* CCommon::m_pTileManager = nullptr; 
+CDrawRecorder* CCommon::m_pDrawRecorder = nullptr;
+CDrawQueue* CCommon::m_pDrawQueue = nullptr;
 
 bool CCommon::m_bDrawAABBs = false;
 bool CCommon::m_bGodMode = false;
 
+SFrameStats CCommon::m_sFrameStats;
+
 Vector2 CCommon::m_vWorldSize = Vector2::Zero;
 CPlayer* CCommon::m_pPlayer = nullptr;
 CGrappler* CCommon::m_pGrappler = nullptr;
@@ -14,6 +14,9 @@ class LParticleEngine2D;
 class CTileManager;
 class CPlayer;
 class CGrappler;
+class CDrawRecorder;
+class CDrawQueue;
+struct SFrameStats;
 
 /// \brief The common variables class.
 ///
@@ -29,10 +32,14 @@ class CCommon{
     static CObjectManager* m_pObjectManager; ///< Pointer to object manager.
     static LParticleEngine2D* m_pParticleEngine; ///< Pointer to particle engine.
     static CTileManager* m_pTileManager; ///< Pointer to tile manager. 
+    static CDrawRecorder* m_pDrawRecorder; ///< Pointer to draw recorder, if recording.
+    static CDrawQueue* m_pDrawQueue; ///< Pointer to draw queue.
 
     static bool m_bDrawAABBs; ///< Draw AABB flag.
     static bool m_bGodMode; ///< God mode flag.
 
+    static SFrameStats m_sFrameStats; ///< Frame statistics for the stats overlay.
+
     static Vector2 m_vWorldSize; ///< World height and width.
     static CPlayer* m_pPlayer; ///< Pointer to player character.
     static CGrappler* m_pGrappler; ///< Pointer to grappler object.
@@ -6,12 +6,38 @@
 #include "Helpers.h"
 #include "Particle.h"
 #include "ParticleEngine.h"
+#include "SpawnTable.h"
 
 CCreeper::CCreeper(const Vector2& p) : CObject(eSprite::Creeper, p) {
     m_bStatic = false;
     m_bIsCreeper = true;
 } //constructor
 
+/// Keep the creeper's position, orientation, and health in its spawn record
+/// when it is stored away.
+/// \param r [out] The spawn record.
+
+void CCreeper::SaveSpawn(SSpawnRecord& r) const {
+    CObject::SaveSpawn(r);
+    r.m_nHealth = m_nHealth;
+    r.m_bChanged = m_nHealth != m_nMaxHealth;
+} //SaveSpawn
+
+/// Get back the creeper's position, orientation, and health from its spawn
+/// record, with the health bar and tint to match.
+/// \param r The spawn record.
+
+void CCreeper::LoadSpawn(const SSpawnRecord& r) {
+    CObject::LoadSpawn(r);
+
+    if (r.m_bChanged && r.m_nHealth > 0) {
+        m_nHealth = r.m_nHealth;
+        m_bHealthPercent = (float)m_nHealth / m_nMaxHealth;
+        const float f = 0.5f + 0.5f * (float)m_nHealth / m_nMaxHealth; //health fraction
+        m_f4Tint = XMFLOAT4(1.0f, f, f, 0); //redden the sprite to indicate damage
+    }
+} //LoadSpawn
+
 void CCreeper::move() {
     const float moveT = m_pTimer->GetFrameTime(); //time
 
@@ -21,16 +47,24 @@ void CCreeper::move() {
     const float delta = 40.0f * moveT;
 
     if (m_pPlayer) {
-        const float r = ((CCreeper*)m_pPlayer)->m_fRadius; //player radius
-
-        if (m_pTileManager->Visible(m_vPos, m_pPlayer->m_vPos, r)) {
-            RotateTowards(m_pPlayer->m_vPos);
-
-            float distance = m_vPos.Distance(m_pPlayer->m_vPos, m_vPos);
-            if (abs(distance) <= explosionDistance) {
-                Explode();
-            }
-        }//player visible
+        const Vector2 target = m_pPlayer->GetPos(); //player position
+        const uint32_t steps = m_pTileManager->GetFlowDistance(m_vPos); //tiles to player
+        Vector2 dir; //direction of next step toward player
+
+        if (m_pTileManager->GetFlowDirection(m_vPos, dir)) {
+            RotateTowards(m_vPos + dir); //follow the flow field around walls
+        }
+        else if (steps == 0) {
+            RotateTowards(target); //same tile as player
+        }
+        else { //can't reach player
+            m_fRotSpeed = 0.0f;
+            m_fSpeed = 0.0f;
+        }
+
+        if (steps <= 2 && Vector2::Distance(m_vPos, target) <= explosionDistance) {
+            Explode();
+        }
     }
     else
     {
@@ -95,7 +129,19 @@ void CCreeper::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
         } //else
     } //if
 
-    if (pObj && pObj->isSpike())
+    CObject::CollisionResponse(norm, d, pObj);
+} //CollisionResponse
+
+/// Response to touching a tile. A spike kills it outright, then
+/// `CObject::TileResponse` backs it off.
+/// \param norm Collision normal.
+/// \param d Overlap distance.
+/// \param props The tile's `eTileProp` flags.
+
+void CCreeper::TileResponse(const Vector2& norm, float d, uint8_t props) {
+    if (m_bDead)return; //already dead, bail out 
+
+    if (props & (uint8_t)eTileProp::Hazard)
     {
         m_pAudio->play(eSound::Boom); //explosion
         m_bHealthPercent = 0.0f;
@@ -103,8 +149,8 @@ void CCreeper::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
         DeathFX(); //particle effects
     }
 
-    CObject::CollisionResponse(norm, d, pObj);
-} //CollisionResponse
+    CObject::TileResponse(norm, d, props);
+} //TileResponse
 
 /// Perform a particle effect to mark the death of the turret.
 void CCreeper::DeathFX() {
@@ -117,7 +163,7 @@ void CCreeper::DeathFX() {
     d.m_fScaleInFrac = 0.01f;
     d.m_fFadeOutFrac = 0.8f;
     d.m_fScaleOutFrac = 0;
-    m_pParticleEngine->create(d);
+    m_pObjectManager->CreateParticle(d);
 } //DeathFX
 
 void CCreeper::Explode() {
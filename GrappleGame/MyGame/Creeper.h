@@ -13,12 +13,15 @@ protected:
 
     void RotateTowards(const Vector2&); ///< Swivel towards position.
     virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
+    virtual void TileResponse(const Vector2&, float, uint8_t); ///< Response to touching a tile.
     virtual void DeathFX(); ///< Death special effects.
 
     void Explode(); ///< Creeper explodes.
 public:
     CCreeper(const Vector2& p); ///< Constructor.
     virtual void move(); ///< Move creeper.
+    virtual void SaveSpawn(SSpawnRecord&) const; ///< Keep state in a spawn record.
+    virtual void LoadSpawn(const SSpawnRecord&); ///< Get state from a spawn record.
 };
 
 #endif
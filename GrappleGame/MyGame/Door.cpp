@@ -11,6 +11,7 @@ CDoor::CDoor(eSprite doorSprite, const Vector2& p) : CObject(eSprite::Door, p)
 {
 	m_bIsTarget = false;
 	m_bStatic = true;
+	m_bSensor = true;
 	m_bIsDoor = true;
 	m_bIsDoorLocked = true;
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+/// \file DrawQueue.cpp
+/// \brief Code for the sprite-sorted draw queue CDrawQueue.
+
+#include "DrawQueue.h"
+
+#include <algorithm>
+#include <cmath>
+
+static const float DEPTH_CELL_SIZE = 64.0f; ///< Width and height of a depth grid cell.
+static const uint32_t MAX_DEPTH = 255; ///< Largest depth, which fits in 8 bits of a sort key.
+
+/// Queue an instance, counting a new run whenever its sprite differs from
+/// that of the instance queued before it.
+/// \param i The instance.
+
+void CDrawQueue::Add(const SDrawInstance& i){
+  if(i.m_nSprite != m_nLastAdded)
+    m_nUnsortedBatches++;
+
+  m_nLastAdded = i.m_nSprite;
+
+  const uint64_t key = (uint64_t)i.m_eLayer << 56 |
+    (uint64_t)i.m_nSprite << 32 | (uint64_t)m_vecInstances.size();
+
+  m_vecInstances.push_back(i);
+  m_vecKeys.push_back(key);
+} //Add
+
+/// Get the cells of the depth grid that the bounding square of an instance
+/// overlaps.
+/// \param i The instance.
+/// \param x0 [out] First column.
+/// \param x1 [out] Last column.
+/// \param y0 [out] First row.
+/// \param y1 [out] Last row.
+/// \return Number of cells.
+
+static size_t GetCells(const SDrawInstance& i, int& x0, int& x1, int& y0, int& y1){
+  x0 = (int)floorf((i.m_fX - i.m_fRadius)/DEPTH_CELL_SIZE);
+  x1 = (int)floorf((i.m_fX + i.m_fRadius)/DEPTH_CELL_SIZE);
+  y0 = (int)floorf((i.m_fY - i.m_fRadius)/DEPTH_CELL_SIZE);
+  y1 = (int)floorf((i.m_fY + i.m_fRadius)/DEPTH_CELL_SIZE);
+
+  return (size_t)(x1 - x0 + 1)*(y1 - y0 + 1);
+} //GetCells
+
+/// Find a cell of the depth grid in the hash table, adding it if it isn't
+/// there, with no sprite in it. The table must have an empty slot.
+/// \param layer Layer.
+/// \param x Column.
+/// \param y Row.
+/// \return The cell.
+
+CDrawQueue::SDepthCell& CDrawQueue::GetCell(eDrawLayer layer, int x, int y){
+  const uint64_t key = (uint64_t)layer << 56 |
+    (uint64_t)(x & 0xFFFFFFF) << 28 | (uint64_t)(y & 0xFFFFFFF); //28 bits each
+  const size_t mask = m_vecCells.size() - 1; //table size is a power of 2
+  size_t k = (size_t)((key*0x9E3779B97F4A7C15ULL) >> 32) & mask; //slot
+
+  while(m_vecCells[k].m_nKey != key && m_vecCells[k].m_nKey != UINT64_MAX)
+    k = (k + 1) & mask;
+
+  m_vecCells[k].m_nKey = key;
+  return m_vecCells[k];
+} //GetCell
+
+/// Give each instance that has a bounding radius a depth one more than the
+/// deepest earlier instance of another sprite in its layer that it may
+/// overlap, or the same depth as an earlier instance of its own sprite, and
+/// put it into its sort key between the layer and the sprite index. Overlap
+/// is found from the bounding squares of the instances on a coarse grid, so
+/// that a cell only needs to keep its deepest instance. Every instance at
+/// the deepest depth in a cell has the same sprite, since one of another
+/// sprite would have gone deeper. Instances without a radius stay at depth
+/// 0. The hash table is sized to be at most half full.
+
+void CDrawQueue::SetDepths(){
+  int x0, x1, y0, y1; //range of cells
+  size_t cells = 0; //most cells that can be used
+
+  for(const SDrawInstance& i: m_vecInstances)
+    if(i.m_fRadius > 0.0f)
+      cells += GetCells(i, x0, x1, y0, y1);
+
+  if(cells == 0)return;
+
+  size_t n = 64; //hash table size, a power of 2
+
+  while(n < 2*cells)
+    n *= 2;
+
+  m_vecCells.assign(n, SDepthCell());
+
+  for(size_t k=0; k<m_vecInstances.size(); k++){
+    const SDrawInstance& i = m_vecInstances[k]; //shorthand
+    if(i.m_fRadius <= 0.0f)continue;
+
+    GetCells(i, x0, x1, y0, y1);
+    uint32_t depth = 0; //depth of this instance
+
+    for(int y=y0; y<=y1; y++)
+      for(int x=x0; x<=x1; x++){
+        const SDepthCell& c = GetCell(i.m_eLayer, x, y);
+
+        if(c.m_nSprite != UINT32_MAX)
+          depth = std::max(depth, c.m_nDepth + (c.m_nSprite != i.m_nSprite));
+      } //for
+
+    depth = std::min(depth, MAX_DEPTH);
+
+    for(int y=y0; y<=y1; y++)
+      for(int x=x0; x<=x1; x++){
+        SDepthCell& c = GetCell(i.m_eLayer, x, y);
+        c.m_nDepth = depth;
+        c.m_nSprite = i.m_nSprite;
+      } //for
+
+    m_vecKeys[k] |= (uint64_t)depth << 48;
+  } //for
+} //SetDepths
+
+/// Sort the queue by layer, then depth, then sprite index, then the order
+/// queued, and count the runs of the same sprite in the sorted order. The
+/// index in the low bits of each key makes the keys unique, so a plain sort
+/// is stable.
+
+void CDrawQueue::Sort(){
+  SetDepths();
+  std::sort(m_vecKeys.begin(), m_vecKeys.end());
+
+  for(uint64_t key: m_vecKeys){
+    const uint32_t sprite = (uint32_t)(key >> 32) & 0xFFFF;
+
+    if(sprite != m_nLastFlushed)
+      m_nBatches++;
+
+    m_nLastFlushed = sprite;
+  } //for
+} //Sort
+
+/// Empty the queue and reset the counts, ready for the next frame.
+
+void CDrawQueue::Clear(){
+  m_vecInstances.clear();
+  m_vecKeys.clear();
+
+  m_nUnsortedBatches = m_nBatches = m_nInstances = 0;
+  m_nLastAdded = m_nLastFlushed = UINT32_MAX;
+} //Clear
+
+/// Reader function for the number of instances flushed since `Clear()`.
+/// \return Number of instances flushed.
+
+const size_t CDrawQueue::GetNumInstances() const{
+  return m_nInstances;
+} //GetNumInstances
+
+/// Reader function for the number of runs of the same sprite in the order
+/// that sprites were queued, which is the number of texture switches that
+/// drawing them unsorted would make, plus one.
+/// \return Number of runs before sorting.
+
+const size_t CDrawQueue::GetNumUnsortedBatches() const{
+  return m_nUnsortedBatches;
+} //GetNumUnsortedBatches
+
+/// Reader function for the number of runs of the same sprite in the order
+/// that sprites were flushed.
+/// \return Number of runs after sorting.
+
+const size_t CDrawQueue::GetNumBatches() const{
+  return m_nBatches;
+} //GetNumBatches
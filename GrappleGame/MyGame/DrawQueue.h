@@ -0,0 +1,215 @@
+/// \file DrawQueue.h
+/// \brief Interface for the sprite-sorted draw queue CDrawQueue.
+
+#ifndef __L4RC_GAME_DRAWQUEUE_H__
+#define __L4RC_GAME_DRAWQUEUE_H__
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+
+#include "DrawRecorder.h"
+
+/// \brief Draw layer.
+///
+/// An enumerated type for the layers that sprites are drawn in, which will be
+/// cast to an unsigned integer and used as the most significant part of the
+/// sort key. Lower layers are drawn first. `Size` must be last, and there
+/// must be no more than 256 layers.
+
+enum class eDrawLayer: uint8_t{
+  Background, Objects, Overlay,
+  Size //MUST BE LAST
+}; //eDrawLayer
+
+/// \brief A queued sprite instance.
+///
+/// The per-instance data of one sprite draw.
+
+struct SDrawInstance{
+  uint16_t m_nSprite = 0; ///< Sprite index.
+  uint16_t m_nFrame = 0; ///< Frame number.
+  eDrawLayer m_eLayer = eDrawLayer::Objects; ///< Layer.
+  float m_fX = 0.0f; ///< Position x.
+  float m_fY = 0.0f; ///< Position y.
+  float m_fRoll = 0.0f; ///< Orientation.
+  float m_fXScale = 1.0f; ///< Horizontal scale.
+  float m_fYScale = 1.0f; ///< Vertical scale.
+  float m_fTint[3] = {1.0f, 1.0f, 1.0f}; ///< Tint, RGB.
+  float m_fAlpha = 1.0f; ///< Alpha.
+  float m_fRadius = 0.0f; ///< Bounding radius, 0 if it doesn't need to keep its order.
+}; //SDrawInstance
+
+/// \brief The draw queue.
+///
+/// CDrawQueue sits between the game and the renderer. Sprites drawn during a
+/// frame are queued with a layer instead of going straight to the renderer,
+/// then `Flush()` sorts them by layer and sprite index and submits them, so
+/// that each sprite type in each layer goes to the renderer in as few
+/// unbroken runs of instances as it can, with no texture switches in
+/// between. The sort is stable, so sprites of the same type keep their
+/// order. Sprites queued with a bounding radius, such as game objects, also
+/// keep their submission order relative to the ones of other types that
+/// they overlap, so a bullet fired over an enemy is still drawn over it
+/// whatever their sprite indices. This is done by giving each of them a
+/// depth one more than that of the deepest earlier sprite of another type
+/// that it may overlap, found with a coarse grid of cells, and sorting by
+/// depth before sprite index. Sprites that overlap nothing batch as before.
+/// Lines are queued as the stretched sprite that draws them, so they batch
+/// like any other sprite. The queue counts the runs that the frame would
+/// have had in submission order and the runs after sorting.
+
+class CDrawQueue{
+  private:
+    /// \brief A cell of the depth grid.
+    ///
+    /// The deepest sprite queued so far that may overlap a cell.
+
+    struct SDepthCell{
+      uint64_t m_nKey = UINT64_MAX; ///< Layer and cell coordinates, `UINT64_MAX` if empty.
+      uint32_t m_nDepth = 0; ///< Depth of the deepest sprite in the cell.
+      uint32_t m_nSprite = UINT32_MAX; ///< Sprite index of the deepest sprite in the cell, `UINT32_MAX` if none.
+    }; //SDepthCell
+
+    std::vector<SDrawInstance> m_vecInstances; ///< Queued instances.
+    std::vector<uint64_t> m_vecKeys; ///< Sort keys with instance index in the low bits.
+    std::vector<SDepthCell> m_vecCells; ///< Hash table of depth grid cells.
+
+    size_t m_nUnsortedBatches = 0; ///< Runs of the same sprite in submission order.
+    size_t m_nBatches = 0; ///< Runs of the same sprite after sorting.
+    size_t m_nInstances = 0; ///< Instances flushed.
+    uint32_t m_nLastAdded = UINT32_MAX; ///< Sprite index last queued.
+    uint32_t m_nLastFlushed = UINT32_MAX; ///< Sprite index last flushed.
+
+    void Add(const SDrawInstance&); ///< Queue an instance.
+    SDepthCell& GetCell(eDrawLayer, int, int); ///< Find or add a depth grid cell.
+    void SetDepths(); ///< Put the depths of overlapping sprites into their keys.
+    void Sort(); ///< Sort the queue.
+
+  public:
+    void Clear(); ///< Empty the queue and reset the counts.
+
+    const size_t GetNumInstances() const; ///< Get number of instances flushed.
+    const size_t GetNumUnsortedBatches() const; ///< Get number of runs before sorting.
+    const size_t GetNumBatches() const; ///< Get number of runs after sorting.
+
+    /// Queue a sprite from a sprite descriptor such as `LSpriteDesc2D`.
+    /// \param d Pointer to sprite descriptor.
+    /// \param layer Layer.
+    /// \param r Bounding radius if it must stay in order with the sprites
+    /// of other types that it overlaps, 0 if not.
+
+    template<class D> void Add(const D* d, eDrawLayer layer, float r=0.0f){
+      SDrawInstance i;
+      i.m_nSprite = (uint16_t)d->m_nSpriteIndex;
+      i.m_nFrame = (uint16_t)d->m_nCurrentFrame;
+      i.m_eLayer = layer;
+      i.m_fX = d->m_vPos.x;
+      i.m_fY = d->m_vPos.y;
+      i.m_fRoll = d->m_fRoll;
+      i.m_fXScale = d->m_fXScale;
+      i.m_fYScale = d->m_fYScale;
+      i.m_fTint[0] = d->m_f4Tint.x;
+      i.m_fTint[1] = d->m_f4Tint.y;
+      i.m_fTint[2] = d->m_f4Tint.z;
+      i.m_fAlpha = d->m_fAlpha;
+      i.m_fRadius = r;
+      Add(i);
+    } //Add
+
+    /// Queue frame 0 of a sprite untinted.
+    /// \param t Sprite type.
+    /// \param p Position.
+    /// \param roll Orientation.
+    /// \param layer Layer.
+
+    template<class E, class V> void Add(E t, const V& p, float roll, eDrawLayer layer){
+      SDrawInstance i;
+      i.m_nSprite = (uint16_t)t;
+      i.m_eLayer = layer;
+      i.m_fX = p.x;
+      i.m_fY = p.y;
+      i.m_fRoll = roll;
+      Add(i);
+    } //Add
+
+    /// Queue a line as a sprite stretched horizontally between two points.
+    /// \param t Sprite type.
+    /// \param p0 Start of line.
+    /// \param p1 End of line.
+    /// \param w Width of the sprite.
+    /// \param layer Layer.
+
+    template<class E, class V> void AddLine(E t, const V& p0, const V& p1,
+      float w, eDrawLayer layer)
+    {
+      const float dx = p1.x - p0.x, dy = p1.y - p0.y;
+
+      SDrawInstance i;
+      i.m_nSprite = (uint16_t)t;
+      i.m_eLayer = layer;
+      i.m_fX = 0.5f*(p0.x + p1.x);
+      i.m_fY = 0.5f*(p0.y + p1.y);
+      i.m_fRoll = atan2f(dy, dx);
+      i.m_fXScale = w > 0.0f? sqrtf(dx*dx + dy*dy)/w: 0.0f;
+      Add(i);
+    } //AddLine
+
+    /// Queue the four lines of an axially aligned bounding box.
+    /// \param t Sprite type for the lines.
+    /// \param b Bounding box with `Center` and `Extents`.
+    /// \param w Width of the sprite.
+    /// \param layer Layer.
+
+    template<class E, class B> void AddBoundingBox(E t, const B& b, float w,
+      eDrawLayer layer)
+    {
+      struct{float x, y;} p[4] = {
+        {b.Center.x - b.Extents.x, b.Center.y - b.Extents.y},
+        {b.Center.x + b.Extents.x, b.Center.y - b.Extents.y},
+        {b.Center.x + b.Extents.x, b.Center.y + b.Extents.y},
+        {b.Center.x - b.Extents.x, b.Center.y + b.Extents.y},
+      }; //p
+
+      for(int k=0; k<4; k++)
+        AddLine(t, p[k], p[(k + 1)%4], w, layer);
+    } //AddBoundingBox
+
+    /// Sort the queue and submit it to a renderer, recording the draws if
+    /// there is a recorder. The queue is emptied, but the counts are kept
+    /// until `Clear()` so that a frame may be flushed more than once.
+    /// \tparam D Sprite descriptor type that the renderer draws.
+    /// \param pRenderer Pointer to renderer.
+    /// \param pRecorder Pointer to draw recorder, or `nullptr` for none.
+
+    template<class D, class R> void Flush(R* pRenderer, CDrawRecorder* pRecorder=nullptr){
+      Sort();
+
+      D d;
+
+      for(uint64_t key: m_vecKeys){
+        const SDrawInstance& i = m_vecInstances[(uint32_t)key];
+
+        d.m_nSpriteIndex = i.m_nSprite;
+        d.m_nCurrentFrame = i.m_nFrame;
+        d.m_vPos.x = i.m_fX;
+        d.m_vPos.y = i.m_fY;
+        d.m_fRoll = i.m_fRoll;
+        d.m_fXScale = i.m_fXScale;
+        d.m_fYScale = i.m_fYScale;
+        d.m_f4Tint.x = i.m_fTint[0];
+        d.m_f4Tint.y = i.m_fTint[1];
+        d.m_f4Tint.z = i.m_fTint[2];
+        d.m_fAlpha = i.m_fAlpha;
+
+        pRenderer->Draw(&d);
+        if(pRecorder)pRecorder->Record(&d);
+      } //for
+
+      m_nInstances += m_vecInstances.size();
+      m_vecInstances.clear();
+      m_vecKeys.clear();
+    } //Flush
+}; //CDrawQueue
+
+#endif //__L4RC_GAME_DRAWQUEUE_H__
@@ -0,0 +1,240 @@
+/// \file DrawRecorder.cpp
+/// \brief Code for the draw command recorder CDrawRecorder.
+
+#include "DrawRecorder.h"
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+static const char MAGIC[8] = {'D', 'R', 'A', 'W', 'R', 'E', 'C', '1'}; ///< File header.
+static const float POS_EPSILON = 0.01f; ///< Position tolerance for diffs.
+static const float ROLL_EPSILON = 0.0001f; ///< Orientation tolerance for diffs.
+
+/// Remove all frames.
+
+void CDrawRecorder::Clear(){
+  m_vecRecords.clear();
+  m_vecFrameStart.clear();
+  m_vecCamera.clear();
+  m_nNumSprites = 0;
+} //Clear
+
+/// Start a new frame. Draws recorded from now on belong to it.
+/// \param x Camera position x.
+/// \param y Camera position y.
+
+void CDrawRecorder::BeginFrame(float x, float y){
+  m_vecFrameStart.push_back(m_vecRecords.size());
+  m_vecCamera.push_back(x);
+  m_vecCamera.push_back(y);
+} //BeginFrame
+
+/// Add a record to the current frame, quantizing the tint and alpha to bytes.
+/// Records before the first frame is begun are ignored.
+/// \param t Sprite index.
+/// \param frame Frame number.
+/// \param x Position x.
+/// \param y Position y.
+/// \param roll Orientation.
+/// \param tint RGB tint, or `nullptr` for none.
+/// \param alpha Alpha.
+
+void CDrawRecorder::Add(unsigned t, unsigned frame, float x, float y,
+  float roll, const float* tint, float alpha)
+{
+  if(m_vecFrameStart.empty())return;
+
+  auto Byte = [](float f){return (uint8_t)(255.0f*std::min(1.0f, std::max(0.0f, f)) + 0.5f);};
+
+  SDrawRecord r;
+  r.m_nSprite = (uint16_t)t;
+  r.m_nFrame = (uint16_t)frame;
+  r.m_fX = x;
+  r.m_fY = y;
+  r.m_fRoll = roll;
+
+  if(tint)
+    for(int k=0; k<3; k++)
+      r.m_nTint[k] = Byte(tint[k]);
+
+  r.m_nAlpha = Byte(alpha);
+
+  m_vecRecords.push_back(r);
+  m_nNumSprites = std::max(m_nNumSprites, (size_t)t + 1);
+} //Add
+
+/// Reader function for the number of frames.
+/// \return Number of frames begun.
+
+const size_t CDrawRecorder::GetNumFrames() const{
+  return m_vecFrameStart.size();
+} //GetNumFrames
+
+/// Reader function for the number of sprite indices.
+/// \return One more than the largest sprite index recorded.
+
+const size_t CDrawRecorder::GetNumSprites() const{
+  return m_nNumSprites;
+} //GetNumSprites
+
+/// Get the number of records in a frame.
+/// \param f Frame number.
+/// \return Number of draws recorded in that frame.
+
+const size_t CDrawRecorder::GetNumRecords(size_t f) const{
+  const size_t end = f + 1 < m_vecFrameStart.size()? m_vecFrameStart[f + 1]: m_vecRecords.size();
+  return end - m_vecFrameStart[f];
+} //GetNumRecords
+
+/// Get the records in a frame.
+/// \param f Frame number.
+/// \return Pointer to the first of `GetNumRecords(f)` records.
+
+const SDrawRecord* CDrawRecorder::GetRecords(size_t f) const{
+  return m_vecRecords.data() + m_vecFrameStart[f];
+} //GetRecords
+
+/// Get the camera position of a frame.
+/// \param f Frame number.
+/// \param x [out] Camera position x.
+/// \param y [out] Camera position y.
+
+void CDrawRecorder::GetCamera(size_t f, float& x, float& y) const{
+  x = m_vecCamera[2*f];
+  y = m_vecCamera[2*f + 1];
+} //GetCamera
+
+/// Count the draws of each sprite in a frame.
+/// \param f Frame number.
+/// \param totals [out] Number of draws indexed by sprite.
+
+void CDrawRecorder::GetTotals(size_t f, std::vector<size_t>& totals) const{
+  totals.assign(m_nNumSprites, 0);
+
+  const SDrawRecord* r = GetRecords(f);
+  const size_t n = GetNumRecords(f);
+
+  for(size_t i=0; i<n; i++)
+    totals[r[i].m_nSprite]++;
+} //GetTotals
+
+/// Save the recording. The file is the header, the number of frames, then
+/// for each frame the camera position, the number of records, and the
+/// records, all in native byte order.
+/// \param filename Name of the file.
+/// \return true if the file was written.
+
+const bool CDrawRecorder::Save(const char* filename) const{
+  FILE* output = fopen(filename, "wb");
+  if(output == nullptr)return false;
+
+  const uint32_t frames = (uint32_t)GetNumFrames();
+  bool ok = fwrite(MAGIC, sizeof(MAGIC), 1, output) == 1 &&
+    fwrite(&frames, 4, 1, output) == 1;
+
+  for(size_t f=0; f<frames && ok; f++){
+    const uint32_t n = (uint32_t)GetNumRecords(f);
+
+    ok = fwrite(&m_vecCamera[2*f], 4, 2, output) == 2 &&
+      fwrite(&n, 4, 1, output) == 1 &&
+      fwrite(GetRecords(f), sizeof(SDrawRecord), n, output) == n;
+  } //for
+
+  fclose(output);
+  return ok;
+} //Save
+
+/// Load a recording saved by `Save()`, replacing any frames held.
+/// \param filename Name of the file.
+/// \return true if the file was read in full.
+
+const bool CDrawRecorder::Load(const char* filename){
+  Clear();
+
+  FILE* input = fopen(filename, "rb");
+  if(input == nullptr)return false;
+
+  char magic[sizeof(MAGIC)];
+  uint32_t frames = 0;
+
+  bool ok = fread(magic, sizeof(magic), 1, input) == 1 &&
+    memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+    fread(&frames, 4, 1, input) == 1;
+
+  for(uint32_t f=0; f<frames && ok; f++){
+    float camera[2] = {0.0f};
+    uint32_t n = 0;
+
+    ok = fread(camera, 4, 2, input) == 2 && fread(&n, 4, 1, input) == 1;
+
+    if(ok){
+      BeginFrame(camera[0], camera[1]);
+
+      const size_t start = m_vecRecords.size();
+      m_vecRecords.resize(start + n);
+      ok = fread(&m_vecRecords[start], sizeof(SDrawRecord), n, input) == n;
+
+      for(size_t i=start; i<start+n && ok; i++)
+        m_nNumSprites = std::max(m_nNumSprites, (size_t)m_vecRecords[i].m_nSprite + 1);
+    } //if
+  } //for
+
+  fclose(input);
+
+  if(!ok)Clear();
+  return ok;
+} //Load
+
+/// Compare two recordings frame by frame. Frames with different draw counts
+/// are counted apart from frames whose draws differ in sprite, frame, tint,
+/// alpha, or by more than a small tolerance in position or orientation. Only
+/// the frames that both recordings have are compared, and the change in
+/// draws by sprite covers only those frames, so that a longer recording
+/// doesn't look like a regression. The draw totals cover every frame.
+/// \param a First recording, usually from the older build.
+/// \param b Second recording.
+/// \param diff [out] The differences.
+
+void CDrawRecorder::Diff(const CDrawRecorder& a, const CDrawRecorder& b, SDrawDiff& diff){
+  diff = SDrawDiff();
+  diff.m_nFrames = std::min(a.GetNumFrames(), b.GetNumFrames());
+  diff.m_nDrawsA = a.m_vecRecords.size();
+  diff.m_nDrawsB = b.m_vecRecords.size();
+  diff.m_vecSpriteDelta.assign(std::max(a.m_nNumSprites, b.m_nNumSprites), 0);
+
+  for(size_t f=0; f<diff.m_nFrames; f++){
+    const size_t n = a.GetNumRecords(f);
+    bool changed = false;
+
+    for(size_t i=0; i<n; i++)
+      diff.m_vecSpriteDelta[a.GetRecords(f)[i].m_nSprite]--;
+
+    for(size_t i=0; i<b.GetNumRecords(f); i++)
+      diff.m_vecSpriteDelta[b.GetRecords(f)[i].m_nSprite]++;
+
+    if(n != b.GetNumRecords(f)){
+      diff.m_nCountChanged++;
+      changed = true;
+    } //if
+
+    else{
+      const SDrawRecord* ra = a.GetRecords(f);
+      const SDrawRecord* rb = b.GetRecords(f);
+
+      for(size_t i=0; i<n && !changed; i++)
+        changed = ra[i].m_nSprite != rb[i].m_nSprite ||
+          ra[i].m_nFrame != rb[i].m_nFrame ||
+          ra[i].m_nAlpha != rb[i].m_nAlpha ||
+          memcmp(ra[i].m_nTint, rb[i].m_nTint, 3) != 0 ||
+          fabsf(ra[i].m_fX - rb[i].m_fX) > POS_EPSILON ||
+          fabsf(ra[i].m_fY - rb[i].m_fY) > POS_EPSILON ||
+          fabsf(ra[i].m_fRoll - rb[i].m_fRoll) > ROLL_EPSILON;
+
+      if(changed)diff.m_nContentChanged++;
+    } //else
+
+    if(changed && diff.m_nFirstChanged == SIZE_MAX)
+      diff.m_nFirstChanged = f;
+  } //for
+} //Diff
@@ -0,0 +1,109 @@
+/// \file DrawRecorder.h
+/// \brief Interface for the draw command recorder CDrawRecorder.
+
+#ifndef __L4RC_GAME_DRAWRECORDER_H__
+#define __L4RC_GAME_DRAWRECORDER_H__
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+
+/// \brief A recorded draw command.
+///
+/// The sprite, frame, position, orientation, tint and alpha of one sprite
+/// draw, packed into 20 bytes. Lines are recorded at their midpoint with the
+/// orientation of the line.
+
+struct SDrawRecord{
+  uint16_t m_nSprite = 0; ///< Sprite index.
+  uint16_t m_nFrame = 0; ///< Frame number.
+  float m_fX = 0.0f; ///< Position x.
+  float m_fY = 0.0f; ///< Position y.
+  float m_fRoll = 0.0f; ///< Orientation.
+  uint8_t m_nTint[3] = {255, 255, 255}; ///< Tint, RGB.
+  uint8_t m_nAlpha = 255; ///< Alpha.
+}; //SDrawRecord
+
+/// \brief Differences between two draw recordings.
+
+struct SDrawDiff{
+  size_t m_nFrames = 0; ///< Number of frames compared.
+  size_t m_nCountChanged = 0; ///< Frames with a different number of draws.
+  size_t m_nContentChanged = 0; ///< Frames with the same number of draws that differ.
+  size_t m_nFirstChanged = SIZE_MAX; ///< First frame that differs.
+  size_t m_nDrawsA = 0; ///< Total draws in the first recording.
+  size_t m_nDrawsB = 0; ///< Total draws in the second recording.
+  std::vector<long long> m_vecSpriteDelta; ///< Change in draws by sprite over the frames compared.
+}; //SDrawDiff
+
+/// \brief The draw command recorder.
+///
+/// CDrawRecorder captures the draw list of each frame as compact records so
+/// that draws can be counted, saved, and diffed between builds. The calls
+/// mirror `LSpriteRenderer` and are templates that only read the members they
+/// need, as in `CSoftRenderer`. Records for all frames go into one array with
+/// a start index per frame, so recording a draw is a `push_back` once the
+/// array has grown to size.
+
+class CDrawRecorder{
+  private:
+    std::vector<SDrawRecord> m_vecRecords; ///< Records for all frames.
+    std::vector<size_t> m_vecFrameStart; ///< Index of first record of each frame.
+    std::vector<float> m_vecCamera; ///< Camera x and y for each frame.
+    size_t m_nNumSprites = 0; ///< One more than the largest sprite index.
+
+    void Add(unsigned, unsigned, float, float, float, const float*, float); ///< Add a record.
+
+  public:
+    void Clear(); ///< Remove all frames.
+    void BeginFrame(float, float); ///< Start a frame.
+
+    const size_t GetNumFrames() const; ///< Get number of frames.
+    const size_t GetNumSprites() const; ///< Get number of sprite indices.
+    const size_t GetNumRecords(size_t) const; ///< Get number of records in a frame.
+    const SDrawRecord* GetRecords(size_t) const; ///< Get records of a frame.
+    void GetCamera(size_t, float&, float&) const; ///< Get camera of a frame.
+    void GetTotals(size_t, std::vector<size_t>&) const; ///< Get draws by sprite for a frame.
+
+    const bool Save(const char*) const; ///< Save to a file.
+    const bool Load(const char*); ///< Load from a file.
+
+    static void Diff(const CDrawRecorder&, const CDrawRecorder&, SDrawDiff&); ///< Compare recordings.
+
+    /// Start a frame with the camera position.
+    /// \param p Camera position.
+
+    template<class V> void BeginFrame(const V& p){
+      BeginFrame(p.x, p.y);
+    } //BeginFrame
+
+    /// Record a draw from a sprite descriptor such as `LSpriteDesc2D`.
+    /// \param d Pointer to sprite descriptor.
+
+    template<class D> void Record(const D* d){
+      Add((unsigned)d->m_nSpriteIndex, (unsigned)d->m_nCurrentFrame,
+        d->m_vPos.x, d->m_vPos.y, d->m_fRoll, &d->m_f4Tint.x, d->m_fAlpha);
+    } //Record
+
+    /// Record a draw of frame 0 of a sprite untinted.
+    /// \param t Sprite type.
+    /// \param p Position.
+    /// \param roll Orientation.
+
+    template<class E, class V> void Record(E t, const V& p, float roll){
+      Add((unsigned)t, 0, p.x, p.y, roll, nullptr, 1.0f);
+    } //Record
+
+    /// Record a line as the sprite stretched between its end points.
+    /// \param t Sprite type.
+    /// \param p0 Start of line.
+    /// \param p1 End of line.
+
+    template<class E, class V> void RecordLine(E t, const V& p0, const V& p1){
+      Add((unsigned)t, 0, 0.5f*(p0.x + p1.x), 0.5f*(p0.y + p1.y),
+        atan2f(p1.y - p0.y, p1.x - p0.x), nullptr, 1.0f);
+    } //RecordLine
+
+}; //CDrawRecorder
+
+#endif //__L4RC_GAME_DRAWRECORDER_H__
@@ -0,0 +1,531 @@
+/// \file EnvBatch.cpp
+/// \brief Code for the batched headless environment CEnvBatch.
+
+#include "EnvBatch.h"
+
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+//player constants, copied from `CPlayer` so that the two stay comparable
+
+static const float FRAME_TIME = 1.0f/60.0f; ///< Fixed frame time.
+static const float JUMP_HEIGHT = -20.00f; ///< Player jump height.
+static const float PLAYER_GRAVITY = 1.50f; ///< Player gravity.
+static const float PLAYER_TOP_SPEED = 15.00f; ///< Player top speed.
+static const float PLAYER_ACCELERATION = 0.3f; ///< Player acceleration.
+static const float PLAYER_TURN_AROUND = 0.8f; ///< Player turn around acceleration.
+static const float PLAYER_FRICTION = 0.8f; ///< Player friction.
+static const float LAUNCHPAD_VELOCITY = -35.0f; ///< Launch pad velocity.
+
+static const float DOOR_RADIUS = 48.0f; ///< Bounding circle radius of the door sprite.
+static const float ITEM_RADIUS = 16.0f; ///< Bounding circle radius of spikes, pads and pickups.
+
+static const float REWARD_WIN = 1.0f; ///< Reward for reaching the door.
+static const float REWARD_DEATH = -1.0f; ///< Reward for dying.
+static const float REWARD_PICKUP = 0.1f; ///< Reward for a pickup.
+static const float REWARD_PROGRESS = 0.01f; ///< Reward per tile moved towards the door.
+
+static const size_t MIN_ENVS_PER_THREAD = 16; ///< Don't wake a thread for less than this.
+static const int SPIN_COUNT = 4096; ///< Spins before a worker goes to sleep.
+
+/// Load the map, allocate every buffer that will ever be needed, start the
+/// worker threads, and reset all environments.
+/// \param filename Name of a map file in the `LoadMap` glyph format.
+/// \param n Number of environments.
+/// \param threads Maximum number of threads including the caller, 0 for one
+/// per hardware thread.
+
+CEnvBatch::CEnvBatch(const char* filename, size_t n, size_t threads):
+  m_nNumEnvs(n)
+{
+  LoadMap(filename);
+
+  m_vecState.resize(n);
+  m_vecTaken.resize(n*m_vecPickups.size());
+  m_vecObs.resize(n*OBS_SIZE);
+  m_vecReward.resize(n);
+  m_vecDone.resize(n);
+
+  if(threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+
+  m_nThreads = std::min(threads, std::max<size_t>(1, n/MIN_ENVS_PER_THREAD));
+
+  for(size_t i=1; i<m_nThreads; i++) //the caller steps chunk 0 itself
+    m_vecWorkers.emplace_back(&CEnvBatch::WorkerLoop, this, i);
+
+  Reset();
+} //constructor
+
+/// Stop and join the worker threads.
+
+CEnvBatch::~CEnvBatch(){
+  {
+    std::lock_guard<std::mutex> lock(m_stdMutex);
+    m_bQuit = true;
+    m_nGeneration++;
+  }
+
+  m_stdWake.notify_all();
+
+  for(std::thread& t: m_vecWorkers)
+    t.join();
+} //destructor
+
+/// Read a map file in the same glyph format as `CTileManager::LoadMap`. Only
+/// the glyphs that matter to the player are remembered: walls, spikes, launch
+/// pads and the door stay in the map, the player start is recorded, and
+/// stars, health packs, one-ups and shotguns become pickups.
+/// \param filename Name of the map file.
+
+void CEnvBatch::LoadMap(const char* filename){
+  FILE* input = fopen(filename, "rb");
+  if(input == nullptr)
+    throw std::runtime_error(std::string("Map ") + filename + " not found.");
+
+  std::string text;
+  char buffer[4096];
+  size_t k = 0;
+
+  while((k = fread(buffer, 1, sizeof(buffer), input)) > 0)
+    text.append(buffer, k);
+
+  fclose(input);
+
+  //split into rows, ignoring carriage returns and a missing final linefeed
+
+  std::vector<std::string> rows;
+  std::string row;
+
+  for(char c: text){
+    if(c == '\n'){
+      rows.push_back(row);
+      row.clear();
+    } //if
+    else if(c != '\r')row += c;
+  } //for
+
+  if(!row.empty())rows.push_back(row);
+
+  m_nHeight = rows.size();
+  m_nWidth = m_nHeight > 0? rows[0].size(): 0;
+
+  if(m_nWidth == 0)
+    throw std::runtime_error(std::string("Map ") + filename + " is empty.");
+
+  m_vecMap.assign(m_nWidth*m_nHeight, 'F');
+
+  for(size_t i=0; i<m_nHeight; i++){
+    if(rows[i].size() != m_nWidth)
+      throw std::runtime_error("Line " + std::to_string(i) +
+        " of map is not the same length as the previous one.");
+
+    for(size_t j=0; j<m_nWidth; j++){
+      const char c = rows[i][j];
+      const float x = m_fTileSize*(j + 0.5f);
+      const float y = m_fTileSize*(m_nHeight - i - 0.5f);
+
+      switch(c){
+        case 'W': case 'S': case 'L':
+          m_vecMap[i*m_nWidth + j] = c;
+        break;
+
+        case 'D':
+          m_vecMap[i*m_nWidth + j] = c;
+          m_fDoorX = x; m_fDoorY = y;
+        break;
+
+        case 'P':
+          m_fStartX = x; m_fStartY = y;
+        break;
+
+        case 'I': case 'H': case 'O': case 'G':
+          m_vecMap[i*m_nWidth + j] = 'I';
+          m_vecPickups.push_back((uint32_t)(i*m_nWidth + j));
+        break;
+      } //switch
+    } //for
+  } //for
+} //LoadMap
+
+/// Get the glyph at a map position. Anything off the left, right or top edge
+/// of the map counts as a wall so that the player can't leave through them.
+/// \param i Row, with 0 at the top.
+/// \param j Column, with 0 at the left.
+/// \return The glyph at that position.
+
+const char CEnvBatch::Tile(int i, int j) const{
+  if(j < 0 || j >= (int)m_nWidth || i < 0)return 'W';
+  if(i >= (int)m_nHeight)return 'F';
+  return m_vecMap[i*m_nWidth + j];
+} //Tile
+
+/// Reset every environment to the start of the level.
+
+void CEnvBatch::Reset(){
+  for(size_t e=0; e<m_nNumEnvs; e++){
+    ResetEnv(e);
+    m_vecReward[e] = 0.0f;
+    m_vecDone[e] = 0;
+    Observe(e);
+  } //for
+} //Reset
+
+/// Put the player of one environment back at the start and restore all of
+/// its pickups.
+/// \param e Environment index.
+
+void CEnvBatch::ResetEnv(size_t e){
+  SEnvState& s = m_vecState[e];
+  s = SEnvState();
+  s.m_fX = m_fStartX;
+  s.m_fY = m_fStartY;
+  s.m_fDoorDist = hypotf(m_fDoorX - s.m_fX, m_fDoorY - s.m_fY);
+
+  const size_t n = m_vecPickups.size();
+  std::fill(m_vecTaken.begin() + e*n, m_vecTaken.begin() + (e + 1)*n, 0);
+} //ResetEnv
+
+/// Step all environments. The rewards, done flags and observations are
+/// written in place. An environment that is done is reset immediately, so
+/// its observation is the first one of the next episode.
+/// \param actions Array of one `eEnvAction` per environment.
+
+void CEnvBatch::Step(const uint8_t* actions){
+  m_pActions = actions;
+
+  if(m_nThreads == 1){ //single threaded
+    StepRange(0, m_nNumEnvs);
+    return;
+  } //if
+
+  m_nBusy = m_nThreads - 1;
+
+  {
+    std::lock_guard<std::mutex> lock(m_stdMutex);
+    m_nGeneration++;
+  }
+
+  m_stdWake.notify_all();
+  StepRange(0, m_nNumEnvs/m_nThreads); //chunk 0 is ours
+
+  for(int i=0; i<SPIN_COUNT && m_nBusy > 0; i++)
+    std::this_thread::yield();
+
+  if(m_nBusy > 0){
+    std::unique_lock<std::mutex> lock(m_stdMutex);
+    m_stdFinished.wait(lock, [&](){return m_nBusy == 0;});
+  } //if
+} //Step
+
+/// Worker thread body. Wait for the step counter to change, step this
+/// worker's chunk, and report back. A worker spins for a while before
+/// sleeping so that back-to-back steps don't pay for a wake-up.
+/// \param k Chunk number.
+
+void CEnvBatch::WorkerLoop(size_t k){
+  uint32_t seen = 0;
+
+  while(true){
+    for(int i=0; i<SPIN_COUNT && m_nGeneration == seen; i++)
+      std::this_thread::yield();
+
+    if(m_nGeneration == seen){
+      std::unique_lock<std::mutex> lock(m_stdMutex);
+      m_stdWake.wait(lock, [&](){return m_nGeneration != seen;});
+    } //if
+
+    seen = m_nGeneration;
+    if(m_bQuit)return;
+
+    StepRange(k*m_nNumEnvs/m_nThreads, (k + 1)*m_nNumEnvs/m_nThreads);
+
+    if(--m_nBusy == 0){
+      std::lock_guard<std::mutex> lock(m_stdMutex);
+      m_stdFinished.notify_one();
+    } //if
+  } //while
+} //WorkerLoop
+
+/// Step a contiguous range of environments.
+/// \param first Index of the first environment.
+/// \param last One past the index of the last environment.
+
+void CEnvBatch::StepRange(size_t first, size_t last){
+  for(size_t e=first; e<last; e++){
+    StepEnv(e, m_pActions[e]);
+    Observe(e);
+  } //for
+} //StepRange
+
+/// Step one environment by one frame. The order of operations is the same as
+/// in the game: `CPlayer::move` moves the player and updates its velocity,
+/// then the object manager resolves wall collisions, then overlaps with the
+/// other map objects are dealt with.
+/// \param e Environment index.
+/// \param a Action.
+
+void CEnvBatch::StepEnv(size_t e, uint8_t a){
+  SEnvState& s = m_vecState[e];
+  const eEnvAction action = (eEnvAction)a;
+
+  const bool bLeft  = action == eEnvAction::Left  || action == eEnvAction::JumpLeft;
+  const bool bRight = action == eEnvAction::Right || action == eEnvAction::JumpRight;
+  const bool bJump  = action == eEnvAction::Jump  ||
+    action == eEnvAction::JumpLeft || action == eEnvAction::JumpRight;
+
+  const float delta = 40.0f*FRAME_TIME; //as in CPlayer::move
+
+  s.m_fX += delta*s.m_fVelX;
+  s.m_fY -= delta*s.m_fVelY;
+
+  if(bRight){
+    if(s.m_fVelX <= 0)s.m_fVelX += PLAYER_TURN_AROUND;
+    else if(s.m_fVelX < PLAYER_TOP_SPEED)s.m_fVelX += PLAYER_ACCELERATION;
+  } //if
+
+  else if(bLeft){
+    if(s.m_fVelX >= 0)s.m_fVelX -= PLAYER_TURN_AROUND;
+    else if(s.m_fVelX > -PLAYER_TOP_SPEED)s.m_fVelX -= PLAYER_ACCELERATION;
+  } //else if
+
+  if(s.m_bCanJump && bJump)
+    s.m_fVelY = JUMP_HEIGHT;
+
+  s.m_fVelY += PLAYER_GRAVITY*delta;
+
+  if(!bLeft && !bRight){ //friction
+    if(fabsf(s.m_fVelX) < PLAYER_FRICTION)s.m_fVelX = 0.0f;
+    else s.m_fVelX -= s.m_fVelX > 0? PLAYER_FRICTION: -PLAYER_FRICTION;
+  } //if
+
+  s.m_bCanJump = false;
+
+  for(int i=0; i<2; i++) //can collide with 2 edges simultaneously
+    Collide(s);
+
+  s.m_nSteps++;
+
+  bool bDone = false;
+  float reward = Touch(e, bDone);
+
+  const float d = hypotf(m_fDoorX - s.m_fX, m_fDoorY - s.m_fY);
+  reward += REWARD_PROGRESS*(s.m_fDoorDist - d)/m_fTileSize;
+  s.m_fDoorDist = d;
+
+  if(s.m_fY < -m_fTileSize){ //fell out of the world
+    reward += REWARD_DEATH;
+    bDone = true;
+  } //if
+
+  bDone = bDone || s.m_nSteps >= m_nMaxSteps;
+
+  m_vecReward[e] = reward;
+  m_vecDone[e] = bDone? 1: 0;
+
+  if(bDone)ResetEnv(e);
+} //StepEnv
+
+/// Push the player out of the wall tile that it overlaps the most, if any,
+/// and zero the velocity component into the wall the same way that
+/// `CPlayer::CollisionResponse` does. The push is along the axis of least
+/// overlap unless that would push the player into a neighboring wall tile,
+/// which stops the player from snagging on the seams between tiles.
+/// \param s [in, out] Player state.
+
+void CEnvBatch::Collide(SEnvState& s) const{
+  const float t = m_fTileSize;
+  const float r = m_fRadius;
+
+  const int left   = (int)floorf((s.m_fX - r)/t);
+  const int right  = (int)floorf((s.m_fX + r)/t);
+  const int top    = (int)m_nHeight - 1 - (int)floorf((s.m_fY + r)/t);
+  const int bottom = (int)m_nHeight - 1 - (int)floorf((s.m_fY - r)/t);
+
+  float best = 0.0f; //largest overlap area
+  float nx = 0.0f, ny = 0.0f, depth = 0.0f; //push direction and distance
+
+  for(int i=top; i<=bottom; i++)
+    for(int j=left; j<=right; j++){
+      if(Tile(i, j) != 'W')continue;
+
+      const float x0 = j*t, x1 = x0 + t; //left and right of tile
+      const float y0 = (m_nHeight - 1 - i)*t, y1 = y0 + t; //bottom and top of tile
+
+      const float ox = std::min(s.m_fX + r, x1) - std::max(s.m_fX - r, x0);
+      const float oy = std::min(s.m_fY + r, y1) - std::max(s.m_fY - r, y0);
+      if(ox <= 0.0f || oy <= 0.0f || ox*oy <= best)continue;
+
+      const int dj = s.m_fX < x0 + t/2? -1: 1; //side of tile the player is on
+      const int di = s.m_fY < y0 + t/2? 1: -1;
+
+      const bool bBlockedX = Tile(i, j + dj) == 'W';
+      const bool bBlockedY = Tile(i + di, j) == 'W';
+
+      best = ox*oy;
+
+      if((ox < oy && !bBlockedX) || bBlockedY){
+        nx = (float)dj; ny = 0.0f; depth = ox;
+      } //if
+      else{
+        nx = 0.0f; ny = di > 0? -1.0f: 1.0f; depth = oy;
+      } //else
+    } //for
+
+  if(best <= 0.0f)return; //no collision
+
+  s.m_fX += nx*depth;
+  s.m_fY += ny*depth;
+
+  if(nx != 0.0f)s.m_fVelX = 0.0f;
+  else{
+    s.m_fVelY = 0.0f;
+    s.m_bCanJump = ny > 0.0f; //standing on a floor
+  } //else
+} //Collide
+
+/// Deal with the spikes, launch pads, pickups and door that the player's
+/// bounding circle overlaps.
+/// \param e Environment index.
+/// \param bDone [out] Set to true if the episode ends.
+/// \return Reward earned.
+
+const float CEnvBatch::Touch(size_t e, bool& bDone){
+  SEnvState& s = m_vecState[e];
+  const float t = m_fTileSize;
+  const float reach = m_fRadius + DOOR_RADIUS; //furthest an overlap can be
+  float reward = 0.0f;
+
+  const int left   = (int)floorf((s.m_fX - reach)/t);
+  const int right  = (int)floorf((s.m_fX + reach)/t);
+  const int top    = (int)m_nHeight - 1 - (int)floorf((s.m_fY + reach)/t);
+  const int bottom = (int)m_nHeight - 1 - (int)floorf((s.m_fY - reach)/t);
+
+  for(int i=std::max(top, 0); i<=std::min(bottom, (int)m_nHeight - 1); i++)
+    for(int j=std::max(left, 0); j<=std::min(right, (int)m_nWidth - 1); j++){
+      const char c = m_vecMap[i*m_nWidth + j];
+      if(c == 'F' || c == 'W')continue;
+
+      const float dx = (j + 0.5f)*t - s.m_fX;
+      const float dy = (m_nHeight - i - 0.5f)*t - s.m_fY;
+      const float r = m_fRadius + (c == 'D'? DOOR_RADIUS: ITEM_RADIUS);
+      if(dx*dx + dy*dy >= r*r)continue;
+
+      switch(c){
+        case 'S': //spike
+          bDone = true;
+          reward += REWARD_DEATH;
+        break;
+
+        case 'L': //launch pad
+          s.m_fVelY = LAUNCHPAD_VELOCITY;
+        break;
+
+        case 'D': //door
+          bDone = true;
+          reward += REWARD_WIN;
+        break;
+
+        case 'I':{ //pickup
+          const uint32_t cell = (uint32_t)(i*m_nWidth + j);
+          const size_t k = std::lower_bound(m_vecPickups.begin(),
+            m_vecPickups.end(), cell) - m_vecPickups.begin();
+          uint8_t& taken = m_vecTaken[e*m_vecPickups.size() + k];
+
+          if(!taken){
+            taken = 1;
+            reward += REWARD_PICKUP;
+          } //if
+        } //case
+        break;
+      } //switch
+    } //for
+
+  return reward;
+} //Touch
+
+/// Write the observation for one environment. The first 7 floats are the
+/// player position as a fraction of the world size, its velocity as a
+/// fraction of the largest velocity, whether it can jump, and the offset to
+/// the door as a fraction of the world size. These are followed by a square
+/// window of tiles centered on the player, row by row from the top, with
+/// walls as 1, spikes as -1, launch pads as 0.5, the door as 0.75, and
+/// everything else as 0.
+/// \param e Environment index.
+
+void CEnvBatch::Observe(size_t e){
+  const SEnvState& s = m_vecState[e];
+  float* p = &m_vecObs[e*OBS_SIZE];
+
+  const float w = m_nWidth*m_fTileSize;
+  const float h = m_nHeight*m_fTileSize;
+
+  *p++ = s.m_fX/w;
+  *p++ = s.m_fY/h;
+  *p++ = s.m_fVelX/PLAYER_TOP_SPEED;
+  *p++ = s.m_fVelY/-LAUNCHPAD_VELOCITY;
+  *p++ = s.m_bCanJump? 1.0f: 0.0f;
+  *p++ = (m_fDoorX - s.m_fX)/w;
+  *p++ = (m_fDoorY - s.m_fY)/h;
+
+  const int ci = (int)m_nHeight - 1 - (int)floorf(s.m_fY/m_fTileSize);
+  const int cj = (int)floorf(s.m_fX/m_fTileSize);
+
+  for(int i=ci - (int)OBS_RADIUS; i<=ci + (int)OBS_RADIUS; i++)
+    for(int j=cj - (int)OBS_RADIUS; j<=cj + (int)OBS_RADIUS; j++){
+      switch(Tile(i, j)){
+        case 'W': *p++ =  1.0f;  break;
+        case 'S': *p++ = -1.0f;  break;
+        case 'L': *p++ =  0.5f;  break;
+        case 'D': *p++ =  0.75f; break;
+        default:  *p++ =  0.0f;  break;
+      } //switch
+    } //for
+} //Observe
+
+/// Reader function for the number of environments.
+/// \return Number of environments.
+
+const size_t CEnvBatch::GetNumEnvs() const{
+  return m_nNumEnvs;
+} //GetNumEnvs
+
+/// Reader function for the observation buffer, which holds `OBS_SIZE` floats
+/// per environment.
+/// \return Pointer to the first observation.
+
+const float* CEnvBatch::GetObservations() const{
+  return m_vecObs.data();
+} //GetObservations
+
+/// Reader function for the reward buffer.
+/// \return Pointer to the reward for the first environment.
+
+const float* CEnvBatch::GetRewards() const{
+  return m_vecReward.data();
+} //GetRewards
+
+/// Reader function for the done flag buffer.
+/// \return Pointer to the done flag for the first environment.
+
+const uint8_t* CEnvBatch::GetDones() const{
+  return m_vecDone.data();
+} //GetDones
+
+/// Reader function for the state of one environment.
+/// \param e Environment index.
+/// \return State of that environment.
+
+const SEnvState& CEnvBatch::GetState(size_t e) const{
+  return m_vecState[e];
+} //GetState
+
+/// Set the number of steps after which an episode is cut off.
+/// \param n Step limit.
+
+void CEnvBatch::SetMaxSteps(uint32_t n){
+  m_nMaxSteps = n;
+} //SetMaxSteps
@@ -0,0 +1,115 @@
+/// \file EnvBatch.h
+/// \brief Interface for the batched headless environment CEnvBatch.
+
+#ifndef __L4RC_GAME_ENVBATCH_H__
+#define __L4RC_GAME_ENVBATCH_H__
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+
+/// \brief Environment action.
+///
+/// An enumerated type for the discrete actions that an agent can take in one
+/// step, which will be cast to `uint8_t` for the action array. `Size` must
+/// be last.
+
+enum class eEnvAction: uint8_t{
+  Idle, Left, Right, Jump, JumpLeft, JumpRight,
+  Size //MUST BE LAST
+}; //eEnvAction
+
+/// \brief Headless state of one game instance.
+///
+/// Everything that changes from step to step in one environment. The map
+/// itself is shared by all environments and never changes.
+
+struct SEnvState{
+  float m_fX = 0.0f; ///< Player position x.
+  float m_fY = 0.0f; ///< Player position y.
+  float m_fVelX = 0.0f; ///< Player velocity x, in the units used by `CPlayer`.
+  float m_fVelY = 0.0f; ///< Player velocity y, in the units used by `CPlayer`.
+  bool m_bCanJump = false; ///< Standing on a floor.
+  uint32_t m_nSteps = 0; ///< Steps since the last reset.
+  float m_fDoorDist = 0.0f; ///< Distance to the door at the last step.
+}; //SEnvState
+
+/// \brief A batch of headless game instances.
+///
+/// CEnvBatch runs N copies of a level without a window, a renderer, or any of
+/// the `CCommon` singletons, so that automated agents can play many games at
+/// once. The player physics mirrors `CPlayer::move` and its wall response at
+/// a fixed frame time, spikes kill, launch pads launch, pickups give a small
+/// reward, and reaching the door wins. Enemies are not simulated. All output
+/// buffers are allocated once in the constructor and `Step()` writes into
+/// them in place, so stepping never allocates. Environments are split into
+/// contiguous chunks that are stepped in parallel by a pool of worker threads
+/// that lives as long as the batch.
+
+class CEnvBatch{
+  public:
+    static const size_t OBS_RADIUS = 4; ///< Tile window radius in observations.
+    static const size_t OBS_WINDOW = 2*OBS_RADIUS + 1; ///< Tile window width.
+    static const size_t OBS_SIZE = 7 + OBS_WINDOW*OBS_WINDOW; ///< Floats per observation.
+
+  private:
+    size_t m_nWidth = 0; ///< Number of tiles wide.
+    size_t m_nHeight = 0; ///< Number of tiles high.
+    float m_fTileSize = 32.0f; ///< Tile width and height.
+    float m_fRadius = 16.0f; ///< Player bounding circle radius.
+    uint32_t m_nMaxSteps = 3600; ///< Step limit before an episode is cut off.
+
+    std::vector<char> m_vecMap; ///< Map glyphs, row-major, top row first.
+    float m_fStartX = 0.0f; ///< Player start position x.
+    float m_fStartY = 0.0f; ///< Player start position y.
+    float m_fDoorX = 0.0f; ///< Door position x.
+    float m_fDoorY = 0.0f; ///< Door position y.
+    std::vector<uint32_t> m_vecPickups; ///< Cell index of each pickup, sorted.
+
+    size_t m_nNumEnvs = 0; ///< Number of environments.
+    std::vector<SEnvState> m_vecState; ///< State of each environment.
+    std::vector<uint8_t> m_vecTaken; ///< Pickup taken flags, one row per environment.
+    std::vector<float> m_vecObs; ///< Observations, `OBS_SIZE` floats per environment.
+    std::vector<float> m_vecReward; ///< Reward for the last step.
+    std::vector<uint8_t> m_vecDone; ///< Episode ended on the last step.
+
+    size_t m_nThreads = 1; ///< Number of threads stepping, including the caller.
+    std::vector<std::thread> m_vecWorkers; ///< Worker threads.
+    std::mutex m_stdMutex; ///< Guards the worker wake-up.
+    std::condition_variable m_stdWake; ///< Wakes the workers.
+    std::condition_variable m_stdFinished; ///< Wakes the stepping thread.
+    std::atomic<uint32_t> m_nGeneration{0}; ///< Incremented once per step.
+    std::atomic<size_t> m_nBusy{0}; ///< Workers still stepping.
+    const uint8_t* m_pActions = nullptr; ///< Actions for the current step.
+    bool m_bQuit = false; ///< Tell the workers to exit.
+
+    void LoadMap(const char*); ///< Load the map.
+    const char Tile(int, int) const; ///< Glyph at a row and column.
+    void ResetEnv(size_t); ///< Reset one environment.
+    void StepEnv(size_t, uint8_t); ///< Step one environment.
+    const float Touch(size_t, bool&); ///< Respond to map glyphs under the player.
+    void Collide(SEnvState&) const; ///< Resolve wall overlap.
+    void Observe(size_t); ///< Write one observation.
+    void StepRange(size_t, size_t); ///< Step a contiguous range of environments.
+    void WorkerLoop(size_t); ///< Worker thread body.
+
+  public:
+    CEnvBatch(const char*, size_t, size_t=0); ///< Constructor.
+    ~CEnvBatch(); ///< Destructor.
+
+    void Reset(); ///< Reset all environments.
+    void Step(const uint8_t*); ///< Step all environments.
+
+    const size_t GetNumEnvs() const; ///< Get number of environments.
+    const float* GetObservations() const; ///< Get observation buffer.
+    const float* GetRewards() const; ///< Get reward buffer.
+    const uint8_t* GetDones() const; ///< Get done flag buffer.
+    const SEnvState& GetState(size_t) const; ///< Get state of one environment.
+
+    void SetMaxSteps(uint32_t); ///< Set episode step limit.
+}; //CEnvBatch
+
+#endif //__L4RC_GAME_ENVBATCH_H__
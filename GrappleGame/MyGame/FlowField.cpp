@@ -0,0 +1,141 @@
+/// \file FlowField.cpp
+/// \brief Code for the flow field CFlowField.
+
+#include "FlowField.h"
+
+#include <algorithm>
+
+static const int DCOL[8] = {1, 0, -1, 0, 1, -1, -1, 1}; ///< Column offset of each direction.
+static const int DROW[8] = {0, -1, 0, 1, -1, -1, 1, 1}; ///< Row offset of each direction, down is positive.
+static const uint8_t BACK[8] = {2, 3, 0, 1, 6, 7, 4, 5}; ///< Opposite of each direction.
+static const uint8_t NONE = 8; ///< No direction.
+
+static const float DIAG = 0.70710678f; ///< Component of a unit diagonal.
+static const float DX[8] = {1, 0, -1, 0, DIAG, -DIAG, -DIAG, DIAG}; ///< World x of each direction.
+static const float DY[8] = {0, 1, 0, -1, DIAG, DIAG, -DIAG, -DIAG}; ///< World y of each direction.
+
+/// Use a new map and forget the target. Any tile that isn't a wall `W` is
+/// open.
+/// \param map The map, an array of rows top row first.
+/// \param w Number of tiles wide.
+/// \param h Number of tiles high.
+/// \param t Tile width and height.
+
+void CFlowField::SetMap(const char* const* map, size_t w, size_t h, float t){
+  m_nWidth = w;
+  m_nHeight = h;
+  m_fTileSize = t;
+
+  m_vecOpen.resize(w*h);
+
+  for(size_t i=0; i<h; i++)
+    for(size_t j=0; j<w; j++)
+      m_vecOpen[i*w + j] = map[i][j] != 'W';
+
+  m_vecDist.assign(w*h, UINT32_MAX);
+  m_vecDir.assign(w*h, NONE);
+  m_vecQueue.resize(w*h);
+  m_nTarget = SIZE_MAX;
+} //SetMap
+
+/// Get the index of the tile at a position. World y is up and the map's
+/// rows go down, so the row is flipped.
+/// \param x Position x.
+/// \param y Position y.
+/// \return Index of the tile, `SIZE_MAX` if it is off the map.
+
+const size_t CFlowField::GetTile(float x, float y) const{
+  if(x < 0.0f || y < 0.0f)return SIZE_MAX;
+
+  const size_t j = (size_t)(x/m_fTileSize); //column
+  const size_t k = (size_t)(y/m_fTileSize); //row counting up
+  if(j >= m_nWidth || k >= m_nHeight)return SIZE_MAX;
+
+  return (m_nHeight - 1 - k)*m_nWidth + j;
+} //GetTile
+
+/// Breadth-first search out from a tile. Each tile reached gets the direction
+/// back to the tile it was reached from. The straight neighbors come before
+/// the diagonal ones, so where both are equally short the path is straight.
+/// \param start Index of the tile to search from.
+
+void CFlowField::Search(size_t start){
+  std::fill(m_vecDist.begin(), m_vecDist.end(), UINT32_MAX);
+  std::fill(m_vecDir.begin(), m_vecDir.end(), NONE);
+
+  size_t head = 0, tail = 0; //queue front and back
+  m_vecDist[start] = 0;
+  m_vecQueue[tail++] = (uint32_t)start;
+
+  while(head < tail){
+    const size_t n = m_vecQueue[head++]; //tile to expand
+    const int i = (int)(n/m_nWidth), j = (int)(n%m_nWidth); //its row and column
+    const uint32_t d = m_vecDist[n] + 1; //distance of its neighbors
+
+    for(uint8_t k=0; k<8; k++){
+      const int ni = i + DROW[k], nj = j + DCOL[k]; //neighbor row and column
+      if(ni < 0 || nj < 0 || ni >= (int)m_nHeight || nj >= (int)m_nWidth)continue;
+
+      const size_t m = ni*m_nWidth + nj; //neighbor index
+      if(!m_vecOpen[m] || m_vecDist[m] != UINT32_MAX)continue;
+
+      if(k >= 4 && (!m_vecOpen[i*m_nWidth + nj] || !m_vecOpen[ni*m_nWidth + j]))
+        continue; //diagonal would cut a corner
+
+      m_vecDist[m] = d;
+      m_vecDir[m] = BACK[k];
+      m_vecQueue[tail++] = (uint32_t)m;
+    } //for
+  } //while
+
+  m_nSearches++;
+} //Search
+
+/// Move the target, searching again if it is in a different tile from last
+/// time. A target off the map leaves the field as it was.
+/// \param x Target position x.
+/// \param y Target position y.
+/// \return true if there was a search.
+
+const bool CFlowField::Update(float x, float y){
+  const size_t n = GetTile(x, y); //target tile
+  if(n == SIZE_MAX || n == m_nTarget)return false;
+
+  m_nTarget = n;
+  Search(n);
+  return true;
+} //Update
+
+/// Get the direction of the next step toward the target from a position.
+/// \param x Position x.
+/// \param y Position y.
+/// \param dx [out] Unit direction x.
+/// \param dy [out] Unit direction y.
+/// \return true if there is a step to take, false if the position is in
+/// the target's tile, can't reach it, or is off the map.
+
+const bool CFlowField::GetDirection(float x, float y, float& dx, float& dy) const{
+  const size_t n = GetTile(x, y); //tile
+  if(n == SIZE_MAX || m_vecDir.empty() || m_vecDir[n] == NONE)return false;
+
+  dx = DX[m_vecDir[n]];
+  dy = DY[m_vecDir[n]];
+  return true;
+} //GetDirection
+
+/// Get the number of steps from a position to the target.
+/// \param x Position x.
+/// \param y Position y.
+/// \return Number of steps, `UINT32_MAX` if the target can't be reached.
+
+const uint32_t CFlowField::GetDistance(float x, float y) const{
+  const size_t n = GetTile(x, y); //tile
+  return n == SIZE_MAX || m_vecDist.empty()? UINT32_MAX: m_vecDist[n];
+} //GetDistance
+
+/// Reader function for the number of searches made.
+/// \return Number of searches made since the program started.
+
+const size_t CFlowField::GetNumSearches() const{
+  return m_nSearches;
+} //GetNumSearches
@@ -0,0 +1,49 @@
+/// \file FlowField.h
+/// \brief Interface for the flow field CFlowField.
+
+#ifndef __L4RC_GAME_FLOWFIELD_H__
+#define __L4RC_GAME_FLOWFIELD_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/// \brief The flow field.
+///
+/// CFlowField routes chasers around walls to a target. A breadth-first
+/// search out from the target's tile over the 8-neighbors of each open tile
+/// gives every reachable tile its distance in steps and the direction of the
+/// next step back toward the target. Diagonal steps must not cut the corner
+/// of a wall. The search is made again only when the target moves to a
+/// different tile, so the cost of a frame is one search at most however many
+/// chasers there are, and each chaser's direction is an array lookup.
+/// Positions are in world space with tile (0, 0) at the top left of the
+/// map, which is how `m_chMap` is laid out.
+
+class CFlowField{
+  private:
+    size_t m_nWidth = 0; ///< Number of tiles wide.
+    size_t m_nHeight = 0; ///< Number of tiles high.
+    float m_fTileSize = 1.0f; ///< Tile width and height.
+
+    std::vector<uint8_t> m_vecOpen; ///< 1 if a tile is not a wall.
+    std::vector<uint32_t> m_vecDist; ///< Steps to the target, `UINT32_MAX` if unreachable.
+    std::vector<uint8_t> m_vecDir; ///< Direction of the next step, 8 for none.
+    std::vector<uint32_t> m_vecQueue; ///< Search queue.
+
+    size_t m_nTarget = SIZE_MAX; ///< Target tile, `SIZE_MAX` for none.
+    size_t m_nSearches = 0; ///< Number of searches made.
+
+    const size_t GetTile(float, float) const; ///< Get tile at position.
+    void Search(size_t); ///< Breadth-first search from a tile.
+
+  public:
+    void SetMap(const char* const*, size_t, size_t, float); ///< Use a new map.
+    const bool Update(float, float); ///< Move the target.
+
+    const bool GetDirection(float, float, float&, float&) const; ///< Get direction of next step.
+    const uint32_t GetDistance(float, float) const; ///< Get distance to target in steps.
+    const size_t GetNumSearches() const; ///< Get number of searches made.
+}; //CFlowField
+
+#endif //__L4RC_GAME_FLOWFIELD_H__
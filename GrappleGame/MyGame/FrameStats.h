@@ -0,0 +1,55 @@
+/// \file FrameStats.h
+/// \brief Interface for the frame statistics SFrameStats.
+
+#ifndef __L4RC_GAME_FRAMESTATS_H__
+#define __L4RC_GAME_FRAMESTATS_H__
+
+#include <cstddef>
+
+/// \brief Frame statistics.
+///
+/// Counts gathered while moving and drawing a frame, shown by the stats
+/// overlay that F2 turns on. The counts are reset at the end of each
+/// rendered frame, so counts made while moving objects are shown in the
+/// frame that follows. The level transition time is kept until the next
+/// transition.
+
+struct SFrameStats{
+  size_t m_nObjectsDrawn = 0; ///< Objects drawn.
+  size_t m_nObjectsCulled = 0; ///< Objects not drawn because they are off screen.
+  size_t m_nParticlesCulled = 0; ///< Particles not created because they would be off screen.
+  size_t m_nSprites = 0; ///< Sprites sent to the renderer by the draw queue.
+  size_t m_nUnsortedBatches = 0; ///< Sprite switches plus one, had the sprites not been sorted.
+  size_t m_nBatches = 0; ///< Sprite switches plus one after sorting.
+  size_t m_nAiUpdates = 0; ///< Objects that thought.
+  size_t m_nAiDeferred = 0; ///< Objects that were due to think but were deferred.
+  float m_fAiTime = 0.0f; ///< Microseconds spent thinking.
+  float m_fAiBudget = 0.0f; ///< Microseconds per frame allowed for thinking.
+  size_t m_nAwake = 0; ///< Objects awake.
+  size_t m_nSlow = 0; ///< Objects updated at a reduced rate.
+  size_t m_nAsleep = 0; ///< Objects asleep.
+  size_t m_nPairTests = 0; ///< Pairs of objects looked at for collisions.
+  size_t m_nContacts = 0; ///< Sensors overlapping other objects.
+  size_t m_nTriggers = 0; ///< Overlap begin and end and tile enter events raised.
+  size_t m_nSpawned = 0; ///< Objects made from spawn records.
+  size_t m_nStored = 0; ///< Objects stored back into spawn records.
+  size_t m_nDormant = 0; ///< Spawn records waiting for the camera to come near.
+
+  float m_fTransitionTime = 0.0f; ///< Milliseconds taken by the last level transition.
+  bool m_bPreloaded = false; ///< true if the last level was preloaded.
+  bool m_bCached = false; ///< true if the last level came from the level cache.
+
+  /// Reset the counts for the next frame, keeping the transition.
+
+  void Reset(){
+    SFrameStats s; //fresh counts
+
+    s.m_fTransitionTime = m_fTransitionTime;
+    s.m_bPreloaded = m_bPreloaded;
+    s.m_bCached = m_bCached;
+
+    *this = s;
+  } //Reset
+}; //SFrameStats
+
+#endif //__L4RC_GAME_FRAMESTATS_H__
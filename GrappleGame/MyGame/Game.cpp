@@ -8,24 +8,38 @@
 #include "ComponentIncludes.h"
 #include "ParticleEngine.h"
 #include "TileManager.h"
+#include "DrawRecorder.h"
+#include "DrawQueue.h"
+#include "SpriteRegistry.h"
+#include "FrameStats.h"
+#include "LevelLoader.h"
+#include "LevelManifest.h"
+#include "Abort.h"
+#include "Turret.h"
 
 #include "shellapi.h"
 
 #include <Windows.h>
 
 #include <string>
+#include <chrono>
 
-/// Delete the renderer, the object manager, and the tile manager. The renderer
+/// Delete the renderer, the object manager, the tile manager, the level
+/// manifest, and the level loader, which waits for any level it is loading.
+/// The renderer
 /// needs to be deleted before this destructor runs so it will be done elsewhere.
 
 CGame::~CGame(){
   delete m_pParticleEngine;
   delete m_pObjectManager;
   delete m_pTileManager;
+  delete m_pDrawQueue;
+  delete m_pLevelLoader;
+  delete m_pLevelManifest;
 } //destructor
 
 /// Initialize the renderer, the tile manager and the object manager, load 
-/// images and sounds, and begin the game.
+/// images, sounds, and the level manifest, and begin the game.
 
 void CGame::Initialize(){
   m_pRenderer = new LSpriteRenderer(eSpriteMode::Batched2D); 
@@ -33,7 +47,16 @@ void CGame::Initialize(){
   LoadImages(); //load images from xml file list
   
   m_pTileManager = new CTileManager((size_t)m_pRenderer->GetWidth(eSprite::Tile));
+
+  m_pLevelManifest = new CLevelManifest; //set up the level list
+  if(!m_pLevelManifest->Load("Media\\Maps\\levels.xml"))
+    ABORT("Level manifest Media\\Maps\\levels.xml not found or empty.");
+
+  m_pLevelLoader = new CLevelLoader(m_pRenderer->GetWidth(eSprite::Tile),
+    m_pLevelManifest->GetCacheSize()); //set up the level loader
+  m_pLevelLoader->AddNavProfile(CTurret::m_sNavProfile); //levels get turret navigation graphs
   m_pObjectManager = new CObjectManager; //set up the object manager 
+  m_pDrawQueue = new CDrawQueue; //set up the draw queue
   LoadSounds(); //load the sounds for this game
 
   m_pParticleEngine = new LParticleEngine2D(m_pRenderer);
@@ -46,51 +69,47 @@ void CGame::Initialize(){
 /// `gamesettings.xml`. Those sprite tags contain the name of the corresponding
 /// image file. If the image tag or the image file are missing, then the game
 /// should abort from deeper in the Engine code leaving you with an error
-/// message in a dialog box.
+/// message in a dialog box. The sprites go into a registry first so that
+/// each one is loaded only once.
 
 void CGame::LoadImages(){  
-  m_pRenderer->BeginResourceUpload();
-
-  m_pRenderer->Load(eSprite::Tile,    "tile"); 
-  m_pRenderer->Load(eSprite::Player,  "player");
-  m_pRenderer->Load(eSprite::Bullet,  "bullet");
-  m_pRenderer->Load(eSprite::Bullet2, "bullet2");
-  m_pRenderer->Load(eSprite::Smoke,   "smoke");
-  m_pRenderer->Load(eSprite::Spark,   "spark");
-  m_pRenderer->Load(eSprite::Turret,  "turret");
-  m_pRenderer->Load(eSprite::Line,    "greenline");
-  m_pRenderer->Load(eSprite::Spike, "spike");
-  m_pRenderer->Load(eSprite::Door, "door");
-  m_pRenderer->Load(eSprite::DoorOpen, "dooropen");
-  m_pRenderer->Load(eSprite::Star, "star");
-  m_pRenderer->Load(eSprite::HealthPack, "healthpack");
-  m_pRenderer->Load(eSprite::OneUp, "oneup");
-  m_pRenderer->Load(eSprite::Bat, "bat");
-  m_pRenderer->Load(eSprite::Swooper, "swooper");
-  m_pRenderer->Load(eSprite::LaunchPad, "launchpad");
-  m_pRenderer->Load(eSprite::Win, "win");
-  m_pRenderer->Load(eSprite::Lose, "lose");
-  m_pRenderer->Load(eSprite::HealthBar_Green, "healthbar_green");
-  m_pRenderer->Load(eSprite::HealthBar_Red, "healthbar_red");
-  m_pRenderer->Load(eSprite::Creeper, "creeper");
-  m_pRenderer->Load(eSprite::CreeperExplosion, "creeper_explosion");
-
-  m_pRenderer->Load(eSprite::Walkleft, "walkleft");
-  m_pRenderer->Load(eSprite::Walkright, "walkright");
-  m_pRenderer->Load(eSprite::Standleft, "standleft");
-  m_pRenderer->Load(eSprite::Standright, "standright");
-  m_pRenderer->Load(eSprite::Jump, "jump");
-
-
-  m_pRenderer->Load(eSprite::Walkleft, "walkleft");
-  m_pRenderer->Load(eSprite::Walkright, "walkright");
-  m_pRenderer->Load(eSprite::Standleft, "standleft");
-  m_pRenderer->Load(eSprite::Standright, "standright");
-  m_pRenderer->Load(eSprite::Jump, "jump");
-
-  m_pRenderer->Load(eSprite::Grappler, "grappler");
-  m_pRenderer->Load(eSprite::Shotgun, "shotgun");
+  CSpriteRegistry sprites;
+
+  sprites.Add(eSprite::Tile,    "tile"); 
+  sprites.Add(eSprite::Player,  "player");
+  sprites.Add(eSprite::Bullet,  "bullet");
+  sprites.Add(eSprite::Bullet2, "bullet2");
+  sprites.Add(eSprite::Smoke,   "smoke");
+  sprites.Add(eSprite::Spark,   "spark");
+  sprites.Add(eSprite::Turret,  "turret");
+  sprites.Add(eSprite::Line,    "greenline");
+  sprites.Add(eSprite::Spike, "spike");
+  sprites.Add(eSprite::Door, "door");
+  sprites.Add(eSprite::DoorOpen, "dooropen");
+  sprites.Add(eSprite::Star, "star");
+  sprites.Add(eSprite::HealthPack, "healthpack");
+  sprites.Add(eSprite::OneUp, "oneup");
+  sprites.Add(eSprite::Bat, "bat");
+  sprites.Add(eSprite::Swooper, "swooper");
+  sprites.Add(eSprite::LaunchPad, "launchpad");
+  sprites.Add(eSprite::Win, "win");
+  sprites.Add(eSprite::Lose, "lose");
+  sprites.Add(eSprite::HealthBar_Green, "healthbar_green");
+  sprites.Add(eSprite::HealthBar_Red, "healthbar_red");
+  sprites.Add(eSprite::Creeper, "creeper");
+  sprites.Add(eSprite::CreeperExplosion, "creeper_explosion");
+
+  sprites.Add(eSprite::Walkleft, "walkleft");
+  sprites.Add(eSprite::Walkright, "walkright");
+  sprites.Add(eSprite::Standleft, "standleft");
+  sprites.Add(eSprite::Standright, "standright");
+  sprites.Add(eSprite::Jump, "jump");
+
+  sprites.Add(eSprite::Grappler, "grappler");
+  sprites.Add(eSprite::Shotgun, "shotgun");
 
+  m_pRenderer->BeginResourceUpload();
+  sprites.Load<eSprite>(m_pRenderer);
   m_pRenderer->EndResourceUpload();
 } //LoadImages
 
@@ -113,85 +132,54 @@ void CGame::LoadSounds(){
 /// Release all of the DirectX12 objects by deleting the renderer.
 
 void CGame::Release(){
+  if(m_pDrawRecorder)ToggleDrawRecorder(); //save recording in progress
+
   delete m_pRenderer;
   m_pRenderer = nullptr; //for safety
 } //Release
 
-/// Ask the object manager to create a player object and turrets specified by
-/// the tile manager.
+/// Ask the object manager to create the player, who is first on the map and
+/// also gets a grappler, then point the camera at the player and create the
+/// objects near enough to it. The rest of the objects on the map wait in
+/// the tile manager's spawn records until the camera comes near them, so
+/// the time this takes doesn't depend on how many there are.
 
 void CGame::CreateObjects(){
-  std::vector<Vector2> turretpos; //vector of turret positions
-  Vector2 playerpos; //player position
-  std::vector<Vector2> spikepos; //vector of spikepos
-  std::vector<Vector2> doorpos;//door position
-  std::vector<Vector2> starpos; // star position
-  std::vector<Vector2> batpos; // bat position
-  std::vector<Vector2> swooperpos; //swooper position
-  std::vector<Vector2> launchpadpos; // launchpad pos
-  std::vector<Vector2> healthpackpos;
-  std::vector<Vector2> oneuppos;
-  std::vector<Vector2> shotgunpos;
-  std::vector<Vector2> creeperpos;
-  m_pTileManager->GetObjects(turretpos, playerpos, spikepos, doorpos, starpos, batpos, launchpadpos, healthpackpos, oneuppos, shotgunpos, creeperpos, swooperpos); //get positions
-  
-  m_pPlayer = (CPlayer*)m_pObjectManager->create(eSprite::Standright, playerpos);
-  m_pGrappler = (CGrappler*)m_pObjectManager->create(eSprite::Grappler, playerpos);     //create grappler on player position
-
-  for(const Vector2& pos: turretpos)
-    m_pObjectManager->create(eSprite::Turret, pos);
-
-  for (const Vector2& pos : spikepos)
-      m_pObjectManager->create(eSprite::Spike, pos);
+  const std::vector<SSpawn>& spawns = m_pTileManager->GetSpawns(); //shorthand
 
-  for (const Vector2& pos : doorpos)
-      m_pObjectManager->create(eSprite::Door, pos);
-
-  for (const Vector2& pos : starpos)
-      m_pObjectManager->create(eSprite::Star, pos);
-
-  for (const Vector2& pos : batpos)
-      m_pObjectManager->create(eSprite::Bat, pos);
-
-  for (const Vector2& pos : swooperpos)
-      m_pObjectManager->create(eSprite::Swooper, pos);
-
-  for (const Vector2& pos : launchpadpos)
-      m_pObjectManager->create(eSprite::LaunchPad, pos);
-
-  for (const Vector2& pos : healthpackpos)
-      m_pObjectManager->create(eSprite::HealthPack, pos);
-
-  for (const Vector2& pos : oneuppos)
-      m_pObjectManager->create(eSprite::OneUp, pos);
-
-  for (const Vector2& pos : shotgunpos)
-      m_pObjectManager->create(eSprite::Shotgun, pos);
+  if(!spawns.empty() && spawns[0].m_eSprite == eSprite::Standright){ //player
+    const SSpawn& s = spawns[0]; //shorthand
+    m_pPlayer = (CPlayer*)m_pObjectManager->create(s.m_eSprite, s.m_vPos);
+    m_pGrappler = (CGrappler*)m_pObjectManager->create(eSprite::Grappler, s.m_vPos);
+  } //if
 
-  for (const Vector2& pos : creeperpos)
-      m_pObjectManager->create(eSprite::Creeper, pos);
+  FollowCamera(); //camera to player
+  m_pObjectManager->UpdateSpawns(); //create nearby objects
 } //CreateObjects
 
 /// Call this function to start a new game. This should be re-entrant so that
 /// you can restart a new game without having to shut down and restart the
 /// program. Clear the particle engine to get rid of any existing particles,
 /// delete any old objects out of the object manager and create some new ones.
+/// The level is usually waiting for us, either in the level cache or having
+/// been loaded in the background while the previous one was played, and
+/// once it is up the one after it is loaded in the background in turn. The
+/// time taken is shown in the stats overlay.
 
 void CGame::BeginGame(){  
+  const auto t0 = std::chrono::high_resolution_clock::now(); //start time
+
   m_pParticleEngine->clear(); //clear old particles
-  state = 2;
-  
-  switch(m_nNextLevel){
-    case 0: m_pTileManager->LoadMap("Media\\Maps\\level_one.txt"); break;
-    case 1: m_pTileManager->LoadMap("Media\\Maps\\mario_star_from_china.txt"); break;
-    case 2: m_pTileManager->LoadMap("Media\\Maps\\momentum_testing.txt"); break;
-    case 3: m_pTileManager->LoadMap("Media\\Maps\\platforms.txt"); break;
-    case 4: m_pTileManager->LoadMap("Media\\Maps\\spikechasm.txt"); break;
-    case 5: m_pTileManager->LoadMap("Media\\Maps\\launchpads.txt"); break;
-    case 6: m_pTileManager->LoadMap("Media\\Maps\\ascension.txt"); break;
-    case 7: m_pTileManager->LoadMap("Media\\Maps\\final_climb.txt"); break;
-    case 8: m_pTileManager->LoadMap("Media\\Maps\\winner.txt"); state = 0; break;
-  } //switch
+  const SLevelInfo& info = m_pLevelManifest->GetLevel(m_nNextLevel); //shorthand
+  state = info.m_bWinner? 0: 2;
+
+  eLevelSource source = eLevelSource::Loaded; //where the level came from
+  auto level = m_pLevelLoader->Take(info.m_strFile.c_str(), source);
+
+  if(!level->IsLoaded())
+    ABORT("%s", level->GetError().c_str()); //panic
+
+  m_pTileManager->SetLevel(level);
 
   m_pObjectManager->clear(); //clear old objects
   CreateObjects(); //create new objects (must be after map is loaded) 
@@ -199,8 +187,25 @@ void CGame::BeginGame(){
   m_pAudio->play(eSound::Start); //play start-of-game sound
   m_pGrappler->normalGun(); // set back to normal gun
   m_eGameState = eGameState::Playing; //now playing
+
+  const std::chrono::duration<float, std::milli> t =
+    std::chrono::high_resolution_clock::now() - t0; //time taken
+  m_sFrameStats.m_fTransitionTime = t.count();
+  m_sFrameStats.m_bPreloaded = source == eLevelSource::Preloaded;
+  m_sFrameStats.m_bCached = source == eLevelSource::Cached;
+
+  const SLevelInfo& next = m_pLevelManifest->GetLevel(m_nNextLevel + 1);
+  m_pLevelLoader->Preload(next.m_strFile.c_str()); //get the next one ready
 } //BeginGame
 
+/// Move on to the next level in the manifest, wrapping around to the first
+/// one after the last, and begin it.
+
+void CGame::NextLevel(){
+  m_nNextLevel = (m_nNextLevel + 1)%m_pLevelManifest->GetSize();
+  BeginGame();
+} //NextLevel
+
 /// Poll the keyboard state and respond to the key presses that happened since
 /// the last frame.
 
@@ -208,8 +213,7 @@ void CGame::KeyboardHandler(){
   m_pKeyboard->GetState(); //get current keyboard state
 
   if (m_pKeyboard->TriggerDown(VK_RETURN)) {
-      m_nNextLevel = (m_nNextLevel + 1) % 9;
-      BeginGame();
+      NextLevel();
   } //if
   
   //if(m_pKeyboard->TriggerDown(VK_F1)) //help
@@ -217,6 +221,9 @@ void CGame::KeyboardHandler(){
   
   if(m_pKeyboard->TriggerDown(VK_F2)) //toggle frame rate
     m_bDrawFrameRate = !m_bDrawFrameRate;
+
+  if(m_pKeyboard->TriggerDown(VK_F4)) //toggle draw recording
+    ToggleDrawRecorder();
   
   //if(m_pKeyboard->TriggerDown(VK_F3)) //toggle AABB drawing
   //  m_bDrawAABBs = !m_bDrawAABBs; 
@@ -376,6 +383,62 @@ void CGame::DrawFrameRateText(){
   m_pRenderer->DrawScreenText(s.c_str(), pos); //draw to screen
 } //DrawFrameRateText
 
+/// Draw the frame statistics below the frame rate, one count per line.
+
+void CGame::DrawFrameStatsText(){
+  const CLevelCache& cache = m_pLevelLoader->GetCache(); //shorthand
+
+  const std::string s[] = { //one line each
+    std::to_string(m_sFrameStats.m_nObjectsDrawn) + " drawn",
+    std::to_string(m_sFrameStats.m_nObjectsCulled) + " culled",
+    std::to_string(m_sFrameStats.m_nParticlesCulled) + " fx culled",
+    std::to_string(m_sFrameStats.m_nSprites) + " sprites",
+    std::to_string(m_sFrameStats.m_nUnsortedBatches) + " > " +
+      std::to_string(m_sFrameStats.m_nBatches) + " batches",
+    std::to_string(m_sFrameStats.m_nAwake) + "/" +
+      std::to_string(m_sFrameStats.m_nSlow) + "/" +
+      std::to_string(m_sFrameStats.m_nAsleep) + " awake/slow/asleep",
+    std::to_string(m_sFrameStats.m_nPairTests) + " pair tests",
+    std::to_string(m_sFrameStats.m_nContacts) + " contacts, " +
+      std::to_string(m_sFrameStats.m_nTriggers) + " triggers",
+    std::to_string(m_sFrameStats.m_nSpawned) + "+/" +
+      std::to_string(m_sFrameStats.m_nStored) + "- spawns, " +
+      std::to_string(m_sFrameStats.m_nDormant) + " dormant",
+    std::to_string(m_sFrameStats.m_nAiUpdates) + " ai, " +
+      std::to_string(m_sFrameStats.m_nAiDeferred) + " deferred",
+    std::to_string((int)m_sFrameStats.m_fAiTime) + "/" +
+      std::to_string((int)m_sFrameStats.m_fAiBudget) + " us ai",
+    std::to_string((int)m_sFrameStats.m_fTransitionTime) + " ms level" +
+      (m_sFrameStats.m_bPreloaded? " (pre)": m_sFrameStats.m_bCached? " (cache)": ""),
+    std::to_string(cache.GetHits()) + "/" +
+      std::to_string(cache.GetHits() + cache.GetMisses()) + " level hits",
+  }; //s
+
+  Vector2 pos(m_nWinWidth - 128.0f, 60.0f); //hard-coded position
+
+  for(const std::string& line: s){
+    m_pRenderer->DrawScreenText(line.c_str(), pos); //draw to screen
+    pos.y += 30.0f; //next line
+  } //for
+} //DrawFrameStatsText
+
+/// Start recording the draws of each frame, or stop recording and save the
+/// recording to `drawrecord.bin` in the current folder, overwriting any
+/// previous recording. The recording can be summarized and compared with
+/// another using the `drawstats` and `drawdiff` commands of the benchmark
+/// program.
+
+void CGame::ToggleDrawRecorder(){
+  if(m_pDrawRecorder == nullptr)
+    m_pDrawRecorder = new CDrawRecorder;
+
+  else{
+    m_pDrawRecorder->Save("drawrecord.bin");
+    delete m_pDrawRecorder;
+    m_pDrawRecorder = nullptr;
+  } //else
+} //ToggleDrawRecorder
+
 /// Draw the god mode text to a hard-coded position in the window using the
 /// font specified in `gamesettings.xml`.
 
@@ -440,13 +503,23 @@ Vector2 CGame::ConvertGameToScreenSpace(Vector2& gameVector) {
 
 void CGame::RenderFrame(){                                  //if you want something to happen every frame, it's probably going to happen here
   m_pRenderer->BeginFrame(); //required before rendering
+  if(m_pDrawRecorder)m_pDrawRecorder->BeginFrame(m_pRenderer->GetCameraPos());
 
-  m_pObjectManager->draw(); //draw objects
+  m_pObjectManager->draw(); //queue objects
+  m_pDrawQueue->Flush<LSpriteDesc2D>(m_pRenderer, m_pDrawRecorder); //draw them sorted by sprite
   m_pParticleEngine->Draw(); //draw particles
-  if(m_bDrawFrameRate)DrawFrameRateText(); //draw frame rate, if required
+
+  m_sFrameStats.m_nSprites = m_pDrawQueue->GetNumInstances();
+  m_sFrameStats.m_nUnsortedBatches = m_pDrawQueue->GetNumUnsortedBatches();
+  m_sFrameStats.m_nBatches = m_pDrawQueue->GetNumBatches();
+
+  if(m_bDrawFrameRate){ //draw frame rate and stats, if required
+    DrawFrameRateText();
+    DrawFrameStatsText();
+  } //if
   if(m_bGodMode)DrawGodModeText(); //draw god mode text, if required
-  if (m_nNextLevel == 0) DrawTutorialText();
-  if (m_nNextLevel == 8) DrawWinnerText();
+  if (m_pLevelManifest->GetLevel(m_nNextLevel).m_bTutorial) DrawTutorialText();
+  if (m_pLevelManifest->GetLevel(m_nNextLevel).m_bWinner) DrawWinnerText();
 
   DrawPlayerLivesText();
 
@@ -462,6 +535,7 @@ void CGame::RenderFrame(){                                  //if you want someth
   else if (state == 1)
   {
       m_pRenderer->Draw(eSprite::Lose, Vector2(deathLocation), 0.0f);
+      if(m_pDrawRecorder)m_pDrawRecorder->Record(eSprite::Lose, deathLocation, 0.0f);
   }
 
   /*std::string grapX = std::to_string(m_pGrappler->GetPos().x);
@@ -474,6 +548,8 @@ void CGame::RenderFrame(){                                  //if you want someth
   m_pRenderer->DrawScreenText(coords, m_pGrappler->GetPos());*/
 
   m_pRenderer->EndFrame(); //required after rendering
+  m_sFrameStats.Reset(); //start counting for the next frame
+  m_pDrawQueue->Clear();
 } //RenderFrame
 
 /// Make the camera follow the player, but don't let it get too close to the
@@ -513,7 +589,13 @@ void CGame::ProcessFrame(){
   m_pAudio->BeginFrame(); //notify audio player that frame has begun
   
   m_pTimer->Tick([&](){ //all time-dependent function calls should go here
-    m_pObjectManager->move(); //move all objects
+    if(m_pPlayer)m_pTileManager->UpdateFlowField(m_pPlayer->GetPos()); //route chasers to player
+    if(m_pPlayer)m_pTileManager->UpdateNavRoute(CTurret::m_sNavProfile, m_pPlayer->GetPos()); //route turrets
+    m_pTileManager->BeginPathFrame(); //reset path search budget
+    m_pObjectManager->UpdateSpawns(); //make near objects, store far ones
+    m_pObjectManager->SetActivity(); //sleep or wake objects by distance
+    m_pObjectManager->perceive(); //scheduled thinking, line of sight at once
+    m_pObjectManager->move(); //move all objects every frame
     FollowCamera(); //make camera follow player
     m_pParticleEngine->step(); //advance particle animation
     if (m_pPlayer) {
@@ -575,8 +657,7 @@ void CGame::ProcessGameState(){
         {
             if (m_pPlayer->m_bIsWinner == true) { //player won
                 m_pPlayer->m_bIsWinner == false;
-                m_nNextLevel = (m_nNextLevel + 1) % 9; //note: 4 instead of 3
-                BeginGame(); //restart game
+                NextLevel(); //on to the next level
             }
         } //if
       break;
@@ -12,6 +12,9 @@
 #include "Player.h"
 #include "Grappler.h"
 
+class CLevelLoader;
+class CLevelManifest;
+
 /// \brief The game class.
 ///
 /// The game class is the object-oriented implementation of the game. This class
@@ -29,19 +32,24 @@ class CGame:
   private:
     bool m_bDrawFrameRate = false; ///< Draw the frame rate.
     eGameState m_eGameState = eGameState::Playing; ///< Game state.
-    int m_nNextLevel = 0; ///< Current level number.
+    size_t m_nNextLevel = 0; ///< Current level number.
     int m_nPlayerLives = 3; ///< Current player lives.
+    CLevelLoader* m_pLevelLoader = nullptr; ///< Loads levels in the background.
+    CLevelManifest* m_pLevelManifest = nullptr; ///< The levels in order.
 
     float test = 0.0f;
   
     void LoadImages(); ///< Load images.
     void LoadSounds(); ///< Load sounds.
     void BeginGame(); ///< Begin playing the game.
+    void NextLevel(); ///< Move on to the next level.
     void KeyboardHandler(); ///< The keyboard handler.
     void ControllerHandler(); ///< The controller handler.
     void MouseHandler(); ///< The Mouse Handler.
     void RenderFrame(); ///< Render an animation frame.
     void DrawFrameRateText(); ///< Draw frame rate text to screen.
+    void DrawFrameStatsText(); ///< Draw frame statistics text to screen.
+    void ToggleDrawRecorder(); ///< Start or stop recording draws.
     void DrawGodModeText(); ///< Draw god mode text if in god mode.
     void DrawPlayerLivesText();///< Draw player lives count.
     void CreateObjects(); ///< Create game objects.
@@ -8,17 +8,20 @@ CHealthPack::CHealthPack(const Vector2& p) : CObject(eSprite::HealthPack, p)
 {
 	m_bIsTarget = false;
 	m_bStatic = true;
+	m_bSensor = true;
 	m_bIsHealthpack = true;
 }
 
-void CHealthPack::CollisionResponse(const Vector2& norm, float d, CObject* pObj)
+/// Response to the start of an overlap. The health pack is picked up, and
+/// so dies, when the player first touches it.
+/// \param pObj Pointer to the other object.
+
+void CHealthPack::OverlapBegin(CObject* pObj)
 {
 	if (m_bDead)return; //already dead, bail out 
 
-	if (pObj && pObj->isPlayer())
+	if (pObj->isPlayer())
 	{
 		m_bDead = true; //flag for deletion from object list
 	}
-
-	CObject::CollisionResponse(norm, d, pObj);
 }
\ No newline at end of file
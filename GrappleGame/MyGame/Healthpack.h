@@ -8,7 +8,7 @@
 
 class CHealthPack : public CObject {
 	protected:
-		virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
+		virtual void OverlapBegin(CObject*); ///< Response to starting to overlap.
 public:
 	CHealthPack(const Vector2& p);
 };
@@ -0,0 +1,653 @@
+/// \file HierPathFinder.cpp
+/// \brief Code for the hierarchical path finder CHierPathFinder.
+
+#include "HierPathFinder.h"
+
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+
+static const uint32_t NONE = UINT32_MAX; ///< No tile, node, or cost.
+static const uint32_t STRAIGHT = 10; ///< Cost of a straight step.
+static const uint32_t DIAGONAL = 14; ///< Cost of a diagonal step, about 10 root 2.
+static const size_t SPLIT = 6; ///< Entrances at least this wide get a pair of nodes at each end.
+static const uint32_t BUCKETS = 32; ///< Buckets in a cluster search's open list, a power of 2 over 2 diagonal steps.
+
+static const int DX[8] = {1, -1, 0, 0, 1, -1, 1, -1}; ///< Column steps to the 8-neighbors.
+static const int DY[8] = {0, 0, 1, -1, 1, 1, -1, -1}; ///< Row steps to the 8-neighbors.
+
+/// Estimate the cost between two tiles as if there were no walls.
+/// \param x0 Column of first tile.
+/// \param y0 Row of first tile.
+/// \param x1 Column of second tile.
+/// \param y1 Row of second tile.
+/// \return The cost of the shortest path with no walls in the way.
+
+static inline uint32_t Octile(int x0, int y0, int x1, int y1){
+  const uint32_t dx = std::abs(x1 - x0), dy = std::abs(y1 - y0);
+  return STRAIGHT*std::max(dx, dy) + (DIAGONAL - STRAIGHT)*std::min(dx, dy);
+} //Octile
+
+/// Use a new map. Any tile that isn't a wall `W` is open. All of the
+/// entrances and the links between them are made here. Linking the nodes
+/// in each cluster is most of the work, and the clusters are shared out
+/// between worker threads.
+/// \param map The map, an array of rows top row first.
+/// \param w Number of tiles wide.
+/// \param h Number of tiles high.
+/// \param size Cluster width and height in tiles.
+/// \param threads Number of threads, 0 for one per hardware thread.
+
+void CHierPathFinder::SetMap(const char* const* map, size_t w, size_t h, size_t size,
+  size_t threads)
+{
+  m_nWidth = w;
+  m_nHeight = h;
+  m_nClusterSize = std::max<size_t>(2, size);
+  m_nClustersWide = (w + m_nClusterSize - 1)/m_nClusterSize;
+  m_nClustersHigh = (h + m_nClusterSize - 1)/m_nClusterSize;
+
+  m_vecOpen.resize(w*h);
+
+  for(size_t i=0; i<h; i++)
+    for(size_t j=0; j<w; j++)
+      m_vecOpen[i*w + j] = map[i][j] != 'W';
+
+  const size_t n = m_nClustersWide*m_nClustersHigh; //number of clusters
+
+  m_vecNodes.clear();
+  m_vecFree.clear();
+  m_vecClusterNodes.assign(n, std::vector<uint32_t>());
+  m_vecBorderNodes.assign(2*n, std::vector<uint32_t>());
+
+  for(size_t c=0; c<n; c++){
+    MakeBorder(c, 0);
+    MakeBorder(c, 1);
+  } //for
+
+  //link the nodes in each cluster, which touches nothing outside it
+
+  if(threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<SClusterSearch> work(std::min(threads, n)); //work space for each thread
+  std::atomic<size_t> next{0}; //next cluster to link
+
+  auto Work = [&](SClusterSearch* ws){
+    InitSearch(*ws);
+
+    for(size_t c=next++; c<n; c=next++)
+      MakeEdges(*ws, c);
+  }; //Work
+
+  std::vector<std::thread> workers;
+
+  for(size_t i=1; i<work.size(); i++) //the caller works too
+    workers.emplace_back(Work, &work[i]);
+
+  if(!work.empty())
+    Work(&work[0]);
+
+  for(std::thread& t: workers)
+    t.join();
+
+  InitSearch(m_sSearch);
+
+  m_vecCost.assign(m_vecNodes.size(), 0);
+  m_vecParent.assign(m_vecNodes.size(), 0);
+  m_vecStamp.assign(m_vecNodes.size(), 0);
+  m_vecHeuristic.assign(m_vecNodes.size(), 0);
+  m_vecToGoal.assign(m_vecNodes.size(), NONE);
+  m_nStamp = 0;
+} //SetMap
+
+/// Open or close a tile. The entrances on any cluster border that the tile
+/// is on are made again, and the nodes are linked again in its cluster and
+/// in the clusters across those borders. Nothing else changes.
+/// \param i Row.
+/// \param j Column.
+/// \param open true if the tile is to be open, false for a wall.
+
+void CHierPathFinder::SetOpen(size_t i, size_t j, bool open){
+  if(i >= m_nHeight || j >= m_nWidth || m_vecOpen[i*m_nWidth + j] == (uint8_t)open)
+    return; //nothing to do
+
+  m_vecOpen[i*m_nWidth + j] = open;
+  m_sSearch.m_nCluster = SIZE_MAX;
+
+  const size_t C = m_nClusterSize; //shorthand
+  const size_t cx = j/C, cy = i/C; //cluster column and row
+  const size_t c = cy*m_nClustersWide + cx; //cluster
+  std::vector<size_t> changed(1, c); //clusters whose nodes changed
+
+  if(j%C == C - 1 && cx + 1 < m_nClustersWide){ //on the right border
+    MakeBorder(c, 0);
+    changed.push_back(c + 1);
+  } //if
+
+  if(j%C == 0 && cx > 0){ //on the left border
+    MakeBorder(c - 1, 0);
+    changed.push_back(c - 1);
+  } //if
+
+  if(i%C == C - 1 && cy + 1 < m_nClustersHigh){ //on the bottom border
+    MakeBorder(c, 1);
+    changed.push_back(c + m_nClustersWide);
+  } //if
+
+  if(i%C == 0 && cy > 0){ //on the top border
+    MakeBorder(c - m_nClustersWide, 1);
+    changed.push_back(c - m_nClustersWide);
+  } //if
+
+  for(size_t k: changed)
+    MakeEdges(m_sSearch, k);
+
+  m_nRebuilt += changed.size();
+} //SetOpen
+
+/// Find a path from one tile to another. If they are in the same cluster
+/// and there is a path between them in it, that is the whole path.
+/// Otherwise the start and goal are joined to the nodes of their clusters
+/// and the nodes are searched with A*. A leg between waypoints can be
+/// turned into tiles with `RefineLeg()`.
+/// \param start Index of start tile.
+/// \param goal Index of goal tile.
+/// \param path [out] Waypoint tiles from the start to the goal.
+/// \return true if a path was found.
+
+const bool CHierPathFinder::FindPath(size_t start, size_t goal, std::vector<uint32_t>& path){
+  path.clear();
+
+  const size_t n = m_nWidth*m_nHeight; //number of tiles
+  if(start >= n || goal >= n || !m_vecOpen[start] || !m_vecOpen[goal])return false;
+
+  if(start == goal){
+    path.push_back((uint32_t)start);
+    return true;
+  } //if
+
+  m_nSearches++;
+  const size_t cs = GetCluster(start), cg = GetCluster(goal); //clusters
+
+  if(cs == cg && Search(m_sSearch, cs, start, goal) != NONE){ //in the same cluster
+    path.push_back((uint32_t)start);
+    path.push_back((uint32_t)goal);
+    return true;
+  } //if
+
+  m_vecCost.resize(m_vecNodes.size(), 0);
+  m_vecParent.resize(m_vecNodes.size(), 0);
+  m_vecStamp.resize(m_vecNodes.size(), 0);
+  m_vecHeuristic.resize(m_vecNodes.size(), 0);
+  m_vecToGoal.resize(m_vecNodes.size(), NONE);
+
+  //join the goal to the nodes of its cluster
+
+  Search(m_sSearch, cg, goal, SIZE_MAX);
+
+  for(uint32_t k: m_vecClusterNodes[cg])
+    m_vecToGoal[k] = GetLocalCost(m_sSearch, cg, m_vecNodes[k].m_nTile);
+
+  //join the start to the nodes of its cluster
+
+  Search(m_sSearch, cs, start, SIZE_MAX);
+
+  const int gx = (int)(goal%m_nWidth), gy = (int)(goal/m_nWidth); //goal column and row
+
+  auto heuristic = [&](uint32_t k){ //worked out once per node per search
+    if(m_vecStamp[k] != m_nStamp){
+      const uint32_t t = m_vecNodes[k].m_nTile; //tile of node
+      m_vecHeuristic[k] = Octile((int)(t%m_nWidth), (int)(t/m_nWidth), gx, gy);
+    } //if
+
+    return m_vecHeuristic[k];
+  }; //heuristic
+
+  m_nStamp++;
+  m_vecHeap.clear();
+
+  for(uint32_t k: m_vecClusterNodes[cs]){
+    const uint32_t cost = GetLocalCost(m_sSearch, cs, m_vecNodes[k].m_nTile); //cost from start
+    if(cost == NONE)continue;
+
+    const uint32_t h = heuristic(k); //before the stamp is set
+    m_vecCost[k] = cost;
+    m_vecParent[k] = NONE;
+    m_vecStamp[k] = m_nStamp;
+    m_vecHeap.push_back((uint64_t)(cost + h) << 32 | k);
+  } //for
+
+  std::make_heap(m_vecHeap.begin(), m_vecHeap.end(), std::greater<uint64_t>());
+
+  //A* over the nodes
+
+  uint32_t best = NONE; //cost of the best path to the goal so far
+  uint32_t last = NONE; //last node on it
+
+  while(!m_vecHeap.empty()){
+    std::pop_heap(m_vecHeap.begin(), m_vecHeap.end(), std::greater<uint64_t>());
+    const uint64_t top = m_vecHeap.back();
+    m_vecHeap.pop_back();
+
+    const uint32_t k = (uint32_t)top; //node
+    if((top >> 32) != m_vecCost[k] + heuristic(k))continue; //stale
+    if((top >> 32) >= best)break; //can't do better
+
+    if(m_vecToGoal[k] != NONE && m_vecCost[k] + m_vecToGoal[k] < best){
+      best = m_vecCost[k] + m_vecToGoal[k];
+      last = k;
+    } //if
+
+    auto relax = [&](uint32_t m, uint32_t cost){
+      if(m_vecStamp[m] != m_nStamp || cost < m_vecCost[m]){
+        const uint32_t h = heuristic(m); //before the stamp is set
+        m_vecCost[m] = cost;
+        m_vecParent[m] = k;
+        m_vecStamp[m] = m_nStamp;
+        m_vecHeap.push_back((uint64_t)(cost + h) << 32 | m);
+        std::push_heap(m_vecHeap.begin(), m_vecHeap.end(), std::greater<uint64_t>());
+      } //if
+    }; //relax
+
+    relax(m_vecNodes[k].m_nPair, m_vecCost[k] + STRAIGHT); //across the entrance
+
+    for(const SEdge& e: m_vecNodes[k].m_vecEdges) //across the cluster
+      relax(e.m_nTo, m_vecCost[k] + e.m_nCost);
+  } //while
+
+  for(uint32_t k: m_vecClusterNodes[cg])
+    m_vecToGoal[k] = NONE;
+
+  if(last == NONE)return false;
+
+  //waypoints, leaving out nodes on the same tile
+
+  path.push_back((uint32_t)goal);
+
+  for(uint32_t k=last; k!=NONE; k=m_vecParent[k])
+    if(m_vecNodes[k].m_nTile != path.back())
+      path.push_back(m_vecNodes[k].m_nTile);
+
+  if(path.back() != start)
+    path.push_back((uint32_t)start);
+
+  std::reverse(path.begin(), path.end());
+  return true;
+} //FindPath
+
+/// Find the tiles of one leg of a path, from a waypoint to the next. A leg
+/// across an entrance is one step, and any other leg is a search inside
+/// one cluster.
+/// \param from Index of the waypoint at the start of the leg.
+/// \param to Index of the waypoint at the end of the leg.
+/// \param tiles [out] Tiles after the first up to and including the last.
+/// \return true if the leg was found.
+
+const bool CHierPathFinder::RefineLeg(size_t from, size_t to, std::vector<uint32_t>& tiles){
+  tiles.clear();
+
+  const size_t n = m_nWidth*m_nHeight; //number of tiles
+  if(from >= n || to >= n)return false;
+  if(from == to)return true;
+
+  const int dx = std::abs((int)(from%m_nWidth) - (int)(to%m_nWidth));
+  const int dy = std::abs((int)(from/m_nWidth) - (int)(to/m_nWidth));
+
+  if(dx + dy == 1 && m_vecOpen[to]){ //one step
+    tiles.push_back((uint32_t)to);
+    return true;
+  } //if
+
+  const size_t c = GetCluster(from); //cluster
+  if(GetCluster(to) != c || Search(m_sSearch, c, from, to) == NONE)return false;
+
+  const size_t P = m_nClusterSize + 2; //cluster size with a border
+  const size_t x0 = (c%m_nClustersWide)*m_nClusterSize - 1; //column left of cluster
+  const size_t y0 = (c/m_nClustersWide)*m_nClusterSize - 1; //row above cluster
+  const uint32_t s = GetLocal(c, from); //start in cluster
+
+  for(uint32_t k=GetLocal(c, to); k!=s; k=m_sSearch.m_vecParent[k])
+    tiles.push_back((uint32_t)((y0 + k/P)*m_nWidth + x0 + k%P));
+
+  std::reverse(tiles.begin(), tiles.end());
+  return true;
+} //RefineLeg
+
+/// Get a cluster search work space ready for this map's cluster size.
+/// \param work Work space.
+
+void CHierPathFinder::InitSearch(SClusterSearch& work) const{
+  const size_t P = m_nClusterSize + 2; //cluster size with a border
+
+  work.m_nCluster = SIZE_MAX;
+  work.m_vecOpen.assign(P*P, 0);
+  work.m_vecCost.assign(P*P, 0);
+  work.m_vecParent.assign(P*P, 0);
+  work.m_vecStamp.assign(P*P, 0);
+  work.m_vecBuckets.assign(BUCKETS, std::vector<uint32_t>());
+  work.m_nStamp = 0;
+} //InitSearch
+
+/// Get the index of a tile in the arrays of a cluster search work space,
+/// which cover the cluster and a border of one tile all round.
+/// \param c Cluster.
+/// \param tile Index of the tile, which must be in the cluster.
+/// \return Index in the work space arrays.
+
+const uint32_t CHierPathFinder::GetLocal(size_t c, size_t tile) const{
+  const size_t P = m_nClusterSize + 2; //cluster size with a border
+  const size_t x = tile%m_nWidth - (c%m_nClustersWide)*m_nClusterSize; //column in cluster
+  const size_t y = tile/m_nWidth - (c/m_nClustersWide)*m_nClusterSize; //row in cluster
+
+  return (uint32_t)((y + 1)*P + x + 1);
+} //GetLocal
+
+/// Copy the open tiles of a cluster into a work space, with a border of
+/// walls so that searches don't need to check for the edge of the cluster.
+/// Nothing is done if it is already there.
+/// \param work Work space.
+/// \param c Cluster.
+
+void CHierPathFinder::LoadCluster(SClusterSearch& work, size_t c) const{
+  if(c == work.m_nCluster)return;
+  work.m_nCluster = c;
+
+  const size_t P = m_nClusterSize + 2; //cluster size with a border
+  const size_t x0 = (c%m_nClustersWide)*m_nClusterSize; //left column
+  const size_t y0 = (c/m_nClustersWide)*m_nClusterSize; //top row
+  const size_t x1 = std::min(x0 + m_nClusterSize, m_nWidth); //one past right column
+  const size_t y1 = std::min(y0 + m_nClusterSize, m_nHeight); //one past bottom row
+
+  std::fill(work.m_vecOpen.begin(), work.m_vecOpen.end(), 0);
+
+  for(size_t y=y0; y<y1; y++)
+    std::copy(&m_vecOpen[y*m_nWidth + x0], &m_vecOpen[y*m_nWidth + x1],
+      &work.m_vecOpen[(y - y0 + 1)*P + 1]);
+} //LoadCluster
+
+/// Get the cluster that a tile is in.
+/// \param tile Index of the tile.
+/// \return Index of the cluster.
+
+const size_t CHierPathFinder::GetCluster(size_t tile) const{
+  const size_t x = tile%m_nWidth, y = tile/m_nWidth; //column and row
+  return (y/m_nClusterSize)*m_nClustersWide + x/m_nClusterSize;
+} //GetCluster
+
+/// Make a node, reusing a free one if there is one.
+/// \param tile Index of its tile.
+/// \param c Its cluster.
+/// \return The node.
+
+const uint32_t CHierPathFinder::NewNode(size_t tile, size_t c){
+  uint32_t k = (uint32_t)m_vecNodes.size(); //new node
+
+  if(m_vecFree.empty())
+    m_vecNodes.push_back(SNode());
+
+  else{
+    k = m_vecFree.back();
+    m_vecFree.pop_back();
+  } //else
+
+  m_vecNodes[k].m_nTile = (uint32_t)tile;
+  m_vecNodes[k].m_nCluster = (uint32_t)c;
+  m_vecNodes[k].m_vecEdges.clear();
+  m_vecClusterNodes[c].push_back(k);
+
+  return k;
+} //NewNode
+
+/// Make the entrances on the border between a cluster and the next one to
+/// its right or below, dropping the old ones. An entrance is a run of open
+/// tiles on this side of the border facing open tiles on the other side. A
+/// narrow entrance gets a pair of nodes in the middle, and a wide one gets
+/// a pair at each end. The nodes in both clusters must be linked again
+/// afterwards.
+/// \param c Cluster.
+/// \param side 0 for the border on the right, 1 for the border below.
+
+void CHierPathFinder::MakeBorder(size_t c, size_t side){
+  std::vector<uint32_t>& border = m_vecBorderNodes[2*c + side]; //nodes on this border
+
+  for(uint32_t k: border){ //drop the old nodes
+    std::vector<uint32_t>& v = m_vecClusterNodes[m_vecNodes[k].m_nCluster];
+    v.erase(std::find(v.begin(), v.end(), k));
+    m_vecNodes[k].m_nTile = NONE;
+    m_vecNodes[k].m_vecEdges.clear();
+    m_vecFree.push_back(k);
+  } //for
+
+  border.clear();
+
+  const size_t C = m_nClusterSize; //shorthand
+  const size_t cx = c%m_nClustersWide, cy = c/m_nClustersWide; //cluster column and row
+
+  if(side == 0 && cx + 1 >= m_nClustersWide)return; //nothing to the right
+  if(side == 1 && cy + 1 >= m_nClustersHigh)return; //nothing below
+
+  const size_t other = side == 0? c + 1: c + m_nClustersWide; //cluster on the other side
+  const size_t step = side == 0? 1: m_nWidth; //from a tile to the one across the border
+  const size_t len = side == 0? std::min(C, m_nHeight - cy*C): std::min(C, m_nWidth - cx*C); //border length
+
+  auto tile = [&](size_t k){ //k-th tile along this side of the border
+    return side == 0? (cy*C + k)*m_nWidth + (cx + 1)*C - 1: ((cy + 1)*C - 1)*m_nWidth + cx*C + k;
+  }; //tile
+
+  auto open = [&](size_t k){ //whether open on both sides
+    return m_vecOpen[tile(k)] && m_vecOpen[tile(k) + step];
+  }; //open
+
+  for(size_t k=0; k<len; k++){
+    if(!open(k))continue;
+
+    size_t e = k; //one past the end of the entrance
+    while(e < len && open(e))e++;
+
+    const bool wide = e - k >= SPLIT; //whether a wide entrance
+    const size_t places[2] = {wide? k: (k + e - 1)/2, e - 1}; //where the nodes go
+
+    for(size_t q=0; q<(wide? 2U: 1U); q++){
+      const size_t p = places[q]; //place along the border
+      const uint32_t a = NewNode(tile(p), c); //this side
+      const uint32_t b = NewNode(tile(p) + step, other); //other side
+
+      m_vecNodes[a].m_nPair = b;
+      m_vecNodes[b].m_nPair = a;
+      border.push_back(a);
+      border.push_back(b);
+    } //for
+
+    k = e;
+  } //for
+} //MakeBorder
+
+/// Link each pair of nodes in a cluster by the cost of the shortest path
+/// between them that stays in the cluster, if there is one. Only the nodes
+/// of this cluster are changed, so different clusters can be linked at the
+/// same time with different work spaces.
+/// \param work Work space.
+/// \param c Cluster.
+
+void CHierPathFinder::MakeEdges(SClusterSearch& work, size_t c){
+  const std::vector<uint32_t>& nodes = m_vecClusterNodes[c]; //shorthand
+
+  for(uint32_t k: nodes)
+    m_vecNodes[k].m_vecEdges.clear();
+
+  for(size_t a=0; a+1<nodes.size(); a++){
+    Search(work, c, m_vecNodes[nodes[a]].m_nTile, SIZE_MAX);
+
+    for(size_t b=a+1; b<nodes.size(); b++){
+      const uint32_t cost = GetLocalCost(work, c, m_vecNodes[nodes[b]].m_nTile);
+
+      if(cost != NONE){
+        m_vecNodes[nodes[a]].m_vecEdges.push_back({nodes[b], cost});
+        m_vecNodes[nodes[b]].m_vecEdges.push_back({nodes[a], cost});
+      } //if
+    } //for
+  } //for
+} //MakeEdges
+
+/// Search the open tiles of one cluster from a start tile, with A* if there
+/// is a goal and all of them with Dijkstra's algorithm if not. Steps are to
+/// the 8-neighbors, and diagonal steps must not cut the corner of a wall.
+/// Costs are small whole numbers and each step adds at most two diagonal
+/// steps to the estimated cost, so the open list is a ring of buckets by
+/// estimated cost instead of a heap. The costs and parents stay in the work
+/// space for `GetLocalCost()` and `RefineLeg()`.
+/// \param work Work space.
+/// \param c Cluster.
+/// \param start Index of start tile, which must be in the cluster.
+/// \param goal Index of goal tile, which must be in the cluster, or
+/// `SIZE_MAX` for none.
+/// \return Cost to the goal, `UINT32_MAX` if it can't be reached, 0 if
+/// there is no goal.
+
+const uint32_t CHierPathFinder::Search(SClusterSearch& work, size_t c, size_t start,
+  size_t goal) const
+{
+  LoadCluster(work, c);
+
+  const int P = (int)m_nClusterSize + 2; //cluster size with a border
+  const bool aim = goal != SIZE_MAX; //whether there is a goal
+  const uint32_t g = aim? GetLocal(c, goal): NONE; //goal in cluster
+  const int gx = (int)(g%P), gy = (int)(g/P); //its column and row
+
+  auto heuristic = [&](uint32_t n){
+    return aim? Octile(n%P, n/P, gx, gy): 0;
+  }; //heuristic
+
+  work.m_nStamp++;
+
+  for(std::vector<uint32_t>& b: work.m_vecBuckets)
+    b.clear();
+
+  const uint32_t s = GetLocal(c, start); //start in cluster
+  work.m_vecCost[s] = 0;
+  work.m_vecParent[s] = s;
+  work.m_vecStamp[s] = work.m_nStamp;
+
+  uint32_t f = heuristic(s); //estimated cost of bucket being emptied
+  work.m_vecBuckets[f%BUCKETS].push_back(s);
+  size_t left = 1; //number of entries in the buckets
+
+  while(left > 0){
+    std::vector<uint32_t>& bucket = work.m_vecBuckets[f%BUCKETS]; //current bucket
+
+    if(bucket.empty()){
+      f++;
+      continue;
+    } //if
+
+    const uint32_t n = bucket.back(); //tile in cluster
+    bucket.pop_back();
+    left--;
+
+    if(work.m_vecCost[n] + heuristic(n) != f)continue; //stale
+    if(n == g)return f;
+
+    for(int k=0; k<8; k++){
+      const uint32_t m = n + DY[k]*P + DX[k]; //neighbor
+      if(!work.m_vecOpen[m])continue;
+      if(k >= 4 && (!work.m_vecOpen[n + DX[k]] || !work.m_vecOpen[n + DY[k]*P]))continue;
+
+      const uint32_t cost = work.m_vecCost[n] + (k >= 4? DIAGONAL: STRAIGHT);
+
+      if(work.m_vecStamp[m] != work.m_nStamp || cost < work.m_vecCost[m]){
+        work.m_vecCost[m] = cost;
+        work.m_vecParent[m] = n;
+        work.m_vecStamp[m] = work.m_nStamp;
+        work.m_vecBuckets[(cost + heuristic(m))%BUCKETS].push_back(m);
+        left++;
+      } //if
+    } //for
+  } //while
+
+  return aim? NONE: 0;
+} //Search
+
+/// Get the cost to a tile found by the last search in a work space.
+/// \param work Work space.
+/// \param c Cluster searched.
+/// \param tile Index of the tile, which must be in the cluster.
+/// \return The cost, `UINT32_MAX` if the search didn't reach it.
+
+const uint32_t CHierPathFinder::GetLocalCost(const SClusterSearch& work, size_t c,
+  size_t tile) const
+{
+  const uint32_t n = GetLocal(c, tile); //tile in cluster
+  return work.m_vecStamp[n] == work.m_nStamp? work.m_vecCost[n]: NONE;
+} //GetLocalCost
+
+/// Reader function for the number of clusters.
+/// \return Number of clusters.
+
+const size_t CHierPathFinder::GetNumClusters() const{
+  return m_nClustersWide*m_nClustersHigh;
+} //GetNumClusters
+
+/// Reader function for the number of nodes.
+/// \return Number of nodes in use.
+
+const size_t CHierPathFinder::GetNumNodes() const{
+  return m_vecNodes.size() - m_vecFree.size();
+} //GetNumNodes
+
+/// Get the number of links, counting each way separately.
+/// \return Number of links across entrances and across clusters.
+
+const size_t CHierPathFinder::GetNumEdges() const{
+  size_t n = GetNumNodes(); //one across an entrance from each node
+
+  for(const SNode& k: m_vecNodes)
+    n += k.m_vecEdges.size();
+
+  return n;
+} //GetNumEdges
+
+/// Reader function for the number of searches.
+/// \return Number of paths asked for.
+
+const size_t CHierPathFinder::GetNumSearches() const{
+  return m_nSearches;
+} //GetNumSearches
+
+/// Reader function for the number of clusters linked again.
+/// \return Number of clusters whose nodes were linked again after tile
+/// changes.
+
+const size_t CHierPathFinder::GetNumRebuilt() const{
+  return m_nRebuilt;
+} //GetNumRebuilt
+
+/// Get the memory used by the map, the nodes and links, and the search
+/// arrays.
+/// \return Size in bytes.
+
+const size_t CHierPathFinder::GetMemory() const{
+  size_t n = sizeof(CHierPathFinder) + m_vecOpen.capacity() +
+    m_vecNodes.capacity()*sizeof(SNode) + m_vecFree.capacity()*sizeof(uint32_t) +
+    (m_vecClusterNodes.capacity() + m_vecBorderNodes.capacity())*sizeof(std::vector<uint32_t>) +
+    m_sSearch.m_vecOpen.capacity() + (m_sSearch.m_vecCost.capacity() +
+    m_sSearch.m_vecParent.capacity() + m_sSearch.m_vecStamp.capacity() +
+    m_vecCost.capacity() + m_vecParent.capacity() + m_vecStamp.capacity() + m_vecHeuristic.capacity() +
+    m_vecToGoal.capacity())*sizeof(uint32_t) + m_vecHeap.capacity()*sizeof(uint64_t);
+
+  for(const SNode& k: m_vecNodes)
+    n += k.m_vecEdges.capacity()*sizeof(SEdge);
+
+  for(const std::vector<uint32_t>& v: m_vecClusterNodes)
+    n += v.capacity()*sizeof(uint32_t);
+
+  for(const std::vector<uint32_t>& v: m_vecBorderNodes)
+    n += v.capacity()*sizeof(uint32_t);
+
+  for(const std::vector<uint32_t>& v: m_sSearch.m_vecBuckets)
+    n += v.capacity()*sizeof(uint32_t);
+
+  return n;
+} //GetMemory
@@ -0,0 +1,111 @@
+/// \file HierPathFinder.h
+/// \brief Interface for the hierarchical path finder CHierPathFinder.
+
+#ifndef __L4RC_GAME_HIERPATHFINDER_H__
+#define __L4RC_GAME_HIERPATHFINDER_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/// \brief The hierarchical path finder.
+///
+/// CHierPathFinder finds paths on maps too big to search tile by tile, using
+/// hierarchical path finding (HPA*). The map is cut into square clusters.
+/// Where open tiles face each other across the border between two clusters
+/// there is an entrance, and each entrance has a pair of nodes, one on
+/// each side, linked by a step. Within a cluster every pair of nodes is
+/// linked by the length of the shortest path between them that stays in the
+/// cluster. All this is made when the map is set, so a query only searches
+/// the small graph of nodes, after joining the start and goal to the nodes
+/// of their clusters. The result is a list of waypoints, and each leg from
+/// one waypoint to the next stays inside one cluster. An agent asks for the
+/// tiles of a leg only when it gets to the start of it. Paths use the same
+/// moves and costs as `CPathFinder`, and are within a few percent of the
+/// shortest. Changing a tile only makes again the entrances on the borders
+/// of its cluster that it is on and the links inside the clusters whose
+/// nodes changed. Making the links is shared between threads. Tiles are
+/// indexed row by row from the top left of the map.
+
+class CHierPathFinder{
+  private:
+    /// \brief A link from one node to another.
+
+    struct SEdge{
+      uint32_t m_nTo = 0; ///< Node at the other end.
+      uint32_t m_nCost = 0; ///< Cost of the path between them.
+    }; //SEdge
+
+    /// \brief A node at one side of an entrance.
+
+    struct SNode{
+      uint32_t m_nTile = UINT32_MAX; ///< Tile, `UINT32_MAX` if the node is free.
+      uint32_t m_nCluster = 0; ///< Cluster it is in.
+      uint32_t m_nPair = 0; ///< Node on the other side of the entrance.
+      std::vector<SEdge> m_vecEdges; ///< Links to the other nodes in its cluster.
+    }; //SNode
+
+    /// \brief Work space for searching one cluster.
+
+    struct SClusterSearch{
+      size_t m_nCluster = SIZE_MAX; ///< Cluster whose tiles are in `m_vecOpen`.
+      std::vector<uint8_t> m_vecOpen; ///< Open tiles of the cluster, with a border of walls.
+      std::vector<uint32_t> m_vecCost; ///< Cost of best path so far to each tile.
+      std::vector<uint32_t> m_vecParent; ///< Previous tile on that path.
+      std::vector<uint32_t> m_vecStamp; ///< Search that the cost and parent belong to.
+      std::vector<std::vector<uint32_t>> m_vecBuckets; ///< Open list, by estimated cost.
+      uint32_t m_nStamp = 0; ///< Current search.
+    }; //SClusterSearch
+
+    size_t m_nWidth = 0; ///< Number of tiles wide.
+    size_t m_nHeight = 0; ///< Number of tiles high.
+    size_t m_nClusterSize = 16; ///< Cluster width and height in tiles.
+    size_t m_nClustersWide = 0; ///< Number of clusters wide.
+    size_t m_nClustersHigh = 0; ///< Number of clusters high.
+    std::vector<uint8_t> m_vecOpen; ///< 1 if a tile is not a wall.
+
+    std::vector<SNode> m_vecNodes; ///< Nodes, some of which may be free.
+    std::vector<uint32_t> m_vecFree; ///< Free nodes.
+    std::vector<std::vector<uint32_t>> m_vecClusterNodes; ///< Nodes in each cluster.
+    std::vector<std::vector<uint32_t>> m_vecBorderNodes; ///< Nodes made for each border, right then below.
+
+    SClusterSearch m_sSearch; ///< Work space for searching clusters.
+
+    std::vector<uint32_t> m_vecCost; ///< Cost of best path so far to each node.
+    std::vector<uint32_t> m_vecParent; ///< Previous node on that path.
+    std::vector<uint32_t> m_vecStamp; ///< Search that the cost and parent belong to.
+    std::vector<uint32_t> m_vecHeuristic; ///< Estimated cost from each node to the goal.
+    std::vector<uint32_t> m_vecToGoal; ///< Cost from each node in the goal's cluster to the goal.
+    uint32_t m_nStamp = 0; ///< Current search of the nodes.
+
+    std::vector<uint64_t> m_vecHeap; ///< Open list of a search of the nodes, estimated cost then node.
+
+    size_t m_nSearches = 0; ///< Number of searches made.
+    size_t m_nRebuilt = 0; ///< Number of clusters linked again after tile changes.
+
+    const size_t GetCluster(size_t) const; ///< Get cluster of a tile.
+    const uint32_t NewNode(size_t, size_t); ///< Make a node.
+    void MakeBorder(size_t, size_t); ///< Make the entrances on a border.
+    void MakeEdges(SClusterSearch&, size_t); ///< Link the nodes in a cluster.
+    void InitSearch(SClusterSearch&) const; ///< Get a work space ready.
+    const uint32_t GetLocal(size_t, size_t) const; ///< Get index of a tile in a work space.
+    void LoadCluster(SClusterSearch&, size_t) const; ///< Copy a cluster's tiles into a work space.
+    const uint32_t Search(SClusterSearch&, size_t, size_t, size_t) const; ///< Search within a cluster.
+    const uint32_t GetLocalCost(const SClusterSearch&, size_t, size_t) const; ///< Get cost to a tile from a search.
+
+  public:
+    void SetMap(const char* const*, size_t, size_t, size_t=16, size_t=0); ///< Use a new map.
+    void SetOpen(size_t, size_t, bool); ///< Change a tile.
+
+    const bool FindPath(size_t, size_t, std::vector<uint32_t>&); ///< Find waypoints.
+    const bool RefineLeg(size_t, size_t, std::vector<uint32_t>&); ///< Find the tiles of a leg.
+
+    const size_t GetNumClusters() const; ///< Get number of clusters.
+    const size_t GetNumNodes() const; ///< Get number of nodes.
+    const size_t GetNumEdges() const; ///< Get number of links.
+    const size_t GetNumSearches() const; ///< Get number of searches made.
+    const size_t GetNumRebuilt() const; ///< Get number of clusters linked again.
+    const size_t GetMemory() const; ///< Get memory used.
+}; //CHierPathFinder
+
+#endif //__L4RC_GAME_HIERPATHFINDER_H__
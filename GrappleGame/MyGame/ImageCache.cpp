@@ -0,0 +1,207 @@
+/// \file ImageCache.cpp
+/// \brief Code for the decoded image cache CImageCache.
+
+#include "ImageCache.h"
+#include "MediaUtil.h"
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+  #include <direct.h>
+  #define MakeFolder(f) _mkdir(f) ///< Make a folder.
+#else
+  #define MakeFolder(f) mkdir(f, 0755) ///< Make a folder.
+#endif
+
+static const char MAGIC[8] = {'I', 'M', 'G', 'C', 'A', 'C', 'H', '1'}; ///< Cache file header.
+
+/// \brief Header of a cache file, followed by the texels.
+
+struct SCacheHeader{
+  char m_cMagic[8] = {0}; ///< Must be `MAGIC`.
+  int64_t m_nTime = 0; ///< Modification time of the image file.
+  int64_t m_nSize = 0; ///< Size of the image file in bytes.
+  uint64_t m_nHash = 0; ///< Hash of the image file contents.
+  int32_t m_nWidth = 0; ///< Width in texels.
+  int32_t m_nHeight = 0; ///< Height in texels.
+}; //SCacheHeader
+
+/// Make the cache folder if there is to be one.
+/// \param folder Cache folder, or an empty string for no cache.
+/// \param threads Maximum number of threads including the caller, 0 for one
+/// per hardware thread.
+
+CImageCache::CImageCache(const char* folder, size_t threads):
+  m_strFolder(FixPath(folder))
+{
+  if(!m_strFolder.empty()){
+    if(m_strFolder.back() == '/')m_strFolder.pop_back();
+    MakeFolder(m_strFolder.c_str()); //fails harmlessly if it's there
+    m_strFolder += "/";
+  } //if
+
+  if(threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+
+  m_nThreads = threads;
+} //constructor
+
+/// Get the name of the cache file for an image, which is a hash of its path.
+/// \param file Image file name.
+/// \return Cache file name.
+
+const std::string CImageCache::GetCacheFile(const std::string& file) const{
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.img",
+    (unsigned long long)HashBytes(file.data(), file.size()));
+
+  return m_strFolder + name;
+} //GetCacheFile
+
+/// Decode one image, using its cache file if it is up to date and writing
+/// the cache file if not. Safe to call on many threads at once for
+/// different images.
+/// \param img [in, out] Image with file name set.
+
+void CImageCache::Decode(SImageData& img){
+  img.m_bLoaded = false;
+
+  struct stat st;
+  if(stat(img.m_strFile.c_str(), &st) != 0)return;
+
+  const std::string cacheFile = m_strFolder.empty()? "": GetCacheFile(img.m_strFile);
+  SCacheHeader header;
+  FILE* cache = cacheFile.empty()? nullptr: fopen(cacheFile.c_str(), "r+b");
+
+  const bool valid = cache && fread(&header, sizeof(header), 1, cache) == 1 &&
+    memcmp(header.m_cMagic, MAGIC, sizeof(MAGIC)) == 0 &&
+    header.m_nWidth > 0 && header.m_nHeight > 0;
+
+  auto ReadTexels = [&](){ //from the cache file, after the header
+    img.m_nWidth = header.m_nWidth;
+    img.m_nHeight = header.m_nHeight;
+    img.m_vecTexels.resize((size_t)img.m_nWidth*img.m_nHeight);
+
+    return fread(img.m_vecTexels.data(), 4, img.m_vecTexels.size(), cache) ==
+      img.m_vecTexels.size();
+  }; //ReadTexels
+
+  //same size and time, no need to look at the image
+
+  if(valid && header.m_nTime == (int64_t)st.st_mtime && header.m_nSize == (int64_t)st.st_size)
+    img.m_bLoaded = ReadTexels();
+
+  //same contents, refresh the time
+
+  std::string contents;
+
+  if(!img.m_bLoaded && ReadFile(img.m_strFile, contents)){
+    const uint64_t hash = HashBytes(contents.data(), contents.size());
+
+    if(valid && header.m_nHash == hash && ReadTexels()){
+      header.m_nTime = (int64_t)st.st_mtime;
+      header.m_nSize = (int64_t)st.st_size;
+      fseek(cache, 0, SEEK_SET);
+      fwrite(&header, sizeof(header), 1, cache);
+      img.m_bLoaded = true;
+    } //if
+
+    //decode and write the cache file
+
+    else if(DecodeImageRGBA(contents.data(), contents.size(), img.m_nWidth,
+      img.m_nHeight, img.m_vecTexels))
+    {
+      img.m_bLoaded = true;
+      m_nMisses++;
+
+      if(cache){
+        fclose(cache);
+        cache = nullptr;
+      } //if
+
+      if(!cacheFile.empty() && (cache = fopen(cacheFile.c_str(), "wb")) != nullptr){
+        memcpy(header.m_cMagic, MAGIC, sizeof(MAGIC));
+        header.m_nTime = (int64_t)st.st_mtime;
+        header.m_nSize = (int64_t)st.st_size;
+        header.m_nHash = hash;
+        header.m_nWidth = img.m_nWidth;
+        header.m_nHeight = img.m_nHeight;
+
+        fwrite(&header, sizeof(header), 1, cache);
+        fwrite(img.m_vecTexels.data(), 4, img.m_vecTexels.size(), cache);
+      } //if
+
+      if(cache)fclose(cache);
+      return;
+    } //else if
+  } //if
+
+  if(img.m_bLoaded)m_nHits++;
+  if(cache)fclose(cache);
+} //Decode
+
+/// Decode a list of images. The caller and up to `m_nThreads - 1` worker
+/// threads take images from the list in turn until none are left, so large
+/// and small images balance out across threads.
+/// \param images [in, out] Images with file names set.
+
+void CImageCache::Decode(std::vector<SImageData>& images){
+  std::atomic<size_t> next{0}; //next image to decode
+
+  auto Work = [&](){
+    for(size_t i=next++; i<images.size(); i=next++)
+      Decode(images[i]);
+  }; //Work
+
+  std::vector<std::thread> workers;
+  const size_t n = std::min(m_nThreads, images.size());
+
+  for(size_t i=1; i<n; i++) //the caller works too
+    workers.emplace_back(Work);
+
+  Work();
+
+  for(std::thread& t: workers)
+    t.join();
+} //Decode
+
+/// Remove the cache files of some images so that they will be decoded again.
+/// \param images Images with file names set.
+
+void CImageCache::Evict(const std::vector<SImageData>& images){
+  if(m_strFolder.empty())return;
+
+  for(const SImageData& img: images)
+    remove(GetCacheFile(img.m_strFile).c_str());
+} //Evict
+
+/// Reader function for the number of threads.
+/// \return Number of threads decoding, including the caller.
+
+const size_t CImageCache::GetThreads() const{
+  return m_nThreads;
+} //GetThreads
+
+/// Reader function for the number of cache hits.
+/// \return Number of images read from the cache since the last reset.
+
+const size_t CImageCache::GetHits() const{
+  return m_nHits;
+} //GetHits
+
+/// Reader function for the number of cache misses.
+/// \return Number of images decoded since the last reset.
+
+const size_t CImageCache::GetMisses() const{
+  return m_nMisses;
+} //GetMisses
+
+/// Reset the hit and miss counts.
+
+void CImageCache::ResetCounts(){
+  m_nHits = m_nMisses = 0;
+} //ResetCounts
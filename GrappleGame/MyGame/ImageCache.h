@@ -0,0 +1,61 @@
+/// \file ImageCache.h
+/// \brief Interface for the decoded image cache CImageCache.
+
+#ifndef __L4RC_GAME_IMAGECACHE_H__
+#define __L4RC_GAME_IMAGECACHE_H__
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <atomic>
+
+/// \brief An image to be decoded.
+///
+/// The name of an image file, filled in with its texels by
+/// `CImageCache::Decode()`.
+
+struct SImageData{
+  std::string m_strFile; ///< Image file name.
+  int m_nWidth = 0; ///< Width in texels.
+  int m_nHeight = 0; ///< Height in texels.
+  std::vector<uint32_t> m_vecTexels; ///< Texels, RGBA, top row first.
+  bool m_bLoaded = false; ///< true if decoded or read from the cache.
+}; //SImageData
+
+/// \brief The decoded image cache.
+///
+/// CImageCache decodes a list of images on a pool of worker threads, one
+/// image at a time per thread, and keeps a copy of each decoded image in a
+/// cache folder so that the next run can read the texels instead of
+/// decoding the PNG again. A cache file is named after a hash of the image's
+/// path and starts with the image's size, modification time, and a hash of
+/// its contents. If the size and time match, the cache file is used without
+/// reading the image. If only the time changed, the image is read and hashed,
+/// and the cache file is used if the hash still matches. Otherwise the image
+/// is decoded and the cache file is written again. With no cache folder the
+/// images are just decoded in parallel.
+
+class CImageCache{
+  private:
+    std::string m_strFolder; ///< Cache folder, empty for no cache.
+    size_t m_nThreads = 1; ///< Number of threads decoding, including the caller.
+
+    std::atomic<size_t> m_nHits{0}; ///< Images read from the cache.
+    std::atomic<size_t> m_nMisses{0}; ///< Images decoded.
+
+    const std::string GetCacheFile(const std::string&) const; ///< Get cache file name.
+    void Decode(SImageData&); ///< Decode one image.
+
+  public:
+    CImageCache(const char* = "", size_t = 0); ///< Constructor.
+
+    void Decode(std::vector<SImageData>&); ///< Decode images in parallel.
+    void Evict(const std::vector<SImageData>&); ///< Remove images from the cache.
+
+    const size_t GetThreads() const; ///< Get number of threads.
+    const size_t GetHits() const; ///< Get number of cache hits.
+    const size_t GetMisses() const; ///< Get number of images decoded.
+    void ResetCounts(); ///< Reset hits and misses.
+}; //CImageCache
+
+#endif //__L4RC_GAME_IMAGECACHE_H__
@@ -0,0 +1,105 @@
+/// \file LevelCache.cpp
+/// \brief Code for the parsed level cache CLevelCache.
+
+#include "LevelCache.h"
+
+/// Construct an empty cache.
+/// \param budget Maximum total size of the levels in bytes.
+
+CLevelCache::CLevelCache(size_t budget):
+  m_nBudget(budget){
+} //constructor
+
+/// Drop the least recently used level.
+
+void CLevelCache::Evict(){
+  const LevelPtr& level = m_listLevels.back();
+  m_nBytes -= level->GetMemory();
+  m_mapLevels.erase(level->GetFile());
+  m_listLevels.pop_back();
+} //Evict
+
+/// Find a level and make it the most recently used one, counting a hit or
+/// a miss.
+/// \param file Name of the map file.
+/// \return The level, or nullptr if it isn't in the cache.
+
+CLevelCache::LevelPtr CLevelCache::Find(const std::string& file){
+  auto i = m_mapLevels.find(file);
+
+  if(i == m_mapLevels.end()){
+    m_nMisses++;
+    return nullptr;
+  } //if
+
+  m_nHits++;
+  m_listLevels.splice(m_listLevels.begin(), m_listLevels, i->second); //to front
+  return *i->second;
+} //Find
+
+/// Check whether a level is in the cache without counting a hit or miss or
+/// changing the order of use.
+/// \param file Name of the map file.
+/// \return true if the level is in the cache.
+
+const bool CLevelCache::Contains(const std::string& file) const{
+  return m_mapLevels.find(file) != m_mapLevels.end();
+} //Contains
+
+/// Add a level as the most recently used one, replacing any level loaded
+/// from the same file, then drop levels from the other end until the cache
+/// is within budget. A level bigger than the whole budget isn't kept.
+/// \param level The level.
+
+void CLevelCache::Insert(const LevelPtr& level){
+  auto i = m_mapLevels.find(level->GetFile());
+
+  if(i != m_mapLevels.end()){ //replace
+    m_nBytes -= (*i->second)->GetMemory();
+    m_listLevels.erase(i->second);
+    m_mapLevels.erase(i);
+  } //if
+
+  m_listLevels.push_front(level);
+  m_mapLevels[level->GetFile()] = m_listLevels.begin();
+  m_nBytes += level->GetMemory();
+
+  while(m_nBytes > m_nBudget && !m_listLevels.empty())
+    Evict();
+} //Insert
+
+/// Drop all levels. The hit and miss counts are kept.
+
+void CLevelCache::Clear(){
+  m_listLevels.clear();
+  m_mapLevels.clear();
+  m_nBytes = 0;
+} //Clear
+
+/// Reader function for the number of levels.
+/// \return Number of levels in the cache.
+
+const size_t CLevelCache::GetSize() const{
+  return m_listLevels.size();
+} //GetSize
+
+/// Reader function for the total size.
+/// \return Total size of the levels in the cache in bytes.
+
+const size_t CLevelCache::GetBytes() const{
+  return m_nBytes;
+} //GetBytes
+
+/// Reader function for the number of hits.
+/// \return Number of finds that found a level.
+
+const size_t CLevelCache::GetHits() const{
+  return m_nHits;
+} //GetHits
+
+/// Reader function for the number of misses.
+/// \return Number of finds that didn't find a level.
+
+const size_t CLevelCache::GetMisses() const{
+  return m_nMisses;
+} //GetMisses
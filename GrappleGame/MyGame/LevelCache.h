@@ -0,0 +1,50 @@
+/// \file LevelCache.h
+/// \brief Interface for the parsed level cache CLevelCache.
+
+#ifndef __L4RC_GAME_LEVELCACHE_H__
+#define __L4RC_GAME_LEVELCACHE_H__
+
+#include <list>
+#include <unordered_map>
+#include <string>
+#include <memory>
+
+#include "LevelData.h"
+
+/// \brief The parsed level cache.
+///
+/// CLevelCache keeps recently played levels in memory so that restarting or
+/// replaying one skips reading and parsing its map file. Levels are kept in
+/// order of last use and the least recently used ones are dropped when the
+/// total size goes over a budget. A level dropped from the cache lives on
+/// for as long as anyone else holds a pointer to it.
+
+class CLevelCache{
+  private:
+    using LevelPtr = std::shared_ptr<const CLevelData>; ///< Pointer to a level.
+
+    std::list<LevelPtr> m_listLevels; ///< Levels, most recently used first.
+    std::unordered_map<std::string, std::list<LevelPtr>::iterator> m_mapLevels; ///< Levels by file name.
+
+    size_t m_nBudget = 0; ///< Maximum total size in bytes.
+    size_t m_nBytes = 0; ///< Total size in bytes.
+    size_t m_nHits = 0; ///< Number of finds that found a level.
+    size_t m_nMisses = 0; ///< Number of finds that didn't.
+
+    void Evict(); ///< Drop the least recently used level.
+
+  public:
+    CLevelCache(size_t); ///< Constructor.
+
+    LevelPtr Find(const std::string&); ///< Find a level and mark it used.
+    const bool Contains(const std::string&) const; ///< Is a level in the cache?
+    void Insert(const LevelPtr&); ///< Add a level.
+    void Clear(); ///< Drop all levels.
+
+    const size_t GetSize() const; ///< Get number of levels.
+    const size_t GetBytes() const; ///< Get total size.
+    const size_t GetHits() const; ///< Get number of hits.
+    const size_t GetMisses() const; ///< Get number of misses.
+}; //CLevelCache
+
+#endif //__L4RC_GAME_LEVELCACHE_H__
@@ -0,0 +1,621 @@
+/// \file LevelData.cpp
+/// \brief Code for the parsed level CLevelData.
+
+#include "LevelData.h"
+#include "MediaUtil.h"
+
+#include <cstdio>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+static const size_t SPAWN_CELL_TILES = 8; ///< Spawn cell width and height in tiles.
+
+/// \brief Glyph to sprite table.
+///
+/// The sprite type of the object spawned by each map glyph, or `eSprite::Size`
+/// for glyphs that are just tiles. It is built at compile time from the list
+/// in the constructor, so a new kind of object needs just one more line
+/// there.
+
+class CGlyphTable{
+  private:
+    eSprite m_eSprite[128]; ///< Sprite type for each 7-bit glyph.
+
+  public:
+    /// Fill in the table.
+
+    constexpr CGlyphTable(): m_eSprite(){
+      for(eSprite& t: m_eSprite)
+        t = eSprite::Size;
+
+      m_eSprite['P'] = eSprite::Standright; //player
+      m_eSprite['T'] = eSprite::Turret;
+      m_eSprite['D'] = eSprite::Door;
+      m_eSprite['I'] = eSprite::Star;
+      m_eSprite['B'] = eSprite::Bat;
+      m_eSprite['V'] = eSprite::Swooper;
+      m_eSprite['H'] = eSprite::HealthPack;
+      m_eSprite['O'] = eSprite::OneUp;
+      m_eSprite['G'] = eSprite::Shotgun;
+      m_eSprite['K'] = eSprite::Creeper;
+    } //constructor
+
+    /// Look up a glyph.
+    /// \param c A map glyph.
+    /// \return Sprite type of the object it spawns, `eSprite::Size` if none.
+
+    constexpr eSprite operator[](char c) const{
+      return (unsigned char)c < 128? m_eSprite[(unsigned char)c]: eSprite::Size;
+    } //operator[]
+}; //CGlyphTable
+
+static constexpr CGlyphTable GLYPHS; ///< The glyph to sprite table.
+
+static_assert(GLYPHS['P'] == eSprite::Standright, "the player must spawn from P");
+static_assert(GLYPHS['W'] == eSprite::Size && GLYPHS['F'] == eSprite::Size,
+  "walls and floors are not objects");
+static_assert(GLYPHS['S'] == eSprite::Size && GLYPHS['L'] == eSprite::Size,
+  "spikes and launch pads are tiles");
+
+/// Get the property flags of a tile from its map glyph.
+/// \param c A map glyph.
+/// \return Its `eTileProp` flags.
+
+static uint8_t GlyphProps(char c){
+  switch(c){
+    case 'S': return (uint8_t)eTileProp::Hazard; //spike
+    case 'L': return (uint8_t)eTileProp::Bounce; //launch pad
+    default:  return (uint8_t)eTileProp::None;
+  } //switch
+} //GlyphProps
+
+/// Make a texel color from red, green, and blue as they would be picked in a
+/// paint program.
+/// \param r Red.
+/// \param g Green.
+/// \param b Blue.
+/// \return The color as it is in a texel from `LoadImageRGBA()`, without alpha.
+
+static constexpr uint32_t MapColor(uint32_t r, uint32_t g, uint32_t b){
+  return r | g << 8 | b << 16;
+} //MapColor
+
+/// \brief Image map palette entry.
+///
+/// The map glyph that a color in an image map stands for.
+
+struct SPaletteEntry{
+  uint32_t m_nColor; ///< Texel color without alpha.
+  char m_chGlyph; ///< Map glyph.
+}; //SPaletteEntry
+
+/// The image map palette. Colors that aren't here are floor.
+
+static constexpr SPaletteEntry PALETTE[] = {
+  {MapColor(  0,   0,   0), 'W'}, //black wall
+  {MapColor(255, 255, 255), 'F'}, //white floor
+  {MapColor(  0,   0, 255), 'P'}, //blue player
+  {MapColor(  0, 255,   0), 'T'}, //green turret
+  {MapColor(255,   0,   0), 'S'}, //red spike
+  {MapColor(128,  64,   0), 'D'}, //brown door
+  {MapColor(255, 255,   0), 'I'}, //yellow star
+  {MapColor(128,   0, 128), 'B'}, //purple bat
+  {MapColor(255,   0, 255), 'V'}, //magenta swooper
+  {MapColor(  0, 255, 255), 'L'}, //cyan launch pad
+  {MapColor(255, 128, 128), 'H'}, //pink health pack
+  {MapColor(  0, 128,   0), 'O'}, //dark green one up
+  {MapColor(128, 128, 128), 'G'}, //gray shotgun
+  {MapColor(128, 128,   0), 'K'}, //olive creeper
+}; //PALETTE
+
+/// Look up a color in the image map palette.
+/// \param color Texel color without alpha.
+/// \return The map glyph for that color.
+
+static char PaletteGlyph(uint32_t color){
+  for(const SPaletteEntry& e: PALETTE)
+    if(e.m_nColor == color)return e.m_chGlyph;
+
+  return 'F';
+} //PaletteGlyph
+
+/// Construct an empty level using square tiles.
+/// \param t Width and height of square tile in pixels.
+/// \param nav Movement profiles to make navigation graphs for when loaded.
+
+CLevelData::CLevelData(float t, const std::vector<SNavProfile>& nav):
+  m_fTileSize(t), m_vecNavProfiles(nav){
+} //constructor
+
+/// Forget any previous level and get ready to load a new one.
+/// \param filename Name of the map file.
+
+void CLevelData::Clear(const char* filename){
+  m_strFile = filename;
+  m_strError.clear();
+  m_bLoaded = false;
+
+  m_nWidth = m_nHeight = 0;
+  m_vecTiles.clear();
+  m_vecRows.clear();
+  m_vecProps.clear();
+  m_nPropTiles = 0;
+
+  m_vecWalls.clear();
+  m_vecSpawns.clear();
+  m_sSpawnCells = SSpawnCells();
+  m_vecNavGraphs.clear();
+} //Clear
+
+/// Allocate the tile grid in one chunk for the current width and height,
+/// and point the row pointers into it.
+
+void CLevelData::MakeRows(){
+  m_vecTiles.assign(m_nWidth*m_nHeight, 'F');
+  m_vecRows.resize(m_nHeight);
+
+  for(size_t i=0; i<m_nHeight; i++)
+    m_vecRows[i] = &m_vecTiles[i*m_nWidth];
+} //MakeRows
+
+/// Make the AABBs for the walls. Care is taken to use the longest horizontal
+/// and vertical AABBs possible so that there aren't so many of them.
+
+void CLevelData::MakeBoundingBoxes(){
+  m_vecWalls.clear(); //no walls yet
+  const char* const* m_chMap = m_vecRows.data(); //the map, row by row
+
+  BoundingBox aabb; //current bounding box
+  const float t = m_fTileSize; //shorthand for tile width and height
+  const Vector3 vTileExtents = 0.5f*t*Vector3::One; //tile extents extended to 3D
+  BoundingBox b; //single-tile bounding box
+  b.Extents = vTileExtents; //bounding box extents cover a single tile
+
+  //horizontal walls with more than one tile
+
+  const Vector2 vstart(t/2, t*(m_nHeight - 0.5f)); //start position
+  Vector2 pos = vstart; //set current position to start position
+  
+  for(size_t i=0; i<m_nHeight; i++){ //for each row
+    size_t j = 0; //column index
+    pos.x = vstart.x; //set start position x coordinate
+
+    while(j < m_nWidth){ //for each column
+      while(j < m_nWidth && m_chMap[i][j] != 'W'){ //skip over non-wall entries
+        j++; //next column
+        pos.x += t; //move right by tile width
+      } //while
+
+      if(j < m_nWidth){ //found leftmost tile in a wall
+        aabb.Center = Vector3(pos.x, pos.y, 0); //bounding box center
+        aabb.Extents = vTileExtents; //bounding box extents
+        j++; //next column
+        pos.x += t; //move right by tile width
+      } //if
+
+      bool bSingleTile = true; //as far as we know, this is a single-tile wall
+
+      while(j < m_nWidth && m_chMap[i][j] == 'W'){ //for each adjacent wall tile
+        b.Center = Vector3(pos.x, pos.y, 0); //bounding box center
+        BoundingBox::CreateMerged(aabb, aabb, b); //merge b into aabb
+        bSingleTile = false; //the wall now has at least 2 tiles in it
+        j++; //next column
+        pos.x += t; //move right by tile width
+      } //while
+
+      if(!bSingleTile) //skip this wall if it is a single tile
+        m_vecWalls.push_back(aabb); //add horizontal wall to the list
+    } //while
+
+    pos.y -= t; //next row
+  } //for
+
+  //vertical walls, the single tiles get caught here
+
+  pos = vstart; //reset current position to start position
+  
+  for(size_t j=0; j<m_nWidth; j++){ //for each column
+    size_t i = 0; //row index
+    pos.y = vstart.y; //set start position y coordinate
+
+    while(i < m_nHeight){ //for each row
+      while(i < m_nHeight && m_chMap[i][j] != 'W'){ //skip over non-wall entries
+        i++; //next row
+        pos.y -= t; //move down by tile height
+      } //while
+
+      if(i < m_nHeight){ //found topmost tile in a wall
+        aabb.Center = Vector3(pos.x, pos.y, 0); //bounding box center
+        aabb.Extents = vTileExtents; //bounding box extents
+        i++; //next row
+        pos.y -= t; //move down by tile height
+      } //if
+      
+      bool bSingleTile = true; //as far as we know, this is a single-tile wall
+
+      while(i < m_nHeight && m_chMap[i][j] == 'W'){ //for each adjacent wall tile
+        b.Center = Vector3(pos.x, pos.y, 0); //bounding box center
+        BoundingBox::CreateMerged(aabb, aabb, b); //merge b into aabb
+        bSingleTile = false; //the wall now has at least 2 tiles in it
+        i++; //next row
+        pos.y -= t; //move down by tile height
+      } //while
+      
+      if(!bSingleTile) //skip this wall if it is a single tile
+        m_vecWalls.push_back(aabb); //add horizontal wall to the list
+    } //while
+
+    pos.x += t; //next column
+  } //for
+
+  //orphaned single tiles
+
+  pos = vstart; //reset current position to start position
+  
+  for(size_t i=0; i<m_nHeight; i++){ //for each row
+    for(size_t j=0; j<m_nWidth; j++){ //for each column
+      if(m_chMap[i][j] == 'W' && //is a wall tile and
+        ((i == 0 || m_chMap[i - 1][j] != 'W') && //has non-wall tile below or is on edge
+         (i == m_nHeight - 1 || m_chMap[i + 1][j] != 'W') && //has non-wall tile above or is on edge
+         (j == 0 || m_chMap[i][j - 1] != 'W') && //has non-wall tile at left or is on edge
+         (j == m_nWidth - 1 || m_chMap[i][j + 1] != 'W') //has non-wall tile at right or is on edge
+        )
+      ){    
+        b.Center = Vector3(pos.x, pos.y, 0); //bounding box center
+        m_vecWalls.push_back(b); //add single-tile wall to the list
+      } //if
+
+      pos.x += t; //next column
+    } //for
+    
+    pos.x = vstart.x; //first column
+    pos.y -= t; //next row
+  } //for
+} //MakeBoundingBoxes
+
+/// Make the tile property flags from the tile glyphs and count the tiles
+/// that have any.
+
+void CLevelData::MakeTileProps(){
+  m_vecProps.resize(m_vecTiles.size());
+  m_nPropTiles = 0;
+
+  for(size_t n=0; n<m_vecTiles.size(); n++){
+    m_vecProps[n] = GlyphProps(m_vecTiles[n]);
+    if(m_vecProps[n] != (uint8_t)eTileProp::None)m_nPropTiles++;
+  } //for
+} //MakeTileProps
+
+/// Make a navigation graph for each movement profile, with the launch pads
+/// and spikes found from the tile property flags.
+
+void CLevelData::MakeNavGraphs(){
+  std::vector<size_t> pads, spikes; //tiles with launch pads and spikes
+
+  if(m_nPropTiles > 0)
+    for(size_t n=0; n<m_vecProps.size(); n++){
+      if(m_vecProps[n] & (uint8_t)eTileProp::Bounce)pads.push_back(n);
+      if(m_vecProps[n] & (uint8_t)eTileProp::Hazard)spikes.push_back(n);
+    } //for
+
+  m_vecNavGraphs.resize(m_vecNavProfiles.size());
+
+  for(size_t k=0; k<m_vecNavProfiles.size(); k++)
+    m_vecNavGraphs[k].Build(m_vecRows.data(), m_nWidth, m_nHeight, m_fTileSize,
+      m_vecNavProfiles[k], pads, spikes);
+} //MakeNavGraphs
+
+/// Sort the spawns other than the player into cells with a counting sort,
+/// keeping them in spawn list order within each cell, and count them by
+/// sprite type. This is done when the level is loaded, possibly on a worker
+/// thread, so that starting the level needn't look at every spawn.
+
+void CLevelData::MakeSpawnCells(){
+  SSpawnCells& c = m_sSpawnCells; //shorthand
+  c.m_fCellSize = SPAWN_CELL_TILES*m_fTileSize;
+  c.m_nWide = std::max<size_t>(1, (m_nWidth + SPAWN_CELL_TILES - 1)/SPAWN_CELL_TILES);
+  c.m_nHigh = std::max<size_t>(1, (m_nHeight + SPAWN_CELL_TILES - 1)/SPAWN_CELL_TILES);
+  c.m_vecFirst.assign(c.m_nWide*c.m_nHigh + 1, 0);
+  c.m_vecCounts.assign((size_t)eSprite::Size + 1, 0);
+
+  const size_t first = !m_vecSpawns.empty() &&
+    m_vecSpawns[0].m_eSprite == eSprite::Standright? 1: 0; //skip player
+  std::vector<uint32_t> cell(m_vecSpawns.size()); //cell of each spawn
+
+  for(size_t i=first; i<m_vecSpawns.size(); i++){
+    const SSpawn& s = m_vecSpawns[i]; //shorthand
+    const size_t x = std::min((size_t)std::max(0.0f, s.m_vPos.x/c.m_fCellSize), c.m_nWide - 1);
+    const size_t y = std::min((size_t)std::max(0.0f, s.m_vPos.y/c.m_fCellSize), c.m_nHigh - 1);
+
+    cell[i] = (uint32_t)(y*c.m_nWide + x);
+    c.m_vecFirst[cell[i] + 1]++;
+    c.m_vecCounts[(size_t)s.m_eSprite]++;
+  } //for
+
+  for(size_t k=1; k<c.m_vecFirst.size(); k++)
+    c.m_vecFirst[k] += c.m_vecFirst[k - 1];
+
+  std::vector<uint32_t> next(c.m_vecFirst.begin(), c.m_vecFirst.end() - 1); //next entry in each cell
+  c.m_vecSpawns.resize(m_vecSpawns.size() - first);
+
+  for(size_t i=first; i<m_vecSpawns.size(); i++)
+    c.m_vecSpawns[next[cell[i]]++] = (uint32_t)i;
+} //MakeSpawnCells
+
+/// Read the level from a text file, one character per tile. Safe to call on
+/// a worker thread.
+/// \param filename Name of the map file.
+/// \return true if the level was loaded.
+
+const bool CLevelData::Load(const char* filename){
+  Clear(filename);
+
+  std::string s; //contents of map file
+
+  if(!ReadFile(filename, s)){
+    m_strError = "Map " + m_strFile + " not found.";
+    return false;
+  } //if
+
+  const char* buffer = s.data(); //shorthand
+  const size_t n = s.size(); //file size in bytes
+
+  //get map width and height into m_nWidth and m_nHeight
+
+  size_t w = 0; //width of current row
+  size_t spawns = 1; //number of objects to spawn, counting the player
+  bool bFirstLine = true;
+
+  for(size_t i=0; i<n; i++){
+    if(buffer[i] != '\n'){
+      w++; //skip characters until the end of line
+      if(GLYPHS[buffer[i]] != eSprite::Size && buffer[i] != 'P')spawns++;
+    } //if
+
+    else{
+      if(w == 0){ //blank line
+        m_strError = "Line " + std::to_string(m_nHeight) + " of map " + m_strFile + " is empty.";
+        return false;
+      } //if
+
+      if(w != m_nWidth && !bFirstLine){ //not the same length as the previous one
+        m_strError = "Line " + std::to_string(m_nHeight) + " of map " + m_strFile +
+          " is not the same length as the previous one.";
+        return false;
+      } //if
+
+      m_nWidth = w; w = 0; m_nHeight++; //next line
+      bFirstLine = false; //the next line is not the first
+    } //else
+  } //for
+
+  MakeRows();
+
+  //load the map information from the buffer to the map, with the player
+  //always first in the spawn list
+
+  m_vecSpawns.reserve(spawns);
+  m_vecSpawns.push_back({eSprite::Standright, Vector2::Zero});
+
+  size_t index = 0; //index into character buffer
+  
+  for(size_t i=0; i<m_nHeight; i++){
+    for(size_t j=0; j<m_nWidth; j++){
+      const char c = buffer[index++]; //map glyph
+      const eSprite t = GLYPHS[c]; //what it spawns, if anything
+
+      if(t == eSprite::Size) //just a tile
+        m_vecTiles[i*m_nWidth + j] = c;
+
+      else{ //an object on a floor tile
+        const Vector2 pos = m_fTileSize*Vector2(j + 0.5f, m_nHeight - i - 0.5f);
+
+        if(c == 'P')m_vecSpawns[0].m_vPos = pos;
+        else m_vecSpawns.push_back({t, pos});
+      } //else
+    } //for
+
+    index += 1; //skip end of line character (assume single linefeed now)
+  } //for
+
+  MakeBoundingBoxes();
+  MakeTileProps();
+  MakeNavGraphs();
+  MakeSpawnCells();
+  return m_bLoaded = true;
+} //Load
+
+/// Read the level from an image file, one texel per tile, with the colors
+/// in `PALETTE` standing for map glyphs. Once the image is decoded its rows
+/// are converted to glyphs in blocks, each thread taking the next block
+/// until there are none left. Each block keeps its own spawn list and the
+/// lists are joined in block order afterwards, so the spawn list comes out
+/// the same as it would on one thread. Safe to call on a worker thread.
+/// \param filename Name of the image file.
+/// \param threads Maximum number of threads including the caller, 0 for one
+/// per hardware thread.
+/// \return true if the level was loaded.
+
+const bool CLevelData::LoadFromImageFile(const char* filename, size_t threads){
+  Clear(filename);
+
+  int w = 0, h = 0; //image width and height
+  std::vector<uint32_t> texels; //image texels, red in the low byte
+
+  if(!LoadImageRGBA(filename, w, h, texels)){
+    m_strError = "Map " + m_strFile + " not found.";
+    return false;
+  } //if
+
+  m_nWidth = (size_t)w;
+  m_nHeight = (size_t)h;
+  MakeRows();
+
+  //convert blocks of rows in parallel
+
+  const size_t BLOCK = 64; //rows per block
+  std::vector<std::vector<SSpawn>> blocks((m_nHeight + BLOCK - 1)/BLOCK); //spawns per block
+  std::atomic<size_t> next{0}; //next block to convert
+
+  auto Work = [&](){
+    for(size_t b=next++; b<blocks.size(); b=next++){
+      const size_t last = std::min(m_nHeight, (b + 1)*BLOCK); //one past last row
+
+      for(size_t i=b*BLOCK; i<last; i++){
+        const uint32_t* src = &texels[i*m_nWidth]; //texel row
+        char* dest = &m_vecTiles[i*m_nWidth]; //tile row
+
+        uint32_t color = 0xFFFFFFFF; //previous color, not a valid one
+        char c = 'F'; //its glyph
+
+        for(size_t j=0; j<m_nWidth; j++){
+          if((src[j] & 0xFFFFFF) != color){ //runs of one color are common
+            color = src[j] & 0xFFFFFF; //ignore alpha
+            c = PaletteGlyph(color);
+          } //if
+
+          const eSprite t = GLYPHS[c]; //what it spawns, if anything
+
+          if(t == eSprite::Size)dest[j] = c; //just a tile
+          else blocks[b].push_back({t, m_fTileSize*Vector2(j + 0.5f, m_nHeight - i - 0.5f)});
+        } //for
+      } //for
+    } //for
+  }; //Work
+
+  if(threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<std::thread> workers;
+  const size_t n = std::min(threads, blocks.size());
+
+  for(size_t i=1; i<n; i++) //the caller works too
+    workers.emplace_back(Work);
+
+  Work();
+
+  for(std::thread& t: workers)
+    t.join();
+
+  //join the spawn lists with the player first
+
+  size_t spawns = 1; //number of objects to spawn, counting the player
+
+  for(const std::vector<SSpawn>& v: blocks)
+    spawns += v.size();
+
+  m_vecSpawns.reserve(spawns);
+  m_vecSpawns.push_back({eSprite::Standright, Vector2::Zero});
+
+  for(const std::vector<SSpawn>& v: blocks)
+    for(const SSpawn& sp: v)
+      if(sp.m_eSprite == eSprite::Standright)m_vecSpawns[0].m_vPos = sp.m_vPos;
+      else m_vecSpawns.push_back(sp);
+
+  MakeBoundingBoxes();
+  MakeTileProps();
+  MakeNavGraphs();
+  MakeSpawnCells();
+  return m_bLoaded = true;
+} //LoadFromImageFile
+
+/// Get the navigation graph for a movement profile.
+/// \param profile How the entity moves.
+/// \return Pointer to the graph, `nullptr` if the level wasn't given that
+/// profile when it was made.
+
+const CNavGraph* CLevelData::GetNavGraph(const SNavProfile& profile) const{
+  for(const CNavGraph& g: m_vecNavGraphs)
+    if(g.GetProfile() == profile)return &g;
+
+  return nullptr;
+} //GetNavGraph
+
+/// Reader function for whether the level was loaded.
+/// \return true if the last load succeeded.
+
+const bool CLevelData::IsLoaded() const{
+  return m_bLoaded;
+} //IsLoaded
+
+/// Reader function for the map file name.
+/// \return Name of the map file last loaded.
+
+const std::string& CLevelData::GetFile() const{
+  return m_strFile;
+} //GetFile
+
+/// Reader function for the error message.
+/// \return Why the last load failed, or an empty string if it didn't.
+
+const std::string& CLevelData::GetError() const{
+  return m_strError;
+} //GetError
+
+/// Reader function for the memory used, which is what the level cache counts
+/// against its budget.
+/// \return Approximate number of bytes used by the level.
+
+const size_t CLevelData::GetMemory() const{
+  size_t nav = m_vecNavProfiles.capacity()*sizeof(SNavProfile) +
+    m_vecNavGraphs.capacity()*sizeof(CNavGraph); //navigation graphs
+
+  for(const CNavGraph& g: m_vecNavGraphs)
+    nav += g.GetMemory();
+
+  return sizeof(CLevelData) + m_strFile.capacity() + m_strError.capacity() +
+    m_vecTiles.capacity() + m_vecRows.capacity()*sizeof(const char*) + m_vecProps.capacity() +
+    m_vecWalls.capacity()*sizeof(BoundingBox) + m_vecSpawns.capacity()*sizeof(SSpawn) +
+    (m_sSpawnCells.m_vecFirst.capacity() + m_sSpawnCells.m_vecSpawns.capacity() +
+    m_sSpawnCells.m_vecCounts.capacity())*sizeof(uint32_t) + nav;
+} //GetMemory
+
+/// Reader function for the width.
+/// \return Number of tiles wide.
+
+const size_t CLevelData::GetWidth() const{
+  return m_nWidth;
+} //GetWidth
+
+/// Reader function for the height.
+/// \return Number of tiles high.
+
+const size_t CLevelData::GetHeight() const{
+  return m_nHeight;
+} //GetHeight
+
+/// Reader function for the walls.
+/// \return The wall AABBs made by `MakeBoundingBoxes()`.
+
+const std::vector<BoundingBox>& CLevelData::GetWalls() const{
+  return m_vecWalls;
+} //GetWalls
+
+/// Reader function for the objects to spawn.
+/// \return The objects listed on the map, the player first.
+
+const std::vector<SSpawn>& CLevelData::GetSpawns() const{
+  return m_vecSpawns;
+} //GetSpawns
+
+/// Reader function for the tile property flags.
+/// \return One byte of `eTileProp` flags per tile, top row first.
+
+const std::vector<uint8_t>& CLevelData::GetTileProps() const{
+  return m_vecProps;
+} //GetTileProps
+
+/// Reader function for the number of tiles with properties.
+/// \return Number of tiles whose property flags aren't all clear.
+
+const size_t CLevelData::GetNumPropTiles() const{
+  return m_nPropTiles;
+} //GetNumPropTiles
+
+/// Reader function for the objects to spawn sorted into cells.
+/// \return The objects other than the player, by cell.
+
+const SSpawnCells& CLevelData::GetSpawnCells() const{
+  return m_sSpawnCells;
+} //GetSpawnCells
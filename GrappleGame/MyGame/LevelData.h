@@ -0,0 +1,115 @@
+/// \file LevelData.h
+/// \brief Interface for the parsed level CLevelData.
+
+#ifndef __L4RC_GAME_LEVELDATA_H__
+#define __L4RC_GAME_LEVELDATA_H__
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "GameDefines.h"
+#include "NavGraph.h"
+
+/// \brief An object to be spawned.
+///
+/// The type and position of an object placed on the map.
+
+struct SSpawn{
+  eSprite m_eSprite = eSprite::Size; ///< Sprite type, which says what kind of object.
+  Vector2 m_vPos; ///< Position.
+}; //SSpawn
+
+/// \brief Tile property flags.
+///
+/// Bit flags for what a tile does to a moving object that touches it. A
+/// level keeps one byte of them per tile, so that spikes and launch pads
+/// are looked up under an object instead of being objects themselves.
+/// Hazard tiles are solid and push objects back, while bounce tiles act as
+/// sensors that only say when an object gets onto them.
+
+enum class eTileProp: uint8_t{
+  None = 0, Hazard = 1, Bounce = 2
+}; //eTileProp
+
+/// \brief Spawns sorted into cells.
+///
+/// The objects on the map other than the player, sorted into square cells
+/// by position, so that the ones in a cell can be found without looking at
+/// the rest. Cells are numbered row by row from the bottom left.
+
+struct SSpawnCells{
+  float m_fCellSize = 0.0f; ///< Cell width and height.
+  size_t m_nWide = 0; ///< Number of cells wide.
+  size_t m_nHigh = 0; ///< Number of cells high.
+  std::vector<uint32_t> m_vecFirst; ///< First entry of each cell in `m_vecSpawns`, and one past the last.
+  std::vector<uint32_t> m_vecSpawns; ///< Indices into the spawn list, cell by cell.
+  std::vector<uint32_t> m_vecCounts; ///< Number of spawns of each sprite type.
+}; //SSpawnCells
+
+/// \brief A parsed level.
+///
+/// CLevelData is everything that comes out of a map file: the tile grid, the
+/// properties of each tile, the wall AABBs, and the objects to be spawned, also sorted into cells so that
+/// the ones near the camera can be found quickly. Loading touches
+/// nothing but the level itself and reports errors through `GetError()`
+/// instead of aborting, so a level can be loaded on a worker thread and
+/// handed to the tile manager when it is finished. A navigation graph is
+/// made for each movement profile given to the constructor as part of the
+/// load, so a level that comes out of the level cache already has them.
+/// Once loaded a level is not changed, so it can be shared between threads
+/// as a pointer to const.
+
+class CLevelData{
+  friend class CTileManager;
+
+  private:
+    std::string m_strFile; ///< Name of the map file.
+    std::string m_strError; ///< Why the load failed, empty if it didn't.
+    bool m_bLoaded = false; ///< true if the load succeeded.
+
+    size_t m_nWidth = 0; ///< Number of tiles wide.
+    size_t m_nHeight = 0; ///< Number of tiles high.
+    float m_fTileSize = 0.0f; ///< Tile width and height.
+
+    std::vector<char> m_vecTiles; ///< Tile characters, top row first.
+    std::vector<const char*> m_vecRows; ///< Pointers to the start of each row.
+    std::vector<uint8_t> m_vecProps; ///< Tile property flags, laid out like the tiles.
+    size_t m_nPropTiles = 0; ///< Number of tiles with properties.
+
+    std::vector<BoundingBox> m_vecWalls; ///< AABBs for the walls.
+    std::vector<SSpawn> m_vecSpawns; ///< Objects to spawn, the player first.
+    SSpawnCells m_sSpawnCells; ///< Objects to spawn other than the player, by cell.
+
+    std::vector<SNavProfile> m_vecNavProfiles; ///< Movement profiles to make navigation graphs for.
+    std::vector<CNavGraph> m_vecNavGraphs; ///< Navigation graphs, one per profile.
+
+    void Clear(const char*); ///< Start again with a new file.
+    void MakeRows(); ///< Allocate the tile grid.
+    void MakeBoundingBoxes(); ///< Make bounding boxes for walls.
+    void MakeTileProps(); ///< Make tile property flags.
+    void MakeNavGraphs(); ///< Make navigation graphs.
+    void MakeSpawnCells(); ///< Sort the spawns into cells.
+
+  public:
+    CLevelData(float, const std::vector<SNavProfile>& = std::vector<SNavProfile>()); ///< Constructor.
+
+    const bool Load(const char*); ///< Load from a text file.
+    const bool LoadFromImageFile(const char*, size_t=0); ///< Load from an image file.
+
+    const bool IsLoaded() const; ///< Was the load successful?
+    const std::string& GetFile() const; ///< Get map file name.
+    const std::string& GetError() const; ///< Get error message.
+    const size_t GetMemory() const; ///< Get memory used.
+
+    const size_t GetWidth() const; ///< Get width in tiles.
+    const size_t GetHeight() const; ///< Get height in tiles.
+    const std::vector<BoundingBox>& GetWalls() const; ///< Get wall AABBs.
+    const std::vector<uint8_t>& GetTileProps() const; ///< Get tile property flags.
+    const size_t GetNumPropTiles() const; ///< Get number of tiles with properties.
+    const std::vector<SSpawn>& GetSpawns() const; ///< Get objects to spawn.
+    const SSpawnCells& GetSpawnCells() const; ///< Get objects to spawn by cell.
+    const CNavGraph* GetNavGraph(const SNavProfile&) const; ///< Get a navigation graph.
+}; //CLevelData
+
+#endif //__L4RC_GAME_LEVELDATA_H__
@@ -0,0 +1,112 @@
+/// \file LevelLoader.cpp
+/// \brief Code for the background level loader CLevelLoader.
+
+#include "LevelLoader.h"
+
+#include <algorithm>
+#include <cctype>
+
+/// Construct a level loader for levels using square tiles.
+/// \param t Width and height of square tile in pixels.
+/// \param budget Level cache size in bytes.
+
+CLevelLoader::CLevelLoader(float t, size_t budget):
+  m_fTileSize(t), m_cCache(budget){
+} //constructor
+
+/// Wait for any preload in progress so that the worker thread doesn't
+/// outlive the loader.
+
+CLevelLoader::~CLevelLoader(){
+  if(m_futPending.valid())
+    m_futPending.wait();
+} //destructor
+
+/// Load a level from a text file, or from an image file if its name ends
+/// in `.png`. This runs on the worker thread for a preload, so it takes
+/// copies of everything it needs.
+/// \param file Name of the map file.
+/// \param t Width and height of square tile in pixels.
+/// \param nav Movement profiles to make navigation graphs for.
+/// \return The level, which reports its own errors.
+
+std::shared_ptr<const CLevelData> CLevelLoader::Load(const std::string& file, float t,
+  const std::vector<SNavProfile>& nav)
+{
+  std::shared_ptr<CLevelData> level = std::make_shared<CLevelData>(t, nav);
+  std::string ext = file.substr(file.size() - std::min<size_t>(4, file.size())); //extension
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+  if(ext == ".png")
+    level->LoadFromImageFile(file.c_str());
+  else level->Load(file.c_str());
+
+  return level;
+} //Load
+
+/// Make a navigation graph for a movement profile in every level loaded
+/// from now on. Levels already in the cache or being preloaded don't get
+/// one, so add all the profiles before the first level is loaded.
+/// \param profile How the entity moves.
+
+void CLevelLoader::AddNavProfile(const SNavProfile& profile){
+  if(std::find(m_vecNavProfiles.begin(), m_vecNavProfiles.end(), profile) == m_vecNavProfiles.end())
+    m_vecNavProfiles.push_back(profile);
+} //AddNavProfile
+
+/// Start loading a level on a worker thread, unless it is already being
+/// preloaded or is in the cache. A preload of a different level that hasn't
+/// been taken is waited for and thrown away.
+/// \param file Name of the map file.
+
+void CLevelLoader::Preload(const char* file){
+  if(m_futPending.valid() && m_strPending == file)return; //already on it
+  if(m_cCache.Contains(file))return; //no need
+
+  if(m_futPending.valid())
+    m_futPending.wait();
+
+  m_strPending = file;
+  m_futPending = std::async(std::launch::async, Load, m_strPending, m_fTileSize,
+    m_vecNavProfiles);
+} //Preload
+
+/// Get a level, from the cache if it is there, from the preload if it is
+/// the one being preloaded, and loading it on this thread if not. A level
+/// that loaded successfully goes into the cache. Check `IsLoaded()` on the
+/// result.
+/// \param file Name of the map file.
+/// \param source [out] Where the level came from.
+/// \return The level.
+
+std::shared_ptr<const CLevelData> CLevelLoader::Take(const char* file, eLevelSource& source){
+  std::shared_ptr<const CLevelData> level = m_cCache.Find(file);
+
+  if(level){
+    source = eLevelSource::Cached;
+    return level;
+  } //if
+
+  if(m_futPending.valid() && m_strPending == file){
+    source = eLevelSource::Preloaded;
+    m_strPending.clear();
+    level = m_futPending.get(); //waits if the worker isn't done yet
+  } //if
+
+  else{
+    source = eLevelSource::Loaded;
+    level = Load(file, m_fTileSize, m_vecNavProfiles);
+  } //else
+
+  if(level->IsLoaded())
+    m_cCache.Insert(level);
+
+  return level;
+} //Take
+
+/// Reader function for the level cache.
+/// \return The level cache, for its size and hit counts.
+
+const CLevelCache& CLevelLoader::GetCache() const{
+  return m_cCache;
+} //GetCache
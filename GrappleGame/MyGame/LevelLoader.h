@@ -0,0 +1,59 @@
+/// \file LevelLoader.h
+/// \brief Interface for the background level loader CLevelLoader.
+
+#ifndef __L4RC_GAME_LEVELLOADER_H__
+#define __L4RC_GAME_LEVELLOADER_H__
+
+#include <string>
+#include <memory>
+#include <future>
+
+#include "LevelData.h"
+#include "LevelCache.h"
+
+/// \brief Where a level came from.
+///
+/// How `CLevelLoader::Take()` got hold of a level.
+
+enum class eLevelSource{
+  Loaded, Preloaded, Cached
+}; //eLevelSource
+
+/// \brief The background level loader.
+///
+/// CLevelLoader parses a level on a worker thread while the current one is
+/// being played. `Preload()` starts the load and `Take()` hands over the
+/// finished level as a shared pointer to const, waiting for the worker if it
+/// isn't done yet. A level that wasn't preloaded is loaded by `Take()` on
+/// the calling thread, leaving any preload in progress alone. Only one
+/// preload is kept at a time. Levels that have been taken go into a level
+/// cache, and a level found there is neither preloaded nor loaded again.
+/// The loader and its cache are to be used from one thread only, the
+/// worker thread sees nothing but the level it is loading. Movement profiles
+/// added with `AddNavProfile()` before the first load get a navigation graph
+/// in every level.
+
+class CLevelLoader{
+  private:
+    float m_fTileSize = 0.0f; ///< Tile width and height.
+    CLevelCache m_cCache; ///< Recently used levels.
+    std::vector<SNavProfile> m_vecNavProfiles; ///< Movement profiles for navigation graphs.
+
+    std::string m_strPending; ///< Name of the map file being preloaded.
+    std::future<std::shared_ptr<const CLevelData>> m_futPending; ///< Level being preloaded.
+
+    static std::shared_ptr<const CLevelData> Load(const std::string&, float,
+      const std::vector<SNavProfile>&); ///< Load a level.
+
+  public:
+    CLevelLoader(float, size_t); ///< Constructor.
+    ~CLevelLoader(); ///< Destructor.
+
+    void AddNavProfile(const SNavProfile&); ///< Make navigation graphs for a profile.
+    void Preload(const char*); ///< Start loading a level in the background.
+    std::shared_ptr<const CLevelData> Take(const char*, eLevelSource&); ///< Get a level.
+
+    const CLevelCache& GetCache() const; ///< Get the level cache.
+}; //CLevelLoader
+
+#endif //__L4RC_GAME_LEVELLOADER_H__
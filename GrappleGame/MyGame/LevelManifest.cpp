@@ -0,0 +1,60 @@
+/// \file LevelManifest.cpp
+/// \brief Code for the level manifest CLevelManifest.
+
+#include "LevelManifest.h"
+#include "MediaUtil.h"
+
+#include <cstdlib>
+
+/// Read the level list from a manifest file, replacing any levels already
+/// there.
+/// \param filename Name of the manifest file.
+/// \return true if the file was read and lists at least one level.
+
+const bool CLevelManifest::Load(const char* filename){
+  m_vecLevels.clear();
+  m_nCacheSize = 0;
+
+  std::string s, tag, value; //file contents, current tag, attribute value
+  if(!ReadFile(filename, s))return false;
+
+  if(GetTag(s, "<levels", tag) && GetAttribute(tag, "cache", value))
+    m_nCacheSize = (size_t)atoi(value.c_str())*1024; //in kilobytes
+
+  for(size_t pos=0; NextTag(s, "<level", pos, tag);){
+    SLevelInfo info;
+    if(!GetAttribute(tag, "file", info.m_strFile))continue;
+    if(!GetAttribute(tag, "name", info.m_strName))info.m_strName = info.m_strFile;
+
+    if(GetAttribute(tag, "text", value)){
+      info.m_bTutorial = value == "tutorial";
+      info.m_bWinner = value == "winner";
+    } //if
+
+    m_vecLevels.push_back(info);
+  } //for
+
+  return !m_vecLevels.empty();
+} //Load
+
+/// Reader function for the number of levels.
+/// \return Number of levels in the manifest.
+
+const size_t CLevelManifest::GetSize() const{
+  return m_vecLevels.size();
+} //GetSize
+
+/// Reader function for a level, wrapping around past the last one.
+/// \param n Level number.
+/// \return Information about level `n` modulo the number of levels.
+
+const SLevelInfo& CLevelManifest::GetLevel(size_t n) const{
+  return m_vecLevels[n%m_vecLevels.size()];
+} //GetLevel
+
+/// Reader function for the level cache size.
+/// \return Level cache size in bytes, 0 if the manifest doesn't say.
+
+const size_t CLevelManifest::GetCacheSize() const{
+  return m_nCacheSize;
+} //GetCacheSize
@@ -0,0 +1,41 @@
+/// \file LevelManifest.h
+/// \brief Interface for the level manifest CLevelManifest.
+
+#ifndef __L4RC_GAME_LEVELMANIFEST_H__
+#define __L4RC_GAME_LEVELMANIFEST_H__
+
+#include <vector>
+#include <string>
+
+/// \brief Level information.
+///
+/// What the manifest says about one level.
+
+struct SLevelInfo{
+  std::string m_strName; ///< Level name.
+  std::string m_strFile; ///< Name of the map file.
+  bool m_bTutorial = false; ///< true to show the controls.
+  bool m_bWinner = false; ///< true if reaching this level wins the game.
+}; //SLevelInfo
+
+/// \brief The level manifest.
+///
+/// CLevelManifest is the list of levels in the order they are played, read
+/// from an XML file such as `Media\Maps\levels.xml` that has a `<level>` tag
+/// for each level with its name, map file, and the text to be shown on it.
+/// The root `<levels>` tag gives the size of the level cache.
+
+class CLevelManifest{
+  private:
+    std::vector<SLevelInfo> m_vecLevels; ///< The levels in order.
+    size_t m_nCacheSize = 0; ///< Level cache size in bytes.
+
+  public:
+    const bool Load(const char*); ///< Load from a file.
+
+    const size_t GetSize() const; ///< Get number of levels.
+    const SLevelInfo& GetLevel(size_t) const; ///< Get a level.
+    const size_t GetCacheSize() const; ///< Get level cache size.
+}; //CLevelManifest
+
+#endif //__L4RC_GAME_LEVELMANIFEST_H__
@@ -0,0 +1,630 @@
+/// \file LosBatch.cpp
+/// \brief Code for the batched line of sight tester CLosBatch.
+
+#include "LosBatch.h"
+
+#include <cmath>
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <atomic>
+#include <thread>
+
+#if defined(_M_X64) || defined(__SSE2__)
+  #include <emmintrin.h>
+  #define LOS_USE_SSE2 ///< Use SSE2 to test four walls at once.
+#endif
+
+static const size_t CHUNK = 64; ///< Number of sorted queries in each piece of work.
+static const size_t MIN_PARALLEL = 512; ///< Smallest batch worth sharing between threads.
+static const size_t SHORT_RANGE = 16; ///< Walls in a column to test without narrowing them down first.
+static const float FAR_AWAY = 1e30f; ///< Position of the walls that pad a group.
+static const size_t MIN_BATCH_WALLS = 512; ///< Fewest walls for which grouping queries beats testing every wall.
+
+/// \brief A triangle ready for testing against walls.
+///
+/// The bounding box of the triangle and, for each edge, its normal and the
+/// extent of the triangle along it. A wall misses the triangle if it is
+/// clear of it along one of these five directions.
+
+struct STriangle{
+  float m_fMinX = 0.0f; ///< Left of bounding box.
+  float m_fMaxX = 0.0f; ///< Right of bounding box.
+  float m_fMinY = 0.0f; ///< Bottom of bounding box.
+  float m_fMaxY = 0.0f; ///< Top of bounding box.
+  float m_fNormX[3] = {0.0f}; ///< Edge normal horizontal components.
+  float m_fNormY[3] = {0.0f}; ///< Edge normal vertical components.
+  float m_fAbsX[3] = {0.0f}; ///< Absolute values of `m_fNormX`.
+  float m_fAbsY[3] = {0.0f}; ///< Absolute values of `m_fNormY`.
+  float m_fLo[3] = {0.0f}; ///< Least extent along each normal.
+  float m_fHi[3] = {0.0f}; ///< Greatest extent along each normal.
+}; //STriangle
+
+/// Get a triangle ready for testing.
+/// \param x Horizontal components of the corners.
+/// \param y Vertical components of the corners.
+/// \param t [out] The triangle.
+
+static void MakeTriangle(const float x[3], const float y[3], STriangle& t){
+  t.m_fMinX = std::min(x[0], std::min(x[1], x[2]));
+  t.m_fMaxX = std::max(x[0], std::max(x[1], x[2]));
+  t.m_fMinY = std::min(y[0], std::min(y[1], y[2]));
+  t.m_fMaxY = std::max(y[0], std::max(y[1], y[2]));
+
+  for(size_t i=0; i<3; i++){
+    const size_t j = (i + 1)%3; //other end of edge
+    const float nx = y[i] - y[j], ny = x[j] - x[i]; //edge normal
+
+    t.m_fNormX[i] = nx;
+    t.m_fNormY[i] = ny;
+    t.m_fAbsX[i] = fabsf(nx);
+    t.m_fAbsY[i] = fabsf(ny);
+
+    float lo = nx*x[0] + ny*y[0], hi = lo; //extent along normal
+
+    for(size_t k=1; k<3; k++){
+      const float d = nx*x[k] + ny*y[k];
+      lo = std::min(lo, d);
+      hi = std::max(hi, d);
+    } //for
+
+    t.m_fLo[i] = lo;
+    t.m_fHi[i] = hi;
+  } //for
+} //MakeTriangle
+
+/// Make the two triangles of a query, from the viewer to each side of the
+/// circle, the same as `CTileManager::Visible()` does.
+/// \param x0 Horizontal position of the viewer.
+/// \param y0 Vertical position of the viewer.
+/// \param x1 Horizontal position of the circle center.
+/// \param y1 Vertical position of the circle center.
+/// \param r Circle radius.
+/// \param t [out] The left and right triangles.
+
+static void MakeTriangles(float x0, float y0, float x1, float y1, float r, STriangle t[2]){
+  float dx = x0 - x1, dy = y0 - y1; //direction from circle to viewer
+  const float len = sqrtf(dx*dx + dy*dy);
+
+  if(len > 0.0f){
+    dx /= len;
+    dy /= len;
+  } //if
+
+  const float nx = -dy, ny = dx; //normal to direction
+  const float s = r - std::min(r, 16.0f); //distance of the inner corners from the center
+
+  const float lx[3] = {x0, x1 + r*nx, x1 + s*nx};
+  const float ly[3] = {y0, y1 + r*ny, y1 + s*ny};
+  MakeTriangle(lx, ly, t[0]);
+
+  const float rx[3] = {x0, x1 - r*nx, x1 - s*nx};
+  const float ry[3] = {y0, y1 - r*ny, y1 - s*ny};
+  MakeTriangle(rx, ry, t[1]);
+} //MakeTriangles
+
+/// Check whether a wall is clear of a triangle. Walls that touch the
+/// triangle are not clear of it.
+/// \param t Triangle.
+/// \param left Left edge of wall.
+/// \param bottom Bottom edge of wall.
+/// \param right Right edge of wall.
+/// \param top Top edge of wall.
+/// \return true if the wall misses the triangle.
+
+static bool Separated(const STriangle& t, float left, float bottom, float right, float top){
+  if(left > t.m_fMaxX || right < t.m_fMinX || bottom > t.m_fMaxY || top < t.m_fMinY)
+    return true;
+
+  const float x = 0.5f*(left + right), y = 0.5f*(bottom + top); //center
+  const float w = 0.5f*(right - left), h = 0.5f*(top - bottom); //half extents
+
+  for(size_t i=0; i<3; i++){
+    const float d = t.m_fNormX[i]*x + t.m_fNormY[i]*y; //wall center along normal
+    const float e = t.m_fAbsX[i]*w + t.m_fAbsY[i]*h; //wall extent along normal
+    if(d - e > t.m_fHi[i] || d + e < t.m_fLo[i])return true;
+  } //for
+
+  return false;
+} //Separated
+
+/// Find which of four walls block a query, that is, overlap both of its
+/// triangles. A wall can only do that if it reaches into the horizontal and
+/// vertical extents of both triangles, and since most walls near a query
+/// miss it by a long way that is tested first.
+/// \param left Left edges of the walls.
+/// \param bottom Bottom edges of the walls.
+/// \param right Right edges of the walls.
+/// \param top Top edges of the walls.
+/// \param box Left, right, bottom, and top of the overlap of the triangles' bounding boxes.
+/// \param t The query's two triangles.
+/// \return A bit for each wall, set if it blocks.
+
+static int Blocks4(const float* left, const float* bottom, const float* right, const float* top,
+  const float box[4], const STriangle t[2])
+{
+  #ifdef LOS_USE_SSE2
+    const __m128 l = _mm_loadu_ps(left), b = _mm_loadu_ps(bottom);
+    const __m128 r = _mm_loadu_ps(right), u = _mm_loadu_ps(top);
+
+    __m128 sep = _mm_or_ps( //set where a wall misses a triangle
+      _mm_or_ps(_mm_cmpgt_ps(l, _mm_set1_ps(box[1])), _mm_cmplt_ps(r, _mm_set1_ps(box[0]))),
+      _mm_or_ps(_mm_cmpgt_ps(b, _mm_set1_ps(box[3])), _mm_cmplt_ps(u, _mm_set1_ps(box[2]))));
+
+    if(_mm_movemask_ps(sep) == 15)return 0; //all miss
+
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 cx = _mm_mul_ps(half, _mm_add_ps(l, r)), cy = _mm_mul_ps(half, _mm_add_ps(b, u));
+    const __m128 hw = _mm_mul_ps(half, _mm_sub_ps(r, l)), hh = _mm_mul_ps(half, _mm_sub_ps(u, b));
+
+    for(size_t k=0; k<2; k++) //edge normals
+      for(size_t i=0; i<3; i++){
+        const STriangle& tk = t[k]; //shorthand
+
+        const __m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(tk.m_fNormX[i]), cx),
+          _mm_mul_ps(_mm_set1_ps(tk.m_fNormY[i]), cy));
+        const __m128 e = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(tk.m_fAbsX[i]), hw),
+          _mm_mul_ps(_mm_set1_ps(tk.m_fAbsY[i]), hh));
+
+        sep = _mm_or_ps(sep, _mm_or_ps(
+          _mm_cmpgt_ps(_mm_sub_ps(d, e), _mm_set1_ps(tk.m_fHi[i])),
+          _mm_cmplt_ps(_mm_add_ps(d, e), _mm_set1_ps(tk.m_fLo[i]))));
+      } //for
+
+    return 15 & ~_mm_movemask_ps(sep);
+  #else
+    int block = 0; //result
+
+    for(int i=0; i<4; i++)
+      if(left[i] <= box[1] && right[i] >= box[0] && bottom[i] <= box[3] && top[i] >= box[2] &&
+        !Separated(t[0], left[i], bottom[i], right[i], top[i]) &&
+        !Separated(t[1], left[i], bottom[i], right[i], top[i]))
+        block |= 1 << i;
+
+    return block;
+  #endif //LOS_USE_SSE2
+} //Blocks4
+
+/// Remove all walls.
+
+void CLosBatch::SWalls::clear(){
+  m_vecLeft.clear();
+  m_vecBottom.clear();
+  m_vecRight.clear();
+  m_vecTop.clear();
+} //clear
+
+/// Add a wall.
+/// \param left Left edge.
+/// \param bottom Bottom edge.
+/// \param right Right edge.
+/// \param top Top edge.
+
+void CLosBatch::SWalls::push_back(float left, float bottom, float right, float top){
+  m_vecLeft.push_back(left);
+  m_vecBottom.push_back(bottom);
+  m_vecRight.push_back(right);
+  m_vecTop.push_back(top);
+} //push_back
+
+/// Reader function for the number of walls.
+/// \return Number of walls.
+
+const size_t CLosBatch::SWalls::size() const{
+  return m_vecLeft.size();
+} //size
+
+/// Construct a tester with no walls and no queries.
+/// \param width Width of the columns that the walls are sorted into, for
+/// which 16 tiles works well.
+
+CLosBatch::CLosBatch(float width):
+  m_fColumnWidth(std::max(1.0f, width)){
+} //constructor
+
+/// Remove all walls.
+
+void CLosBatch::ClearWalls(){
+  m_sWalls.clear();
+  m_bGridMade = false;
+} //ClearWalls
+
+/// Add a wall. It goes into the columns the next time that queries are
+/// answered.
+/// \param left Left edge.
+/// \param bottom Bottom edge.
+/// \param right Right edge.
+/// \param top Top edge.
+
+void CLosBatch::AddWall(float left, float bottom, float right, float top){
+  m_sWalls.push_back(left, bottom, right, top);
+  m_bGridMade = false;
+} //AddWall
+
+/// Get the column that a horizontal position is in.
+/// \param x Horizontal position.
+/// \return Column index.
+
+const int CLosBatch::GetColumn(float x) const{
+  return (int)floorf(x/m_fColumnWidth);
+} //GetColumn
+
+/// Sort the walls into columns. A wall that crosses into other columns
+/// goes into each of them whole, since a wall blocks a query only if it
+/// overlaps both of its triangles, and two pieces of a wall could each
+/// overlap only one of them. The walls in each column are sorted by bottom
+/// edge and padded to a multiple of 4 with walls that are far away.
+
+void CLosBatch::MakeGrid(){
+  std::vector<std::pair<int, uint32_t>> bin; //column and wall pairs
+  m_fMaxHeight = 0.0f;
+
+  for(size_t k=0; k<m_sWalls.size(); k++){
+    const float left = m_sWalls.m_vecLeft[k], right = m_sWalls.m_vecRight[k]; //horizontal extent
+    m_fMaxHeight = std::max(m_fMaxHeight, m_sWalls.m_vecTop[k] - m_sWalls.m_vecBottom[k]);
+
+    for(int c=GetColumn(left); c<=GetColumn(right); c++)
+      bin.push_back({c, (uint32_t)k});
+  } //for
+
+  std::sort(bin.begin(), bin.end(), [&](const std::pair<int, uint32_t>& a,
+    const std::pair<int, uint32_t>& b)
+  {
+    if(a.first != b.first)return a.first < b.first;
+    return m_sWalls.m_vecBottom[a.second] < m_sWalls.m_vecBottom[b.second];
+  }); //sort
+
+  m_sGrid.clear();
+  m_vecColumnFirst.clear();
+  m_nColumn = bin.empty()? 0: bin.front().first;
+  m_nColumns = bin.empty()? 0: (size_t)(bin.back().first - m_nColumn + 1);
+
+  size_t n = 0; //next in bin
+
+  for(size_t c=0; c<m_nColumns; c++){
+    const size_t first = m_sGrid.size(); //first in column
+    m_vecColumnFirst.push_back(first);
+
+    for(; n<bin.size() && bin[n].first == m_nColumn + (int)c; n++){
+      const uint32_t i = bin[n].second; //wall index
+      m_sGrid.push_back(m_sWalls.m_vecLeft[i], m_sWalls.m_vecBottom[i], m_sWalls.m_vecRight[i], m_sWalls.m_vecTop[i]);
+    } //for
+
+    while((m_sGrid.size() - first)%4 != 0)
+      m_sGrid.push_back(FAR_AWAY, FAR_AWAY, FAR_AWAY, FAR_AWAY);
+  } //for
+
+  m_vecColumnFirst.push_back(m_sGrid.size());
+  m_bGridMade = true;
+} //MakeGrid
+
+/// Get the walls of a column whose bottom edges are in a range, rounded out
+/// to whole groups of four.
+/// \param first First wall in the grid to look at, at the start of a group of four.
+/// \param last One past the last wall to look at, at the end of a group of four.
+/// \param lo Lowest bottom edge.
+/// \param hi Highest bottom edge.
+/// \return First wall and one past the last wall.
+
+const std::pair<size_t, size_t> CLosBatch::GetRange(size_t first, size_t last,
+  float lo, float hi) const
+{
+  const float* bottom = m_sGrid.m_vecBottom.data(); //shorthand
+  const size_t i0 = std::lower_bound(bottom + first, bottom + last, lo) - bottom; //first in range
+  const size_t i1 = std::upper_bound(bottom + i0, bottom + last, hi) - bottom; //one past the last
+
+  return {first + ((i0 - first) & ~(size_t)3), std::min(last, first + ((i1 - first + 3) & ~(size_t)3))};
+} //GetRange
+
+/// Remove all queries, ready for the next frame.
+
+void CLosBatch::Clear(){
+  m_vecQueries.clear();
+  m_vecResult.clear();
+} //Clear
+
+/// Add a query, which is answered by the next call to `Evaluate()`.
+/// \param x0 Horizontal position of the viewer.
+/// \param y0 Vertical position of the viewer.
+/// \param x1 Horizontal position of the circle center.
+/// \param y1 Vertical position of the circle center.
+/// \param r Circle radius.
+/// \return Index of the query, for getting the answer.
+
+const size_t CLosBatch::Add(float x0, float y0, float x1, float y1, float r){
+  SQuery q;
+  q.m_fFromX = x0;
+  q.m_fFromY = y0;
+  q.m_fToX = x1;
+  q.m_fToY = y1;
+  q.m_fRadius = r;
+
+  m_vecQueries.push_back(q);
+  return m_vecQueries.size() - 1;
+} //Add
+
+/// Work out which walls may block the queries of a group, which are those
+/// under the box that takes in the circle and all of the viewers. That is a
+/// range of walls in each column under the box, found once for all of the
+/// queries in the group.
+/// \param k0 First query of the group in `m_vecOrder`.
+/// \param k1 One past its last query in `m_vecOrder`.
+
+void CLosBatch::MakeGroup(size_t k0, size_t k1){
+  const SQuery& q = m_vecQueries[m_vecOrder[k0]]; //shorthand
+
+  float minx = q.m_fToX - q.m_fRadius, maxx = q.m_fToX + q.m_fRadius; //horizontal extent
+  float miny = q.m_fToY - q.m_fRadius, maxy = q.m_fToY + q.m_fRadius; //vertical extent
+
+  for(size_t k=k0; k<k1; k++){
+    const SQuery& p = m_vecQueries[m_vecOrder[k]]; //shorthand
+    minx = std::min(minx, p.m_fFromX);
+    maxx = std::max(maxx, p.m_fFromX);
+    miny = std::min(miny, p.m_fFromY);
+    maxy = std::max(maxy, p.m_fFromY);
+  } //for
+
+  SGroup g;
+  g.m_nFirstRange = m_vecRanges.size();
+  g.m_nColumn = std::max(m_nColumn, GetColumn(minx));
+  const int last = std::min(m_nColumn + (int)m_nColumns - 1, GetColumn(maxx)); //last column
+
+  for(int c=g.m_nColumn; c<=last; c++){
+    const size_t k = (size_t)(c - m_nColumn); //index of column
+    m_vecRanges.push_back(GetRange(m_vecColumnFirst[k], m_vecColumnFirst[k + 1],
+      miny - m_fMaxHeight, maxy));
+  } //for
+
+  g.m_nColumns = m_vecRanges.size() - g.m_nFirstRange;
+  m_vecGroups.push_back(g);
+} //MakeGroup
+
+/// Answer a query. The triangles lie within the radius of the line from
+/// the viewer to the circle center, so in each column under them only the
+/// walls near where that line crosses the column are tested, four at a time.
+/// \param q The query.
+/// \param g Its group.
+/// \param tests [in, out] Number of query-wall tests made.
+/// \return true if the circle is visible.
+
+const bool CLosBatch::TestQuery(const SQuery& q, const SGroup& g, size_t& tests) const{
+  STriangle t[2]; //left and right triangles
+  MakeTriangles(q.m_fFromX, q.m_fFromY, q.m_fToX, q.m_fToY, q.m_fRadius, t);
+
+  const float box[4] = { //overlap of bounding boxes
+    std::max(t[0].m_fMinX, t[1].m_fMinX), std::min(t[0].m_fMaxX, t[1].m_fMaxX),
+    std::max(t[0].m_fMinY, t[1].m_fMinY), std::min(t[0].m_fMaxY, t[1].m_fMaxY)
+  }; //box
+
+  if(box[0] > box[1] || box[2] > box[3])return true; //no wall can overlap both
+
+  const float x0 = q.m_fFromX, y0 = q.m_fFromY; //viewer
+  const float dx = q.m_fToX - x0, dy = q.m_fToY - y0; //viewer to circle center
+  const float r = q.m_fRadius; //radius
+  const float slope = dx != 0.0f? dy/dx: 0.0f; //change in height across
+
+  const int c0 = std::max(g.m_nColumn, GetColumn(box[0])); //first column
+  const int c1 = std::min(g.m_nColumn + (int)g.m_nColumns - 1, GetColumn(box[1])); //last column
+
+  const float* left = m_sGrid.m_vecLeft.data();
+  const float* bottom = m_sGrid.m_vecBottom.data();
+  const float* right = m_sGrid.m_vecRight.data();
+  const float* top = m_sGrid.m_vecTop.data();
+
+  for(int c=c0; c<=c1; c++){
+    float ya = y0, yb = y0 + dy; //vertical extent of the line in the column
+
+    if(dx != 0.0f){ //clamp the column, widened by the radius, to the line
+      const float xa = std::min(std::max(c*m_fColumnWidth - r, std::min(x0, x0 + dx)), std::max(x0, x0 + dx));
+      const float xb = std::min(std::max((c + 1)*m_fColumnWidth + r, std::min(x0, x0 + dx)), std::max(x0, x0 + dx));
+      ya = y0 + (xa - x0)*slope;
+      yb = y0 + (xb - x0)*slope;
+    } //if
+
+    const std::pair<size_t, size_t>& column = m_vecRanges[g.m_nFirstRange + (size_t)(c - g.m_nColumn)];
+    std::pair<size_t, size_t> range = column; //walls to test
+
+    if(column.second - column.first > SHORT_RANGE)
+      range = GetRange(column.first, column.second, std::min(ya, yb) - r - m_fMaxHeight,
+        std::max(ya, yb) + r);
+
+    for(size_t i=range.first; i<range.second; i+=4){
+      tests += 4;
+      if(Blocks4(left + i, bottom + i, right + i, top + i, box, t))return false;
+    } //for
+  } //for
+
+  return true;
+} //TestQuery
+
+/// Answer all of the queries added since the last call to `Clear()`. The
+/// queries are grouped by target, which is usually the same as for the
+/// query before, and put in order of group. The walls for each target are
+/// found once for all of its queries. Then the queries are tested in chunks,
+/// shared between threads if there are enough of them. The columns are made
+/// first if the walls have changed, even if there are no queries. With
+/// fewer than `MIN_BATCH_WALLS` walls, which takes in every level that
+/// ships with the game, grouping and narrowing down the walls costs more
+/// than it saves, so each query is tested against every wall instead, as
+/// `Test()` does.
+/// \param threads Number of threads, or 0 to use one per core.
+
+void CLosBatch::Evaluate(size_t threads){
+  const size_t n = m_vecQueries.size(); //number of queries
+  m_vecResult.assign(n, 1);
+  m_vecGroups.clear();
+  m_vecRanges.clear();
+  m_nTests = 0;
+
+  if(!m_bGridMade)MakeGrid();
+  if(n == 0)return;
+
+  if(IsDirect()){ //test every wall
+    for(size_t i=0; i<n; i++)
+      m_vecResult[i] = TestAll(m_vecQueries[i], m_nTests)? 1: 0;
+
+    return;
+  } //if
+
+  //group by target
+
+  std::map<std::tuple<float, float, float>, uint32_t> targets; //group of each target
+  m_vecGroupOf.resize(n);
+
+  for(size_t i=0; i<n; i++){
+    const SQuery& q = m_vecQueries[i]; //shorthand
+    const SQuery* p = i > 0? &m_vecQueries[i - 1]: nullptr; //previous query
+
+    if(p && p->m_fToX == q.m_fToX && p->m_fToY == q.m_fToY && p->m_fRadius == q.m_fRadius)
+      m_vecGroupOf[i] = m_vecGroupOf[i - 1];
+
+    else m_vecGroupOf[i] = targets.emplace(std::make_tuple(q.m_fToX, q.m_fToY, q.m_fRadius),
+      (uint32_t)targets.size()).first->second;
+  } //for
+
+  //put in order of group
+
+  std::vector<size_t> first(targets.size() + 1, 0); //first query of each group in order
+
+  for(size_t i=0; i<n; i++)
+    first[m_vecGroupOf[i] + 1]++;
+
+  for(size_t g=1; g<first.size(); g++)
+    first[g] += first[g - 1];
+
+  std::vector<size_t> place(first); //where the next query of each group goes
+  m_vecOrder.resize(n);
+
+  for(size_t i=0; i<n; i++)
+    m_vecOrder[place[m_vecGroupOf[i]]++] = (uint32_t)i;
+
+  for(size_t g=0; g<targets.size(); g++)
+    MakeGroup(first[g], first[g + 1]);
+
+  //test in chunks
+
+  std::atomic<size_t> next{0}; //next chunk
+  std::atomic<size_t> tests{0}; //number of query-wall tests
+
+  auto Work = [&](){
+    size_t count = 0; //tests made by this thread
+
+    for(size_t c=next++; c*CHUNK<n; c=next++)
+      for(size_t k=c*CHUNK; k<std::min(n, (c + 1)*CHUNK); k++){
+        const uint32_t i = m_vecOrder[k]; //query index
+        m_vecResult[i] = TestQuery(m_vecQueries[i], m_vecGroups[m_vecGroupOf[i]], count)? 1: 0;
+      } //for
+
+    tests += count;
+  }; //Work
+
+  if(n < MIN_PARALLEL)threads = 1;
+  else if(threads == 0)threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min(threads, (n + CHUNK - 1)/CHUNK);
+
+  std::vector<std::thread> workers; //the caller works too
+
+  for(size_t i=1; i<threads; i++)
+    workers.emplace_back(Work);
+
+  Work();
+
+  for(std::thread& t: workers)
+    t.join();
+
+  m_nTests = tests;
+} //Evaluate
+
+/// Reader function for the answer to a query made by the last call to
+/// `Evaluate()`.
+/// \param i Index of the query returned by `Add()`.
+/// \return true if the circle is visible, false if not or there is no such query.
+
+const bool CLosBatch::GetResult(size_t i) const{
+  return i < m_vecResult.size() && m_vecResult[i] != 0;
+} //GetResult
+
+/// Answer a query by testing every wall one at a time, which is what
+/// `CTileManager::Visible()` does.
+/// \param q The query.
+/// \param tests [in, out] Number of query-wall tests made.
+/// \return true if the circle is visible.
+
+const bool CLosBatch::TestAll(const SQuery& q, size_t& tests) const{
+  STriangle t[2]; //left and right triangles
+  MakeTriangles(q.m_fFromX, q.m_fFromY, q.m_fToX, q.m_fToY, q.m_fRadius, t);
+
+  for(size_t i=0; i<m_sWalls.size(); i++){
+    const float l = m_sWalls.m_vecLeft[i], b = m_sWalls.m_vecBottom[i]; //bottom left corner
+    const float r = m_sWalls.m_vecRight[i], u = m_sWalls.m_vecTop[i]; //top right corner
+    tests++;
+    if(!Separated(t[0], l, b, r, u) && !Separated(t[1], l, b, r, u))return false;
+  } //for
+
+  return true;
+} //TestAll
+
+/// Answer one query now by testing every wall one at a time.
+/// \param x0 Horizontal position of the viewer.
+/// \param y0 Vertical position of the viewer.
+/// \param x1 Horizontal position of the circle center.
+/// \param y1 Vertical position of the circle center.
+/// \param r Circle radius.
+/// \return true if the circle is visible.
+
+const bool CLosBatch::Test(float x0, float y0, float x1, float y1, float r) const{
+  SQuery q;
+  q.m_fFromX = x0;
+  q.m_fFromY = y0;
+  q.m_fToX = x1;
+  q.m_fToY = y1;
+  q.m_fRadius = r;
+
+  size_t tests = 0; //not wanted
+  return TestAll(q, tests);
+} //Test
+
+/// Reader function for whether `Evaluate()` tests every wall for each query
+/// instead of grouping them, which it does when there are few walls.
+/// \return true if queries are tested against every wall.
+
+const bool CLosBatch::IsDirect() const{
+  return m_sWalls.size() < MIN_BATCH_WALLS;
+} //IsDirect
+
+/// Reader function for the number of queries.
+/// \return Number of queries added since the last call to `Clear()`.
+
+const size_t CLosBatch::GetNumQueries() const{
+  return m_vecQueries.size();
+} //GetNumQueries
+
+/// Reader function for the number of targets in the last batch.
+/// \return Number of groups of queries with the same target.
+
+const size_t CLosBatch::GetNumGroups() const{
+  return m_vecGroups.size();
+} //GetNumGroups
+
+/// Reader function for the number of query-wall tests in the last batch.
+/// \return Number of query-wall tests made, counting four for each group of four.
+
+const size_t CLosBatch::GetNumTests() const{
+  return m_nTests;
+} //GetNumTests
+
+/// Reader function for the number of walls.
+/// \return Number of walls added.
+
+const size_t CLosBatch::GetNumWalls() const{
+  return m_sWalls.size();
+} //GetNumWalls
+
+/// Reader function for the number of walls in the columns, which counts the
+/// walls that are in more than one column once for each of them, and the
+/// padding. It is 0 until the first batch after the walls change.
+/// \return Number of walls in the columns.
+
+const size_t CLosBatch::GetGridSize() const{
+  return m_sGrid.size();
+} //GetGridSize
@@ -0,0 +1,108 @@
+/// \file LosBatch.h
+/// \brief Interface for the batched line of sight tester CLosBatch.
+
+#ifndef __L4RC_GAME_LOSBATCH_H__
+#define __L4RC_GAME_LOSBATCH_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+/// \brief The batched line of sight tester.
+///
+/// CLosBatch answers a frame's worth of line of sight queries together
+/// instead of one at a time. A query asks whether a circle can be seen from
+/// a point, using the same test as `CTileManager::Visible()`: a thin
+/// triangle runs from the point to each side of the circle, and the circle
+/// is hidden only if some wall overlaps both triangles. Queries are grouped
+/// by target, and for each target the walls that may be in the way of any
+/// of its shooters are found once and shared by all of them. The walls are
+/// sorted into columns, whole, and by height within each column, so a
+/// query only looks at the walls along the line from its viewer to the
+/// target. These are tested four at a time with SSE2 where it is
+/// available. Big batches are shared between threads. On levels with few
+/// walls that costs more than it saves, so then each query is simply
+/// tested against every wall. Positions are in pixels with y up, as in the
+/// game.
+
+class CLosBatch{
+  private:
+    /// \brief A line of sight query.
+
+    struct SQuery{
+      float m_fFromX = 0.0f; ///< Horizontal position of the viewer.
+      float m_fFromY = 0.0f; ///< Vertical position of the viewer.
+      float m_fToX = 0.0f; ///< Horizontal position of the circle center.
+      float m_fToY = 0.0f; ///< Vertical position of the circle center.
+      float m_fRadius = 0.0f; ///< Circle radius.
+    }; //SQuery
+
+    /// \brief Walls stored one array per coordinate.
+
+    struct SWalls{
+      std::vector<float> m_vecLeft; ///< Left edges.
+      std::vector<float> m_vecBottom; ///< Bottom edges.
+      std::vector<float> m_vecRight; ///< Right edges.
+      std::vector<float> m_vecTop; ///< Top edges.
+
+      void clear(); ///< Remove all walls.
+      void push_back(float, float, float, float); ///< Add a wall.
+      const size_t size() const; ///< Get number of walls.
+    }; //SWalls
+
+    /// \brief Queries that share a target.
+
+    struct SGroup{
+      int m_nColumn = 0; ///< First column under the group.
+      size_t m_nColumns = 0; ///< Number of columns under the group.
+      size_t m_nFirstRange = 0; ///< Index in `m_vecRanges` of the first column's walls.
+    }; //SGroup
+
+    float m_fColumnWidth = 1024.0f; ///< Column width.
+    SWalls m_sWalls; ///< Walls as they were added.
+
+    SWalls m_sGrid; ///< Walls, column by column.
+    std::vector<size_t> m_vecColumnFirst; ///< First wall of each column in the grid, and one past the last.
+    int m_nColumn = 0; ///< First column.
+    size_t m_nColumns = 0; ///< Number of columns.
+    float m_fMaxHeight = 0.0f; ///< Height of the highest wall.
+    bool m_bGridMade = true; ///< Whether the grid is up to date with the walls.
+
+    std::vector<SQuery> m_vecQueries; ///< Queries in the order they were added.
+    std::vector<uint8_t> m_vecResult; ///< 1 for each query that is visible.
+    std::vector<uint32_t> m_vecOrder; ///< Queries in order of group.
+    std::vector<uint32_t> m_vecGroupOf; ///< Group of each query.
+    std::vector<SGroup> m_vecGroups; ///< Groups of queries with the same target.
+    std::vector<std::pair<size_t, size_t>> m_vecRanges; ///< Walls in each column under each group.
+
+    size_t m_nTests = 0; ///< Number of query-wall tests made.
+
+    const int GetColumn(float) const; ///< Get column at horizontal position.
+    void MakeGrid(); ///< Sort the walls into columns.
+    const std::pair<size_t, size_t> GetRange(size_t, size_t, float, float) const; ///< Get walls in a column.
+    void MakeGroup(size_t, size_t); ///< Pick out the walls for a group.
+    const bool TestQuery(const SQuery&, const SGroup&, size_t&) const; ///< Answer a query.
+    const bool TestAll(const SQuery&, size_t&) const; ///< Answer a query against every wall.
+
+  public:
+    CLosBatch(float=1024.0f); ///< Constructor.
+
+    void ClearWalls(); ///< Remove all walls.
+    void AddWall(float, float, float, float); ///< Add a wall.
+
+    void Clear(); ///< Remove all queries.
+    const size_t Add(float, float, float, float, float); ///< Add a query.
+    void Evaluate(size_t=0); ///< Answer all queries.
+    const bool GetResult(size_t) const; ///< Get the answer to a query.
+    const bool Test(float, float, float, float, float) const; ///< Answer one query now.
+
+    const bool IsDirect() const; ///< Whether every wall is tested.
+    const size_t GetNumQueries() const; ///< Get number of queries.
+    const size_t GetNumGroups() const; ///< Get number of targets.
+    const size_t GetNumTests() const; ///< Get number of query-wall tests made.
+    const size_t GetNumWalls() const; ///< Get number of walls.
+    const size_t GetGridSize() const; ///< Get number of walls in the columns.
+}; //CLosBatch
+
+#endif //__L4RC_GAME_LOSBATCH_H__
@@ -0,0 +1,218 @@
+/// \file MapGenerator.cpp
+/// \brief Code for the stress level generator CMapGenerator.
+
+#include "MapGenerator.h"
+
+#include <cstdio>
+#include <algorithm>
+
+/// \brief Default entity density.
+///
+/// How many of an entity glyph there are per thousand tiles in a busy map.
+
+static const struct{char m_chGlyph; float m_fPerThousand;} DENSITY[] = {
+  {'T', 1.5f}, {'B', 1.0f}, {'V', 0.3f}, {'K', 0.5f}, {'S', 4.0f},
+  {'L', 0.5f}, {'H', 0.5f}, {'I', 0.2f}, {'O', 0.1f}, {'G', 0.1f},
+}; //DENSITY
+
+/// Set how many of an entity glyph to place, adding the glyph if it isn't
+/// there yet.
+/// \param c Entity glyph.
+/// \param n How many.
+
+void SMapGenDesc::SetCount(char c, size_t n){
+  const size_t i = m_strGlyphs.find(c);
+
+  if(i == std::string::npos){
+    m_strGlyphs += c;
+    m_vecCounts.push_back(n);
+  } //if
+
+  else m_vecCounts[i] = n;
+} //SetCount
+
+/// Set the counts of all entity glyphs from their default density and the
+/// map size.
+/// \param scale Multiplier for the default densities.
+
+void SMapGenDesc::ScaleCounts(float scale){
+  const float k = scale*m_nWidth*m_nHeight/1000.0f; //thousands of tiles, scaled
+
+  for(const auto& d: DENSITY)
+    SetCount(d.m_chGlyph, (size_t)(d.m_fPerThousand*k + 0.5f));
+} //ScaleCounts
+
+/// Get the next random number, using SplitMix64, which is small, quick, and
+/// the same everywhere.
+/// \return A random 32-bit number.
+
+const uint32_t CMapGenerator::Random(){
+  uint64_t z = (m_nState += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+  return (uint32_t)((z ^ (z >> 31)) >> 32);
+} //Random
+
+/// Get a random number less than a bound.
+/// \param n The bound, greater than zero.
+/// \return A random number in [0, n).
+
+const size_t CMapGenerator::Random(size_t n){
+  return (size_t)(((uint64_t)Random()*n) >> 32);
+} //Random
+
+/// Get a random number between 0 and 1.
+/// \return A random number in [0, 1).
+
+const float CMapGenerator::RandomFloat(){
+  return (Random() >> 8)/16777216.0f;
+} //RandomFloat
+
+/// Check whether a tile is open floor.
+/// \param i Row, with 0 at the top.
+/// \param j Column, with 0 at the left.
+/// \return true if the tile is floor with nothing on it.
+
+const bool CMapGenerator::Open(size_t i, size_t j) const{
+  return m_vecRows[i][j] == 'F';
+} //Open
+
+/// Check whether a tile is open floor with a wall below it, so that
+/// something can stand there.
+/// \param i Row, with 0 at the top.
+/// \param j Column, with 0 at the left.
+/// \return true if the tile is open and on a wall.
+
+const bool CMapGenerator::Standing(size_t i, size_t j) const{
+  return Open(i, j) && i + 1 < m_vecRows.size() && m_vecRows[i + 1][j] == 'W';
+} //Standing
+
+/// Place entities on random open tiles, giving up on any that can't find a
+/// place after a fair number of tries.
+/// \param c Entity glyph.
+/// \param n How many.
+/// \param bFlying true if they can go anywhere open, false if they stand.
+/// \return How many were placed.
+
+const size_t CMapGenerator::Place(char c, size_t n, bool bFlying){
+  const size_t w = m_vecRows[0].size();
+  const size_t h = m_vecRows.size();
+
+  size_t placed = 0;
+
+  for(size_t tries=0; placed<n && tries<50*n; tries++){
+    const size_t i = 1 + Random(h - 2);
+    const size_t j = 1 + Random(w - 2);
+
+    if(bFlying? Open(i, j): Standing(i, j)){
+      m_vecRows[i][j] = c;
+      placed++;
+    } //if
+  } //for
+
+  return placed;
+} //Place
+
+/// Generate a map. The border walls go in first, then the tiers of
+/// platforms from the bottom up, then loose walls, then the player and
+/// door, and then the entities in the order of their glyphs.
+/// \param d Settings.
+
+void CMapGenerator::Generate(const SMapGenDesc& d){
+  m_nState = d.m_nSeed;
+
+  const size_t w = std::max<size_t>(8, d.m_nWidth);
+  const size_t h = std::max<size_t>(6, d.m_nHeight);
+  const size_t gap = std::max<size_t>(2, d.m_nTierGap);
+  const size_t minLen = std::max<size_t>(1, d.m_nMinPlatform);
+  const size_t maxLen = std::max(minLen, d.m_nMaxPlatform);
+  const float start = d.m_fPlatformFill*2.0f/(minLen + maxLen); //chance a platform starts
+
+  m_vecRows.assign(h, std::string(w, 'F'));
+
+  //border
+
+  for(size_t j=0; j<w; j++)
+    m_vecRows[0][j] = m_vecRows[h - 1][j] = 'W';
+
+  for(size_t i=0; i<h; i++)
+    m_vecRows[i][0] = m_vecRows[i][w - 1] = 'W';
+
+  //tiers of platforms
+
+  for(size_t i=h - 1 - gap; i>=2 && i<h; i-=gap)
+    for(size_t j=1; j<w - 1;){
+      if(RandomFloat() < start){
+        const size_t len = minLen + Random(maxLen - minLen + 1);
+
+        for(size_t k=j; k<std::min(j + len, w - 1); k++)
+          m_vecRows[i][k] = 'W';
+
+        j += len + 1; //leave a gap
+      } //if
+
+      else j++;
+    } //for
+
+  //loose walls
+
+  for(size_t i=1; i<h - 1; i++)
+    for(size_t j=1; j<w - 1; j++)
+      if(m_vecRows[i][j] == 'F' && RandomFloat() < d.m_fWallDensity)
+        m_vecRows[i][j] = 'W';
+
+  //player and door on the bottom wall, with headroom
+
+  for(size_t i=h - 4; i<h - 1; i++){
+    m_vecRows[i][1] = m_vecRows[i][2] = 'F';
+    m_vecRows[i][w - 2] = m_vecRows[i][w - 3] = 'F';
+  } //for
+
+  m_vecRows[h - 2][1] = 'P';
+  m_vecRows[h - 2][w - 2] = 'D';
+
+  //entities
+
+  for(size_t k=0; k<d.m_strGlyphs.size() && k<d.m_vecCounts.size(); k++){
+    const char c = d.m_strGlyphs[k];
+    Place(c, d.m_vecCounts[k], c == 'B' || c == 'V');
+  } //for
+} //Generate
+
+/// Save the map in the `LoadMap` format, each row ending in a linefeed.
+/// \param filename Name of the map file.
+/// \return true if the file was written.
+
+const bool CMapGenerator::Save(const char* filename) const{
+  FILE* output = fopen(filename, "wb");
+  if(output == nullptr)return false;
+
+  bool ok = true;
+
+  for(const std::string& row: m_vecRows)
+    ok = ok && fwrite(row.data(), 1, row.size(), output) == row.size() &&
+      fputc('\n', output) != EOF;
+
+  fclose(output);
+  return ok;
+} //Save
+
+/// Reader function for the map rows.
+/// \return The rows, top row first.
+
+const std::vector<std::string>& CMapGenerator::GetRows() const{
+  return m_vecRows;
+} //GetRows
+
+/// Count the tiles with a given glyph.
+/// \param c A map glyph.
+/// \return How many tiles have it.
+
+const size_t CMapGenerator::GetCount(char c) const{
+  size_t n = 0;
+
+  for(const std::string& row: m_vecRows)
+    n += std::count(row.begin(), row.end(), c);
+
+  return n;
+} //GetCount
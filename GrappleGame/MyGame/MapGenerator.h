@@ -0,0 +1,67 @@
+/// \file MapGenerator.h
+/// \brief Interface for the stress level generator CMapGenerator.
+
+#ifndef __L4RC_GAME_MAPGENERATOR_H__
+#define __L4RC_GAME_MAPGENERATOR_H__
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/// \brief Map generator settings.
+///
+/// What a generated map is to look like. Entity counts are given per glyph,
+/// as many of each as will fit.
+
+struct SMapGenDesc{
+  size_t m_nWidth = 64; ///< Number of tiles wide.
+  size_t m_nHeight = 32; ///< Number of tiles high.
+  uint32_t m_nSeed = 1; ///< Random number seed.
+
+  float m_fWallDensity = 0.02f; ///< Chance of a loose wall tile in open space.
+  size_t m_nTierGap = 4; ///< Rows between tiers of platforms.
+  float m_fPlatformFill = 0.35f; ///< Fraction of each tier covered by platforms.
+  size_t m_nMinPlatform = 3; ///< Shortest platform in tiles.
+  size_t m_nMaxPlatform = 12; ///< Longest platform in tiles.
+
+  std::string m_strGlyphs; ///< Entity glyphs, for example `"TBSLH"`.
+  std::vector<size_t> m_vecCounts; ///< How many of each entity glyph.
+
+  void SetCount(char, size_t); ///< Set the count for a glyph.
+  void ScaleCounts(float); ///< Set counts per thousand tiles.
+}; //SMapGenDesc
+
+/// \brief The stress level generator.
+///
+/// CMapGenerator makes maps in the `LoadMap` glyph format for scaling tests,
+/// far bigger and busier than the hand-made ones. A map has a wall all the
+/// way round, tiers of platforms every few rows for the player to climb,
+/// some loose wall tiles, the player at the bottom left and the door at the
+/// bottom right. Flying enemies, bats and swoopers, go anywhere open. Other
+/// entities stand on a wall or platform. The generator uses its own small
+/// random number generator so that the same settings and seed make the same
+/// map with any compiler and standard library.
+
+class CMapGenerator{
+  private:
+    uint64_t m_nState = 0; ///< Random number generator state.
+    std::vector<std::string> m_vecRows; ///< Map rows, top row first.
+
+    const uint32_t Random(); ///< Next random number.
+    const size_t Random(size_t); ///< Random number less than a bound.
+    const float RandomFloat(); ///< Random number in [0, 1).
+
+    const bool Open(size_t, size_t) const; ///< Is a tile open floor?
+    const bool Standing(size_t, size_t) const; ///< Is an open tile on a wall?
+    const size_t Place(char, size_t, bool); ///< Place entities.
+
+  public:
+    void Generate(const SMapGenDesc&); ///< Generate a map.
+    const bool Save(const char*) const; ///< Save the map.
+
+    const std::vector<std::string>& GetRows() const; ///< Get the map rows.
+    const size_t GetCount(char) const; ///< Count a glyph.
+}; //CMapGenerator
+
+#endif //__L4RC_GAME_MAPGENERATOR_H__
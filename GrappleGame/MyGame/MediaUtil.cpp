@@ -0,0 +1,288 @@
+/// \file MediaUtil.cpp
+/// \brief Code for the media file helpers.
+
+#include "MediaUtil.h"
+
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+
+#define STB_IMAGE_STATIC //keep our copy private in case the engine has one too
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+/// Read a whole file into a string.
+/// \param filename Name of the file.
+/// \param s [out] Contents of the file.
+/// \return true if the file was opened.
+
+const bool ReadFile(const std::string& filename, std::string& s){
+  FILE* input = fopen(filename.c_str(), "rb");
+  if(input == nullptr)return false;
+
+  char buffer[4096];
+  size_t k = 0;
+
+  s.clear();
+
+  while((k = fread(buffer, 1, sizeof(buffer), input)) > 0)
+    s.append(buffer, k);
+
+  fclose(input);
+  return true;
+} //ReadFile
+
+/// Get the value of an attribute from an XML tag. Whitespace is allowed
+/// around the `=`, as in `ext ="png"`.
+/// \param tag The tag, from `<` to `>`.
+/// \param name Name of the attribute.
+/// \param value [out] Value of the attribute.
+/// \return true if the attribute was found.
+
+const bool GetAttribute(const std::string& tag, const char* name,
+  std::string& value)
+{
+  const size_t n = strlen(name);
+
+  for(size_t i=tag.find(name); i!=std::string::npos; i=tag.find(name, i + 1)){
+    if(i == 0 || !isspace((unsigned char)tag[i - 1]))continue; //part of another name
+
+    size_t j = i + n;
+    while(j < tag.size() && isspace((unsigned char)tag[j]))j++;
+    if(j >= tag.size() || tag[j] != '=')continue;
+    j++;
+    while(j < tag.size() && isspace((unsigned char)tag[j]))j++;
+    if(j >= tag.size() || tag[j] != '"')continue;
+
+    const size_t k = tag.find('"', j + 1);
+    if(k == std::string::npos)return false;
+
+    value = tag.substr(j + 1, k - j - 1);
+    return true;
+  } //for
+
+  return false;
+} //GetAttribute
+
+/// Find the first XML tag with a given name.
+/// \param s Contents of the XML file.
+/// \param name Tag name including the `<`, for example `"<renderer"`.
+/// \param tag [out] The tag, from `<` to `>`.
+/// \return true if the tag was found.
+
+const bool GetTag(const std::string& s, const char* name, std::string& tag){
+  size_t pos = 0;
+  return NextTag(s, name, pos, tag);
+} //GetTag
+
+/// Find the next XML tag with a given name, for walking through a list of
+/// tags such as the `<sprite` tags. The name must be followed by whitespace,
+/// `/`, or `>` so that `"<sprite"` doesn't match `<sprites`.
+/// \param s Contents of the XML file.
+/// \param name Tag name including the `<`.
+/// \param pos [in, out] Where to start looking, moved past the tag found.
+/// \param tag [out] The tag, from `<` to `>`.
+/// \return true if a tag was found.
+
+const bool NextTag(const std::string& s, const char* name, size_t& pos,
+  std::string& tag)
+{
+  const size_t n = strlen(name);
+
+  for(size_t i=s.find(name, pos); i!=std::string::npos; i=s.find(name, i + 1)){
+    const char c = i + n < s.size()? s[i + n]: '\0';
+    if(!isspace((unsigned char)c) && c != '/' && c != '>')continue;
+
+    const size_t j = s.find('>', i);
+    if(j == std::string::npos)return false;
+
+    tag = s.substr(i, j - i + 1);
+    pos = j + 1;
+    return true;
+  } //for
+
+  return false;
+} //NextTag
+
+/// Replace the backslashes in a Windows path with slashes, which work
+/// everywhere.
+/// \param s A path.
+/// \return The path with slashes.
+
+std::string FixPath(std::string s){
+  std::replace(s.begin(), s.end(), '\\', '/');
+  return s;
+} //FixPath
+
+/// Hash some bytes with 64-bit FNV-1a, which is quick and good enough to
+/// tell whether a file has changed.
+/// \param p Pointer to bytes.
+/// \param n Number of bytes.
+/// \param h Hash so far, defaults to the FNV offset basis.
+/// \return The hash.
+
+const uint64_t HashBytes(const void* p, size_t n, uint64_t h){
+  const uint8_t* b = (const uint8_t*)p;
+
+  for(size_t i=0; i<n; i++)
+    h = (h ^ b[i])*0x100000001B3ULL;
+
+  return h;
+} //HashBytes
+
+/// Decode an image file to 32-bit RGBA texels.
+/// \param filename Name of the image file.
+/// \param w [out] Width in texels.
+/// \param h [out] Height in texels.
+/// \param texels [out] Texels, RGBA with red in the low byte, top row first.
+/// \return true if the image was decoded.
+
+const bool LoadImageRGBA(const std::string& filename, int& w, int& h,
+  std::vector<uint32_t>& texels)
+{
+  int channels = 0;
+  unsigned char* buffer = stbi_load(filename.c_str(), &w, &h, &channels, 4);
+  if(buffer == nullptr)return false;
+
+  texels.resize((size_t)w*h);
+  memcpy(texels.data(), buffer, (size_t)w*h*4);
+  stbi_image_free(buffer);
+
+  return true;
+} //LoadImageRGBA
+
+/// Decode an image file that has been read into memory to 32-bit RGBA
+/// texels.
+/// \param p Pointer to the contents of the image file.
+/// \param n Size of the image file in bytes.
+/// \param w [out] Width in texels.
+/// \param h [out] Height in texels.
+/// \param texels [out] Texels, RGBA with red in the low byte, top row first.
+/// \return true if the image was decoded.
+
+const bool DecodeImageRGBA(const void* p, size_t n, int& w, int& h,
+  std::vector<uint32_t>& texels)
+{
+  int channels = 0;
+  unsigned char* buffer = stbi_load_from_memory((const stbi_uc*)p, (int)n, &w, &h, &channels, 4);
+  if(buffer == nullptr)return false;
+
+  texels.resize((size_t)w*h);
+  memcpy(texels.data(), buffer, (size_t)w*h*4);
+  stbi_image_free(buffer);
+
+  return true;
+} //DecodeImageRGBA
+
+/// Compute the CRC of some bytes as PNG chunks need.
+/// \param crc CRC so far, initially 0.
+/// \param p Pointer to bytes.
+/// \param n Number of bytes.
+/// \return The CRC.
+
+static uint32_t Crc32(uint32_t crc, const uint8_t* p, size_t n){
+  static uint32_t table[256] = {0};
+
+  if(table[1] == 0)
+    for(uint32_t i=0; i<256; i++){
+      uint32_t c = i;
+      for(int k=0; k<8; k++)
+        c = c & 1? 0xEDB88320 ^ (c >> 1): c >> 1;
+      table[i] = c;
+    } //for
+
+  crc = ~crc;
+
+  for(size_t i=0; i<n; i++)
+    crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+
+  return ~crc;
+} //Crc32
+
+/// Write 32-bit RGBA texels to a PNG file, as RGB or RGBA. The image data is
+/// zlib compressed with stored blocks only, which is quick to write and
+/// needs no compression library, at the cost of file size.
+/// \param filename Name of the PNG file.
+/// \param w Width in texels.
+/// \param h Height in texels.
+/// \param texels Texels, RGBA with red in the low byte, top row first.
+/// \param alpha true to keep the alpha channel.
+/// \return true if the file was written.
+
+const bool WritePNG(const char* filename, int w, int h, const uint32_t* texels,
+  bool alpha)
+{
+  const size_t bpp = alpha? 4: 3; //bytes per pixel
+  const size_t rowSize = 1 + bpp*(size_t)w; //filter byte then pixels
+  std::vector<uint8_t> raw(rowSize*h);
+
+  for(int i=0; i<h; i++){
+    uint8_t* row = &raw[i*rowSize];
+    const uint32_t* src = &texels[(size_t)i*w];
+    *row++ = 0; //no filter
+
+    for(int j=0; j<w; j++)
+      for(size_t k=0; k<bpp; k++)
+        *row++ = (uint8_t)(src[j] >> 8*k);
+  } //for
+
+  std::vector<uint8_t> chunk; //the chunk being built
+  std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+  auto Put32 = [](std::vector<uint8_t>& v, uint32_t n){ //big-endian
+    for(int k=3; k>=0; k--)v.push_back((uint8_t)(n >> 8*k));
+  }; //Put32
+
+  auto EndChunk = [&](){ //wrap up chunk, which begins with the type
+    Put32(png, (uint32_t)chunk.size() - 4);
+    png.insert(png.end(), chunk.begin(), chunk.end());
+    Put32(png, Crc32(0, chunk.data(), chunk.size()));
+    chunk.clear();
+  }; //EndChunk
+
+  chunk = {'I', 'H', 'D', 'R'};
+  Put32(chunk, w);
+  Put32(chunk, h);
+  chunk.insert(chunk.end(), {8, (uint8_t)(alpha? 6: 2), 0, 0, 0}); //8-bit RGB or RGBA
+  EndChunk();
+
+  chunk = {'I', 'D', 'A', 'T', 0x78, 0x01}; //zlib header
+  chunk.reserve(raw.size() + raw.size()/65535*5 + 32);
+
+  uint32_t a = 1, b = 0; //Adler-32 sums
+
+  for(size_t i=0; i<raw.size(); i+=65535){
+    const size_t n = std::min<size_t>(65535, raw.size() - i);
+    const bool last = i + n == raw.size();
+
+    chunk.push_back(last? 1: 0); //stored block
+    chunk.push_back((uint8_t)n);
+    chunk.push_back((uint8_t)(n >> 8));
+    chunk.push_back((uint8_t)~n);
+    chunk.push_back((uint8_t)(~n >> 8));
+    chunk.insert(chunk.end(), raw.begin() + i, raw.begin() + i + n);
+
+    for(size_t k=i; k<i+n; k++){
+      a += raw[k];
+      b += a;
+      if((k & 1023) == 1023){a %= 65521; b %= 65521;}
+    } //for
+
+    a %= 65521; b %= 65521;
+  } //for
+
+  Put32(chunk, (b << 16) | a);
+  EndChunk();
+
+  chunk = {'I', 'E', 'N', 'D'};
+  EndChunk();
+
+  FILE* output = fopen(filename, "wb");
+  if(output == nullptr)return false;
+
+  const bool ok = fwrite(png.data(), 1, png.size(), output) == png.size();
+  fclose(output);
+
+  return ok;
+} //WritePNG
@@ -0,0 +1,26 @@
+/// \file MediaUtil.h
+/// \brief Interface for the media file helpers.
+///
+/// Small helpers for reading the settings XML and reading and writing
+/// images without the Engine, shared by the software renderer and the sprite
+/// atlas packer.
+
+#ifndef __L4RC_GAME_MEDIAUTIL_H__
+#define __L4RC_GAME_MEDIAUTIL_H__
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+const bool ReadFile(const std::string&, std::string&); ///< Read a whole file.
+const bool GetAttribute(const std::string&, const char*, std::string&); ///< Get an XML attribute.
+const bool GetTag(const std::string&, const char*, std::string&); ///< Find an XML tag.
+const bool NextTag(const std::string&, const char*, size_t&, std::string&); ///< Find the next XML tag.
+std::string FixPath(std::string); ///< Use slashes in a path.
+
+const uint64_t HashBytes(const void*, size_t, uint64_t=0xCBF29CE484222325ULL); ///< FNV-1a hash.
+const bool LoadImageRGBA(const std::string&, int&, int&, std::vector<uint32_t>&); ///< Decode an image.
+const bool DecodeImageRGBA(const void*, size_t, int&, int&, std::vector<uint32_t>&); ///< Decode an image in memory.
+const bool WritePNG(const char*, int, int, const uint32_t*, bool); ///< Write a PNG file.
+
+#endif //__L4RC_GAME_MEDIAUTIL_H__
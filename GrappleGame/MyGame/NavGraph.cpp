@@ -0,0 +1,408 @@
+/// \file NavGraph.cpp
+/// \brief Code for the platformer navigation graph CNavGraph and routes CNavRoute.
+
+#include "NavGraph.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <cmath>
+
+static const uint32_t NONE = UINT32_MAX; ///< No node or link.
+static const float MAX_FLIGHT = 4.0f; ///< Longest arc in seconds.
+static const float JUMP_PENALTY = 0.25f; ///< Extra cost of a jump or launch in seconds.
+
+static const uint8_t OPEN = 0; ///< Tile kind for open space.
+static const uint8_t WALL = 1; ///< Tile kind for a wall.
+static const uint8_t SPIKE = 2; ///< Tile kind for a spike.
+static const uint8_t PAD = 3; ///< Tile kind for a launch pad.
+
+/// Equality test.
+/// \param p Profile to compare with.
+/// \return true if all speeds and the gravity are the same.
+
+const bool SNavProfile::operator==(const SNavProfile& p) const{
+  return m_fRunSpeed == p.m_fRunSpeed && m_fJumpSpeed == p.m_fJumpSpeed &&
+    m_fGravity == p.m_fGravity && m_fLaunchSpeed == p.m_fLaunchSpeed;
+} //operator==
+
+/// Follow an arc through the tiles under gravity, in steps of at most a
+/// quarter tile, until it comes down on a standing place other than the
+/// one it started from, or hits a wall or spike. Positions are in pixels from the top left of the
+/// map with y down.
+/// \param kind Kind of each tile.
+/// \param x Start position x.
+/// \param y Start position y.
+/// \param vx Horizontal speed.
+/// \param vy Vertical speed, positive down.
+/// \param from Node it started from.
+/// \param time [out] Time taken.
+/// \return Node landed on, `UINT32_MAX` if it hit a wall or left the map.
+
+const uint32_t CNavGraph::Arc(const uint8_t* kind, float x, float y,
+  float vx, float vy, uint32_t from, float& time) const
+{
+  const float t = m_fTileSize; //shorthand
+  time = 0.0f;
+
+  while(time < MAX_FLIGHT){
+    const float speed = std::max(1.0f, std::max(std::fabs(vx), std::fabs(vy))); //fastest component
+    const float dt = std::min(1.0f/60.0f, 0.25f*t/speed); //time step
+
+    x += vx*dt;
+    y += vy*dt;
+    vy += m_sProfile.m_fGravity*dt;
+    time += dt;
+
+    if(x < 0.0f || y < 0.0f)return NONE; //off the map
+    const size_t i = (size_t)(y/t), j = (size_t)(x/t); //tile row and column
+    if(i >= m_nHeight || j >= m_nWidth)return NONE; //off the map
+    if(kind[i*m_nWidth + j] == WALL || kind[i*m_nWidth + j] == SPIKE)return NONE; //hit something
+
+    const uint32_t n = m_vecNode[i*m_nWidth + j]; //node here, if any
+    if(vy > 0.0f && n != NONE && n != from && y >= (i + 0.5f)*t)
+      return n; //landed
+  } //while
+
+  return NONE;
+} //Arc
+
+/// Follow arcs from a start position at several horizontal speeds and add
+/// a link for each one that lands.
+/// \param kind Kind of each tile.
+/// \param links [in, out] Links to add to.
+/// \param from Node to start from.
+/// \param type Kind of link.
+/// \param x Start position x in pixels from the left.
+/// \param y Start position y in pixels from the top.
+/// \param vy Upward speed at the start.
+/// \param vx Horizontal speeds to try.
+/// \param n Number of horizontal speeds.
+
+void CNavGraph::AddArcs(const uint8_t* kind, std::vector<SNavLink>& links,
+  uint32_t from, eNavLink type, float x, float y, float vy, const float* vx, size_t n) const
+{
+  const float penalty = type == eNavLink::Jump || type == eNavLink::Launch? JUMP_PENALTY: 0.0f;
+
+  for(size_t k=0; k<n; k++){
+    float time = 0.0f; //time in the air
+    const uint32_t to = Arc(kind, x, y, vx[k], -vy, from, time); //node landed on
+
+    if(to != NONE){
+      SNavLink link;
+      link.m_nFrom = from;
+      link.m_nTo = to;
+      link.m_eType = type;
+      link.m_fSpeedX = vx[k];
+      link.m_fSpeedY = vy;
+      link.m_fCost = time + penalty;
+      links.push_back(link);
+    } //if
+  } //for
+} //AddArcs
+
+/// Make the graph. The nodes are the open tiles with a wall below, leaving
+/// out spikes, which arcs must also miss. Each node gets links to the nodes
+/// beside it, arcs for jumps at nine horizontal speeds, arcs off each open
+/// edge at three, and if there is a launch pad on it, arcs for launches.
+/// Where more than one link goes to the same node only the cheapest is kept.
+/// \param map The map, an array of rows top row first.
+/// \param w Number of tiles wide.
+/// \param h Number of tiles high.
+/// \param t Tile width and height.
+/// \param profile How the entity moves.
+/// \param pads Indices of the tiles that have launch pads.
+/// \param spikes Indices of the tiles that have spikes.
+
+void CNavGraph::Build(const char* const* map, size_t w, size_t h, float t,
+  const SNavProfile& profile, const std::vector<size_t>& pads,
+  const std::vector<size_t>& spikes)
+{
+  m_sProfile = profile;
+  m_nWidth = w;
+  m_nHeight = h;
+  m_fTileSize = t;
+
+  //tile kinds
+
+  std::vector<uint8_t> kind(w*h, OPEN); //kind of each tile
+
+  for(size_t i=0; i<h; i++)
+    for(size_t j=0; j<w; j++)
+      if(map[i][j] == 'W')kind[i*w + j] = WALL;
+
+  for(size_t n: pads)if(n < w*h)kind[n] = PAD;
+  for(size_t n: spikes)if(n < w*h)kind[n] = SPIKE;
+
+  //nodes
+
+  m_vecNode.assign(w*h, NONE);
+  m_vecTile.clear();
+
+  for(size_t n=0; n+w<w*h; n++)
+    if(kind[n] != WALL && kind[n] != SPIKE && kind[n + w] == WALL){
+      m_vecNode[n] = (uint32_t)m_vecTile.size();
+      m_vecTile.push_back((uint32_t)n);
+    } //if
+
+  //links
+
+  const float run = profile.m_fRunSpeed; //shorthand
+  const float jumps[] = {-run, -0.75f*run, -run/2, -run/4, 0.0f,
+    run/4, run/2, 0.75f*run, run}; //horizontal speeds for jumps
+
+  m_vecLinks.clear();
+  m_vecFirst.assign(1, 0);
+  std::vector<SNavLink> links; //links from one node
+
+  for(uint32_t n=0; n<(uint32_t)m_vecTile.size(); n++){
+    const size_t i = m_vecTile[n]/w, j = m_vecTile[n]%w; //row and column
+    const float cx = (j + 0.5f)*t, cy = (i + 0.5f)*t; //tile center
+    links.clear();
+
+    for(int d=-1; d<=1; d+=2){ //left and right
+      const size_t k = j + d; //column beside
+      if(k >= w)continue; //wrapped, so off the map
+
+      const uint32_t m = m_vecNode[i*w + k]; //node beside, if any
+
+      if(m != NONE && run > 0.0f){ //walk
+        SNavLink link;
+        link.m_nFrom = n;
+        link.m_nTo = m;
+        link.m_fSpeedX = d*run;
+        link.m_fCost = t/run;
+        links.push_back(link);
+      } //if
+
+      else if(m == NONE && kind[i*w + k] == OPEN && run > 0.0f){ //fall off the edge
+        const float falls[] = {d*run, d*run/2, d*run/4}; //horizontal speeds for falls
+        AddArcs(kind.data(), links, n, eNavLink::Fall, cx + d*t/2, cy, 0.0f, falls, 3);
+      } //else if
+    } //for
+
+    if(profile.m_fJumpSpeed > 0.0f)
+      AddArcs(kind.data(), links, n, eNavLink::Jump, cx, cy, profile.m_fJumpSpeed, jumps, 9);
+
+    if(profile.m_fLaunchSpeed > 0.0f && kind[m_vecTile[n]] == PAD)
+      AddArcs(kind.data(), links, n, eNavLink::Launch, cx, cy, profile.m_fLaunchSpeed, jumps, 9);
+
+    std::sort(links.begin(), links.end(), [](const SNavLink& a, const SNavLink& b){
+      return a.m_nTo < b.m_nTo || (a.m_nTo == b.m_nTo && a.m_fCost < b.m_fCost);
+    }); //sort
+
+    for(size_t k=0; k<links.size(); k++) //cheapest to each node
+      if(k == 0 || links[k].m_nTo != links[k - 1].m_nTo)
+        m_vecLinks.push_back(links[k]);
+
+    m_vecFirst.push_back((uint32_t)m_vecLinks.size());
+  } //for
+
+  //links into each node, by counting sort
+
+  m_vecInFirst.assign(m_vecTile.size() + 1, 0);
+  for(const SNavLink& l: m_vecLinks)m_vecInFirst[l.m_nTo + 1]++;
+
+  for(size_t n=0; n<m_vecTile.size(); n++)
+    m_vecInFirst[n + 1] += m_vecInFirst[n];
+
+  std::vector<uint32_t> next(m_vecInFirst.begin(), m_vecInFirst.end() - 1); //next free slot
+  m_vecIn.resize(m_vecLinks.size());
+
+  for(uint32_t k=0; k<(uint32_t)m_vecLinks.size(); k++)
+    m_vecIn[next[m_vecLinks[k].m_nTo]++] = k;
+} //Build
+
+/// Reader function for the profile.
+/// \return How the entity that the graph is for moves.
+
+const SNavProfile& CNavGraph::GetProfile() const{
+  return m_sProfile;
+} //GetProfile
+
+/// Reader function for the number of nodes.
+/// \return Number of nodes.
+
+const size_t CNavGraph::GetNumNodes() const{
+  return m_vecTile.size();
+} //GetNumNodes
+
+/// Reader function for the number of links.
+/// \return Number of links.
+
+const size_t CNavGraph::GetNumLinks() const{
+  return m_vecLinks.size();
+} //GetNumLinks
+
+/// Get the number of links of a kind.
+/// \param type Kind of link.
+/// \return Number of links of that kind.
+
+const size_t CNavGraph::GetNumLinks(eNavLink type) const{
+  return std::count_if(m_vecLinks.begin(), m_vecLinks.end(),
+    [=](const SNavLink& l){return l.m_eType == type;});
+} //GetNumLinks
+
+/// Get the memory used by the graph.
+/// \return Size in bytes.
+
+const size_t CNavGraph::GetMemory() const{
+  return (m_vecNode.capacity() + m_vecTile.capacity() + m_vecFirst.capacity() +
+    m_vecInFirst.capacity() + m_vecIn.capacity())*sizeof(uint32_t) +
+    m_vecLinks.capacity()*sizeof(SNavLink);
+} //GetMemory
+
+/// Get the node at a tile.
+/// \param tile Index of the tile.
+/// \return The node, `UINT32_MAX` if the tile isn't a standing place.
+
+const uint32_t CNavGraph::GetNode(size_t tile) const{
+  return tile < m_vecNode.size()? m_vecNode[tile]: NONE;
+} //GetNode
+
+/// Get the node at a tile or the first one straight down from it, which is
+/// where something in the air there would land.
+/// \param tile Index of the tile.
+/// \return The node, `UINT32_MAX` if there is none.
+
+const uint32_t CNavGraph::GetNodeBelow(size_t tile) const{
+  for(; tile<m_vecNode.size(); tile+=m_nWidth)
+    if(m_vecNode[tile] != NONE)
+      return m_vecNode[tile];
+
+  return NONE;
+} //GetNodeBelow
+
+/// Get the tile of a node.
+/// \param n Node.
+/// \return Index of its tile.
+
+const size_t CNavGraph::GetTile(uint32_t n) const{
+  return m_vecTile[n];
+} //GetTile
+
+/// Get a link.
+/// \param k Index of the link.
+/// \return The link.
+
+const SNavLink& CNavGraph::GetLink(size_t k) const{
+  return m_vecLinks[k];
+} //GetLink
+
+/// Get the links out of a node.
+/// \param n Node.
+/// \param count [out] Number of links.
+/// \return Pointer to an array of links.
+
+const SNavLink* CNavGraph::GetLinksOut(uint32_t n, size_t& count) const{
+  count = m_vecFirst[n + 1] - m_vecFirst[n];
+  return m_vecLinks.data() + m_vecFirst[n];
+} //GetLinksOut
+
+/// Get the links into a node.
+/// \param n Node.
+/// \param count [out] Number of links.
+/// \return Pointer to an array of link indices.
+
+const uint32_t* CNavGraph::GetLinksIn(uint32_t n, size_t& count) const{
+  count = m_vecInFirst[n + 1] - m_vecInFirst[n];
+  return m_vecIn.data() + m_vecInFirst[n];
+} //GetLinksIn
+
+/// Forget the graph and the goal, which must be done when the graph is
+/// about to go away.
+
+void CNavRoute::Reset(){
+  m_pGraph = nullptr;
+  m_nGoal = NONE;
+  m_vecCost.clear();
+  m_vecNext.clear();
+} //Reset
+
+/// Move the goal to the node at or below a tile, working out the route again
+/// if that is a different node from last time. A goal with no node under it,
+/// such as over a pit, leaves the route as it was.
+/// \param graph The graph.
+/// \param tile Index of the goal tile.
+/// \return true if the route was worked out again.
+
+const bool CNavRoute::Update(const CNavGraph& graph, size_t tile){
+  const uint32_t goal = graph.GetNodeBelow(tile); //goal node
+  if(goal == NONE || (m_pGraph == &graph && goal == m_nGoal))return false;
+
+  m_pGraph = &graph;
+  m_nGoal = goal;
+
+  const size_t n = graph.GetNumNodes(); //shorthand
+  m_vecCost.assign(n, INFINITY);
+  m_vecNext.assign(n, NONE);
+
+  using Entry = std::pair<float, uint32_t>; //cost and node
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+  m_vecCost[goal] = 0.0f;
+  heap.push(Entry(0.0f, goal));
+
+  while(!heap.empty()){
+    const Entry top = heap.top();
+    heap.pop();
+    if(top.first > m_vecCost[top.second])continue; //stale
+
+    size_t count = 0; //number of links in
+    const uint32_t* in = graph.GetLinksIn(top.second, count); //links in
+
+    for(size_t k=0; k<count; k++){
+      const SNavLink& link = graph.GetLink(in[k]);
+      const float cost = top.first + link.m_fCost; //cost through this link
+
+      if(cost < m_vecCost[link.m_nFrom]){
+        m_vecCost[link.m_nFrom] = cost;
+        m_vecNext[link.m_nFrom] = in[k];
+        heap.push(Entry(cost, link.m_nFrom));
+      } //if
+    } //for
+  } //while
+
+  m_nSearches++;
+  return true;
+} //Update
+
+/// Reader function for the graph.
+/// \return The graph that the route goes through, `nullptr` if none.
+
+const CNavGraph* CNavRoute::GetGraph() const{
+  return m_pGraph;
+} //GetGraph
+
+/// Get the link to take next from a tile.
+/// \param tile Index of the tile.
+/// \return Pointer to the link, `nullptr` if the tile isn't a standing place,
+/// is the goal, or can't reach it.
+
+const SNavLink* CNavRoute::GetNext(size_t tile) const{
+  if(m_pGraph == nullptr)return nullptr;
+
+  const uint32_t n = m_pGraph->GetNode(tile); //node
+  if(n == NONE || m_vecNext[n] == NONE)return nullptr;
+
+  return &m_pGraph->GetLink(m_vecNext[n]);
+} //GetNext
+
+/// Get the cost of the route to the goal from a tile.
+/// \param tile Index of the tile.
+/// \return Time to the goal in seconds plus jump penalties, infinite if
+/// there is no route.
+
+const float CNavRoute::GetCost(size_t tile) const{
+  if(m_pGraph == nullptr)return INFINITY;
+
+  const uint32_t n = m_pGraph->GetNode(tile); //node
+  return n == NONE? INFINITY: m_vecCost[n];
+} //GetCost
+
+/// Reader function for the number of searches.
+/// \return Number of times the route was worked out.
+
+const size_t CNavRoute::GetNumSearches() const{
+  return m_nSearches;
+} //GetNumSearches
@@ -0,0 +1,128 @@
+/// \file NavGraph.h
+/// \brief Interface for the platformer navigation graph CNavGraph and routes CNavRoute.
+
+#ifndef __L4RC_GAME_NAVGRAPH_H__
+#define __L4RC_GAME_NAVGRAPH_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/// \brief How an entity moves.
+///
+/// The speeds and gravity that decide where an entity can get to by
+/// walking, jumping, falling, and being thrown by a launch pad, in pixels
+/// and seconds.
+
+struct SNavProfile{
+  float m_fRunSpeed = 300.0f; ///< Walking speed.
+  float m_fJumpSpeed = 800.0f; ///< Upward speed at the start of a jump, 0 for none.
+  float m_fGravity = 2400.0f; ///< Downward acceleration.
+  float m_fLaunchSpeed = 1400.0f; ///< Upward speed off a launch pad, 0 for none.
+
+  const bool operator==(const SNavProfile&) const; ///< Equality test.
+}; //SNavProfile
+
+/// \brief Kind of navigation link.
+///
+/// An enumerated type for the ways of getting from one standing place to
+/// another. `Size` must be last.
+
+enum class eNavLink: uint8_t{
+  Walk, Jump, Fall, Launch,
+  Size //MUST BE LAST
+}; //eNavLink
+
+/// \brief A navigation link.
+///
+/// A way of getting from one node to another, and how to do it. A walk is a
+/// step to the next tile along. A jump or launch starts from the center of
+/// the node's tile with the given speeds, and a fall walks off the edge of
+/// the tile with the given horizontal speed.
+
+struct SNavLink{
+  uint32_t m_nFrom = 0; ///< Node to start from.
+  uint32_t m_nTo = 0; ///< Node to end at.
+  eNavLink m_eType = eNavLink::Walk; ///< Kind of link.
+  float m_fSpeedX = 0.0f; ///< Horizontal speed, positive to the right.
+  float m_fSpeedY = 0.0f; ///< Upward speed at the start.
+  float m_fCost = 0.0f; ///< Time taken in seconds, plus a penalty for jumps.
+}; //SNavLink
+
+/// \brief The navigation graph.
+///
+/// CNavGraph is a graph of the places on a map where a ground entity can
+/// stand, which are the open tiles with a wall below, with links for
+/// walking to the next tile, jumping, falling off edges, and being thrown
+/// up by launch pads. Jumps, falls, and launches are found by following the
+/// arc for a few horizontal speeds through the tiles, tile center by tile
+/// center, until it comes down on a standing place or hits a wall or a
+/// spike. The arcs depend on the entity's `SNavProfile`, so each kind of
+/// entity has its own graph. The graph is made once when a level is loaded
+/// and is not changed after that. Tiles are indexed row by row from the top
+/// left of the map.
+
+class CNavGraph{
+  private:
+    SNavProfile m_sProfile; ///< How the entity moves.
+    size_t m_nWidth = 0; ///< Number of tiles wide.
+    size_t m_nHeight = 0; ///< Number of tiles high.
+    float m_fTileSize = 1.0f; ///< Tile width and height.
+
+    std::vector<uint32_t> m_vecNode; ///< Node at each tile, `UINT32_MAX` for none.
+    std::vector<uint32_t> m_vecTile; ///< Tile of each node.
+    std::vector<uint32_t> m_vecFirst; ///< First link out of each node, and one past the last.
+    std::vector<SNavLink> m_vecLinks; ///< Links in order of the node they start from.
+    std::vector<uint32_t> m_vecInFirst; ///< First link into each node, and one past the last.
+    std::vector<uint32_t> m_vecIn; ///< Indices of links in order of the node they end at.
+
+    const uint32_t Arc(const uint8_t*, float, float, float, float, uint32_t, float&) const; ///< Follow an arc.
+    void AddArcs(const uint8_t*, std::vector<SNavLink>&, uint32_t, eNavLink,
+      float, float, float, const float*, size_t) const; ///< Add links for arcs.
+
+  public:
+    void Build(const char* const*, size_t, size_t, float, const SNavProfile&,
+      const std::vector<size_t>&, const std::vector<size_t>&); ///< Make the graph.
+
+    const SNavProfile& GetProfile() const; ///< Get the profile.
+    const size_t GetNumNodes() const; ///< Get number of nodes.
+    const size_t GetNumLinks() const; ///< Get number of links.
+    const size_t GetNumLinks(eNavLink) const; ///< Get number of links of a kind.
+    const size_t GetMemory() const; ///< Get memory used.
+
+    const uint32_t GetNode(size_t) const; ///< Get node at a tile.
+    const uint32_t GetNodeBelow(size_t) const; ///< Get node at or below a tile.
+    const size_t GetTile(uint32_t) const; ///< Get tile of a node.
+    const SNavLink& GetLink(size_t) const; ///< Get a link.
+    const SNavLink* GetLinksOut(uint32_t, size_t&) const; ///< Get links out of a node.
+    const uint32_t* GetLinksIn(uint32_t, size_t&) const; ///< Get links into a node.
+}; //CNavGraph
+
+/// \brief A route to a goal through a navigation graph.
+///
+/// CNavRoute is the cheapest way to a goal node from every node of a
+/// navigation graph, found by one run of Dijkstra's algorithm backwards
+/// along the links from the goal. Each node keeps the first link to take,
+/// so any number of entities can look up their next move in constant time.
+/// The route is only worked out again when the goal moves to a different
+/// node or the graph changes.
+
+class CNavRoute{
+  private:
+    const CNavGraph* m_pGraph = nullptr; ///< The graph.
+    uint32_t m_nGoal = UINT32_MAX; ///< Goal node.
+    std::vector<float> m_vecCost; ///< Cost to the goal from each node.
+    std::vector<uint32_t> m_vecNext; ///< Link to take from each node, `UINT32_MAX` for none.
+    size_t m_nSearches = 0; ///< Number of searches made.
+
+  public:
+    void Reset(); ///< Forget the graph and goal.
+    const bool Update(const CNavGraph&, size_t); ///< Move the goal.
+
+    const CNavGraph* GetGraph() const; ///< Get the graph.
+    const SNavLink* GetNext(size_t) const; ///< Get link to take from a tile.
+    const float GetCost(size_t) const; ///< Get cost to goal from a tile.
+    const size_t GetNumSearches() const; ///< Get number of searches made.
+}; //CNavRoute
+
+#endif //__L4RC_GAME_NAVGRAPH_H__
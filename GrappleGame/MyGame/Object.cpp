@@ -7,6 +7,8 @@
 #include "Particle.h"
 #include "ParticleEngine.h"
 #include "Helpers.h"
+#include "DrawQueue.h"
+#include "SpawnTable.h"
 
 /// Create and initialize an object given its sprite type and initial position.
 /// \param t Type of sprite.
@@ -30,6 +32,38 @@ CObject::~CObject(){
   delete m_pGunFireEvent;
 } //destructor
 
+/// Ask for anything that the object needs to see, such as line of sight
+/// queries, before anything moves. This is only called for objects that
+/// think, and only on the frames that the AI scheduler picks them. The
+/// answers are ready in `think()`.
+
+void CObject::perceive(){
+} //perceive
+
+/// Read the answers asked for in `perceive()` and make the decisions that
+/// `move()` acts on until the next time the object is picked to think.
+
+void CObject::think(){
+} //think
+
+/// Keep the object's state in its spawn record when it is stored away, for
+/// the next time it is made. Objects that change more than where they are
+/// keep that too.
+/// \param r [out] The spawn record.
+
+void CObject::SaveSpawn(SSpawnRecord& r) const{
+  r.m_vPos = m_vPos;
+  r.m_fRoll = m_fRoll;
+} //SaveSpawn
+
+/// Get back the state kept in the object's spawn record when it is made.
+/// \param r The spawn record.
+
+void CObject::LoadSpawn(const SSpawnRecord& r){
+  m_vPos = r.m_vPos;
+  m_fRoll = r.m_fRoll;
+} //LoadSpawn
+
 /// Move object an amount that depends on its velocity and the frame time.
 
 void CObject::move(){
@@ -45,7 +79,7 @@ void CObject::move(){
 /// sprite descriptor.
 
 void CObject::draw(){ 
-  m_pRenderer->Draw(this);
+  m_pDrawQueue->Add(this, eDrawLayer::Objects, m_fRadius);
 
   if (m_bHealthPercent < 1.0f && m_bHealthPercent > 0.0f) {
       drawHealthBar();
@@ -74,8 +108,11 @@ void CObject::drawHealthBar() {
     Vector2 redEndVector = redStartVector;
     redEndVector.x -= redLength;
 
-    m_pRenderer->DrawLine(eSprite::HealthBar_Green, greenStartVector, greenEndVector);
-    m_pRenderer->DrawLine(eSprite::HealthBar_Red, redStartVector, redEndVector);
+    const float greenWidth = m_pRenderer->GetWidth(eSprite::HealthBar_Green);
+    const float redWidth = m_pRenderer->GetWidth(eSprite::HealthBar_Red);
+
+    m_pDrawQueue->AddLine(eSprite::HealthBar_Green, greenStartVector, greenEndVector, greenWidth, eDrawLayer::Overlay);
+    m_pDrawQueue->AddLine(eSprite::HealthBar_Red, redStartVector, redEndVector, redWidth, eDrawLayer::Overlay);
 }
 
 Vector2 CObject::convertGameToScreenSpace(Vector2& gameVector) {
@@ -111,6 +148,49 @@ void CObject::CollisionResponse(const Vector2& norm, float d, CObject* pObj){
   }
 } //CollisionResponse
 
+/// Response to touching a solid tile, such as a spike. Move back the overlap
+/// distance along the collision normal, as from a static object.
+/// \param norm Collision normal.
+/// \param d Overlap distance.
+/// \param props The tile's `eTileProp` flags.
+
+void CObject::TileResponse(const Vector2& norm, float d, uint8_t props){
+  if(m_bDead || m_bIsGrappler || m_bStatic)return;
+  m_vPos += d*norm; //back off this object
+} //TileResponse
+
+/// Response to starting to touch tiles with properties that it wasn't
+/// touching when it last collided, such as a launch pad, which is called
+/// once when the object gets onto them and not again until it has left.
+/// This function is a stub intended to be overridden by various object
+/// classes derived from this class.
+/// \param props The `eTileProp` flags that are new.
+
+void CObject::TileEnter(uint8_t props){
+  //stub
+} //TileEnter
+
+/// Response to starting to overlap, which is called once for each of the
+/// two objects when a sensor and another object first overlap, with no
+/// collision response. This function is a stub intended to be overridden
+/// by various object classes derived from this class.
+/// \param pObj Pointer to the other object.
+
+void CObject::OverlapBegin(CObject* pObj){
+  //stub
+} //OverlapBegin
+
+/// Response to no longer overlapping, which is called once for each of the
+/// two objects when a sensor and another object that were overlapping
+/// separate, and for the one left when the other goes away. This function
+/// is a stub intended to be overridden by various object classes derived
+/// from this class.
+/// \param pObj Pointer to the other object.
+
+void CObject::OverlapEnd(CObject* pObj){
+  //stub
+} //OverlapEnd
+
 /// Create a particle effect to mark the death of the object.
 /// This function is a stub intended to be overridden by various object classes
 /// derived from this class.
@@ -133,13 +213,6 @@ const bool CObject::isBullet() const{
   return m_bIsBullet;
 } //isBullet
 
-/// Reader function for spike flag.
-/// \return true if a spike.
-
-const bool CObject::isSpike() const {
-    return m_bIsSpike;
-} //isSpike
-
 /// Reader function for door flag.
 /// \return true if a door.
 
@@ -163,10 +236,6 @@ const bool CObject::isPlayer() const {
     return m_bIsPlayer;
 } // isPlayer
 
-const bool CObject::isLaunchPad() const {
-    return m_bIsLaunchPad;
-} //isLaunchPad
-
 const bool CObject::isGrappler() const {
     return m_bIsGrappler;
 } //isGrappler
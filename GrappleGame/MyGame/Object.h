@@ -12,6 +12,19 @@
 #include "BaseObject.h"
 #include "EventTimer.h"
 
+struct SSpawnRecord;
+
+/// \brief Activity tier.
+///
+/// How often an object is moved, collided, and given time to think, which
+/// depends on how far it is from the camera view and the player. An awake
+/// object is updated every frame. A slow one moves every frame but collides
+/// and thinks only one frame in a few. One that is asleep does nothing.
+
+enum class eActivity{
+  Awake, Slow, Asleep
+}; //eActivity
+
 /// \brief The game object. 
 ///
 /// The abstract representation of an object. `CObjectManager` is a friend of
@@ -34,21 +47,29 @@ class CObject:
     float m_fRotSpeed = 0; ///< Rotational speed.
     Vector2 m_vVelocity; ///< Velocity.
     bool m_bStatic = true; ///< Is static (does not move).
+    bool m_bSensor = false; ///< Reports overlaps instead of colliding.
     bool m_bIsTarget = true; ///< Is a target.
     bool m_bIsBullet = false; ///< Is a bullet.
-    bool m_bIsSpike = false; ///< Is a spike.
     bool m_bIsDoor = false; ///< Is a door.
     bool m_bIsDoorLocked = false; ///< Is Door Locked.
     bool m_bIsStar = false; ///< Is a star.
     bool m_bIsHealthpack = false;
     bool m_bIsPlayer = false; ///< Is a player.
-    bool m_bIsLaunchPad = false; ///< Is a Launch pad.
     bool m_bIsGrappler = false;
     bool m_bIsOneUp = false;
     bool m_bIsShotgun = false;
     bool m_bIsCreeper = false;
     bool m_bIsSwooper = false;
 
+    bool m_bThinks = false; ///< Has perception and decisions to schedule.
+    size_t m_nStaleFrames = 0; ///< Number of frames since it last thought.
+
+    eActivity m_eActivity = eActivity::Awake; ///< Activity tier.
+    size_t m_nPhase = 0; ///< Frame out of every few on which it updates when slow.
+    size_t m_nSpawn = SIZE_MAX; ///< Spawn record it was made from, `SIZE_MAX` if none.
+    uint32_t m_nStaticItem = UINT32_MAX; ///< Handle in the static object grid, `UINT32_MAX` if not in it.
+    uint8_t m_nTileProps = 0; ///< Property flags of the tiles it touched when it last collided.
+
     std::string m_bHealthString = "";
     float m_bHealthPercent = 1.0f;
 
@@ -56,6 +77,10 @@ class CObject:
     
     virtual void CollisionResponse(const Vector2&, float,
       CObject* = nullptr); ///< Collision response.
+    virtual void TileResponse(const Vector2&, float, uint8_t); ///< Response to touching a tile.
+    virtual void TileEnter(uint8_t); ///< Response to starting to touch tiles.
+    virtual void OverlapBegin(CObject*); ///< Response to starting to overlap a sensor.
+    virtual void OverlapEnd(CObject*); ///< Response to no longer overlapping a sensor.
     virtual void DeathFX(); ///< Death special effects.
 
     const Vector2 GetViewVector() const; ///< Compute view vector.
@@ -64,19 +89,21 @@ class CObject:
     CObject(eSprite, const Vector2&); ///< Constructor.
     virtual ~CObject(); ///< Destructor.
 
+    virtual void perceive(); ///< Ask for what the object needs to see.
+    virtual void think(); ///< Decide what to do.
+    virtual void SaveSpawn(SSpawnRecord&) const; ///< Keep state in a spawn record.
+    virtual void LoadSpawn(const SSpawnRecord&); ///< Get state from a spawn record.
     void move(); ///< Move object.
     void draw(); ///< Draw object.
 
     void drawHealthBar(); ///< Draw the healthbar if applicable.
 
     const bool isBullet() const; ///< Is a bullet.
-    const bool isSpike() const; ///< Is a spike
     const bool isDoor() const; ///< Is a door
     const bool isDoorLocked() const; ///< Is the door locked
     const bool isStar() const; ///< Is a star
     const bool isHealthPack() const; ///Is a healthpack
     const bool isPlayer() const; ///< Is a player.
-    const bool isLaunchPad() const; ///< Is a launch pad.
     const bool isGrappler() const; ///< Is a grappler
     const bool isOneUp() const; ///< Is a oneup
     const bool isShotgun() const; ///< Is a shotgun
@@ -1,19 +1,19 @@
 /// \file ObjectManager.cpp
 /// \brief Code for the the object manager class CObjectManager.
 
+#include <algorithm>
+
 #include "ObjectManager.h"
 #include "ComponentIncludes.h"
 
 #include "Player.h"
 #include "Turret.h"
 #include "Bullet.h"
-#include "Spike.h"
 #include "Door.h"
 #include "Star.h"
 #include "Bat.h"
 #include "Swooper.h"
 #include "Oneup.h"
-#include "LaunchPad.h"
 #include "ParticleEngine.h"
 #include "Helpers.h"
 #include "GameDefines.h"
@@ -23,6 +23,20 @@
 #include "Creeper.h"
 
 #include "Grappler.h"
+#include "SpawnTable.h"
+#include "FrameStats.h"
+
+static const float AI_ON_SCREEN = 4.0f; ///< Thinking weight of an object on screen.
+static const float AI_NEAR = 2.0f; ///< Thinking weight of an object near the player.
+static const float AI_NEAR_DISTANCE = 1024.0f; ///< How near to the player is near.
+
+static const float AWAKE_DISTANCE = 512.0f; ///< Awake when at most this far from the view or player.
+static const float SLOW_DISTANCE = 2048.0f; ///< Slow when at most this far, asleep beyond, and made from spawn records.
+static const float ACTIVITY_SLACK = 128.0f; ///< Extra distance before dropping a tier, to stop flicker.
+static const size_t SLOW_PERIOD = 4; ///< A slow object is tested against others and thinks once in this many frames.
+static const float STATIC_CELL_SIZE = 128.0f; ///< Width and height of a cell in the static object grid.
+static const float CAMERA_SPEED = 600.0f; ///< Pixels per second that the camera moves with the player running at top speed.
+static const uint8_t SOLID_TILES = (uint8_t)eTileProp::Hazard; ///< Tile properties that push objects back.
 
 /// Create an object and put a pointer to it at the back of the object list
 /// `m_stdObjectList`, which it inherits from `LBaseObjectManager`.
@@ -45,11 +59,9 @@ CObject* CObjectManager::create(eSprite t, const Vector2& pos){
     case eSprite::Turret:  pObj = new CTurret(pos); break;
     case eSprite::Bullet:  pObj = new CBullet(eSprite::Bullet,  pos); break;
     case eSprite::Bullet2: pObj = new CBullet(eSprite::Bullet2, pos); break;
-    case eSprite::Spike:   pObj = new CSpike(pos); break;
     case eSprite::Door:    pObj = new CDoor(eSprite::Door, pos); break;
     case eSprite::DoorOpen: pObj = new CDoor(eSprite::DoorOpen, pos); break;
     case eSprite::Star:    pObj = new CStar(pos); break;
-    case eSprite::LaunchPad:    pObj = new CLaunchPad(pos); break;
     case eSprite::Grappler:pObj = new CGrappler(eSprite::Grappler, pos); break;
     case eSprite::HealthPack:pObj = new CHealthPack(pos); break;
     case eSprite::OneUp:pObj = new COneUp(pos); break;
@@ -58,11 +70,260 @@ CObject* CObjectManager::create(eSprite t, const Vector2& pos){
     default: pObj = new CObject(t, pos);
   } //switch
   
+  pObj->m_nPhase = m_nCreated++%SLOW_PERIOD; //spread slow updates over frames
   m_stdObjectList.push_back(pObj); //push pointer onto object list
+  if(pObj->m_bStatic)AddStatic(pObj); //and static objects into the grid
   return pObj; //return pointer to created object
 } //create
 
-/// Draw the tiled background and the objects in the object list.
+/// Delete all of the objects in the object list, which is done at the start
+/// of each level, and empty the static object grid and size it to the
+/// level's world, so this must be called after the tile manager has the
+/// level.
+
+void CObjectManager::clear(){
+  LBaseObjectManager<CObject>::clear();
+
+  m_cStaticGrid.Set(m_vWorldSize.x, m_vWorldSize.y, STATIC_CELL_SIZE);
+  m_vecStatics.clear();
+  m_vecContacts.clear();
+} //clear
+
+/// Put a static object into the static object grid. Static objects never
+/// move, so it stays in the same cell until it is taken out.
+/// \param pObj Pointer to a static object.
+
+void CObjectManager::AddStatic(CObject* pObj){
+  const uint32_t n = m_cStaticGrid.Insert(pObj->m_vPos, pObj->m_fRadius); //handle
+  if(n >= m_vecStatics.size())m_vecStatics.resize(n + 1, nullptr);
+
+  m_vecStatics[n] = pObj;
+  pObj->m_nStaticItem = n;
+} //AddStatic
+
+/// Take an object out of the static object grid, which must be done before
+/// it is deleted. Objects not in the grid are left alone.
+/// \param pObj Pointer to an object.
+
+void CObjectManager::RemoveStatic(CObject* pObj){
+  const uint32_t n = pObj->m_nStaticItem; //handle
+  if(n == UINT32_MAX)return;
+
+  m_cStaticGrid.Erase(n);
+  m_vecStatics[n] = nullptr;
+  pObj->m_nStaticItem = UINT32_MAX;
+} //RemoveStatic
+
+/// Let the live objects that think and are due look around and decide, as
+/// many as the AI scheduler's budget allows, most important and longest
+/// waiting first.
+/// The ones picked ask for the line of sight queries that they need, the
+/// tile manager answers them all at once, and then they think. The others
+/// keep their old decisions for another frame. The time taken and the
+/// number of objects deferred go into the frame statistics.
+
+void CObjectManager::perceive(){
+  m_vecThinkers.clear();
+  m_cAiScheduler.Begin();
+
+  for(CObject* pObj: m_stdObjectList)
+    if(pObj->m_bThinks && !pObj->m_bDead && IsDue(pObj)){
+      m_vecThinkers.push_back(pObj);
+      m_cAiScheduler.Add(pObj->m_nStaleFrames, GetAiWeight(pObj));
+    } //if
+
+  const size_t n = m_cAiScheduler.Pick(); //number picked
+  m_pTileManager->BeginLosFrame();
+
+  for(size_t i=0; i<n; i++)
+    m_vecThinkers[m_cAiScheduler.GetChosen(i)]->perceive();
+
+  m_pTileManager->EvaluateLos();
+
+  for(CObject* pObj: m_vecThinkers)
+    pObj->m_nStaleFrames++;
+
+  for(size_t i=0; i<n; i++){
+    CObject* pObj = m_vecThinkers[m_cAiScheduler.GetChosen(i)];
+    pObj->think();
+    pObj->m_nStaleFrames = 0;
+  } //for
+
+  m_cAiScheduler.End();
+
+  m_sFrameStats.m_nAiUpdates += n;
+  m_sFrameStats.m_nAiDeferred += m_vecThinkers.size() - n;
+  m_sFrameStats.m_fAiTime += m_cAiScheduler.GetTimeUsed();
+  m_sFrameStats.m_fAiBudget = m_cAiScheduler.GetBudget();
+} //perceive
+
+/// Put each object into an activity tier by how far it is from the camera
+/// view and from the player, whichever is nearer. An object must get a
+/// little further away than the distance that woke it before it drops a
+/// tier, so that one on the edge doesn't flicker between tiers. This depends
+/// only on where things are, so objects wake the same way every time the
+/// player comes near. The player, its grappler, and bullets are always
+/// awake. The number of objects in each tier goes into the frame statistics.
+
+void CObjectManager::SetActivity(){
+  m_nFrame++;
+
+  size_t count[3] = {0, 0, 0}; //number in each tier
+
+  for(CObject* pObj: m_stdObjectList){
+    eActivity tier = eActivity::Awake; //new tier
+
+    if(!pObj->isPlayer() && !pObj->isGrappler() && !pObj->isBullet()){
+      float d = GetViewDistance(pObj->m_vPos) - pObj->m_fRadius; //distance from view
+
+      if(m_pPlayer)
+        d = std::min(d, Vector2::Distance(pObj->m_vPos, m_pPlayer->GetPos()));
+
+      const eActivity old = pObj->m_eActivity; //old tier
+      const float awake = AWAKE_DISTANCE + (old == eActivity::Awake? ACTIVITY_SLACK: 0.0f);
+      const float slow = SLOW_DISTANCE + (old != eActivity::Asleep? ACTIVITY_SLACK: 0.0f);
+
+      if(d > slow)tier = eActivity::Asleep;
+      else if(d > awake)tier = eActivity::Slow;
+    } //if
+
+    pObj->m_eActivity = tier;
+    count[(size_t)tier]++;
+  } //for
+
+  m_sFrameStats.m_nAwake = count[(size_t)eActivity::Awake];
+  m_sFrameStats.m_nSlow = count[(size_t)eActivity::Slow];
+  m_sFrameStats.m_nAsleep = count[(size_t)eActivity::Asleep];
+} //SetActivity
+
+/// Make an object from each dormant spawn record within the distance at
+/// which objects are slow, and store each object made from a spawn record
+/// back into it when the object is a little further away than that, so
+/// that one on the edge isn't made and stored over and over. The stored
+/// object keeps its state in the record. Only the records in cells near the
+/// camera view are looked at, so the number of objects made and the time
+/// taken depend on how crowded the map is near the camera, not on how many
+/// objects there are on the whole map. The counts go into the frame
+/// statistics.
+
+void CObjectManager::UpdateSpawns(){
+  CSpawnTable& table = m_pTileManager->GetSpawnTable(); //shorthand
+
+  for(auto it=m_stdObjectList.begin(); it!=m_stdObjectList.end();){ //store far objects
+    CObject* pObj = *it;
+
+    if(pObj->m_nSpawn != SIZE_MAX && !pObj->m_bDead &&
+      GetViewDistance(pObj->m_vPos) - pObj->m_fRadius > SLOW_DISTANCE + ACTIVITY_SLACK)
+    {
+      SSpawnRecord r = table.GetRecord((uint32_t)pObj->m_nSpawn); //copy of record
+      pObj->SaveSpawn(r);
+      table.Store((uint32_t)pObj->m_nSpawn, r);
+
+      RemoveStatic(pObj);
+      EndContacts(pObj);
+      delete pObj;
+      it = m_stdObjectList.erase(it);
+      m_sFrameStats.m_nStored++;
+    } //if
+
+    else ++it;
+  } //for
+
+  const Vector2 campos = m_pRenderer->GetCameraPos(); //camera position
+  const Vector2 v(0.5f*m_nWinWidth + SLOW_DISTANCE, 0.5f*m_nWinHeight + SLOW_DISTANCE);
+  table.Find(campos - v, campos + v, m_vecSpawns);
+
+  for(uint32_t n: m_vecSpawns){ //make near objects
+    const SSpawnRecord& r = table.GetRecord(n); //shorthand
+
+    if(GetViewDistance(r.m_vPos) <= SLOW_DISTANCE){
+      CObject* pObj = create(r.m_eSprite, r.m_vPos);
+      pObj->LoadSpawn(r);
+      pObj->m_nSpawn = n;
+      table.Wake(n);
+      m_sFrameStats.m_nSpawned++;
+    } //if
+  } //for
+
+  m_sFrameStats.m_nDormant = table.GetNumDormant();
+} //UpdateSpawns
+
+/// Determine whether an object is tested against other objects and thinks
+/// this frame, which an awake object does every frame and a slow one does
+/// once every few frames, on a frame set when it was created so that the
+/// slow objects are spread out over the frames.
+/// \param pObj Pointer to an object.
+/// \return true if the object is due for an update.
+
+const bool CObjectManager::IsDue(const CObject* pObj) const{
+  switch(pObj->m_eActivity){
+    case eActivity::Awake: return true;
+    case eActivity::Slow: return (m_nFrame + pObj->m_nPhase)%SLOW_PERIOD == 0;
+    default: return false;
+  } //switch
+} //IsDue
+
+/// Determine whether an object is one of the moving objects whose pairs
+/// the broad phase tests this frame. Static objects are found by the moving
+/// ones instead.
+/// \param pObj Pointer to an object.
+/// \return true if the object is tested against other objects this frame.
+
+const bool CObjectManager::IsCollider(const CObject* pObj) const{
+  return pObj->m_nStaticItem == UINT32_MAX && IsDue(pObj);
+} //IsCollider
+
+/// Move the objects that aren't asleep, then do collision detection and
+/// response for them, and delete the dead ones. The spawn
+/// records of dead objects are gone for good, dead static objects are taken
+/// out of the static object grid, and the sensor overlaps of dead objects
+/// end.
+
+void CObjectManager::move(){
+  for(CObject* pObj: m_stdObjectList)
+    if(pObj->m_eActivity != eActivity::Asleep)
+      pObj->move();
+
+  BroadPhase();
+
+  for(CObject* pObj: m_stdObjectList)
+    if(pObj->m_bDead){
+      if(pObj->m_nSpawn != SIZE_MAX)
+        m_pTileManager->GetSpawnTable().Remove((uint32_t)pObj->m_nSpawn);
+
+      RemoveStatic(pObj);
+      EndContacts(pObj);
+    } //if
+
+  CullDeadObjects();
+} //move
+
+/// Set the number of microseconds that objects may spend thinking each frame.
+/// \param t Microseconds per frame.
+
+void CObjectManager::SetAiBudget(float t){
+  m_cAiScheduler.SetBudget(t);
+} //SetAiBudget
+
+/// Get the weight that the AI scheduler gives to an object's thinking. An
+/// object on screen matters most, then one near the player.
+/// \param pObj Pointer to an object.
+/// \return Weight, at least 1.
+
+const float CObjectManager::GetAiWeight(const CObject* pObj) const{
+  if(InView(pObj->m_vPos, pObj->m_fRadius))
+    return AI_ON_SCREEN;
+
+  if(m_pPlayer && Vector2::DistanceSquared(pObj->m_vPos, m_pPlayer->GetPos()) <
+    AI_NEAR_DISTANCE*AI_NEAR_DISTANCE)
+    return AI_NEAR;
+
+  return 1.0f;
+} //GetAiWeight
+
+/// Draw the tiled background and the objects in the object list. Objects
+/// whose bounding circle is outside the camera view are not drawn. Objects
+/// whose health bar is showing get a bigger circle that takes in the bar.
 
 void CObjectManager::draw(){
   m_pTileManager->Draw(eSprite::Tile); //draw tiled background
@@ -70,19 +331,143 @@ void CObjectManager::draw(){
   if(m_bDrawAABBs)
     m_pTileManager->DrawBoundingBoxes(eSprite::Line); //draw AABBs
 
-  LBaseObjectManager::draw();
+  for(CObject* pObj: m_stdObjectList){
+    float r = pObj->m_fRadius; //radius of bounding circle
+
+    if(pObj->m_bHealthPercent < 1.0f && pObj->m_bHealthPercent > 0.0f)
+      r = std::max(r, 72.0f); //health bar is 70 wide and 60 above
+
+    if(InView(pObj->m_vPos, r)){
+      pObj->draw();
+      m_sFrameStats.m_nObjectsDrawn++;
+    } //if
+
+    else m_sFrameStats.m_nObjectsCulled++;
+  } //for
 } //draw
 
-/// Perform collision detection and response for each object with the world
-/// edges and for all objects with another object, making sure that each pair
-/// of objects is processed only once.
+/// Determine whether a circle overlaps the rectangle seen by the camera.
+/// The circle is treated as its bounding square, which is good enough for
+/// culling.
+/// \param p Center of circle.
+/// \param r Radius of circle.
+/// \return true if the circle may be seen.
+
+const bool CObjectManager::InView(const Vector2& p, float r) const{
+  const Vector2 campos = m_pRenderer->GetCameraPos(); //camera position
+
+  return fabsf(p.x - campos.x) <= 0.5f*m_nWinWidth + r &&
+    fabsf(p.y - campos.y) <= 0.5f*m_nWinHeight + r;
+} //InView
+
+/// Get the distance from a point to the rectangle seen by the camera.
+/// \param p Point.
+/// \return Distance from the rectangle, 0 if the point is inside it.
+
+const float CObjectManager::GetViewDistance(const Vector2& p) const{
+  const Vector2 campos = m_pRenderer->GetCameraPos(); //camera position
+  const float dx = std::max(0.0f, fabsf(p.x - campos.x) - 0.5f*m_nWinWidth);
+  const float dy = std::max(0.0f, fabsf(p.y - campos.y) - 0.5f*m_nWinHeight);
+
+  return sqrtf(dx*dx + dy*dy);
+} //GetViewDistance
+
+/// Create a particle unless it can't be seen during its lifetime. The camera
+/// view is tested against a circle that takes in the particle at its largest
+/// and everywhere that its velocity can take it, grown by how far the camera
+/// can move in that time with the player running toward it.
+/// \param d Particle descriptor.
+
+void CObjectManager::CreateParticle(LParticleDesc2D& d){
+  const float w = m_pRenderer->GetWidth(d.m_nSpriteIndex); //sprite width
+  const float h = m_pRenderer->GetHeight(d.m_nSpriteIndex); //sprite height
+  const float r = 0.5f*std::max(w, h)*std::max(1.0f, d.m_fMaxScale) +
+    (d.m_vVel.Length() + CAMERA_SPEED)*d.m_fLifeSpan; //radius of circle
+
+  if(InView(d.m_vPos, r))
+    m_pParticleEngine->create(d);
+
+  else m_sFrameStats.m_nParticlesCulled++;
+} //CreateParticle
+
+/// Perform collision detection and response for the moving objects that
+/// aren't asleep, each with the world edges and the tiles under it every
+/// frame, since they all move every frame. Only pairs of objects are tested
+/// at a reduced rate: the moving objects due this frame are tested against
+/// every other moving object that isn't asleep and against the static
+/// objects that the static object grid finds around them, or all of the
+/// static objects if there are too few for the grid to pay, making sure that
+/// each pair of objects is processed only once, so that an object that is
+/// always due, such as a bullet, can't pass through a slow one. Static
+/// objects are never tested against walls or each other, since neither of
+/// them would move and none of them respond to it. The number of pairs
+/// looked at goes into the frame statistics. Spikes and launch pads are
+/// tiles, which the tile manager finds under each moving object. Spikes
+/// push it back, and a launch pad only tells it when it gets on. Overlaps
+/// with sensors are gathered by the narrow phase and turned into events at
+/// the end.
 
 void CObjectManager::BroadPhase(){
-  LBaseObjectManager::BroadPhase(); //collide with other objects
+  m_vecColliders.clear();
+
+  for(CObject* pObj: m_stdObjectList)
+    if(pObj->m_nStaticItem == UINT32_MAX && pObj->m_eActivity != eActivity::Asleep)
+      m_vecColliders.push_back(pObj);
+
+  const auto due = std::partition(m_vecColliders.begin(), m_vecColliders.end(),
+    [this](const CObject* pObj){return IsDue(pObj);}); //due ones first
+
+  const size_t n = m_vecColliders.size(); //number of moving objects that collide
+  const size_t m = due - m_vecColliders.begin(); //number of them due for pair tests
+  size_t pairs = m*(m - 1)/2 + m*(n - m); //pairs looked at
+
+  for(size_t i=0; i<m; i++) //collide with other moving objects
+    for(size_t j=i + 1; j<n; j++)
+      NarrowPhase(m_vecColliders[i], m_vecColliders[j]);
+
+  if(m_cStaticGrid.IsWorthQuerying())
+    for(size_t i=0; i<m; i++){ //collide with static objects near it
+      CObject* pObj = m_vecColliders[i];
+      pairs += m_cStaticGrid.Query(pObj->m_vPos, pObj->m_fRadius, m_vecNear);
+
+      for(uint32_t k: m_vecNear)
+        NarrowPhase(pObj, m_vecStatics[k]);
+    } //for
+
+  else{ //too few static objects to be worth the grid
+    pairs += m*m_cStaticGrid.GetNumItems();
+
+    for(size_t i=0; i<m; i++) //collide with every static object
+      for(CObject* pStatic: m_vecStatics)
+        if(pStatic)NarrowPhase(m_vecColliders[i], pStatic);
+  } //else
+
+  for(CObject* pObj: m_vecColliders){ //touch tiles with properties
+    m_pTileManager->TouchTiles(pObj->m_vPos, pObj->m_fRadius, m_vecTouches);
+    uint8_t props = 0; //properties of all tiles touched
+
+    for(const STileTouch& t: m_vecTouches){
+      props |= t.m_nProps;
+
+      if(t.m_nProps & SOLID_TILES)
+        pObj->TileResponse(t.m_vNorm, t.m_fOverlap, t.m_nProps);
+    } //for
+
+    const uint8_t entered = props & ~pObj->m_nTileProps; //properties just touched
+    pObj->m_nTileProps = props;
+
+    if(entered){
+      pObj->TileEnter(entered);
+      m_sFrameStats.m_nTriggers++;
+    } //if
+  } //for
+
+  m_sFrameStats.m_nPairTests += pairs;
+  UpdateContacts();
 
   //collide with walls
 
-  for(CObject* pObj: m_stdObjectList) //for each object
+  for(CObject* pObj: m_vecColliders) //for each object
     if(!pObj->m_bDead){ //for each non-dead object, that is
       for(int i=0; i<2; i++){ //can collide with 2 edges simultaneously
         Vector2 norm; //collision normal
@@ -97,7 +482,8 @@ void CObjectManager::BroadPhase(){
 
 /// Perform collision detection and response for a pair of objects. Makes
 /// use of the helper function Identify() because this function may be called
-/// with the objects in an arbitrary order.
+/// with the objects in an arbitrary order. If either object is a sensor then
+/// there is no response, and the overlap is put into this frame's contacts.
 /// \param p0 Pointer to the first object.
 /// \param p1 Pointer to the second object.
 
@@ -105,7 +491,14 @@ void CObjectManager::NarrowPhase(CObject* p0, CObject* p1){
   Vector2 vSep = p0->m_vPos - p1->m_vPos; //vector from *p1 to *p0
   const float d = p0->m_fRadius + p1->m_fRadius - vSep.Length(); //overlap
 
-  if(d > 0.0f){ //bounding circles overlap
+  if(d > 0.0f && (p0->m_bSensor || p1->m_bSensor)){ //overlaps a sensor
+    SContact c;
+    c.m_pSensor = p0->m_bSensor? p0: p1;
+    c.m_pOther = p0->m_bSensor? p1: p0;
+    m_vecNewContacts.push_back(c);
+  } //if
+
+  else if(d > 0.0f){ //bounding circles overlap
     vSep.Normalize(); //vSep is now the collision normal
 
     p0->CollisionResponse( vSep, d, p1); //this changes separation of objects
@@ -113,6 +506,82 @@ void CObjectManager::NarrowPhase(CObject* p0, CObject* p1){
   } //if
 } //NarrowPhase
 
+/// Compare this frame's sensor overlaps with the last frame's and raise an
+/// overlap begin event on both objects of each new one, and an overlap end
+/// event on both objects of each one that has gone. Overlaps of pairs that
+/// weren't looked at this frame, because neither object was due, are kept
+/// as they were. Events are raised only on live objects, and a new overlap
+/// with a dead object is dropped, so every end follows a begin. The number
+/// of overlaps and events go into the frame statistics.
+
+void CObjectManager::UpdateContacts(){
+  for(const SContact& c: m_vecContacts) //keep pairs not looked at
+    if(!IsCollider(c.m_pSensor) && !IsCollider(c.m_pOther))
+      m_vecNewContacts.push_back(c);
+
+  std::sort(m_vecNewContacts.begin(), m_vecNewContacts.end());
+
+  auto i = m_vecContacts.begin(); //last frame's overlaps
+  auto j = m_vecNewContacts.begin(); //this frame's overlaps
+
+  while(i != m_vecContacts.end() || j != m_vecNewContacts.end()){
+    if(j == m_vecNewContacts.end() || (i != m_vecContacts.end() && *i < *j)){ //ended
+      if(!i->m_pOther->m_bDead)i->m_pOther->OverlapEnd(i->m_pSensor);
+      if(!i->m_pSensor->m_bDead)i->m_pSensor->OverlapEnd(i->m_pOther);
+      m_sFrameStats.m_nTriggers++;
+      ++i;
+    } //if
+
+    else if(i == m_vecContacts.end() || *j < *i){ //began
+      if(j->m_pOther->m_bDead || j->m_pSensor->m_bDead)
+        j->m_pSensor = nullptr; //drop it
+
+      else{
+        j->m_pOther->OverlapBegin(j->m_pSensor);
+        j->m_pSensor->OverlapBegin(j->m_pOther);
+        m_sFrameStats.m_nTriggers++;
+      } //else
+
+      ++j;
+    } //else if
+
+    else{ //still overlapping
+      ++i;
+      ++j;
+    } //else
+  } //while
+
+  m_vecNewContacts.erase(std::remove_if(m_vecNewContacts.begin(), m_vecNewContacts.end(),
+    [](const SContact& c){return c.m_pSensor == nullptr;}), m_vecNewContacts.end());
+
+  m_vecContacts.swap(m_vecNewContacts);
+  m_vecNewContacts.clear();
+  m_sFrameStats.m_nContacts = m_vecContacts.size();
+} //UpdateContacts
+
+/// End every sensor overlap that an object is in, raising an overlap end
+/// event on the other object of each if it is alive. This must be done
+/// before the object is deleted, so that no contact points to it.
+/// \param pObj Pointer to an object.
+
+void CObjectManager::EndContacts(CObject* pObj){
+  size_t k = 0; //number of contacts kept
+
+  for(const SContact& c: m_vecContacts){
+    CObject* pOther = c.m_pSensor == pObj? c.m_pOther: c.m_pOther == pObj? c.m_pSensor: nullptr;
+
+    if(pOther == nullptr)
+      m_vecContacts[k++] = c;
+
+    else if(!pOther->m_bDead){
+      pOther->OverlapEnd(pObj);
+      m_sFrameStats.m_nTriggers++;
+    } //else if
+  } //for
+
+  m_vecContacts.resize(k);
+} //EndContacts
+
 /// Create a bullet object and a flash particle effect. It is assumed that the
 /// object is round and that the bullet appears at the edge of the object in
 /// the direction that it is facing and continues moving in that direction.
@@ -157,7 +626,7 @@ void CObjectManager::FireGun(CObject* pObj, eSprite bullet){
   d.m_fMaxScale = 0.5f;
   d.m_f4Tint = XMFLOAT4(Colors::Yellow);
   
-  m_pParticleEngine->create(d);
+  CreateParticle(d);
 } //FireGun
 
 void CObjectManager::FireShotgun(CObject* pObj, eSprite bullet) {
@@ -182,14 +651,54 @@ const size_t CObjectManager::GetNumEnemies() const{
       
       if (pObj->m_nSpriteIndex == (UINT)eSprite::Swooper) n++;
   }
+
+  const CSpawnTable& table = m_pTileManager->GetSpawnTable(); //enemies not made yet
+  n += table.GetNumDormant(eSprite::Turret) + table.GetNumDormant(eSprite::Bat) +
+    table.GetNumDormant(eSprite::Creeper) + table.GetNumDormant(eSprite::Swooper);
     
   return n;
 } //GetNumTurrets
 
+/// Open every door. The sensor overlaps of each door end, so that a player
+/// already standing in one gets a fresh overlap begin event next frame and
+/// wins.
+
 void CObjectManager::SetDoorOpen() {
     for (CObject* pObj : m_stdObjectList) {
         if (pObj->m_nSpriteIndex == (UINT)eSprite::Door) {
             pObj->setDoorOpen();
+            EndContacts(pObj);
         }
     }
-}
\ No newline at end of file
+}
+
+/// Rasterize a camera-centered observation of the map and the live objects,
+/// with the objects grouped into channels by type. Spikes and launch pads
+/// come from the map. The scratch list of object
+/// positions is reused from frame to frame, so once it has grown to the
+/// number of objects nothing more is allocated.
+/// \param raster The rasterizer, which knows the size of the observation.
+/// \param out [out] Buffer of at least `raster.GetSize()` bytes.
+
+void CObjectManager::Observe(const CObsRaster& raster, uint8_t* out){
+  m_vecObsObjects.clear();
+
+  for(CObject* pObj: m_stdObjectList){
+    if(pObj->m_bDead || pObj->isGrappler())continue;
+
+    SObsObject obj;
+    obj.m_fX = pObj->m_vPos.x;
+    obj.m_fY = pObj->m_vPos.y;
+
+    if(pObj->isPlayer())obj.m_eChannel = eObsChannel::Player;
+    else if(pObj->isBullet())obj.m_eChannel = eObsChannel::Bullet;
+    else if(pObj->isDoor())obj.m_eChannel = eObsChannel::Door;
+    else if(pObj->isStar() || pObj->isHealthPack() || pObj->isOneUp() || pObj->isShotgun())
+      obj.m_eChannel = eObsChannel::Pickup;
+    else obj.m_eChannel = eObsChannel::Enemy;
+
+    m_vecObsObjects.push_back(obj);
+  } //for
+
+  m_pTileManager->Rasterize(raster, m_vecObsObjects.data(), m_vecObsObjects.size(), out);
+} //Observe
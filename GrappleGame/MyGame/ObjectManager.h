@@ -7,28 +7,102 @@
 #include "BaseObjectManager.h"
 #include "Object.h"
 #include "Common.h"
+#include "Settings.h"
+#include "Particle.h"
+#include "ObsRaster.h"
+#include "AiScheduler.h"
+#include "StaticGrid.h"
+#include "TileManager.h"
 
 /// \brief The object manager.
 ///
-/// A collection of all of the game objects.
+/// A collection of all of the game objects. Objects that think are given
+/// time to look around and decide by an AI scheduler, which favors those on
+/// screen or near the player and defers the rest when a frame's budget is
+/// spent. Objects far from the camera view and the player are put to sleep
+/// and left out of moving, collision, and thinking, and those part way out
+/// are tested against other objects and think at a reduced rate, though
+/// they still move and collide with walls and tiles every frame. The
+/// player, its grappler, and bullets are always awake. Objects placed on
+/// the map are made from their spawn records only when they come near the
+/// camera view, and stored back into them when they get far enough away.
+/// Objects that never move are kept in a static object grid as well as the
+/// object list, and collision detection tests each moving object only
+/// against the ones in the cells around it, never against walls or each
+/// other. Spikes and launch pads aren't objects but tiles, found under each
+/// moving object. Sensors, such as pickups and doors, and launch pads don't
+/// push anything back. Instead the objects that overlap them are told once
+/// when the overlap begins and once when it ends, from a list of contacts
+/// kept from frame to frame.
 
 class CObjectManager: 
   public LBaseObjectManager<CObject>,
-  public CCommon
+  public CCommon,
+  public LSettings
 {
   private:
+    /// \brief A sensor overlapping another object.
+
+    struct SContact{
+      CObject* m_pSensor = nullptr; ///< Pointer to the sensor.
+      CObject* m_pOther = nullptr; ///< Pointer to the object overlapping it.
+
+
+      /// Order contacts by sensor and then by the other object.
+      /// \param c Another contact.
+      /// \return true if this one comes first.
+
+      const bool operator<(const SContact& c) const{
+        return m_pSensor < c.m_pSensor || (m_pSensor == c.m_pSensor && m_pOther < c.m_pOther);
+      } //operator<
+    }; //SContact
+
+    std::vector<SObsObject> m_vecObsObjects; ///< Scratch space for observations.
+    std::vector<CObject*> m_vecThinkers; ///< Scratch space for objects that think.
+    std::vector<CObject*> m_vecColliders; ///< Scratch space for objects that collide.
+    std::vector<uint32_t> m_vecSpawns; ///< Scratch space for spawn records.
+    std::vector<uint32_t> m_vecNear; ///< Scratch space for static objects near a moving one.
+    std::vector<STileTouch> m_vecTouches; ///< Scratch space for tiles touched by a moving one.
+    std::vector<CObject*> m_vecStatics; ///< Static objects by handle in the static object grid.
+    std::vector<SContact> m_vecContacts; ///< Sensor overlaps as of the last frame, sorted.
+    std::vector<SContact> m_vecNewContacts; ///< Scratch space for this frame's sensor overlaps.
+    CStaticGrid m_cStaticGrid; ///< Static objects by where they are.
+    CAiScheduler m_cAiScheduler; ///< Decides which objects think each frame.
+
+    size_t m_nFrame = 0; ///< Number of frames since the game started.
+    size_t m_nCreated = 0; ///< Number of objects created, for staggering slow updates.
+
     void BroadPhase(); ///< Broad phase collision detection and response.
     void NarrowPhase(CObject*, CObject*); ///< Narrow phase collision detection and response.
+    void AddStatic(CObject*); ///< Put an object into the static object grid.
+    void RemoveStatic(CObject*); ///< Take an object out of the static object grid.
+    void UpdateContacts(); ///< Raise overlap events for sensor overlaps that began or ended.
+    void EndContacts(CObject*); ///< End every sensor overlap that an object is in.
+
+    const bool InView(const Vector2&, float) const; ///< Is a circle in the camera view?
+    const float GetViewDistance(const Vector2&) const; ///< Distance from the camera view.
+    const float GetAiWeight(const CObject*) const; ///< How much an object's thinking matters.
+    const bool IsDue(const CObject*) const; ///< Is an object tested against others and thinking this frame?
+    const bool IsCollider(const CObject*) const; ///< Is an object in this frame's pair tests?
 
   public:
     CObject* create(eSprite, const Vector2&); ///< Create new object.
+    void clear(); ///< Delete all objects and size the static object grid.
     
+    void UpdateSpawns(); ///< Make objects near the view and store far ones.
+    void SetActivity(); ///< Put objects into activity tiers.
+    void perceive(); ///< Let objects look around and decide.
+    void move(); ///< Move and collide the objects that are awake.
+    void SetAiBudget(float); ///< Set microseconds per frame for thinking.
     virtual void draw(); ///< Draw all objects.
 
     void FireGun(CObject*, eSprite); ///< Fire object's gun
     void FireShotgun(CObject*, eSprite); ///< Fire object's gun multiple times.
     const size_t GetNumEnemies() const; ///< Get number of turrets in object list.
     void SetDoorOpen();
+    void CreateParticle(LParticleDesc2D&); ///< Create a particle if it can be seen.
+
+    void Observe(const CObsRaster&, uint8_t*); ///< Rasterize an observation.
 }; //CObjectManager
 
 #endif //__L4RC_GAME_OBJECTMANAGER_H__
@@ -0,0 +1,173 @@
+/// \file ObsRaster.cpp
+/// \brief Code for the observation rasterizer CObsRaster.
+
+#include "ObsRaster.h"
+
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__SSE2__)
+  #include <emmintrin.h>
+  #define OBS_USE_SSE2 ///< Use SSE2 for the wall plane.
+#endif
+
+/// Construct a rasterizer for a given plane size.
+/// \param w Width of each plane in cells.
+/// \param h Height of each plane in cells.
+
+CObsRaster::CObsRaster(size_t w, size_t h):
+  m_nWidth(w), m_nHeight(h){
+} //constructor
+
+/// Reader function for the plane width.
+/// \return Width of each plane in cells.
+
+const size_t CObsRaster::GetWidth() const{
+  return m_nWidth;
+} //GetWidth
+
+/// Reader function for the plane height.
+/// \return Height of each plane in cells.
+
+const size_t CObsRaster::GetHeight() const{
+  return m_nHeight;
+} //GetHeight
+
+/// Get the number of bytes needed for the output buffer.
+/// \return Number of bytes in an observation.
+
+const size_t CObsRaster::GetSize() const{
+  return m_nWidth*m_nHeight*(size_t)eObsChannel::Size;
+} //GetSize
+
+/// Make one row of the wall plane. The part of the row that lies inside the
+/// map is compared against 'W' 16 tiles at a time, and the parts hanging off
+/// either end are filled as walls.
+/// \param row Map row, or `nullptr` if the row is off the map.
+/// \param n Width of the map in tiles.
+/// \param left Map column of the first cell, which may be negative.
+/// \param out [out] The row of the wall plane.
+
+void CObsRaster::WallRow(const char* row, size_t n, int left, uint8_t* out) const{
+  if(row == nullptr){ //whole row is off the map
+    memset(out, 255, m_nWidth);
+    return;
+  } //if
+
+  const int w = (int)m_nWidth;
+  const int j0 = std::max(0, -left); //first cell on the map
+  const int j1 = std::min(w, (int)n - left); //one past the last cell on the map
+
+  if(j1 <= j0){ //row misses the map
+    memset(out, 255, m_nWidth);
+    return;
+  } //if
+
+  memset(out, 255, j0);
+  memset(out + j1, 255, w - j1);
+
+  const char* src = row + left + j0;
+  uint8_t* dst = out + j0;
+  int k = j1 - j0; //cells left to do
+
+  #ifdef OBS_USE_SSE2
+    const __m128i wall = _mm_set1_epi8('W');
+
+    for(; k>=16; k-=16, src+=16, dst+=16){
+      const __m128i v = _mm_loadu_si128((const __m128i*)src);
+      _mm_storeu_si128((__m128i*)dst, _mm_cmpeq_epi8(v, wall));
+    } //for
+  #endif //OBS_USE_SSE2
+
+  for(; k>0; k--)
+    *dst++ = *src++ == 'W'? 255: 0;
+} //WallRow
+
+/// Mark the spike and launch pad tiles in one row of the hazard and launch
+/// pad planes, which must already be cleared. The part of the row that
+/// lies inside the map is compared against 'S' and 'L' 16 tiles at a time.
+/// \param row Map row.
+/// \param n Width of the map in tiles.
+/// \param left Map column of the first cell, which may be negative.
+/// \param hazard [out] The row of the hazard plane.
+/// \param pad [out] The row of the launch pad plane.
+
+void CObsRaster::ItemRow(const char* row, size_t n, int left, uint8_t* hazard,
+  uint8_t* pad) const
+{
+  const int j0 = std::max(0, -left); //first cell on the map
+  const int j1 = std::min((int)m_nWidth, (int)n - left); //one past the last cell on the map
+  int j = j0; //current cell
+
+  #ifdef OBS_USE_SSE2
+    const __m128i spike = _mm_set1_epi8('S');
+    const __m128i launch = _mm_set1_epi8('L');
+
+    for(; j+16<=j1; j+=16){
+      const __m128i v = _mm_loadu_si128((const __m128i*)(row + left + j));
+      _mm_storeu_si128((__m128i*)(hazard + j), _mm_cmpeq_epi8(v, spike));
+      _mm_storeu_si128((__m128i*)(pad + j), _mm_cmpeq_epi8(v, launch));
+    } //for
+  #endif //OBS_USE_SSE2
+
+  for(; j<j1; j++){
+    const char c = row[left + j];
+    if(c == 'S')hazard[j] = 255;
+    else if(c == 'L')pad[j] = 255;
+  } //for
+} //ItemRow
+
+/// Rasterize an observation into a caller-provided buffer of `GetSize()`
+/// bytes. The window is centered on the tile under the camera. Nothing is
+/// allocated.
+/// \param map Map rows, top row first, as in `CTileManager::m_chMap`.
+/// \param w Map width in tiles.
+/// \param h Map height in tiles.
+/// \param t Tile width and height.
+/// \param x Camera position x.
+/// \param y Camera position y.
+/// \param obj Array of objects.
+/// \param n Number of objects.
+/// \param out [out] Buffer for the observation.
+
+void CObsRaster::Rasterize(const char* const* map, size_t w, size_t h,
+  float t, float x, float y, const SObsObject* obj, size_t n, uint8_t* out) const
+{
+  const size_t plane = m_nWidth*m_nHeight; //bytes per plane
+
+  //map row and column of the top left cell
+
+  const int top  = (int)h - 1 - (int)floorf(y/t) - (int)m_nHeight/2;
+  const int left = (int)floorf(x/t) - (int)m_nWidth/2;
+
+  //wall plane
+
+  for(size_t i=0; i<m_nHeight; i++){
+    const int r = top + (int)i; //map row
+    const char* row = r >= 0 && r < (int)h? map[r]: nullptr;
+    WallRow(row, w, left, out + i*m_nWidth);
+  } //for
+
+  //object planes
+
+  memset(out + plane, 0, plane*((size_t)eObsChannel::Size - 1));
+
+  uint8_t* hazard = out + (size_t)eObsChannel::Hazard*plane; //hazard plane
+  uint8_t* pad = out + (size_t)eObsChannel::LaunchPad*plane; //launch pad plane
+
+  for(size_t i=0; i<m_nHeight; i++){ //spikes and launch pads
+    const int r = top + (int)i; //map row
+
+    if(r >= 0 && r < (int)h)
+      ItemRow(map[r], w, left, hazard + i*m_nWidth, pad + i*m_nWidth);
+  } //for
+
+  for(size_t k=0; k<n; k++){
+    const int i = (int)h - 1 - (int)floorf(obj[k].m_fY/t) - top;
+    const int j = (int)floorf(obj[k].m_fX/t) - left;
+
+    if(i >= 0 && i < (int)m_nHeight && j >= 0 && j < (int)m_nWidth)
+      out[(size_t)obj[k].m_eChannel*plane + i*m_nWidth + j] = 255;
+  } //for
+} //Rasterize
@@ -0,0 +1,63 @@
+/// \file ObsRaster.h
+/// \brief Interface for the observation rasterizer CObsRaster.
+
+#ifndef __L4RC_GAME_OBSRASTER_H__
+#define __L4RC_GAME_OBSRASTER_H__
+
+#include <cstdint>
+#include <cstddef>
+
+/// \brief Observation channel.
+///
+/// An enumerated type for the channels of an observation, which will be cast
+/// to an unsigned integer and used as the index of the corresponding plane.
+/// `Size` must be last.
+
+enum class eObsChannel: uint8_t{
+  Wall, Player, Enemy, Bullet, Hazard, Pickup, Door, LaunchPad,
+  Size //MUST BE LAST
+}; //eObsChannel
+
+/// \brief An object to be rasterized.
+///
+/// The position of an object in world space and the channel that it is to be
+/// drawn into.
+
+struct SObsObject{
+  float m_fX = 0.0f; ///< Position x.
+  float m_fY = 0.0f; ///< Position y.
+  eObsChannel m_eChannel = eObsChannel::Wall; ///< Channel.
+}; //SObsObject
+
+/// \brief The observation rasterizer.
+///
+/// CObsRaster writes a low-resolution view of the world into a caller-provided
+/// byte buffer, one cell per tile, centered on the camera. The buffer holds
+/// one plane per `eObsChannel`, each plane row-major from the top row down,
+/// with 255 where the channel is present and 0 elsewhere. Tiles off the edge
+/// of the map count as walls. The wall plane is made 16 tiles at a time with
+/// SSE2 compares straight from the rows of `m_chMap`, the other planes are
+/// cleared with `memset` and the objects are scattered into them. Spikes
+/// and launch pads are tiles, so they go into the hazard and launch pad
+/// planes from the map in the same way as walls.
+
+class CObsRaster{
+  private:
+    size_t m_nWidth = 64; ///< Width of a plane in cells.
+    size_t m_nHeight = 64; ///< Height of a plane in cells.
+
+    void WallRow(const char*, size_t, int, uint8_t*) const; ///< Make one row of the wall plane.
+    void ItemRow(const char*, size_t, int, uint8_t*, uint8_t*) const; ///< Mark spikes and launch pads in one row.
+
+  public:
+    CObsRaster(size_t, size_t); ///< Constructor.
+
+    const size_t GetWidth() const; ///< Get plane width.
+    const size_t GetHeight() const; ///< Get plane height.
+    const size_t GetSize() const; ///< Get buffer size in bytes.
+
+    void Rasterize(const char* const*, size_t, size_t, float, float, float,
+      const SObsObject*, size_t, uint8_t*) const; ///< Rasterize an observation.
+}; //CObsRaster
+
+#endif //__L4RC_GAME_OBSRASTER_H__
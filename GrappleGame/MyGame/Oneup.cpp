@@ -11,16 +11,19 @@ COneUp::COneUp(const Vector2& p) : CObject(eSprite::OneUp, p)
 {
     m_bIsTarget = false;
     m_bStatic = true;
+    m_bSensor = true;
     m_bIsOneUp = true;
 }
 
-void COneUp::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
+/// Response to the start of an overlap. The one up is picked up, and so
+/// dies, when the player first touches it.
+/// \param pObj Pointer to the other object.
+
+void COneUp::OverlapBegin(CObject* pObj) {
     if (m_bDead)return; //already dead, bail out 
 
-    if (pObj && pObj->isPlayer())
+    if (pObj->isPlayer())
     {
         m_bDead = true; //flag for deletion from object list
     }
-
-    CObject::CollisionResponse(norm, d, pObj);
-} //CollisionResponse
\ No newline at end of file
+} //OverlapBegin
\ No newline at end of file
@@ -14,7 +14,7 @@
 class COneUp : public CObject {
 	\
 protected:
-	virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
+	virtual void OverlapBegin(CObject*); ///< Response to starting to overlap.
 public:
 	COneUp(const Vector2& p);
 };
@@ -0,0 +1,485 @@
+/// \file PathFinder.cpp
+/// \brief Code for the path finder CPathFinder.
+
+#include "PathFinder.h"
+
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static const uint32_t STRAIGHT = 10; ///< Cost of a straight step.
+static const uint32_t DIAGONAL = 14; ///< Cost of a diagonal step, about 10 root 2.
+
+/// Get the index of the lowest set bit.
+/// \param x A word that isn't zero.
+/// \return Index of its lowest set bit.
+
+static inline int LowBit(uint64_t x){
+#ifdef _MSC_VER
+  unsigned long n;
+  _BitScanForward64(&n, x);
+  return (int)n;
+#else
+  return __builtin_ctzll(x);
+#endif
+} //LowBit
+
+/// Get the index of the highest set bit.
+/// \param x A word that isn't zero.
+/// \return Index of its highest set bit.
+
+static inline int HighBit(uint64_t x){
+#ifdef _MSC_VER
+  unsigned long n;
+  _BitScanReverse64(&n, x);
+  return (int)n;
+#else
+  return 63 - __builtin_clzll(x);
+#endif
+} //HighBit
+
+/// Scan a line of bits for the first place to stop, which is a closed bit
+/// in the line or a bit that is open on a side line when the one before it
+/// was closed. A side opening up is where a path along the line might turn.
+/// The line must have a closed bit at each end so that the scan stops, and
+/// a spare word past the last.
+/// \param line Open bits of the line.
+/// \param a Open bits of the line on one side.
+/// \param b Open bits of the line on the other side.
+/// \param p Bit to start from.
+/// \param d Direction, 1 or -1.
+/// \return Index of the bit to stop at.
+
+static int Scan(const uint64_t* line, const uint64_t* a, const uint64_t* b, int p, int d){
+  int k = p >> 6; //word
+
+  if(d > 0){
+    uint64_t mask = ~0ULL << (p & 63); //ignore bits before p
+
+    while(true){
+      const uint64_t a0 = a[k] << 1 | (k > 0? a[k - 1] >> 63: 0); //a shifted forward a bit
+      const uint64_t b0 = b[k] << 1 | (k > 0? b[k - 1] >> 63: 0); //b shifted forward a bit
+      const uint64_t stop = (~line[k] | (a[k] & ~a0) | (b[k] & ~b0)) & mask;
+      if(stop)return (k << 6) + LowBit(stop);
+      mask = ~0ULL; k++;
+    } //while
+  } //if
+
+  else{
+    uint64_t mask = ~0ULL >> (63 - (p & 63)); //ignore bits after p
+
+    while(true){
+      const uint64_t a0 = a[k] >> 1 | a[k + 1] << 63; //a shifted back a bit
+      const uint64_t b0 = b[k] >> 1 | b[k + 1] << 63; //b shifted back a bit
+      const uint64_t stop = (~line[k] | (a[k] & ~a0) | (b[k] & ~b0)) & mask;
+      if(stop)return (k << 6) + HighBit(stop);
+      mask = ~0ULL; k--;
+    } //while
+  } //else
+} //Scan
+
+/// Use a new map. Any tile that isn't a wall `W` is open. This drops every
+/// cached path.
+/// \param map The map, an array of rows top row first.
+/// \param w Number of tiles wide.
+/// \param h Number of tiles high.
+
+void CPathFinder::SetMap(const char* const* map, size_t w, size_t h){
+  m_nWidth = w;
+  m_nHeight = h;
+
+  m_vecOpen.resize(w*h);
+
+  for(size_t i=0; i<h; i++)
+    for(size_t j=0; j<w; j++)
+      m_vecOpen[i*w + j] = map[i][j] != 'W';
+
+  m_nRowWords = (w + 2)/64 + 2;
+  m_nColWords = (h + 2)/64 + 2;
+  m_vecRowBits.assign((h + 2)*m_nRowWords, 0);
+  m_vecColBits.assign((w + 2)*m_nColWords, 0);
+
+  for(size_t i=0; i<h; i++)
+    for(size_t j=0; j<w; j++)
+      SetBits(i, j, m_vecOpen[i*w + j] != 0);
+
+  m_vecCost.assign(w*h, 0);
+  m_vecParent.assign(w*h, 0);
+  m_vecStamp.assign(w*h, 0);
+  m_nStamp = 0;
+
+  ClearCache();
+} //SetMap
+
+/// Open or close a tile. Any cached path might now be wrong, so they are
+/// all dropped.
+/// \param i Row.
+/// \param j Column.
+/// \param open true if the tile is to be open, false for a wall.
+
+void CPathFinder::SetOpen(size_t i, size_t j, bool open){
+  if(i >= m_nHeight || j >= m_nWidth || m_vecOpen[i*m_nWidth + j] == (uint8_t)open)
+    return; //nothing to do
+
+  m_vecOpen[i*m_nWidth + j] = open;
+  SetBits(i, j, open);
+  ClearCache();
+} //SetOpen
+
+/// Set the maximum number of searches per frame.
+/// \param n Number of searches.
+
+void CPathFinder::SetBudget(size_t n){
+  m_nBudget = n;
+} //SetBudget
+
+/// Set the maximum number of cached paths, dropping the least recently used
+/// ones if there are too many.
+/// \param n Number of paths.
+
+void CPathFinder::SetCacheSize(size_t n){
+  m_nCacheSize = n;
+
+  while(m_listCache.size() > m_nCacheSize){
+    m_mapCache.erase(m_listCache.back().m_nKey);
+    m_listCache.pop_back();
+  } //while
+} //SetCacheSize
+
+/// Drop all cached paths.
+
+void CPathFinder::ClearCache(){
+  m_listCache.clear();
+  m_mapCache.clear();
+} //ClearCache
+
+/// Start a new frame, resetting the number of searches left in the budget.
+
+void CPathFinder::BeginFrame(){
+  m_nFrameSearches = 0;
+} //BeginFrame
+
+/// Check whether a tile is open. Tiles off the map are walls.
+/// \param x Column.
+/// \param y Row.
+/// \return true if the tile is on the map and is not a wall.
+
+const bool CPathFinder::IsOpen(int x, int y) const{
+  return x >= 0 && y >= 0 && x < (int)m_nWidth && y < (int)m_nHeight &&
+    m_vecOpen[y*m_nWidth + x] != 0;
+} //IsOpen
+
+/// Set the bits for a tile in the row and column masks. The masks have a
+/// border of closed tiles, so tile (i, j) is bit j + 1 of row i + 1 and bit
+/// i + 1 of column j + 1.
+/// \param i Row.
+/// \param j Column.
+/// \param open true if the tile is open.
+
+void CPathFinder::SetBits(size_t i, size_t j, bool open){
+  uint64_t& r = m_vecRowBits[(i + 1)*m_nRowWords + ((j + 1) >> 6)]; //word in row
+  uint64_t& c = m_vecColBits[(j + 1)*m_nColWords + ((i + 1) >> 6)]; //word in column
+  const uint64_t rbit = 1ULL << ((j + 1) & 63), cbit = 1ULL << ((i + 1) & 63); //bits in words
+
+  if(open){r |= rbit; c |= cbit;}
+  else{r &= ~rbit; c &= ~cbit;}
+} //SetBits
+
+/// The octile distance, which is the cost of the shortest path between two
+/// tiles if there are no walls in the way.
+/// \param x0 First column.
+/// \param y0 First row.
+/// \param x1 Second column.
+/// \param y1 Second row.
+/// \return Estimated cost.
+
+const uint32_t CPathFinder::Heuristic(int x0, int y0, int x1, int y1) const{
+  const uint32_t dx = (uint32_t)std::abs(x1 - x0), dy = (uint32_t)std::abs(y1 - y0);
+  return STRAIGHT*std::max(dx, dy) + (DIAGONAL - STRAIGHT)*std::min(dx, dy);
+} //Heuristic
+
+/// Step from a tile in a direction until reaching a jump point, which is the
+/// goal or a tile where a shortest path might turn. A straight jump stops
+/// beside the end of a wall, since that opens up a tile that couldn't be
+/// reached before without cutting the corner. A diagonal jump stops where a
+/// straight jump from it would stop, and fails if the next diagonal step
+/// would cut a corner.
+/// \param x Column to start from.
+/// \param y Row to start from.
+/// \param dx Column direction.
+/// \param dy Row direction.
+/// \param gx Goal column.
+/// \param gy Goal row.
+/// \return Index of the jump point, -1 if a wall was reached first.
+
+const int CPathFinder::Jump(int x, int y, int dx, int dy, int gx, int gy) const{
+  if(dx == 0 || dy == 0)
+    return JumpStraight(x, y, dx, dy, gx, gy);
+
+  while(true){ //diagonal
+    x += dx; y += dy;
+    if(!IsOpen(x, y))return -1;
+
+    const int n = y*(int)m_nWidth + x; //this tile
+    if(x == gx && y == gy)return n;
+
+    if(JumpStraight(x, y, dx, 0, gx, gy) >= 0 || JumpStraight(x, y, 0, dy, gx, gy) >= 0)
+      return n;
+
+    if(!IsOpen(x + dx, y) || !IsOpen(x, y + dy))
+      return -1; //next step would cut a corner
+  } //while
+} //Jump
+
+/// Jump along a row or column. This stops at the first closed tile, or the
+/// first tile with an open tile beside it where the one behind that was
+/// closed, whichever comes first, found from the bit masks 64 tiles at a
+/// time.
+/// \param x Column to start from.
+/// \param y Row to start from.
+/// \param dx Column direction.
+/// \param dy Row direction.
+/// \param gx Goal column.
+/// \param gy Goal row.
+/// \return Index of the jump point, -1 if a wall was reached first.
+
+const int CPathFinder::JumpStraight(int x, int y, int dx, int dy, int gx, int gy) const{
+  int stop; //where the scan stopped, in mask coordinates
+  int goal = -1; //goal in mask coordinates if it is on the line ahead
+
+  if(dx != 0){ //along row y, which is row y + 1 of the masks
+    const uint64_t* row = &m_vecRowBits[(y + 1)*m_nRowWords]; //this row
+    stop = Scan(row, row - m_nRowWords, row + m_nRowWords, x + 1 + dx, dx);
+    if(gy == y && (gx - x)*dx > 0)goal = gx + 1;
+  } //if
+
+  else{ //along column x, which is column x + 1 of the masks
+    const uint64_t* col = &m_vecColBits[(x + 1)*m_nColWords]; //this column
+    stop = Scan(col, col - m_nColWords, col + m_nColWords, y + 1 + dy, dy);
+    if(gx == x && (gy - y)*dy > 0)goal = gy + 1;
+  } //else
+
+  const int d = dx + dy; //direction along the line
+  if(goal >= 0 && (stop - goal)*d >= 0)
+    return gy*(int)m_nWidth + gx; //reached the goal first
+
+  const int sx = dx != 0? stop - 1: x, sy = dy != 0? stop - 1: y; //stopping tile
+  return IsOpen(sx, sy)? sy*(int)m_nWidth + sx: -1;
+} //JumpStraight
+
+/// Jump from a tile in a direction and, if that finds a jump point by a
+/// path cheaper than any found so far, record the path and add the jump
+/// point to the open list.
+/// \param n Index of the tile to jump from.
+/// \param x Its column.
+/// \param y Its row.
+/// \param dx Column direction.
+/// \param dy Row direction.
+/// \param gx Goal column.
+/// \param gy Goal row.
+
+void CPathFinder::Visit(uint32_t n, int x, int y, int dx, int dy, int gx, int gy){
+  const int m = Jump(x, y, dx, dy, gx, gy); //jump point
+  if(m < 0)return;
+
+  const int mx = m%(int)m_nWidth, my = m/(int)m_nWidth; //its column and row
+  const uint32_t cost = m_vecCost[n] + Heuristic(x, y, mx, my); //cost of path to it
+
+  if(m_vecStamp[m] == m_nStamp && m_vecCost[m] <= cost)
+    return; //already have one as cheap
+
+  m_vecStamp[m] = m_nStamp;
+  m_vecCost[m] = cost;
+  m_vecParent[m] = n;
+
+  const uint64_t f = cost + Heuristic(mx, my, gx, gy); //estimated cost through it
+  m_vecHeap.push_back(f << 32 | (uint32_t)m);
+  std::push_heap(m_vecHeap.begin(), m_vecHeap.end(), std::greater<uint64_t>());
+} //Visit
+
+/// Jump Point Search from one open tile to another. Tiles on the open list
+/// whose cost has since come down are left there and skipped when they come
+/// off it. The directions tried from each jump point are the ones that a
+/// shortest path through it could take next, given the direction it came
+/// from, and all eight from the start.
+/// \param start Index of start tile.
+/// \param goal Index of goal tile.
+/// \param path [out] The path, empty if there is none.
+
+void CPathFinder::Search(uint32_t start, uint32_t goal, Path& path){
+  path.clear();
+  m_nSearches++;
+  m_nFrameSearches++;
+
+  if(++m_nStamp == 0){ //stamps wrapped around
+    std::fill(m_vecStamp.begin(), m_vecStamp.end(), 0);
+    m_nStamp = 1;
+  } //if
+
+  const int w = (int)m_nWidth; //shorthand
+  const int gx = goal%w, gy = goal/w; //goal column and row
+
+  m_vecHeap.clear();
+  m_vecStamp[start] = m_nStamp;
+  m_vecCost[start] = 0;
+  m_vecParent[start] = start;
+  m_vecHeap.push_back((uint64_t)Heuristic(start%w, start/w, gx, gy) << 32 | start);
+
+  while(!m_vecHeap.empty()){
+    std::pop_heap(m_vecHeap.begin(), m_vecHeap.end(), std::greater<uint64_t>());
+    const uint64_t top = m_vecHeap.back();
+    m_vecHeap.pop_back();
+
+    const uint32_t n = (uint32_t)top; //tile
+    const int x = n%w, y = n/w; //its column and row
+
+    if((top >> 32) != m_vecCost[n] + Heuristic(x, y, gx, gy))
+      continue; //stale entry
+
+    if(n == goal){ //found it, so follow the parents back
+      for(uint32_t m=goal; m!=start; m=m_vecParent[m])
+        path.push_back(m);
+
+      path.push_back(start);
+      std::reverse(path.begin(), path.end());
+      return;
+    } //if
+
+    const uint32_t p = m_vecParent[n]; //parent
+    const int px = p%w, py = p/w; //its column and row
+
+    if(p == n){ //start, so try every direction
+      for(int dy=-1; dy<=1; dy++)
+        for(int dx=-1; dx<=1; dx++)
+          if((dx != 0 || dy != 0) && (dx == 0 || dy == 0 ||
+            (IsOpen(x + dx, y) && IsOpen(x, y + dy))))
+            Visit(n, x, y, dx, dy, gx, gy);
+    } //if
+
+    else{
+      const int dx = (x > px) - (x < px), dy = (y > py) - (y < py); //direction of travel
+
+      if(dx != 0 && dy != 0){ //diagonal
+        const bool bx = IsOpen(x + dx, y), by = IsOpen(x, y + dy); //straight steps open
+
+        if(by)Visit(n, x, y, 0, dy, gx, gy);
+        if(bx)Visit(n, x, y, dx, 0, gx, gy);
+        if(bx && by)Visit(n, x, y, dx, dy, gx, gy);
+      } //if
+
+      else if(dx != 0){ //horizontal
+        const bool ahead = IsOpen(x + dx, y); //next step open
+        const bool up = IsOpen(x, y - 1), down = IsOpen(x, y + 1); //sides open
+
+        if(ahead){
+          Visit(n, x, y, dx, 0, gx, gy);
+          if(up)Visit(n, x, y, dx, -1, gx, gy);
+          if(down)Visit(n, x, y, dx, 1, gx, gy);
+        } //if
+
+        if(up)Visit(n, x, y, 0, -1, gx, gy);
+        if(down)Visit(n, x, y, 0, 1, gx, gy);
+      } //else if
+
+      else{ //vertical
+        const bool ahead = IsOpen(x, y + dy); //next step open
+        const bool left = IsOpen(x - 1, y), right = IsOpen(x + 1, y); //sides open
+
+        if(ahead){
+          Visit(n, x, y, 0, dy, gx, gy);
+          if(left)Visit(n, x, y, -1, dy, gx, gy);
+          if(right)Visit(n, x, y, 1, dy, gx, gy);
+        } //if
+
+        if(left)Visit(n, x, y, -1, 0, gx, gy);
+        if(right)Visit(n, x, y, 1, 0, gx, gy);
+      } //else
+    } //else
+  } //while
+} //Search
+
+/// Find a path from one tile to another, from the cache if it is there and
+/// by searching if not. If the search budget for this frame has been spent
+/// then the query is deferred and should be made again next frame.
+/// \param start Index of the start tile.
+/// \param goal Index of the goal tile.
+/// \param path [out] The tiles where the path turns, from start to goal.
+/// Unchanged unless a path was found.
+/// \return Whether a path was found, there is none, or the query was
+/// deferred.
+
+const ePathResult CPathFinder::FindPath(size_t start, size_t goal, std::vector<uint32_t>& path){
+  if(start >= m_vecOpen.size() || goal >= m_vecOpen.size() ||
+    !m_vecOpen[start] || !m_vecOpen[goal])return ePathResult::None;
+
+  const uint64_t key = (uint64_t)start << 32 | goal; //cache key
+  auto i = m_mapCache.find(key);
+
+  if(i != m_mapCache.end()){ //cache hit
+    m_listCache.splice(m_listCache.begin(), m_listCache, i->second);
+    m_nHits++;
+
+    if(i->second->m_vecTiles.empty())return ePathResult::None;
+    path = i->second->m_vecTiles;
+    return ePathResult::Found;
+  } //if
+
+  if(m_nFrameSearches >= m_nBudget){ //over budget
+    m_nDeferred++;
+    return ePathResult::Deferred;
+  } //if
+
+  SCachedPath entry;
+  entry.m_nKey = key;
+  Search((uint32_t)start, (uint32_t)goal, entry.m_vecTiles);
+
+  const bool found = !entry.m_vecTiles.empty(); //whether there is a path
+  if(found)path = entry.m_vecTiles;
+
+  if(m_nCacheSize > 0){
+    m_listCache.push_front(std::move(entry));
+    m_mapCache[key] = m_listCache.begin();
+    SetCacheSize(m_nCacheSize); //drop the least recently used if too many
+  } //if
+
+  return found? ePathResult::Found: ePathResult::None;
+} //FindPath
+
+/// Reader function for the width.
+/// \return Width in tiles.
+
+const size_t CPathFinder::GetWidth() const{
+  return m_nWidth;
+} //GetWidth
+
+/// Reader function for the height.
+/// \return Height in tiles.
+
+const size_t CPathFinder::GetHeight() const{
+  return m_nHeight;
+} //GetHeight
+
+/// Reader function for the number of searches.
+/// \return Number of searches made.
+
+const size_t CPathFinder::GetNumSearches() const{
+  return m_nSearches;
+} //GetNumSearches
+
+/// Reader function for the number of cache hits.
+/// \return Number of queries answered from the cache.
+
+const size_t CPathFinder::GetNumHits() const{
+  return m_nHits;
+} //GetNumHits
+
+/// Reader function for the number of deferred queries.
+/// \return Number of queries deferred because the budget was spent.
+
+const size_t CPathFinder::GetNumDeferred() const{
+  return m_nDeferred;
+} //GetNumDeferred
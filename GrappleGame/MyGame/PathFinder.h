@@ -0,0 +1,99 @@
+/// \file PathFinder.h
+/// \brief Interface for the path finder CPathFinder.
+
+#ifndef __L4RC_GAME_PATHFINDER_H__
+#define __L4RC_GAME_PATHFINDER_H__
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/// \brief Result of a path query.
+///
+/// An enumerated type for what came of asking for a path.
+
+enum class ePathResult{
+  Found, None, Deferred
+}; //ePathResult
+
+/// \brief The path finder.
+///
+/// CPathFinder finds shortest paths between tiles of the map with Jump Point
+/// Search, which is A* over the 8-neighbors of each open tile that skips
+/// along straight and diagonal runs of open tiles and only stops at the
+/// tiles where a path can turn. Diagonal steps must not cut the corner of a
+/// wall. Straight jumps test 64 tiles at a time from bit masks of the open
+/// tiles in each row and column. A path is the list of tiles where it turns,
+/// from the start to the goal, and each leg between them is a straight or
+/// diagonal line through open tiles. Recently found paths are kept by start
+/// and goal tile, least recently used dropped first, and are all thrown away
+/// when a tile changes. A budget caps the number of searches each frame, and
+/// a query that would go over it is deferred to a later frame. Cache hits
+/// are free. Tiles are indexed row by row from the top left of the map,
+/// which is how `m_chMap` is laid out.
+
+class CPathFinder{
+  private:
+    using Path = std::vector<uint32_t>; ///< Tiles where a path turns.
+
+    /// \brief A cached path.
+
+    struct SCachedPath{
+      uint64_t m_nKey = 0; ///< Start and goal tile.
+      Path m_vecTiles; ///< The path, empty if there is none.
+    }; //SCachedPath
+
+    size_t m_nWidth = 0; ///< Number of tiles wide.
+    size_t m_nHeight = 0; ///< Number of tiles high.
+    std::vector<uint8_t> m_vecOpen; ///< 1 if a tile is not a wall.
+
+    size_t m_nRowWords = 0; ///< Number of 64-bit words per row of bits.
+    size_t m_nColWords = 0; ///< Number of 64-bit words per column of bits.
+    std::vector<uint64_t> m_vecRowBits; ///< Open tiles by row, with a border of walls.
+    std::vector<uint64_t> m_vecColBits; ///< Open tiles by column, with a border of walls.
+
+    std::vector<uint32_t> m_vecCost; ///< Cost of best path so far to each tile.
+    std::vector<uint32_t> m_vecParent; ///< Previous jump point on that path.
+    std::vector<uint32_t> m_vecStamp; ///< Search that the cost and parent belong to.
+    std::vector<uint64_t> m_vecHeap; ///< Open list, estimated cost then tile.
+    uint32_t m_nStamp = 0; ///< Current search.
+
+    std::list<SCachedPath> m_listCache; ///< Cached paths, most recently used first.
+    std::unordered_map<uint64_t, std::list<SCachedPath>::iterator> m_mapCache; ///< Cached paths by key.
+    size_t m_nCacheSize = 256; ///< Maximum number of cached paths.
+
+    size_t m_nBudget = 8; ///< Maximum number of searches per frame.
+    size_t m_nFrameSearches = 0; ///< Number of searches this frame.
+
+    size_t m_nSearches = 0; ///< Number of searches made.
+    size_t m_nHits = 0; ///< Number of queries answered from the cache.
+    size_t m_nDeferred = 0; ///< Number of queries deferred.
+
+    const bool IsOpen(int, int) const; ///< Is a tile open?
+    void SetBits(size_t, size_t, bool); ///< Set a tile's bits.
+    const int JumpStraight(int, int, int, int, int, int) const; ///< Jump along a row or column.
+    const uint32_t Heuristic(int, int, int, int) const; ///< Estimated cost between tiles.
+    const int Jump(int, int, int, int, int, int) const; ///< Jump along a direction.
+    void Visit(uint32_t, int, int, int, int, int, int); ///< Jump to a neighbor and add it to the open list.
+    void Search(uint32_t, uint32_t, Path&); ///< Jump Point Search.
+
+  public:
+    void SetMap(const char* const*, size_t, size_t); ///< Use a new map.
+    void SetOpen(size_t, size_t, bool); ///< Change a tile.
+    void SetBudget(size_t); ///< Set searches per frame.
+    void SetCacheSize(size_t); ///< Set number of cached paths.
+    void ClearCache(); ///< Drop all cached paths.
+    void BeginFrame(); ///< Start a new frame's budget.
+
+    const ePathResult FindPath(size_t, size_t, std::vector<uint32_t>&); ///< Find a path.
+
+    const size_t GetWidth() const; ///< Get width in tiles.
+    const size_t GetHeight() const; ///< Get height in tiles.
+    const size_t GetNumSearches() const; ///< Get number of searches made.
+    const size_t GetNumHits() const; ///< Get number of cache hits.
+    const size_t GetNumDeferred() const; ///< Get number of deferred queries.
+}; //CPathFinder
+
+#endif //__L4RC_GAME_PATHFINDER_H__
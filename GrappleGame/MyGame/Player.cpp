@@ -110,53 +110,6 @@ void CPlayer::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
         return;
     }
 
-    if (pObj && pObj->isSpike())
-    {
-        m_nHealth = 0;
-        m_pAudio->play(eSound::Boom);
-        m_bDead = true;
-        DeathFX();
-        m_pPlayer = nullptr;
-    }
-
-    if (pObj && pObj->isDoor())
-    {
-        if (!pObj->isDoorLocked()) {
-            m_bIsWinner = true;
-        }
-    }
-
-    if (pObj && pObj->isStar()) {
-        m_pAudio->play(eSound::Star);
-        isInvincible = true;
-        tInvincible = m_pTimer->GetTime();
-    }
-
-    if (pObj && pObj->isLaunchPad()) {
-        m_pAudio->play(eSound::Bounce);
-        m_vVelocity.y = LAUNCHPAD_VELOCITY;
-    }
-
-    if (pObj && pObj->isHealthPack())
-    {
-        m_pAudio->play(eSound::Star);
-        if (m_nHealth < m_nMaxHealth)
-        {
-            if ((m_nMaxHealth - m_nHealth) < 4)
-                m_nHealth = m_nMaxHealth;
-            else
-                m_nHealth += 4;
-
-            m_bHealthPercent = (float)m_nHealth / m_nMaxHealth;
-            const float f = 0.5f + 0.5f * (float)m_nHealth / m_nMaxHealth; //health fraction
-            m_f4Tint = XMFLOAT4(1.0f, f, f, 0); //redden the health indicator
-        }
-    }
-    if (pObj && pObj->isOneUp())
-    {
-        m_pAudio->play(eSound::Star);
-        hasOneUp = true;
-    }
     if (pObj && pObj->isShotgun())
     {
         m_pAudio->play(eSound::Star);
@@ -229,6 +182,83 @@ void CPlayer::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
         CObject::CollisionResponse(norm, d, pObj); //default collision response
 } //CollisionResponse
 
+/// Response to touching a solid tile. A spike kills the player outright,
+/// then `CObject::TileResponse` backs it off.
+/// \param norm Collision normal.
+/// \param d Overlap distance.
+/// \param props The tile's `eTileProp` flags.
+
+void CPlayer::TileResponse(const Vector2& norm, float d, uint8_t props) {
+    if (m_bDead)return; //already dead, bail out 
+
+    if (props & (uint8_t)eTileProp::Hazard)
+    {
+        m_nHealth = 0;
+        m_pAudio->play(eSound::Boom);
+        m_bDead = true;
+        DeathFX();
+        m_pPlayer = nullptr;
+    }
+
+    CObject::TileResponse(norm, d, props); //default tile response
+} //TileResponse
+
+/// Response to stepping onto tiles. A launch pad throws the player upward,
+/// once each time that it lands on one.
+/// \param props The `eTileProp` flags that it wasn't touching before.
+
+void CPlayer::TileEnter(uint8_t props) {
+    if (m_bDead)return; //already dead, bail out 
+
+    if (props & (uint8_t)eTileProp::Bounce) {
+        m_pAudio->play(eSound::Bounce);
+        m_vVelocity.y = LAUNCHPAD_VELOCITY;
+    }
+} //TileEnter
+
+/// Response to starting to overlap a trigger object. An open door wins the
+/// level, and a star, health pack, or one up is picked up.
+/// \param pObj Pointer to the object being overlapped.
+
+void CPlayer::OverlapBegin(CObject* pObj) {
+    if (m_bDead)return; //already dead, bail out 
+
+    if (pObj->isDoor())
+    {
+        if (!pObj->isDoorLocked()) {
+            m_bIsWinner = true;
+        }
+    }
+
+    if (pObj->isStar()) {
+        m_pAudio->play(eSound::Star);
+        isInvincible = true;
+        tInvincible = m_pTimer->GetTime();
+    }
+
+    if (pObj->isHealthPack())
+    {
+        m_pAudio->play(eSound::Star);
+        if (m_nHealth < m_nMaxHealth)
+        {
+            if ((m_nMaxHealth - m_nHealth) < 4)
+                m_nHealth = m_nMaxHealth;
+            else
+                m_nHealth += 4;
+
+            m_bHealthPercent = (float)m_nHealth / m_nMaxHealth;
+            const float f = 0.5f + 0.5f * (float)m_nHealth / m_nMaxHealth; //health fraction
+            m_f4Tint = XMFLOAT4(1.0f, f, f, 0); //redden the health indicator
+        }
+    }
+
+    if (pObj->isOneUp())
+    {
+        m_pAudio->play(eSound::Star);
+        hasOneUp = true;
+    }
+} //OverlapBegin
+
 
 /// Perform a particle effect to mark the death of the player.
 
@@ -242,7 +272,7 @@ void CPlayer::DeathFX(){
   d.m_fScaleInFrac = 0.5f;
   d.m_fFadeOutFrac = 0.8f;
   d.m_fScaleOutFrac = 0;
-  m_pParticleEngine->create(d);
+  m_pObjectManager->CreateParticle(d);
 
   d.m_nSpriteIndex = (UINT)eSprite::Spark;
   d.m_fLifeSpan = 0.5f;
@@ -251,7 +281,7 @@ void CPlayer::DeathFX(){
   d.m_fScaleOutFrac = 0.3f;
   d.m_fFadeOutFrac = 0.5f;
   d.m_f4Tint = XMFLOAT4(Colors::OrangeRed);
-  m_pParticleEngine->create(d);
+  m_pObjectManager->CreateParticle(d);
 } //DeathFX
 
 /// Set the strafe left flag. This function will be called in response to
@@ -41,6 +41,9 @@ class CPlayer: public CObject{
     const float POWERUP_TIMER = 10.00f; ///< Power Up Timer for a player
     
     virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
+    virtual void TileResponse(const Vector2&, float, uint8_t); ///< Response to touching a tile.
+    virtual void TileEnter(uint8_t); ///< Response to starting to touch tiles.
+    virtual void OverlapBegin(CObject*); ///< Response to starting to overlap a sensor.
     virtual void DeathFX(); ///< Death special effects.
 
     void flashPlayer(); ///< Flash Player Sprite
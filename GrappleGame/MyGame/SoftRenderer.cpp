@@ -0,0 +1,646 @@
+/// \file SoftRenderer.cpp
+/// \brief Code for the software sprite renderer CSoftRenderer.
+
+#include "SoftRenderer.h"
+#include "MediaUtil.h"
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__SSE2__)
+  #include <emmintrin.h>
+  #define SOFT_USE_SSE2 ///< Use SSE2 for alpha blending.
+#endif
+
+/// Read `gamesettings.xml` for the window size, the image folder, the font,
+/// and the sprite atlas if there is one. The sprite tags are looked up later
+/// when sprites are loaded.
+/// \param settings Name of the settings file.
+/// \param pCache Pointer to an image cache to decode images with, or
+/// `nullptr` to decode them one at a time with no cache.
+
+CSoftRenderer::CSoftRenderer(const char* settings, CImageCache* pCache):
+  m_pImageCache(pCache)
+{
+  std::string tag, value;
+
+  if(ReadFile(settings, m_strSettings)){
+    if(GetTag(m_strSettings, "<renderer", tag)){
+      if(GetAttribute(tag, "width", value))m_nWidth = std::max(1, atoi(value.c_str()));
+      if(GetAttribute(tag, "height", value))m_nHeight = std::max(1, atoi(value.c_str()));
+    } //if
+
+    if(GetTag(m_strSettings, "<sprites", tag) && GetAttribute(tag, "path", value))
+      m_strImagePath = FixPath(value) + "/";
+
+    if(GetTag(m_strSettings, "<font", tag) && GetAttribute(tag, "file", value))
+      LoadFont(FixPath(value));
+
+    if(GetTag(m_strSettings, "<atlas", tag) && GetAttribute(tag, "file", value))
+      LoadAtlas(FixPath(value).c_str());
+  } //if
+
+  m_vecFrame.resize((size_t)m_nWidth*m_nHeight, m_nClearColor);
+  m_vecSpan.resize(m_nWidth);
+} //constructor
+
+/// Make space for sprites. Sprites that are never loaded have no frames and
+/// draw nothing.
+/// \param n Number of sprite types.
+
+void CSoftRenderer::Initialize(size_t n){
+  m_vecSprites.clear();
+  m_vecSprites.resize(n);
+} //Initialize
+
+/// Find a sprite tag in the settings.
+/// \param name Name of sprite tag.
+/// \param file [out] Image file name, or its prefix if there are many frames.
+/// \param ext [out] Image file extension if there are many frames.
+/// \param frames [out] Number of frames.
+/// \return true if the sprite tag was found.
+
+const bool CSoftRenderer::FindSprite(const char* name, std::string& file,
+  std::string& ext, size_t& frames) const
+{
+  std::string tag, value;
+
+  for(size_t pos=0; NextTag(m_strSettings, "<sprite", pos, tag);)
+    if(GetAttribute(tag, "name", value) && value == name &&
+      GetAttribute(tag, "file", file))
+    {
+      frames = GetAttribute(tag, "frames", value)? (size_t)atoi(value.c_str()): 1;
+      if(!GetAttribute(tag, "ext", ext))ext.clear();
+      return true;
+    } //if
+
+  return false;
+} //FindSprite
+
+/// Load the pages of a sprite atlas made by `CSpriteAtlas::Build()`. Sprites
+/// loaded after this whose frames are all in the atlas use the atlas pages
+/// instead of loading their own images. If any page can't be loaded, the
+/// atlas is not used.
+/// \param manifest Name of the atlas manifest.
+/// \return true if the atlas was loaded.
+
+const bool CSoftRenderer::LoadAtlas(const char* manifest){
+  m_nAtlasPage = m_vecPages.size();
+
+  if(!m_sAtlas.Load(manifest))return false;
+
+  std::vector<SImageData> images(m_sAtlas.GetNumPages());
+
+  for(size_t i=0; i<images.size(); i++)
+    images[i].m_strFile = m_sAtlas.GetPagePath(i);
+
+  DecodeImages(images);
+
+  for(SImageData& img: images){
+    if(!img.m_bLoaded){
+      m_vecPages.resize(m_nAtlasPage);
+      m_sAtlas.Clear();
+      return false;
+    } //if
+
+    SSoftPage page;
+    page.m_nWidth = img.m_nWidth;
+    page.m_nHeight = img.m_nHeight;
+    page.m_vecTexels = std::move(img.m_vecTexels);
+    m_vecPages.push_back(std::move(page));
+  } //for
+
+  return true;
+} //LoadAtlas
+
+/// Decode images with the image cache if there is one, otherwise one at a
+/// time.
+/// \param images [in, out] Images with file names set.
+
+void CSoftRenderer::DecodeImages(std::vector<SImageData>& images){
+  if(m_pImageCache)
+    m_pImageCache->Decode(images);
+
+  else for(SImageData& img: images)
+    img.m_bLoaded = LoadImageRGBA(img.m_strFile, img.m_nWidth, img.m_nHeight, img.m_vecTexels);
+} //DecodeImages
+
+/// Decode the images of some sprites ahead of loading them, all at once so
+/// that the image cache can decode them in parallel. Sprites that are in the
+/// atlas are skipped. Decoded images wait until `Load()` takes them.
+/// \param names Names of sprite tags, such as `CSpriteRegistry::GetNames()`.
+/// \return Number of images decoded.
+
+const size_t CSoftRenderer::Prefetch(const std::vector<std::string>& names){
+  std::vector<SImageData> images;
+  std::string file, ext;
+  size_t frames = 0;
+
+  for(const std::string& name: names){
+    if(!FindSprite(name.c_str(), file, ext, frames))continue;
+
+    bool atlas = true; //whether all frames are in the atlas
+    for(size_t f=0; f<frames && atlas; f++)
+      atlas = m_sAtlas.Find(name.c_str(), f) != nullptr;
+
+    for(size_t f=0; f<frames && !atlas; f++){
+      images.push_back(SImageData());
+      images.back().m_strFile = m_strImagePath +
+        (frames > 1? file + std::to_string(f) + "." + ext: file);
+    } //for
+  } //for
+
+  DecodeImages(images);
+
+  size_t n = 0;
+
+  for(SImageData& img: images)
+    if(img.m_bLoaded){
+      m_vecPrefetched.push_back(std::move(img));
+      n++;
+    } //if
+
+  return n;
+} //Prefetch
+
+/// Get the texels of an image, taking them from the prefetched images if
+/// they are there and decoding the image otherwise.
+/// \param filename Name of the image file.
+/// \param w [out] Width in texels.
+/// \param h [out] Height in texels.
+/// \param texels [out] Texels.
+/// \return true if the image was found.
+
+const bool CSoftRenderer::GetImage(const std::string& filename, int& w, int& h,
+  std::vector<uint32_t>& texels)
+{
+  for(size_t i=0; i<m_vecPrefetched.size(); i++)
+    if(m_vecPrefetched[i].m_strFile == filename){
+      w = m_vecPrefetched[i].m_nWidth;
+      h = m_vecPrefetched[i].m_nHeight;
+      texels = std::move(m_vecPrefetched[i].m_vecTexels);
+      m_vecPrefetched.erase(m_vecPrefetched.begin() + i);
+      return true;
+    } //if
+
+  std::vector<SImageData> images(1);
+  images[0].m_strFile = filename;
+  DecodeImages(images);
+
+  w = images[0].m_nWidth;
+  h = images[0].m_nHeight;
+  texels = std::move(images[0].m_vecTexels);
+
+  return images[0].m_bLoaded;
+} //GetImage
+
+/// Load a sprite using the sprite tag of the same name in the settings. If
+/// all of its frames are in the atlas, they are used where they are.
+/// Otherwise its images are loaded into a page of their own, one frame
+/// below the other. A sprite with many frames has one image per frame,
+/// named with the frame number between the file name and extension, as
+/// `LSpriteRenderer` expects.
+/// \param t Sprite index.
+/// \param name Name of sprite tag.
+/// \return true if the sprite tag and all of its images were found.
+
+const bool CSoftRenderer::Load(size_t t, const char* name){
+  if(t >= m_vecSprites.size())return false;
+
+  std::string file, ext;
+  size_t frames = 1;
+
+  if(!FindSprite(name, file, ext, frames) || frames == 0)
+    return false;
+
+  SSoftSprite sprite;
+
+  //from the atlas
+
+  for(size_t f=0; f<frames; f++){
+    const SAtlasRegion* r = m_sAtlas.Find(name, f);
+
+    if(r == nullptr || (f > 0 && (r->m_nPage + m_nAtlasPage != sprite.m_nPage ||
+      r->m_nWidth != sprite.m_nWidth || r->m_nHeight != sprite.m_nHeight)))
+    {
+      sprite.m_vecFrames.clear();
+      break;
+    } //if
+
+    sprite.m_nWidth = r->m_nWidth;
+    sprite.m_nHeight = r->m_nHeight;
+    sprite.m_nPage = r->m_nPage + m_nAtlasPage;
+    sprite.m_vecFrames.push_back((size_t)r->m_nY*m_vecPages[sprite.m_nPage].m_nWidth + r->m_nX);
+  } //for
+
+  if(!sprite.m_vecFrames.empty()){
+    m_vecSprites[t] = std::move(sprite);
+    return true;
+  } //if
+
+  //from image files
+
+  SSoftPage page;
+  std::vector<uint32_t> texels;
+
+  for(size_t f=0; f<frames; f++){
+    const std::string filename = m_strImagePath +
+      (frames > 1? file + std::to_string(f) + "." + ext: file);
+
+    int w = 0, h = 0;
+    if(!GetImage(filename, w, h, texels))return false;
+
+    if(f == 0){
+      page.m_nWidth = sprite.m_nWidth = w;
+      page.m_nHeight = (int)frames*h;
+      sprite.m_nHeight = h;
+      page.m_vecTexels.resize((size_t)w*h*frames);
+    } //if
+
+    if(w == sprite.m_nWidth && h == sprite.m_nHeight)
+      memcpy(&page.m_vecTexels[f*w*h], texels.data(), (size_t)w*h*4);
+
+    sprite.m_vecFrames.push_back(f*w*h);
+  } //for
+
+  sprite.m_nPage = m_vecPages.size();
+  m_vecPages.push_back(std::move(page));
+  m_vecSprites[t] = std::move(sprite);
+
+  return true;
+} //Load
+
+/// Load the font from a `.spritefont` file, keeping only the alpha channel.
+/// The texture must be in `BC2` or 32-bit RGBA format.
+/// \param filename Name of the font file.
+/// \return true if the font was loaded.
+
+const bool CSoftRenderer::LoadFont(const std::string& filename){
+  std::string s;
+  if(!ReadFile(filename, s) || s.size() < 12 || s.compare(0, 8, "DXTKfont") != 0)
+    return false;
+
+  const char* p = s.data() + 8;
+  const char* end = s.data() + s.size();
+
+  auto Read = [&](void* dest, size_t n){ //read and advance, if there's room
+    if(p + n > end)return false;
+    memcpy(dest, p, n);
+    p += n;
+    return true;
+  }; //Read
+
+  uint32_t n = 0, defaultChar = 0, w = 0, h = 0, format = 0, stride = 0, rows = 0;
+  if(!Read(&n, 4))return false;
+
+  m_vecGlyphs.resize(n);
+
+  for(SSoftGlyph& g: m_vecGlyphs)
+    if(!Read(&g, sizeof(SSoftGlyph)))return false;
+
+  if(!Read(&m_fLineSpacing, 4) || !Read(&defaultChar, 4) || !Read(&w, 4) ||
+    !Read(&h, 4) || !Read(&format, 4) || !Read(&stride, 4) || !Read(&rows, 4))
+    return false;
+
+  if(p + (size_t)stride*rows > end)return false;
+
+  SSoftPage page;
+  page.m_nWidth = (int)w;
+  page.m_nHeight = (int)h;
+  page.m_vecTexels.assign((size_t)w*h, 0x00FFFFFF);
+
+  if(format == 74){ //BC2, 4-bit alpha in the first 8 bytes of each 4x4 block
+    for(uint32_t by=0; by<rows; by++)
+      for(uint32_t bx=0; bx<w/4; bx++){
+        const uint8_t* block = (const uint8_t*)p + by*stride + bx*16;
+
+        for(uint32_t k=0; k<16; k++){
+          const uint32_t a = (block[k/2] >> (4*(k%2))) & 0xF;
+          const uint32_t x = 4*bx + k%4, y = 4*by + k/4;
+
+          if(x < w && y < h)
+            page.m_vecTexels[y*w + x] |= (a*17) << 24;
+        } //for
+      } //for
+  } //if
+
+  else if(format == 28) //RGBA
+    for(uint32_t y=0; y<h; y++)
+      for(uint32_t x=0; x<w; x++)
+        page.m_vecTexels[y*w + x] |= (uint32_t)(uint8_t)p[y*stride + 4*x + 3] << 24;
+
+  else return false;
+
+  m_sFont.m_nWidth = (int)w;
+  m_sFont.m_nHeight = (int)h;
+  m_sFont.m_nPage = m_vecPages.size();
+  m_sFont.m_vecFrames.assign(1, 0);
+  m_vecPages.push_back(std::move(page));
+
+  std::sort(m_vecGlyphs.begin(), m_vecGlyphs.end(),
+    [](const SSoftGlyph& a, const SSoftGlyph& b){return a.m_nChar < b.m_nChar;});
+
+  return true;
+} //LoadFont
+
+/// Find the glyph for a character.
+/// \param c Character code.
+/// \return Pointer to the glyph, or `nullptr` if there is none.
+
+const SSoftGlyph* CSoftRenderer::FindGlyph(uint32_t c) const{
+  auto i = std::lower_bound(m_vecGlyphs.begin(), m_vecGlyphs.end(), c,
+    [](const SSoftGlyph& g, uint32_t c){return g.m_nChar < c;});
+
+  return i != m_vecGlyphs.end() && i->m_nChar == c? &*i: nullptr;
+} //FindGlyph
+
+/// Clear the framebuffer to the clear color.
+
+void CSoftRenderer::BeginFrame(){
+  std::fill(m_vecFrame.begin(), m_vecFrame.end(), m_nClearColor);
+} //BeginFrame
+
+/// Finish the frame. The framebuffer stays as it is until the next
+/// `BeginFrame()` so that it can be saved.
+
+void CSoftRenderer::EndFrame(){
+  m_nFrameCount++;
+} //EndFrame
+
+/// Set the color that `BeginFrame()` clears to.
+/// \param c Color in RGBA byte order, red in the low byte.
+
+void CSoftRenderer::SetClearColor(uint32_t c){
+  m_nClearColor = c;
+} //SetClearColor
+
+/// Reader function for the framebuffer width.
+/// \return Framebuffer width in pixels.
+
+const int CSoftRenderer::GetFrameWidth() const{
+  return m_nWidth;
+} //GetFrameWidth
+
+/// Reader function for the framebuffer height.
+/// \return Framebuffer height in pixels.
+
+const int CSoftRenderer::GetFrameHeight() const{
+  return m_nHeight;
+} //GetFrameHeight
+
+/// Reader function for the framebuffer.
+/// \return Pointer to the pixels, RGBA, top row first.
+
+const uint32_t* CSoftRenderer::GetFrame() const{
+  return m_vecFrame.data();
+} //GetFrame
+
+/// Reader function for the number of texture pages, which is the number of
+/// textures that sprites are drawn from.
+/// \return Number of pages.
+
+const size_t CSoftRenderer::GetNumPages() const{
+  return m_vecPages.size();
+} //GetNumPages
+
+/// Reader function for the frame count.
+/// \return Number of times `EndFrame()` has been called.
+
+const size_t CSoftRenderer::GetFrameCount() const{
+  return m_nFrameCount;
+} //GetFrameCount
+
+/// Blend a row of texels over a row of the framebuffer. Each texel is first
+/// multiplied by the tint, then blended by its alpha with
+/// `d = (s*a + d*(256 - a))/256`, where `a` is the alpha scaled to 0..256.
+/// SSE2 does four pixels at a time in 16-bit lanes.
+/// \param dest Framebuffer row.
+/// \param src Texels.
+/// \param n Number of texels.
+/// \param mul Tint multipliers for red, green, blue, and alpha, each 0..256.
+
+void CSoftRenderer::BlendRow(uint32_t* dest, const uint32_t* src, int n,
+  const uint16_t* mul) const
+{
+  int i = 0;
+
+  #ifdef SOFT_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i m = _mm_set_epi16(mul[3], mul[2], mul[1], mul[0],
+      mul[3], mul[2], mul[1], mul[0]);
+    const __m128i full = _mm_set1_epi16(256);
+    const __m128i opaque = _mm_set1_epi32((int)0xFF000000);
+
+    auto Blend = [&](__m128i s, __m128i d){ //two pixels in 16-bit lanes
+      s = _mm_srli_epi16(_mm_mullo_epi16(s, m), 8); //tint
+      __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+      a = _mm_add_epi16(a, _mm_srli_epi16(a, 7)); //0..255 to 0..256
+      s = _mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, _mm_sub_epi16(full, a)));
+      return _mm_srli_epi16(s, 8);
+    }; //Blend
+
+    for(; i+4<=n; i+=4){
+      const __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+      const __m128i d = _mm_loadu_si128((const __m128i*)(dest + i));
+
+      const __m128i lo = Blend(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+      const __m128i hi = Blend(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+
+      _mm_storeu_si128((__m128i*)(dest + i), _mm_or_si128(_mm_packus_epi16(lo, hi), opaque));
+    } //for
+  #endif //SOFT_USE_SSE2
+
+  for(; i<n; i++){
+    const uint32_t s = src[i], d = dest[i];
+    uint32_t a = ((s >> 24)*mul[3]) >> 8;
+    a += a >> 7;
+
+    uint32_t result = 0xFF000000;
+
+    for(int k=0; k<3; k++){
+      const uint32_t sc = (((s >> 8*k) & 0xFF)*mul[k]) >> 8;
+      const uint32_t dc = (d >> 8*k) & 0xFF;
+      result |= ((sc*a + dc*(256 - a)) >> 8) << 8*k;
+    } //for
+
+    dest[i] = result;
+  } //for
+} //BlendRow
+
+/// Draw a rectangle of texels unrotated and unscaled, clipped to the
+/// framebuffer.
+/// \param src Top left texel.
+/// \param pitch Texels per row of the source.
+/// \param w Width of the rectangle.
+/// \param h Height of the rectangle.
+/// \param x Framebuffer column of the left of the rectangle.
+/// \param y Framebuffer row of the top of the rectangle.
+/// \param mul Tint multipliers.
+
+void CSoftRenderer::DrawRect(const uint32_t* src, int pitch, int w, int h,
+  int x, int y, const uint16_t* mul)
+{
+  const int x0 = std::max(0, x), x1 = std::min(m_nWidth, x + w);
+  const int y0 = std::max(0, y), y1 = std::min(m_nHeight, y + h);
+  if(x1 <= x0 || y1 <= y0)return;
+
+  for(int i=y0; i<y1; i++)
+    BlendRow(&m_vecFrame[(size_t)i*m_nWidth + x0],
+      src + (size_t)(i - y)*pitch + (x0 - x), x1 - x0, mul);
+} //DrawRect
+
+/// Draw a sprite in screen space. Unrotated unscaled sprites are blended
+/// straight from the texture. Otherwise each row of the sprite's screen
+/// bounding box is point sampled into a span, with texels outside the
+/// sprite left transparent, and the span is blended.
+/// \param s Sprite.
+/// \param frame Frame number.
+/// \param x Screen position x of the center.
+/// \param y Screen position y of the center.
+/// \param roll Counterclockwise rotation.
+/// \param xs Horizontal scale.
+/// \param ys Vertical scale.
+/// \param tint RGB tint, or `nullptr` for none.
+/// \param alpha Alpha multiplier.
+
+void CSoftRenderer::DrawSprite(const SSoftSprite& s, size_t frame, float x,
+  float y, float roll, float xs, float ys, const float* tint, float alpha)
+{
+  if(s.m_vecFrames.empty() || alpha <= 0.0f || xs == 0.0f || ys == 0.0f)return;
+
+  auto Scale = [](float f){return (uint16_t)std::min(256.0f, std::max(0.0f, 256.0f*f));};
+
+  const uint16_t mul[4] = {
+    tint? Scale(tint[0]): (uint16_t)256, tint? Scale(tint[1]): (uint16_t)256,
+    tint? Scale(tint[2]): (uint16_t)256, Scale(alpha)
+  }; //mul
+
+  const SSoftPage& page = m_vecPages[s.m_nPage];
+  const int w = s.m_nWidth, h = s.m_nHeight, pitch = page.m_nWidth;
+  const uint32_t* tex = page.m_vecTexels.data() + s.m_vecFrames[frame%s.m_vecFrames.size()];
+
+  if(roll == 0.0f && xs == 1.0f && ys == 1.0f){ //fast path
+    DrawRect(tex, pitch, w, h, (int)floorf(x - 0.5f*w + 0.5f),
+      (int)floorf(y - 0.5f*h + 0.5f), mul);
+    return;
+  } //if
+
+  const float c = cosf(roll), sn = sinf(roll);
+  const float hw = 0.5f*w*fabsf(xs), hh = 0.5f*h*fabsf(ys); //half size on screen
+  const float ex = fabsf(c)*hw + fabsf(sn)*hh; //half extents of bounding box
+  const float ey = fabsf(sn)*hw + fabsf(c)*hh;
+
+  const int x0 = std::max(0, (int)floorf(x - ex)), x1 = std::min(m_nWidth, (int)ceilf(x + ex));
+  const int y0 = std::max(0, (int)floorf(y - ey)), y1 = std::min(m_nHeight, (int)ceilf(y + ey));
+  if(x1 <= x0 || y1 <= y0)return;
+
+  //texture coordinates are linear in screen position; screen y is down
+
+  const float dudx = c/xs, dvdx = sn/ys; //step along a row
+
+  for(int i=y0; i<y1; i++){
+    const float dx = x0 + 0.5f - x, dy = y - (i + 0.5f); //world offset, y up
+    float u = (dx*c + dy*sn)/xs + 0.5f*w;
+    float v = 0.5f*h - (-dx*sn + dy*c)/ys;
+
+    for(int j=0; j<x1-x0; j++, u+=dudx, v+=dvdx){
+      const int iu = (int)floorf(u), iv = (int)floorf(v);
+      m_vecSpan[j] = iu >= 0 && iu < w && iv >= 0 && iv < h? tex[iv*pitch + iu]: 0;
+    } //for
+
+    BlendRow(&m_vecFrame[(size_t)i*m_nWidth + x0], m_vecSpan.data(), x1 - x0, mul);
+  } //for
+} //DrawSprite
+
+/// Draw a sprite in world space, centered on the camera.
+/// \param t Sprite index.
+/// \param frame Frame number.
+/// \param x World position x.
+/// \param y World position y.
+/// \param roll Counterclockwise rotation.
+/// \param xs Horizontal scale.
+/// \param ys Vertical scale.
+/// \param tint RGB tint, or `nullptr` for none.
+/// \param alpha Alpha multiplier.
+
+void CSoftRenderer::DrawWorldSprite(unsigned t, unsigned frame, float x,
+  float y, float roll, float xs, float ys, const float* tint, float alpha)
+{
+  if(t >= m_vecSprites.size())return;
+
+  DrawSprite(m_vecSprites[t], frame, x - m_fCamX + 0.5f*m_nWidth,
+    m_fCamY - y + 0.5f*m_nHeight, roll, xs, ys, tint, alpha);
+} //DrawWorldSprite
+
+/// Draw a line in world space by stretching a sprite horizontally to the
+/// length of the line and rotating it to match.
+/// \param t Sprite index.
+/// \param x0 Start x.
+/// \param y0 Start y.
+/// \param x1 End x.
+/// \param y1 End y.
+
+void CSoftRenderer::DrawWorldLine(unsigned t, float x0, float y0, float x1, float y1){
+  if(t >= m_vecSprites.size() || m_vecSprites[t].m_nWidth == 0)return;
+
+  const float dx = x1 - x0, dy = y1 - y0;
+  const float xs = sqrtf(dx*dx + dy*dy)/m_vecSprites[t].m_nWidth;
+
+  DrawWorldSprite(t, 0, 0.5f*(x0 + x1), 0.5f*(y0 + y1), atan2f(dy, dx),
+    xs, 1.0f, nullptr, 1.0f);
+} //DrawWorldLine
+
+/// Draw text in screen space with the font from the settings. Glyphs are laid
+/// out as the `.spritefont` format intends, with line feeds starting a new
+/// line.
+/// \param text Text to draw.
+/// \param x Left of the text in pixels.
+/// \param y Top of the text in pixels.
+/// \param color RGBA color, or `nullptr` for white.
+
+void CSoftRenderer::DrawString(const char* text, float x, float y, const float* color){
+  if(m_sFont.m_vecFrames.empty() || text == nullptr)return;
+
+  auto Scale = [](float f){return (uint16_t)std::min(256.0f, std::max(0.0f, 256.0f*f));};
+
+  const uint16_t mul[4] = {
+    color? Scale(color[0]): (uint16_t)256, color? Scale(color[1]): (uint16_t)256,
+    color? Scale(color[2]): (uint16_t)256, color? Scale(color[3]): (uint16_t)256
+  }; //mul
+
+  const SSoftPage& font = m_vecPages[m_sFont.m_nPage];
+  float dx = 0.0f, dy = 0.0f; //offset from the top left
+
+  for(const char* p=text; *p; p++){
+    if(*p == '\r')continue;
+
+    if(*p == '\n'){
+      dx = 0.0f;
+      dy += m_fLineSpacing;
+      continue;
+    } //if
+
+    const SSoftGlyph* g = FindGlyph((unsigned char)*p);
+    if(g == nullptr)continue;
+
+    dx = std::max(0.0f, dx + g->m_fXOffset);
+
+    const int w = g->m_nRight - g->m_nLeft, h = g->m_nBottom - g->m_nTop;
+    const uint32_t* src = font.m_vecTexels.data() + g->m_nTop*font.m_nWidth + g->m_nLeft;
+
+    if(w > 0 && h > 0)
+      DrawRect(src, font.m_nWidth, w, h, (int)(x + dx), (int)(y + dy + g->m_fYOffset), mul);
+
+    dx += w + g->m_fXAdvance;
+  } //for
+} //DrawString
+
+/// Save the framebuffer as an RGB PNG file.
+/// \param filename Name of the PNG file.
+/// \return true if the file was written.
+
+const bool CSoftRenderer::SavePNG(const char* filename) const{
+  return WritePNG(filename, m_nWidth, m_nHeight, m_vecFrame.data(), false);
+} //SavePNG
@@ -0,0 +1,280 @@
+/// \file SoftRenderer.h
+/// \brief Interface for the software sprite renderer CSoftRenderer.
+
+#ifndef __L4RC_GAME_SOFTRENDERER_H__
+#define __L4RC_GAME_SOFTRENDERER_H__
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "SpriteAtlas.h"
+#include "ImageCache.h"
+
+/// \brief A texture page held in memory by the software renderer.
+///
+/// 32-bit RGBA texels, top row first, holding the frames of one or more
+/// sprites.
+
+struct SSoftPage{
+  int m_nWidth = 0; ///< Width in texels.
+  int m_nHeight = 0; ///< Height in texels.
+  std::vector<uint32_t> m_vecTexels; ///< Texels.
+}; //SSoftPage
+
+/// \brief A sprite held in memory by the software renderer.
+///
+/// All frames have the same size and are rectangles in the same page.
+
+struct SSoftSprite{
+  int m_nWidth = 0; ///< Frame width in texels.
+  int m_nHeight = 0; ///< Frame height in texels.
+  size_t m_nPage = 0; ///< Index of the page holding the frames.
+  std::vector<size_t> m_vecFrames; ///< Index of top left texel of each frame in the page.
+}; //SSoftSprite
+
+/// \brief A glyph of the screen font.
+///
+/// The layout of a glyph in a `.spritefont` file.
+
+struct SSoftGlyph{
+  uint32_t m_nChar = 0; ///< Character code.
+  int32_t m_nLeft = 0; ///< Left of texture rectangle.
+  int32_t m_nTop = 0; ///< Top of texture rectangle.
+  int32_t m_nRight = 0; ///< Right of texture rectangle.
+  int32_t m_nBottom = 0; ///< Bottom of texture rectangle.
+  float m_fXOffset = 0.0f; ///< Offset before drawing.
+  float m_fYOffset = 0.0f; ///< Offset down from the line.
+  float m_fXAdvance = 0.0f; ///< Advance after the texture rectangle.
+}; //SSoftGlyph
+
+/// \brief A camera position returned by the software renderer.
+///
+/// It has the `x`, `y`, and `z` of a `Vector3` and converts to any vector
+/// type that can be made from three floats, or from the first two of them
+/// such as `Vector2`, so that code written for `LSpriteRenderer::GetCameraPos`
+/// compiles unchanged.
+
+struct SSoftCameraPos{
+  float x = 0.0f; ///< x coordinate.
+  float y = 0.0f; ///< y coordinate.
+  float z = 0.0f; ///< z coordinate.
+
+  SSoftCameraPos(float a, float b, float c): x(a), y(b), z(c){}; ///< Constructor.
+
+  /// Convert to a vector type.
+  /// \return The camera position as a `V`.
+
+  template<class V> operator V() const{
+    return Make<V>(0);
+  } //operator V
+
+  private:
+    /// Make a vector from all three coordinates, chosen over the other
+    /// overload when `V` has a constructor that takes three floats.
+    /// \return The camera position as a `V`.
+
+    template<class V> auto Make(int) const -> decltype(V(x, y, z)){
+      return V(x, y, z);
+    } //Make
+
+    /// Make a vector from the first two coordinates.
+    /// \return The camera position as a `V`.
+
+    template<class V> V Make(long) const{
+      return V(x, y);
+    } //Make
+}; //SSoftCameraPos
+
+/// \brief The software sprite renderer.
+///
+/// CSoftRenderer draws sprites into a framebuffer in memory so that frames
+/// can be made on machines that have no GPU, for example for screenshot
+/// regression tests and performance captures. It reads the same
+/// `gamesettings.xml` and images as `LSpriteRenderer` and has the same calls
+/// that the game makes on `m_pRenderer`, namely `Initialize`, `Load`,
+/// `GetWidth`, `GetHeight`, `BeginFrame`, `EndFrame`, both flavors of `Draw`,
+/// `DrawLine`, `DrawBoundingBox`, `DrawScreenText`, `GetCameraPos`, and
+/// `SetCameraPos`, with the same arguments, defaults, and return values, so
+/// that the game's code and templates such as `CDrawQueue::Flush` compile
+/// unchanged against either renderer. The calls that take Engine types are
+/// templates that only read the members they need, and `GetCameraPos`
+/// returns an `SSoftCameraPos` that converts to the Engine's vectors, so
+/// this class doesn't depend on the Engine.
+/// Sprites are point sampled and alpha blended four pixels at a time with
+/// SSE2. Finished frames can be saved as PNG files. If the settings name a
+/// sprite atlas, sprites are drawn from its pages. Images can be decoded in
+/// parallel through a `CImageCache` by calling `Prefetch()` before `Load()`.
+
+class CSoftRenderer{
+  private:
+    int m_nWidth = 1024; ///< Framebuffer width.
+    int m_nHeight = 768; ///< Framebuffer height.
+    std::vector<uint32_t> m_vecFrame; ///< Framebuffer, RGBA, top row first.
+    std::vector<uint32_t> m_vecSpan; ///< Texels sampled for one row.
+    uint32_t m_nClearColor = 0xFF000000; ///< Clear color, RGBA.
+    size_t m_nFrameCount = 0; ///< Number of frames ended.
+
+    float m_fCamX = 0.0f; ///< Camera position x.
+    float m_fCamY = 0.0f; ///< Camera position y.
+    float m_fCamZ = 0.0f; ///< Camera position z.
+
+    std::string m_strImagePath; ///< Folder that the images are in.
+    std::string m_strSettings; ///< Contents of the settings file.
+    std::vector<SSoftSprite> m_vecSprites; ///< Sprites indexed by sprite type.
+    std::vector<SSoftPage> m_vecPages; ///< Texture pages.
+    CSpriteAtlas m_sAtlas; ///< Sprite atlas, if any.
+    size_t m_nAtlasPage = 0; ///< Index of first atlas page.
+    CImageCache* m_pImageCache = nullptr; ///< Image cache, if any.
+    std::vector<SImageData> m_vecPrefetched; ///< Images decoded ahead of loading.
+
+    SSoftSprite m_sFont; ///< Font texture, white with alpha, as a sprite.
+    std::vector<SSoftGlyph> m_vecGlyphs; ///< Font glyphs sorted by character.
+    float m_fLineSpacing = 0.0f; ///< Font line spacing.
+
+    const bool FindSprite(const char*, std::string&, std::string&, size_t&) const; ///< Find a sprite tag.
+    const bool LoadFont(const std::string&); ///< Load the font.
+    void DecodeImages(std::vector<SImageData>&); ///< Decode images.
+    const bool GetImage(const std::string&, int&, int&, std::vector<uint32_t>&); ///< Get an image.
+    const SSoftGlyph* FindGlyph(uint32_t) const; ///< Find the glyph for a character.
+
+    void BlendRow(uint32_t*, const uint32_t*, int, const uint16_t*) const; ///< Blend a row of texels.
+    void DrawSprite(const SSoftSprite&, size_t, float, float, float, float, float,
+      const float*, float); ///< Draw a sprite in screen space.
+    void DrawRect(const uint32_t*, int, int, int, int, int, const uint16_t*); ///< Draw texels unrotated.
+    void DrawWorldSprite(unsigned, unsigned, float, float, float, float, float,
+      const float*, float); ///< Draw a sprite in world space.
+    void DrawWorldLine(unsigned, float, float, float, float); ///< Draw a line in world space.
+    void DrawString(const char*, float, float, const float*); ///< Draw text in screen space.
+
+  public:
+    CSoftRenderer(const char* = "Media/XML/gamesettings.xml", CImageCache* = nullptr); ///< Constructor.
+
+    void Initialize(size_t); ///< Make space for sprites.
+    const bool Load(size_t, const char*); ///< Load a sprite.
+    const bool LoadAtlas(const char*); ///< Load a sprite atlas.
+    const size_t Prefetch(const std::vector<std::string>&); ///< Decode sprite images ahead.
+    void BeginResourceUpload(){}; ///< Nothing to do here.
+    void EndResourceUpload(){}; ///< Nothing to do here.
+
+    void BeginFrame(); ///< Clear the framebuffer.
+    void EndFrame(); ///< Finish the frame.
+    void SetClearColor(uint32_t); ///< Set the clear color.
+
+    const int GetFrameWidth() const; ///< Get framebuffer width.
+    const int GetFrameHeight() const; ///< Get framebuffer height.
+    const uint32_t* GetFrame() const; ///< Get the framebuffer.
+    const size_t GetFrameCount() const; ///< Get number of frames ended.
+    const size_t GetNumPages() const; ///< Get number of texture pages.
+    const bool SavePNG(const char*) const; ///< Save the framebuffer.
+
+    /// Make space for sprites.
+    /// \param n Number of sprite types, usually `eSprite::Size`.
+
+    template<class E> void Initialize(E n){
+      Initialize((size_t)n);
+    } //Initialize
+
+    /// Load a sprite from the images named in a sprite tag of the settings.
+    /// \param t Sprite type.
+    /// \param name Name of sprite tag.
+    /// \return true if the images were loaded.
+
+    template<class E> const bool Load(E t, const char* name){
+      return Load((size_t)t, name);
+    } //Load
+
+    /// Reader function for the width of a sprite.
+    /// \param t Sprite type.
+    /// \return Width of the sprite in pixels.
+
+    template<class E> const float GetWidth(E t) const{
+      return (float)m_vecSprites[(size_t)t].m_nWidth;
+    } //GetWidth
+
+    /// Reader function for the height of a sprite.
+    /// \param t Sprite type.
+    /// \return Height of the sprite in pixels.
+
+    template<class E> const float GetHeight(E t) const{
+      return (float)m_vecSprites[(size_t)t].m_nHeight;
+    } //GetHeight
+
+    /// Draw a sprite from a sprite descriptor such as `LSpriteDesc2D`.
+    /// \param d Pointer to sprite descriptor.
+
+    template<class D> void Draw(const D* d){
+      DrawWorldSprite((unsigned)d->m_nSpriteIndex, (unsigned)d->m_nCurrentFrame,
+        d->m_vPos.x, d->m_vPos.y, d->m_fRoll, d->m_fXScale, d->m_fYScale,
+        &d->m_f4Tint.x, d->m_fAlpha);
+    } //Draw
+
+    /// Draw frame 0 of a sprite untinted.
+    /// \param t Sprite type.
+    /// \param p Position.
+    /// \param roll Orientation.
+
+    template<class E, class V> void Draw(E t, const V& p, float roll){
+      DrawWorldSprite((unsigned)t, 0, p.x, p.y, roll, 1.0f, 1.0f, nullptr, 1.0f);
+    } //Draw
+
+    /// Draw a line by stretching a sprite between two points.
+    /// \param t Sprite type.
+    /// \param p0 Start of line.
+    /// \param p1 End of line.
+
+    template<class E, class V> void DrawLine(E t, const V& p0, const V& p1){
+      DrawWorldLine((unsigned)t, p0.x, p0.y, p1.x, p1.y);
+    } //DrawLine
+
+    /// Draw the outline of an axially aligned bounding box.
+    /// \param t Sprite type for the lines.
+    /// \param b Bounding box with `Center` and `Extents`.
+
+    template<class E, class B> void DrawBoundingBox(E t, const B& b){
+      const float x0 = b.Center.x - b.Extents.x, x1 = b.Center.x + b.Extents.x;
+      const float y0 = b.Center.y - b.Extents.y, y1 = b.Center.y + b.Extents.y;
+
+      DrawWorldLine((unsigned)t, x0, y0, x1, y0);
+      DrawWorldLine((unsigned)t, x1, y0, x1, y1);
+      DrawWorldLine((unsigned)t, x1, y1, x0, y1);
+      DrawWorldLine((unsigned)t, x0, y1, x0, y0);
+    } //DrawBoundingBox
+
+    /// Draw text in screen space in black, the Engine's default text color.
+    /// \param text Text to draw.
+    /// \param p Position of the top left corner in pixels.
+
+    template<class V> void DrawScreenText(const char* text, const V& p){
+      const float black[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+      DrawString(text, p.x, p.y, black);
+    } //DrawScreenText
+
+    /// Draw text in screen space.
+    /// \param text Text to draw.
+    /// \param p Position of the top left corner in pixels.
+    /// \param color Color such as `Colors::White`, an `XMVECTORF32` or
+    /// anything else with an RGBA array `f`.
+
+    template<class V, class C> void DrawScreenText(const char* text, const V& p,
+      const C& color)
+    {
+      DrawString(text, p.x, p.y, color.f);
+    } //DrawScreenText
+
+    /// Reader function for the camera position.
+    /// \return Camera position, which converts to `Vector3` or `Vector2`.
+
+    const SSoftCameraPos GetCameraPos() const{
+      return SSoftCameraPos(m_fCamX, m_fCamY, m_fCamZ);
+    } //GetCameraPos
+
+    /// Set the camera position. The camera is centered on it.
+    /// \param p Camera position, which must have `x`, `y`, and `z`.
+
+    template<class V> void SetCameraPos(const V& p){
+      m_fCamX = p.x; m_fCamY = p.y; m_fCamZ = p.z;
+    } //SetCameraPos
+}; //CSoftRenderer
+
+#endif //__L4RC_GAME_SOFTRENDERER_H__
@@ -0,0 +1,209 @@
+/// \file SpawnTable.cpp
+/// \brief Code for the spawn table CSpawnTable.
+
+#include <algorithm>
+
+#include "SpawnTable.h"
+
+/// Forget the records of the last level and use a new level's spawns. No
+/// records are made until their cells are looked at, and nothing is
+/// cleared that hasn't been used, so this takes the same time however many
+/// spawns there are.
+/// \param spawns The level's spawn list, which must outlive the table's use of it.
+/// \param cells The level's spawns by cell, likewise.
+
+void CSpawnTable::Set(const std::vector<SSpawn>& spawns, const SSpawnCells& cells){
+  m_pSpawns = &spawns;
+  m_pCells = &cells;
+
+  const size_t n = cells.m_nWide*cells.m_nHigh; //number of cells
+
+  if(m_vecCells.size() < n){
+    m_vecCells.resize(n);
+    m_vecStamp.resize(n, 0);
+  } //if
+
+  if(++m_nStamp == 0){ //wrapped around, so start again
+    std::fill(m_vecStamp.begin(), m_vecStamp.end(), 0);
+    m_nStamp = 1;
+  } //if
+
+  m_vecRecords.clear();
+  m_vecActive.assign((size_t)eSprite::Size + 1, 0);
+  m_vecGone.assign((size_t)eSprite::Size + 1, 0);
+  m_nActive = m_nGone = 0;
+} //Set
+
+/// Get the cell that a position is in. Positions off the world are put in
+/// the nearest cell.
+/// \param p Position.
+/// \return Index of the cell.
+
+const size_t CSpawnTable::GetCell(const Vector2& p) const{
+  const float x = std::max(0.0f, p.x/m_pCells->m_fCellSize); //column
+  const float y = std::max(0.0f, p.y/m_pCells->m_fCellSize); //row
+
+  return std::min((size_t)y, m_pCells->m_nHigh - 1)*m_pCells->m_nWide +
+    std::min((size_t)x, m_pCells->m_nWide - 1);
+} //GetCell
+
+/// Get a cell's dormant records, first making records for the level's
+/// spawns in that cell if this is the first time that it is looked at.
+/// \param c Index of the cell.
+/// \return The cell's dormant records.
+
+std::vector<uint32_t>& CSpawnTable::MakeCell(size_t c){
+  std::vector<uint32_t>& cell = m_vecCells[c]; //shorthand
+  if(m_vecStamp[c] == m_nStamp)return cell; //made already
+
+  m_vecStamp[c] = m_nStamp;
+  cell.clear();
+
+  for(uint32_t k=m_pCells->m_vecFirst[c]; k<m_pCells->m_vecFirst[c + 1]; k++){
+    const SSpawn& s = (*m_pSpawns)[m_pCells->m_vecSpawns[k]]; //shorthand
+    SSpawnRecord r;
+    r.m_eSprite = s.m_eSprite;
+    r.m_vPos = s.m_vPos;
+
+    cell.push_back((uint32_t)m_vecRecords.size());
+    m_vecRecords.push_back(r);
+  } //for
+
+  return cell;
+} //MakeCell
+
+/// Find the dormant records in the cells that overlap a rectangle. Some of
+/// them may be outside the rectangle, but none inside it are missed.
+/// \param lo Bottom left corner of the rectangle.
+/// \param hi Top right corner of the rectangle.
+/// \param out [out] Indices of the records, replacing anything there.
+
+void CSpawnTable::Find(const Vector2& lo, const Vector2& hi, std::vector<uint32_t>& out){
+  out.clear();
+  if(m_pCells == nullptr || hi.x < 0.0f || hi.y < 0.0f)return;
+
+  const size_t c0 = GetCell(lo); //bottom left cell
+  const size_t c1 = GetCell(hi); //top right cell
+  const size_t w = m_pCells->m_nWide; //shorthand
+
+  for(size_t y=c0/w; y<=c1/w; y++)
+    for(size_t x=c0%w; x<=c1%w; x++){
+      const std::vector<uint32_t>& cell = MakeCell(y*w + x);
+      out.insert(out.end(), cell.begin(), cell.end());
+    } //for
+} //Find
+
+/// Make a dormant record active, which means that its object is about to be
+/// made, taking it out of its cell. Records that aren't dormant are left
+/// alone.
+/// \param n Index of the record.
+
+void CSpawnTable::Wake(uint32_t n){
+  SSpawnRecord& r = m_vecRecords[n]; //shorthand
+  if(r.m_eState != eSpawnState::Dormant)return;
+
+  std::vector<uint32_t>& cell = m_vecCells[GetCell(r.m_vPos)]; //its cell
+  const auto it = std::find(cell.begin(), cell.end(), n);
+  *it = cell.back();
+  cell.pop_back();
+
+  r.m_eState = eSpawnState::Active;
+  m_vecActive[(size_t)r.m_eSprite]++;
+  m_nActive++;
+} //Wake
+
+/// Make an active record dormant again, keeping the state of its object,
+/// and put it into the cell where the object is now. Records that aren't
+/// active are left alone. If that cell hasn't been looked at yet then its
+/// records are made, which can move the records in memory, so the state may
+/// be a reference to a record.
+/// \param n Index of the record.
+/// \param state The record filled in by its object.
+
+void CSpawnTable::Store(uint32_t n, const SSpawnRecord& state){
+  SSpawnRecord& r = m_vecRecords[n]; //shorthand
+  if(r.m_eState != eSpawnState::Active)return;
+
+  r.m_vPos = state.m_vPos;
+  r.m_fRoll = state.m_fRoll;
+  r.m_nHealth = state.m_nHealth;
+  r.m_bChanged = state.m_bChanged;
+  r.m_eState = eSpawnState::Dormant;
+
+  m_vecActive[(size_t)r.m_eSprite]--;
+  m_nActive--;
+
+  const size_t c = GetCell(r.m_vPos); //cell it goes into
+  MakeCell(c).push_back(n); //may add records, so neither r nor state is used after this
+} //Store
+
+/// Make an active record gone, which means that its object died and is not
+/// to be made again. Records that aren't active are left alone.
+/// \param n Index of the record.
+
+void CSpawnTable::Remove(uint32_t n){
+  SSpawnRecord& r = m_vecRecords[n]; //shorthand
+  if(r.m_eState != eSpawnState::Active)return;
+
+  r.m_eState = eSpawnState::Gone;
+  m_vecActive[(size_t)r.m_eSprite]--;
+  m_vecGone[(size_t)r.m_eSprite]++;
+  m_nActive--;
+  m_nGone++;
+} //Remove
+
+/// Reader function for a record.
+/// \param n Index of the record, as given by `Find()`.
+/// \return The record.
+
+const SSpawnRecord& CSpawnTable::GetRecord(uint32_t n) const{
+  return m_vecRecords[n];
+} //GetRecord
+
+/// Reader function for the number of records.
+/// \return Number of spawns in the level, whether made into records or not.
+
+const size_t CSpawnTable::GetNumRecords() const{
+  return m_pCells? m_pCells->m_vecSpawns.size(): 0;
+} //GetNumRecords
+
+/// Reader function for the number of records made.
+/// \return Number of records made from the level's spawns so far.
+
+const size_t CSpawnTable::GetNumMade() const{
+  return m_vecRecords.size();
+} //GetNumMade
+
+/// Reader function for the number of dormant records.
+/// \return Number of records whose objects are waiting to be made.
+
+const size_t CSpawnTable::GetNumDormant() const{
+  return GetNumRecords() - m_nActive - m_nGone;
+} //GetNumDormant
+
+/// Reader function for the number of dormant records of one sprite type.
+/// \param t Sprite type.
+/// \return Number of records of that type whose objects are waiting to be made.
+
+const size_t CSpawnTable::GetNumDormant(eSprite t) const{
+  const size_t k = (size_t)t; //index
+
+  if(m_pCells == nullptr || k >= m_pCells->m_vecCounts.size())
+    return 0;
+
+  return m_pCells->m_vecCounts[k] - m_vecActive[k] - m_vecGone[k];
+} //GetNumDormant
+
+/// Reader function for the number of active records.
+/// \return Number of records whose objects are in the object list.
+
+const size_t CSpawnTable::GetNumActive() const{
+  return m_nActive;
+} //GetNumActive
+
+/// Reader function for the number of records gone.
+/// \return Number of records whose objects died.
+
+const size_t CSpawnTable::GetNumGone() const{
+  return m_nGone;
+} //GetNumGone
@@ -0,0 +1,85 @@
+/// \file SpawnTable.h
+/// \brief Interface for the spawn table CSpawnTable.
+
+#ifndef __L4RC_GAME_SPAWNTABLE_H__
+#define __L4RC_GAME_SPAWNTABLE_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "GameDefines.h"
+#include "LevelData.h"
+
+/// \brief State of a spawn record.
+///
+/// An enumerated type for whether the object of a spawn record is waiting
+/// to be made, has been made, or is gone for good.
+
+enum class eSpawnState{
+  Dormant, Active, Gone
+}; //eSpawnState
+
+/// \brief A spawn record.
+///
+/// An object placed on the map, as passive data while it is not in the
+/// object list. An object that is stored away again keeps where it got to,
+/// and anything else that it changed, for the next time it is made.
+
+struct SSpawnRecord{
+  eSprite m_eSprite = eSprite::Size; ///< Sprite type, which says what kind of object.
+  Vector2 m_vPos; ///< Position, where it was when it was stored.
+  float m_fRoll = 0.0f; ///< Orientation when it was stored.
+  uint32_t m_nHealth = 0; ///< Health when it was stored.
+  bool m_bChanged = false; ///< Whether it was stored with its health changed.
+  eSpawnState m_eState = eSpawnState::Dormant; ///< Whether it has been made.
+}; //SSpawnRecord
+
+/// \brief The spawn table.
+///
+/// CSpawnTable holds the spawn records of the current level, with the
+/// dormant ones in the level's spawn cells, so that the ones near the camera
+/// can be found without looking at the rest. Records are made from a
+/// level's spawns a cell at a time, the first time that the cell is looked
+/// at, so starting a level takes the same time however many objects it has.
+/// Making a record active takes it out of its cell, and storing it again
+/// puts it into the cell where it is now. A record whose object died is gone
+/// and is never made again. Dormant records are counted by sprite type,
+/// including those not yet made, so that objects can be counted before
+/// they are made.
+
+class CSpawnTable{
+  private:
+    const std::vector<SSpawn>* m_pSpawns = nullptr; ///< The level's spawn list.
+    const SSpawnCells* m_pCells = nullptr; ///< The level's spawns by cell.
+
+    std::vector<SSpawnRecord> m_vecRecords; ///< Records made so far.
+    std::vector<std::vector<uint32_t>> m_vecCells; ///< Dormant records in each cell made so far.
+    std::vector<uint32_t> m_vecStamp; ///< Level that each cell's records were made for.
+    uint32_t m_nStamp = 0; ///< Current level.
+
+    std::vector<size_t> m_vecActive; ///< Number of active records of each sprite type.
+    std::vector<size_t> m_vecGone; ///< Number of records gone of each sprite type.
+    size_t m_nActive = 0; ///< Number of active records.
+    size_t m_nGone = 0; ///< Number of records gone.
+
+    const size_t GetCell(const Vector2&) const; ///< Get cell at position.
+    std::vector<uint32_t>& MakeCell(size_t); ///< Make a cell's records if not made yet.
+
+  public:
+    void Set(const std::vector<SSpawn>&, const SSpawnCells&); ///< Use a new level's spawns.
+    void Find(const Vector2&, const Vector2&, std::vector<uint32_t>&); ///< Find dormant records.
+    void Wake(uint32_t); ///< Make a record active.
+    void Store(uint32_t, const SSpawnRecord&); ///< Make a record dormant again.
+    void Remove(uint32_t); ///< Make a record gone.
+
+    const SSpawnRecord& GetRecord(uint32_t) const; ///< Get a record.
+    const size_t GetNumRecords() const; ///< Get number of records.
+    const size_t GetNumMade() const; ///< Get number of records made so far.
+    const size_t GetNumDormant() const; ///< Get number of dormant records.
+    const size_t GetNumDormant(eSprite) const; ///< Get number of dormant records of a type.
+    const size_t GetNumActive() const; ///< Get number of active records.
+    const size_t GetNumGone() const; ///< Get number of records gone.
+}; //CSpawnTable
+
+#endif //__L4RC_GAME_SPAWNTABLE_H__
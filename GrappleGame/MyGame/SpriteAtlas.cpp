@@ -0,0 +1,381 @@
+/// \file SpriteAtlas.cpp
+/// \brief Code for the sprite atlas CSpriteAtlas.
+
+#include "SpriteAtlas.h"
+#include "MediaUtil.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+static const int PADDING = 1; ///< Border texels around each region.
+
+/// Order regions by sprite tag name, then frame.
+/// \param a A region.
+/// \param b Another region.
+/// \return true if `a` comes before `b`.
+
+static bool RegionLess(const SAtlasRegion& a, const SAtlasRegion& b){
+  const int c = a.m_strName.compare(b.m_strName);
+  return c < 0 || (c == 0 && a.m_nFrame < b.m_nFrame);
+} //RegionLess
+
+/// Get the folder part of a path.
+/// \param path A path with slashes.
+/// \return Everything up to and including the last slash.
+
+static std::string FolderOf(const std::string& path){
+  const size_t slash = path.find_last_of('/');
+  return slash == std::string::npos? "": path.substr(0, slash + 1);
+} //FolderOf
+
+/// Remove all pages, regions, and sources.
+
+void CSpriteAtlas::Clear(){
+  m_strFolder.clear();
+  m_vecPages.clear();
+  m_vecRegions.clear();
+  m_vecSources.clear();
+} //Clear
+
+/// Pack the frames of the sprite tags in a settings file into pages and
+/// save the pages and the manifest, unless the manifest already describes
+/// the same images with the same contents and its pages exist, in which
+/// case the manifest is loaded instead. Images that are missing or too big
+/// for a page are left out, and the renderer loads them on their own. The
+/// page width is the smallest power of two that fits everything on one
+/// page, up to `MAX_PAGE_SIZE`, after which more pages are made.
+/// \param settings Name of the settings file.
+/// \param manifest Name of the manifest file, which pages are named after.
+/// \param repacked [out] true if the images were packed, false if cached.
+/// \return true if the atlas is ready.
+
+const bool CSpriteAtlas::Build(const char* settings, const char* manifest,
+  bool& repacked)
+{
+  repacked = false;
+
+  std::string s, tag, value, contents;
+  if(!ReadFile(settings, s))return false;
+
+  std::string path; //image folder
+  if(GetTag(s, "<sprites", tag) && GetAttribute(tag, "path", value))
+    path = FixPath(value) + "/";
+
+  //list the source images and hash them
+
+  std::vector<SAtlasSource> sources;
+
+  for(size_t pos=0; NextTag(s, "<sprite", pos, tag);){
+    std::string name, file, ext;
+    if(!GetAttribute(tag, "name", name) || !GetAttribute(tag, "file", file))continue;
+
+    const size_t frames = GetAttribute(tag, "frames", value)? (size_t)atoi(value.c_str()): 1;
+    if(!GetAttribute(tag, "ext", ext))ext.clear();
+
+    for(size_t f=0; f<frames; f++){
+      SAtlasSource src;
+      src.m_strName = name;
+      src.m_nFrame = f;
+      src.m_strFile = frames > 1? file + std::to_string(f) + "." + ext: file;
+
+      if(ReadFile(path + src.m_strFile, contents))
+        src.m_nHash = HashBytes(contents.data(), contents.size());
+
+      sources.push_back(src);
+    } //for
+  } //for
+
+  //use the atlas that's there if nothing has changed
+
+  CSpriteAtlas old;
+
+  if(old.Load(manifest) && old.m_vecSources.size() == sources.size()){
+    bool same = true;
+
+    for(size_t i=0; i<sources.size() && same; i++)
+      same = old.m_vecSources[i].m_strName == sources[i].m_strName &&
+        old.m_vecSources[i].m_nFrame == sources[i].m_nFrame &&
+        old.m_vecSources[i].m_strFile == sources[i].m_strFile &&
+        old.m_vecSources[i].m_nHash == sources[i].m_nHash;
+
+    for(size_t i=0; i<old.GetNumPages() && same; i++){
+      FILE* input = fopen(old.GetPagePath(i).c_str(), "rb");
+      same = input != nullptr;
+      if(input)fclose(input);
+    } //for
+
+    if(same){
+      *this = std::move(old);
+      return true;
+    } //if
+  } //if
+
+  //decode
+
+  struct SImage{
+    size_t m_nSource = 0; ///< Index into sources.
+    int m_nWidth = 0; ///< Width in texels.
+    int m_nHeight = 0; ///< Height in texels.
+    std::vector<uint32_t> m_vecTexels; ///< Texels.
+  }; //SImage
+
+  std::vector<SImage> images;
+
+  for(size_t i=0; i<sources.size(); i++){
+    SImage img;
+    img.m_nSource = i;
+
+    if(sources[i].m_nHash != 0 &&
+      LoadImageRGBA(path + sources[i].m_strFile, img.m_nWidth, img.m_nHeight, img.m_vecTexels) &&
+      img.m_nWidth + 2*PADDING <= MAX_PAGE_SIZE && img.m_nHeight + 2*PADDING <= MAX_PAGE_SIZE)
+      images.push_back(std::move(img));
+  } //for
+
+  std::stable_sort(images.begin(), images.end(), [](const SImage& a, const SImage& b){
+    return a.m_nHeight > b.m_nHeight || (a.m_nHeight == b.m_nHeight && a.m_nWidth > b.m_nWidth);});
+
+  //pack onto shelves, tallest first
+
+  std::vector<SAtlasRegion> regions(images.size());
+  std::vector<int> used; //height used on each page
+  int size = 64; //page width
+
+  auto Pack = [&](int w, int h){ //pack into pages w wide and h high
+    int x = 0, y = 0, shelf = 0; //cursor and height of current shelf
+    used.assign(1, 0);
+
+    for(size_t i=0; i<images.size(); i++){
+      const int iw = images[i].m_nWidth + 2*PADDING, ih = images[i].m_nHeight + 2*PADDING;
+
+      if(x + iw > w){ //next shelf
+        y += shelf;
+        x = shelf = 0;
+      } //if
+
+      if(y + ih > h){ //next page
+        used.push_back(0);
+        x = y = shelf = 0;
+      } //if
+
+      regions[i].m_nPage = used.size() - 1;
+      regions[i].m_nX = x + PADDING;
+      regions[i].m_nY = y + PADDING;
+
+      x += iw;
+      shelf = std::max(shelf, ih);
+      used.back() = std::max(used.back(), y + ih);
+    } //for
+  }; //Pack
+
+  for(Pack(size, size); used.size() > 1 && size < MAX_PAGE_SIZE; Pack(size, size))
+    size *= 2;
+
+  //copy images into pages, extending the edges into the border
+
+  const std::string name = FixPath(manifest);
+  const size_t dot = name.find_last_of('.');
+
+  Clear();
+  m_strFolder = FolderOf(name);
+  m_vecSources = sources;
+
+  const std::string stem = name.substr(m_strFolder.size(),
+    dot != std::string::npos && dot > m_strFolder.size()? dot - m_strFolder.size(): std::string::npos);
+
+  for(size_t p=0; p<used.size(); p++){
+    SAtlasPage page;
+    page.m_strFile = stem + std::to_string(p) + ".png";
+    page.m_nWidth = size;
+    page.m_nHeight = 1;
+    while(page.m_nHeight < used[p])page.m_nHeight *= 2;
+
+    std::vector<uint32_t> texels((size_t)page.m_nWidth*page.m_nHeight, 0);
+
+    for(size_t i=0; i<images.size(); i++){
+      if(regions[i].m_nPage != p)continue;
+
+      const SImage& img = images[i];
+      SAtlasRegion& r = regions[i];
+
+      for(int y=-PADDING; y<img.m_nHeight+PADDING; y++)
+        for(int x=-PADDING; x<img.m_nWidth+PADDING; x++){
+          const int sx = std::min(img.m_nWidth - 1, std::max(0, x));
+          const int sy = std::min(img.m_nHeight - 1, std::max(0, y));
+          texels[(size_t)(r.m_nY + y)*page.m_nWidth + r.m_nX + x] =
+            img.m_vecTexels[(size_t)sy*img.m_nWidth + sx];
+        } //for
+
+      r.m_strName = sources[img.m_nSource].m_strName;
+      r.m_nFrame = sources[img.m_nSource].m_nFrame;
+      r.m_nWidth = img.m_nWidth;
+      r.m_nHeight = img.m_nHeight;
+      r.m_fU0 = (float)r.m_nX/page.m_nWidth;
+      r.m_fV0 = (float)r.m_nY/page.m_nHeight;
+      r.m_fU1 = (float)(r.m_nX + r.m_nWidth)/page.m_nWidth;
+      r.m_fV1 = (float)(r.m_nY + r.m_nHeight)/page.m_nHeight;
+    } //for
+
+    if(!WritePNG((m_strFolder + page.m_strFile).c_str(), page.m_nWidth, page.m_nHeight, texels.data(), true))
+      return false;
+
+    m_vecPages.push_back(page);
+  } //for
+
+  m_vecRegions = std::move(regions);
+  std::sort(m_vecRegions.begin(), m_vecRegions.end(), RegionLess);
+
+  repacked = true;
+  return Save(manifest);
+} //Build
+
+/// Save the manifest, which lists the pages, the regions with their texture
+/// coordinates, and the source images with their hashes.
+/// \param manifest Name of the manifest file.
+/// \return true if the file was written.
+
+const bool CSpriteAtlas::Save(const char* manifest) const{
+  FILE* output = fopen(manifest, "wt");
+  if(output == nullptr)return false;
+
+  fprintf(output, "<?xml version=\"1.0\"?>\n\n");
+  fprintf(output, "<!-- Sprite atlas made by \"Bench atlas\", do not edit -->\n\n");
+  fprintf(output, "<atlas>\n");
+
+  for(const SAtlasPage& p: m_vecPages)
+    fprintf(output, "  <page file=\"%s\" width=\"%d\" height=\"%d\"/>\n",
+      p.m_strFile.c_str(), p.m_nWidth, p.m_nHeight);
+
+  for(const SAtlasRegion& r: m_vecRegions)
+    fprintf(output, "  <region name=\"%s\" frame=\"%zu\" page=\"%zu\" x=\"%d\" y=\"%d\" "
+      "width=\"%d\" height=\"%d\" u0=\"%.6f\" v0=\"%.6f\" u1=\"%.6f\" v1=\"%.6f\"/>\n",
+      r.m_strName.c_str(), r.m_nFrame, r.m_nPage, r.m_nX, r.m_nY, r.m_nWidth,
+      r.m_nHeight, r.m_fU0, r.m_fV0, r.m_fU1, r.m_fV1);
+
+  for(const SAtlasSource& src: m_vecSources)
+    fprintf(output, "  <source name=\"%s\" frame=\"%zu\" file=\"%s\" hash=\"%016llx\"/>\n",
+      src.m_strName.c_str(), src.m_nFrame, src.m_strFile.c_str(),
+      (unsigned long long)src.m_nHash);
+
+  fprintf(output, "</atlas>\n");
+
+  const bool ok = ferror(output) == 0;
+  fclose(output);
+
+  return ok;
+} //Save
+
+/// Load a manifest saved by `Build()`, replacing anything held. The page
+/// images are not loaded, that's up to the renderer.
+/// \param manifest Name of the manifest file.
+/// \return true if the manifest was read and has at least one page.
+
+const bool CSpriteAtlas::Load(const char* manifest){
+  Clear();
+
+  std::string s, tag, value;
+  if(!ReadFile(manifest, s) || !GetTag(s, "<atlas", tag))return false;
+
+  m_strFolder = FolderOf(FixPath(manifest));
+
+  auto Int = [&](const char* name){ //integer attribute of tag
+    return GetAttribute(tag, name, value)? atoi(value.c_str()): 0;
+  }; //Int
+
+  auto Float = [&](const char* name){ //float attribute of tag
+    return GetAttribute(tag, name, value)? (float)atof(value.c_str()): 0.0f;
+  }; //Float
+
+  for(size_t pos=0; NextTag(s, "<page", pos, tag);){
+    SAtlasPage p;
+    GetAttribute(tag, "file", p.m_strFile);
+    p.m_nWidth = Int("width");
+    p.m_nHeight = Int("height");
+    m_vecPages.push_back(p);
+  } //for
+
+  for(size_t pos=0; NextTag(s, "<region", pos, tag);){
+    SAtlasRegion r;
+    GetAttribute(tag, "name", r.m_strName);
+    r.m_nFrame = (size_t)Int("frame");
+    r.m_nPage = (size_t)Int("page");
+    r.m_nX = Int("x");
+    r.m_nY = Int("y");
+    r.m_nWidth = Int("width");
+    r.m_nHeight = Int("height");
+    r.m_fU0 = Float("u0");
+    r.m_fV0 = Float("v0");
+    r.m_fU1 = Float("u1");
+    r.m_fV1 = Float("v1");
+
+    if(r.m_nPage < m_vecPages.size())
+      m_vecRegions.push_back(r);
+  } //for
+
+  for(size_t pos=0; NextTag(s, "<source", pos, tag);){
+    SAtlasSource src;
+    GetAttribute(tag, "name", src.m_strName);
+    src.m_nFrame = (size_t)Int("frame");
+    GetAttribute(tag, "file", src.m_strFile);
+    if(GetAttribute(tag, "hash", value))src.m_nHash = strtoull(value.c_str(), nullptr, 16);
+    m_vecSources.push_back(src);
+  } //for
+
+  std::sort(m_vecRegions.begin(), m_vecRegions.end(), RegionLess);
+
+  return !m_vecPages.empty();
+} //Load
+
+/// Find the region of a frame of a sprite.
+/// \param name Name of sprite tag.
+/// \param frame Frame number.
+/// \return Pointer to the region, or `nullptr` if it isn't in the atlas.
+
+const SAtlasRegion* CSpriteAtlas::Find(const char* name, size_t frame) const{
+  SAtlasRegion key;
+  key.m_strName = name;
+  key.m_nFrame = frame;
+
+  auto i = std::lower_bound(m_vecRegions.begin(), m_vecRegions.end(), key, RegionLess);
+
+  return i != m_vecRegions.end() && i->m_strName == name && i->m_nFrame == frame? &*i: nullptr;
+} //Find
+
+/// Reader function for the number of pages.
+/// \return Number of pages.
+
+const size_t CSpriteAtlas::GetNumPages() const{
+  return m_vecPages.size();
+} //GetNumPages
+
+/// Reader function for a page.
+/// \param i Page index.
+/// \return The page.
+
+const SAtlasPage& CSpriteAtlas::GetPage(size_t i) const{
+  return m_vecPages[i];
+} //GetPage
+
+/// Get the path of a page image, which is in the manifest's folder.
+/// \param i Page index.
+/// \return Path of the page image.
+
+const std::string CSpriteAtlas::GetPagePath(size_t i) const{
+  return m_strFolder + m_vecPages[i].m_strFile;
+} //GetPagePath
+
+/// Reader function for the number of regions.
+/// \return Number of frames in the atlas.
+
+const size_t CSpriteAtlas::GetNumRegions() const{
+  return m_vecRegions.size();
+} //GetNumRegions
+
+/// Reader function for a region.
+/// \param i Region index, in order of name and frame.
+/// \return The region.
+
+const SAtlasRegion& CSpriteAtlas::GetRegion(size_t i) const{
+  return m_vecRegions[i];
+} //GetRegion
@@ -0,0 +1,88 @@
+/// \file SpriteAtlas.h
+/// \brief Interface for the sprite atlas CSpriteAtlas.
+
+#ifndef __L4RC_GAME_SPRITEATLAS_H__
+#define __L4RC_GAME_SPRITEATLAS_H__
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/// \brief A frame of a sprite in an atlas.
+///
+/// Where one frame of a sprite tag was packed, in texels and as texture
+/// coordinates.
+
+struct SAtlasRegion{
+  std::string m_strName; ///< Name of sprite tag.
+  size_t m_nFrame = 0; ///< Frame number.
+  size_t m_nPage = 0; ///< Page index.
+  int m_nX = 0; ///< Left in texels.
+  int m_nY = 0; ///< Top in texels.
+  int m_nWidth = 0; ///< Width in texels.
+  int m_nHeight = 0; ///< Height in texels.
+  float m_fU0 = 0.0f; ///< Left texture coordinate.
+  float m_fV0 = 0.0f; ///< Top texture coordinate.
+  float m_fU1 = 0.0f; ///< Right texture coordinate.
+  float m_fV1 = 0.0f; ///< Bottom texture coordinate.
+}; //SAtlasRegion
+
+/// \brief A page of an atlas.
+
+struct SAtlasPage{
+  std::string m_strFile; ///< Image file name, in the manifest's folder.
+  int m_nWidth = 0; ///< Width in texels.
+  int m_nHeight = 0; ///< Height in texels.
+}; //SAtlasPage
+
+/// \brief A source image of an atlas.
+///
+/// An image file named by a sprite tag and the hash of its contents, which
+/// tells whether the atlas is out of date.
+
+struct SAtlasSource{
+  std::string m_strName; ///< Name of sprite tag.
+  size_t m_nFrame = 0; ///< Frame number.
+  std::string m_strFile; ///< Image file name.
+  uint64_t m_nHash = 0; ///< Hash of file contents, 0 if missing.
+}; //SAtlasSource
+
+/// \brief The sprite atlas.
+///
+/// CSpriteAtlas packs every frame of every sprite tag in `gamesettings.xml`
+/// into a few large texture pages so that a renderer can load a handful of
+/// images instead of one per frame and draw different sprites without
+/// switching textures. `Build()` is the offline packer, run from the Bench
+/// tool: it packs the images onto shelves, tallest first, with a one texel
+/// border copied from the edge of each image so that filtering doesn't
+/// bleed between neighbors, then writes the pages as PNG files and a
+/// manifest that holds the regions and the hash of each source image.
+/// Unchanged images are not repacked. `Load()` reads the manifest at run
+/// time, and `Find()` gives the region of a frame by the name of its sprite
+/// tag, which the renderer's `Load()` already uses to find images.
+
+class CSpriteAtlas{
+  private:
+    std::string m_strFolder; ///< Folder that the manifest and pages are in.
+    std::vector<SAtlasPage> m_vecPages; ///< Pages.
+    std::vector<SAtlasRegion> m_vecRegions; ///< Regions sorted by name and frame.
+    std::vector<SAtlasSource> m_vecSources; ///< Source images in settings order.
+
+    const bool Save(const char*) const; ///< Save the manifest.
+
+  public:
+    static const int MAX_PAGE_SIZE = 2048; ///< Largest page width and height.
+
+    void Clear(); ///< Remove all pages and regions.
+    const bool Build(const char*, const char*, bool&); ///< Pack the sprites.
+    const bool Load(const char*); ///< Load a manifest.
+
+    const SAtlasRegion* Find(const char*, size_t) const; ///< Find a region.
+    const size_t GetNumPages() const; ///< Get number of pages.
+    const SAtlasPage& GetPage(size_t) const; ///< Get a page.
+    const std::string GetPagePath(size_t) const; ///< Get path of a page image.
+    const size_t GetNumRegions() const; ///< Get number of regions.
+    const SAtlasRegion& GetRegion(size_t) const; ///< Get a region.
+}; //CSpriteAtlas
+
+#endif //__L4RC_GAME_SPRITEATLAS_H__
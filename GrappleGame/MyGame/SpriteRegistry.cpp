@@ -0,0 +1,54 @@
+/// \file SpriteRegistry.cpp
+/// \brief Code for the sprite registry CSpriteRegistry.
+
+#include "SpriteRegistry.h"
+
+#include <algorithm>
+
+/// Add a sprite, dropping it if its type is already there with the same
+/// name and replacing the name if not.
+/// \param t Sprite type.
+/// \param name Name of sprite tag.
+
+void CSpriteRegistry::AddSprite(size_t t, const char* name){
+  auto i = std::find(m_vecTypes.begin(), m_vecTypes.end(), t);
+
+  if(i == m_vecTypes.end()){
+    m_vecTypes.push_back(t);
+    m_vecNames.push_back(name);
+  } //if
+
+  else{
+    m_vecNames[i - m_vecTypes.begin()] = name;
+    m_nDuplicates++;
+  } //else
+} //AddSprite
+
+/// Remove all sprites and reset the duplicate count.
+
+void CSpriteRegistry::Clear(){
+  m_vecTypes.clear();
+  m_vecNames.clear();
+  m_nDuplicates = 0;
+} //Clear
+
+/// Reader function for the number of sprites.
+/// \return Number of sprites to be loaded.
+
+const size_t CSpriteRegistry::GetSize() const{
+  return m_vecTypes.size();
+} //GetSize
+
+/// Reader function for the number of duplicate adds.
+/// \return Number of adds that were dropped or replaced a name.
+
+const size_t CSpriteRegistry::GetNumDuplicates() const{
+  return m_nDuplicates;
+} //GetNumDuplicates
+
+/// Reader function for the sprite tag names.
+/// \return Names of the sprite tags in the order they will be loaded.
+
+const std::vector<std::string>& CSpriteRegistry::GetNames() const{
+  return m_vecNames;
+} //GetNames
@@ -0,0 +1,53 @@
+/// \file SpriteRegistry.h
+/// \brief Interface for the sprite registry CSpriteRegistry.
+
+#ifndef __L4RC_GAME_SPRITEREGISTRY_H__
+#define __L4RC_GAME_SPRITEREGISTRY_H__
+
+#include <vector>
+#include <string>
+
+/// \brief The sprite registry.
+///
+/// CSpriteRegistry is the list of sprites to load, each a sprite type and
+/// the name of its sprite tag in `gamesettings.xml`. A sprite type that is
+/// added again with the same name is dropped, and one added with a new name
+/// replaces the old one, so each sprite is loaded once no matter how many
+/// times it was added. The sprites are loaded by `Load()`, in the order they
+/// were first added, by any renderer that has `Load(type, name)`. Renderers
+/// that can decode in parallel can be given `GetNames()` first.
+
+class CSpriteRegistry{
+  private:
+    std::vector<size_t> m_vecTypes; ///< Sprite types.
+    std::vector<std::string> m_vecNames; ///< Sprite tag names, one per type.
+    size_t m_nDuplicates = 0; ///< Number of adds dropped or replaced.
+
+    void AddSprite(size_t, const char*); ///< Add a sprite.
+
+  public:
+    void Clear(); ///< Remove all sprites.
+
+    const size_t GetSize() const; ///< Get number of sprites.
+    const size_t GetNumDuplicates() const; ///< Get number of duplicate adds.
+    const std::vector<std::string>& GetNames() const; ///< Get sprite tag names.
+
+    /// Add a sprite to be loaded.
+    /// \param t Sprite type.
+    /// \param name Name of sprite tag.
+
+    template<class E> void Add(E t, const char* name){
+      AddSprite((size_t)t, name);
+    } //Add
+
+    /// Load the sprites.
+    /// \tparam E Sprite type, usually `eSprite`.
+    /// \param pRenderer Pointer to renderer.
+
+    template<class E, class R> void Load(R* pRenderer) const{
+      for(size_t i=0; i<m_vecTypes.size(); i++)
+        pRenderer->Load((E)m_vecTypes[i], m_vecNames[i].c_str());
+    } //Load
+}; //CSpriteRegistry
+
+#endif //__L4RC_GAME_SPRITEREGISTRY_H__
@@ -11,16 +11,19 @@ CStar::CStar(const Vector2& p) : CObject(eSprite::Star, p)
 {
 	m_bIsTarget = false;
 	m_bStatic = true;
+	m_bSensor = true;
 	m_bIsStar = true;
 }
 
-void CStar::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
+/// Response to the start of an overlap. The star is picked up, and so dies,
+/// when the player first touches it.
+/// \param pObj Pointer to the other object.
+
+void CStar::OverlapBegin(CObject* pObj) {
     if (m_bDead)return; //already dead, bail out 
 
-    if (pObj && pObj->isPlayer())
+    if (pObj->isPlayer())
     {
         m_bDead = true; //flag for deletion from object list
     }
-
-    CObject::CollisionResponse(norm, d, pObj);
-} //CollisionResponse
\ No newline at end of file
+} //OverlapBegin
\ No newline at end of file
@@ -13,7 +13,7 @@
 
 class CStar : public CObject {\
 protected:
-	virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
+	virtual void OverlapBegin(CObject*); ///< Response to starting to overlap.
 public:
 	CStar(const Vector2& p);
 };
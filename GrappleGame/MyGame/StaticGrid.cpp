@@ -0,0 +1,164 @@
+/// \file StaticGrid.cpp
+/// \brief Code for the static object grid CStaticGrid.
+
+#include <cmath>
+#include <algorithm>
+
+#include "StaticGrid.h"
+
+static const size_t MIN_QUERY_ITEMS = 16; ///< Fewest circles for which a query beats testing every one.
+
+/// Take every circle out of the grid and size it to cover a world. Circles
+/// off the world are put in the nearest cell, so they are still found.
+/// \param w World width.
+/// \param h World height.
+/// \param cellsize Width and height of a cell.
+
+void CStaticGrid::Set(float w, float h, float cellsize){
+  m_fCellSize = std::max(1.0f, cellsize);
+  m_nWide = std::max<size_t>(1, (size_t)ceilf(w/m_fCellSize));
+  m_nHigh = std::max<size_t>(1, (size_t)ceilf(h/m_fCellSize));
+  m_fMaxRadius = 0.0f;
+
+  m_vecHead.assign(m_nWide*m_nHigh, UINT32_MAX);
+  m_vecItems.clear();
+  m_nFree = UINT32_MAX;
+  m_nCount = 0;
+} //Set
+
+/// Get the column that a horizontal position is in.
+/// \param x Horizontal position.
+/// \return Column, clamped to the grid.
+
+const size_t CStaticGrid::GetCol(float x) const{
+  return std::min((size_t)std::max(0.0f, x/m_fCellSize), m_nWide - 1);
+} //GetCol
+
+/// Get the row that a vertical position is in.
+/// \param y Vertical position.
+/// \return Row, clamped to the grid.
+
+const size_t CStaticGrid::GetRow(float y) const{
+  return std::min((size_t)std::max(0.0f, y/m_fCellSize), m_nHigh - 1);
+} //GetRow
+
+/// Put a circle into the cell that its center is in.
+/// \param p Center.
+/// \param r Radius.
+/// \return Handle of the circle, for `Erase()` and for matching query results.
+
+const uint32_t CStaticGrid::Insert(const Vector2& p, float r){
+  if(m_vecHead.empty())
+    Set(0.0f, 0.0f, m_fCellSize); //one cell until set
+
+  uint32_t n = m_nFree; //handle
+
+  if(n != UINT32_MAX)
+    m_nFree = m_vecItems[n].m_nNext;
+
+  else{
+    n = (uint32_t)m_vecItems.size();
+    m_vecItems.push_back(SItem());
+  } //else
+
+  const uint32_t c = (uint32_t)(GetRow(p.y)*m_nWide + GetCol(p.x)); //cell
+  SItem& item = m_vecItems[n]; //shorthand
+
+  item.m_vPos = p;
+  item.m_fRadius = r;
+  item.m_nCell = c;
+  item.m_nPrev = UINT32_MAX;
+  item.m_nNext = m_vecHead[c];
+
+  if(item.m_nNext != UINT32_MAX)
+    m_vecItems[item.m_nNext].m_nPrev = n;
+
+  m_vecHead[c] = n;
+  m_fMaxRadius = std::max(m_fMaxRadius, r);
+  m_nCount++;
+
+  return n;
+} //Insert
+
+/// Take a circle out of the grid. Handles not in use are left alone.
+/// \param n Handle of the circle, as given by `Insert()`.
+
+void CStaticGrid::Erase(uint32_t n){
+  if(n >= m_vecItems.size() || m_vecItems[n].m_nCell == UINT32_MAX)return;
+
+  SItem& item = m_vecItems[n]; //shorthand
+
+  if(item.m_nPrev != UINT32_MAX)
+    m_vecItems[item.m_nPrev].m_nNext = item.m_nNext;
+  else m_vecHead[item.m_nCell] = item.m_nNext;
+
+  if(item.m_nNext != UINT32_MAX)
+    m_vecItems[item.m_nNext].m_nPrev = item.m_nPrev;
+
+  item.m_nCell = UINT32_MAX;
+  item.m_nNext = m_nFree;
+  m_nFree = n;
+  m_nCount--;
+} //Erase
+
+/// Find the circles that overlap a circle, looking only at the cells that
+/// the query circle grown by the largest radius in the grid overlaps.
+/// \param p Center of the query circle.
+/// \param r Radius of the query circle.
+/// \param out [out] Handles of the circles that overlap it, replacing anything there.
+/// \return Number of circles looked at, which is the work done.
+
+const size_t CStaticGrid::Query(const Vector2& p, float r,
+  std::vector<uint32_t>& out) const
+{
+  out.clear();
+  if(m_nCount == 0)return 0;
+
+  const float reach = r + m_fMaxRadius; //how far a center can be and still overlap
+  const size_t x0 = GetCol(p.x - reach), x1 = GetCol(p.x + reach);
+  const size_t y0 = GetRow(p.y - reach), y1 = GetRow(p.y + reach);
+  size_t looked = 0; //number of circles looked at
+
+  for(size_t y=y0; y<=y1; y++)
+    for(size_t x=x0; x<=x1; x++)
+      for(uint32_t n=m_vecHead[y*m_nWide + x]; n!=UINT32_MAX; n=m_vecItems[n].m_nNext){
+        const SItem& item = m_vecItems[n]; //shorthand
+        const float d = r + item.m_fRadius; //distance at which they touch
+        looked++;
+
+        if(Vector2::DistanceSquared(p, item.m_vPos) < d*d)
+          out.push_back(n);
+      } //for
+
+  return looked;
+} //Query
+
+/// Reader function for the number of circles.
+/// \return Number of circles in the grid.
+
+const size_t CStaticGrid::GetNumItems() const{
+  return m_nCount;
+} //GetNumItems
+
+/// Determine whether querying the grid is faster than testing every circle
+/// in it, which it isn't for the handful of static objects on the levels
+/// that ship with the game.
+/// \return true if there are enough circles to query the grid.
+
+const bool CStaticGrid::IsWorthQuerying() const{
+  return m_nCount >= MIN_QUERY_ITEMS;
+} //IsWorthQuerying
+
+/// Reader function for the number of cells.
+/// \return Number of cells in the grid.
+
+const size_t CStaticGrid::GetNumCells() const{
+  return m_vecHead.size();
+} //GetNumCells
+
+/// Get the memory used by the grid.
+/// \return Bytes used by the cells and items.
+
+const size_t CStaticGrid::GetMemory() const{
+  return m_vecHead.capacity()*sizeof(uint32_t) + m_vecItems.capacity()*sizeof(SItem);
+} //GetMemory
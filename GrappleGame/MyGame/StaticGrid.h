@@ -0,0 +1,67 @@
+/// \file StaticGrid.h
+/// \brief Interface for the static object grid CStaticGrid.
+
+#ifndef __L4RC_GAME_STATICGRID_H__
+#define __L4RC_GAME_STATICGRID_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "GameDefines.h"
+
+/// \brief The static object grid.
+///
+/// CStaticGrid indexes the bounding circles of objects that never move, such
+/// as spikes, doors, launch pads, and pickups, by the grid cell that each
+/// center is in, so that a moving object can find the ones that it overlaps
+/// by looking only at the cells around it. The grid is a packed array with
+/// the head of a list in each cell, sized once per level, and the circles
+/// are kept in an array of items threaded through those lists, so putting a
+/// circle in or taking it out takes constant time and doesn't allocate once
+/// the arrays have grown. A query reaches out by the radius of the largest
+/// circle put in since the grid was set, so only one cell holds each circle.
+/// With only a few circles it is faster to test every one of them, and
+/// `IsWorthQuerying()` says when that is.
+
+class CStaticGrid{
+  private:
+    /// \brief An item in the grid.
+    ///
+    /// A bounding circle and its place in the list of its cell, or in the
+    /// free list if it is not in use.
+
+    struct SItem{
+      Vector2 m_vPos; ///< Center.
+      float m_fRadius = 0.0f; ///< Radius.
+      uint32_t m_nCell = UINT32_MAX; ///< Cell, `UINT32_MAX` if not in use.
+      uint32_t m_nNext = UINT32_MAX; ///< Next item in the same list.
+      uint32_t m_nPrev = UINT32_MAX; ///< Previous item in its cell, `UINT32_MAX` if first.
+    }; //SItem
+
+    float m_fCellSize = 128.0f; ///< Width and height of a cell.
+    size_t m_nWide = 0; ///< Width in cells.
+    size_t m_nHigh = 0; ///< Height in cells.
+    float m_fMaxRadius = 0.0f; ///< Largest radius put in since the grid was set.
+
+    std::vector<uint32_t> m_vecHead; ///< First item in each cell, `UINT32_MAX` if none.
+    std::vector<SItem> m_vecItems; ///< Items, in use or free.
+    uint32_t m_nFree = UINT32_MAX; ///< First free item.
+    size_t m_nCount = 0; ///< Number of items in use.
+
+    const size_t GetCol(float) const; ///< Get column at horizontal position.
+    const size_t GetRow(float) const; ///< Get row at vertical position.
+
+  public:
+    void Set(float, float, float); ///< Empty the grid and size it for a world.
+    const uint32_t Insert(const Vector2&, float); ///< Put a circle in.
+    void Erase(uint32_t); ///< Take a circle out.
+    const size_t Query(const Vector2&, float, std::vector<uint32_t>&) const; ///< Find overlapping circles.
+
+    const bool IsWorthQuerying() const; ///< Whether queries beat testing every circle.
+    const size_t GetNumItems() const; ///< Get number of circles in the grid.
+    const size_t GetNumCells() const; ///< Get number of cells.
+    const size_t GetMemory() const; ///< Get memory used in bytes.
+}; //CStaticGrid
+
+#endif //__L4RC_GAME_STATICGRID_H__
@@ -4,320 +4,99 @@
 #include "TileManager.h"
 #include "SpriteRenderer.h"
 #include "Abort.h"
+#include "DrawQueue.h"
 
-#define STBI_ASSERT(x)
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
+static const float PROP_RADIUS = 16.0f; ///< Bounding circle radius of the spike and launch pad sprites.
 
 /// Construct a tile manager using square tiles, given the width and height
-/// of each tile.
+/// of each tile. It starts with an empty level.
 /// \param n Width and height of square tile in pixels.
 
 CTileManager::CTileManager(size_t n):
-  m_fTileSize((float)n){
+  m_fTileSize((float)n), m_cLosBatch(16.0f*n)
+{
+  SetLevel(std::make_shared<CLevelData>(m_fTileSize));
 } //constructor
 
-/// Delete the memory used for storing the map.
-
-CTileManager::~CTileManager(){
-  for(size_t i=0; i<m_nHeight; i++)
-    delete [] m_chMap[i];
-
-  delete [] m_chMap;
-} //destructor
-
-/// Make the AABBs for the walls. Care is taken to use the longest horizontal
-/// and vertical AABBs possible so that there aren't so many of them.
-
-void CTileManager::MakeBoundingBoxes(){
-  m_vecWalls.clear(); //no walls yet
+/// Make a level the current one. The previous level is released once
+/// nothing else is holding on to it. Every object on the map but the player
+/// gets a dormant spawn record, made when it is first looked for.
+/// \param level The new level.
 
-  BoundingBox aabb; //current bounding box
-  const float t = m_fTileSize; //shorthand for tile width and height
-  const Vector3 vTileExtents = 0.5f*t*Vector3::One; //tile extents extended to 3D
-  BoundingBox b; //single-tile bounding box
-  b.Extents = vTileExtents; //bounding box extents cover a single tile
-
-  //horizontal walls with more than one tile
-
-  const Vector2 vstart(t/2, t*(m_nHeight - 0.5f)); //start position
-  Vector2 pos = vstart; //set current position to start position
-  
-  for(size_t i=0; i<m_nHeight; i++){ //for each row
-    size_t j = 0; //column index
-    pos.x = vstart.x; //set start position x coordinate
-
-    while(j < m_nWidth){ //for each column
-      while(j < m_nWidth && m_chMap[i][j] != 'W'){ //skip over non-wall entries
-        j++; //next column
-        pos.x += t; //move right by tile width
-      } //while
-
-      if(j < m_nWidth){ //found leftmost tile in a wall
-        aabb.Center = Vector3(pos.x, pos.y, 0); //bounding box center
-        aabb.Extents = vTileExtents; //bounding box extents
-        j++; //next column
-        pos.x += t; //move right by tile width
-      } //if
+void CTileManager::SetLevel(const std::shared_ptr<const CLevelData>& level){
+  m_pLevel = level;
+  m_nWidth = level->m_nWidth;
+  m_nHeight = level->m_nHeight;
+  m_chMap = level->m_vecRows.data();
+  m_pProps = level->m_nPropTiles > 0? level->m_vecProps.data(): nullptr;
 
-      bool bSingleTile = true; //as far as we know, this is a single-tile wall
-
-      while(j < m_nWidth && m_chMap[i][j] == 'W'){ //for each adjacent wall tile
-        b.Center = Vector3(pos.x, pos.y, 0); //bounding box center
-        BoundingBox::CreateMerged(aabb, aabb, b); //merge b into aabb
-        bSingleTile = false; //the wall now has at least 2 tiles in it
-        j++; //next column
-        pos.x += t; //move right by tile width
-      } //while
+  m_vWorldSize = Vector2((float)m_nWidth, (float)m_nHeight)*m_fTileSize;
+  m_cFlowField.SetMap(m_chMap, m_nWidth, m_nHeight, m_fTileSize);
+  m_cPathFinder.SetMap(m_chMap, m_nWidth, m_nHeight);
+  m_cNavRoute.Reset();
 
-      if(!bSingleTile) //skip this wall if it is a single tile
-        m_vecWalls.push_back(aabb); //add horizontal wall to the list
-    } //while
+  m_cLosBatch.Clear();
+  m_cLosBatch.ClearWalls();
 
-    pos.y -= t; //next row
-  } //for
+  for(const BoundingBox& b: level->m_vecWalls)
+    m_cLosBatch.AddWall(b.Center.x - b.Extents.x, b.Center.y - b.Extents.y,
+      b.Center.x + b.Extents.x, b.Center.y + b.Extents.y);
 
-  //vertical walls, the single tiles get caught here
-
-  pos = vstart; //reset current position to start position
-  
-  for(size_t j=0; j<m_nWidth; j++){ //for each column
-    size_t i = 0; //row index
-    pos.y = vstart.y; //set start position y coordinate
-
-    while(i < m_nHeight){ //for each row
-      while(i < m_nHeight && m_chMap[i][j] != 'W'){ //skip over non-wall entries
-        i++; //next row
-        pos.y -= t; //move down by tile height
-      } //while
-
-      if(i < m_nHeight){ //found topmost tile in a wall
-        aabb.Center = Vector3(pos.x, pos.y, 0); //bounding box center
-        aabb.Extents = vTileExtents; //bounding box extents
-        i++; //next row
-        pos.y -= t; //move down by tile height
-      } //if
-      
-      bool bSingleTile = true; //as far as we know, this is a single-tile wall
-
-      while(i < m_nHeight && m_chMap[i][j] == 'W'){ //for each adjacent wall tile
-        b.Center = Vector3(pos.x, pos.y, 0); //bounding box center
-        BoundingBox::CreateMerged(aabb, aabb, b); //merge b into aabb
-        bSingleTile = false; //the wall now has at least 2 tiles in it
-        i++; //next row
-        pos.y -= t; //move down by tile height
-      } //while
-      
-      if(!bSingleTile) //skip this wall if it is a single tile
-        m_vecWalls.push_back(aabb); //add horizontal wall to the list
-    } //while
-
-    pos.x += t; //next column
-  } //for
-
-  //orphaned single tiles
-
-  pos = vstart; //reset current position to start position
-  
-  for(size_t i=0; i<m_nHeight; i++){ //for each row
-    for(size_t j=0; j<m_nWidth; j++){ //for each column
-      if(m_chMap[i][j] == 'W' && //is a wall tile and
-        ((i == 0 || m_chMap[i - 1][j] != 'W') && //has non-wall tile below or is on edge
-         (i == m_nHeight - 1 || m_chMap[i + 1][j] != 'W') && //has non-wall tile above or is on edge
-         (j == 0 || m_chMap[i][j - 1] != 'W') && //has non-wall tile at left or is on edge
-         (j == m_nWidth - 1 || m_chMap[i][j + 1] != 'W') //has non-wall tile at right or is on edge
-        )
-      ){    
-        b.Center = Vector3(pos.x, pos.y, 0); //bounding box center
-        m_vecWalls.push_back(b); //add single-tile wall to the list
-      } //if
-
-      pos.x += t; //next column
-    } //for
-    
-    pos.x = vstart.x; //first column
-    pos.y -= t; //next row
-  } //for
-} //MakeBoundingBoxes
+  m_cLosBatch.Evaluate(); //sort the walls into columns now, not on the first frame
+  m_cSpawnTable.Set(level->m_vecSpawns, level->m_sSpawnCells);
+} //SetLevel
 
-/// Delete the old map (if any), allocate the right sized chunk of memory for
-/// the new map, and read it from a text file.
+/// Load a map from a text file on this thread and make it the current level.
 /// \param filename Name of the map file.
 
-void CTileManager::LoadMap(char* filename){
-  if(m_chMap != nullptr){ //unload any previous maps
-    for(size_t i=0; i<m_nHeight; i++)
-      delete [] m_chMap[i];
-
-    delete [] m_chMap;
-  } //if
-
-  m_vecTurrets.clear(); //clear out the turret list
-  m_vecSpikes.clear();
-  m_vDoor.clear();
-  m_vStar.clear();
-  m_vBats.clear();
-  m_vLaunchPad.clear();
-  m_vHealthPack.clear();
-  m_vOneUp.clear();
-
-
-  FILE *input; //input file handle
-
-  fopen_s(&input, filename, "rb"); //open the map file
-  if(input == nullptr) //abort if it's missing
-    ABORT("Map &s not found.", filename); //panic
-
-  //read map file into a character buffer 
-
-  fseek(input, 0, SEEK_END); //seek to end of map file
-  const size_t n = ftell(input); //get file size in bytes
-  rewind(input); //seek to start of file
-
-  char *buffer = new char[n + 1]; //temporary character buffer
-  fread(buffer, n, 1, input); //read the whole thing in a chunk
-  fclose(input); //close the map file, we're done with it
-
-  //get map width and height into m_nWidth and m_nHeight
-
-  m_nWidth = 0; 
-  m_nHeight = 0;
-  size_t w = 0; //width of current row
-  bool bFirstLine = true;
-
-  for(size_t i=0; i<n; i++){
-    if(buffer[i] != '\n')
-      w++; //skip characters until the end of line
-    else{
-      if(w == 0)ABORT("Panic!"); //should never happen
-
-      if(w != m_nWidth && !bFirstLine && w != 0) //not the same length as the previous one
-        ABORT("Line %d of map is not the same length as the previous one.", m_nHeight);
-
-      m_nWidth = w; w = 0; m_nHeight++; //next line
-      bFirstLine = false; //the next line is not the first
-    } //else
-  } //for
-
-
-  //allocate space for the map 
-  
-  m_chMap = new char*[m_nHeight];
+void CTileManager::LoadMap(const char* filename){
+  std::shared_ptr<CLevelData> level = std::make_shared<CLevelData>(m_fTileSize);
 
-  for(size_t i=0; i<m_nHeight; i++)
-    m_chMap[i] = new char[m_nWidth];
+  if(!level->Load(filename))
+    ABORT("%s", level->GetError().c_str()); //panic
 
-  //load the map information from the buffer to the map
-
-  size_t index = 0; //index into character buffer
-  
-  //nested for loop for placement of 2-dimensional assets
-  for(size_t i=0; i<m_nHeight; i++){
-    for(size_t j=0; j<m_nWidth; j++){
-      const char c = buffer[index];
-
-      if(c == 'T'){ // TURRET
-        m_chMap[i][j] = 'F'; //floor tile
-        const Vector2 pos = m_fTileSize*Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-        m_vecTurrets.push_back(pos);
-      } //if
-
-      else if(c == 'P'){    // PLAYER
-        m_chMap[i][j] = 'F'; //floor tile
-        m_vPlayer = m_fTileSize*Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-      } //else if
-
-      else if (c == 'S') {  // SPIKES
-          m_chMap[i][j] = 'F'; //floor tile
-          const Vector2 pos = m_fTileSize * Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-          m_vecSpikes.push_back(pos);
-      } //else if
-
-      else if (c == 'D') {  // DOOR
-          m_chMap[i][j] = 'F'; //floor tile
-          const Vector2 pos = m_fTileSize * Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-          m_vDoor.push_back(pos);
-      } //else if
-
-      else if (c == 'I') {  // STAR
-          m_chMap[i][j] = 'F'; //floor tile
-          const Vector2 pos = m_fTileSize * Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-          m_vStar.push_back(pos);
-      }
-
-      else if (c == 'B') {  // BATS
-          m_chMap[i][j] = 'F'; //floor tile
-          const Vector2 pos = m_fTileSize * Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-          m_vBats.push_back(pos);
-      }
-
-      else if (c == 'L') {  // LAUNCHPAD
-          m_chMap[i][j] = 'F'; //floor tile
-          const Vector2 pos = m_fTileSize * Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-          m_vLaunchPad.push_back(pos);
-      }
-
-      else if (c == 'H') {  // HEALTHPACK
-          m_chMap[i][j] = 'F'; //floor tile
-          const Vector2 pos = m_fTileSize * Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-          m_vHealthPack.push_back(pos);
-      }
-
-      else if (c == 'O') {  // One Up
-          m_chMap[i][j] = 'F'; //floor tile
-          const Vector2 pos = m_fTileSize * Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-          m_vOneUp.push_back(pos);
-      }
-
-      else m_chMap[i][j] = c; //load character into map
-
-      index++; //next index
-    } //for
+  SetLevel(level);
+} //LoadMap
 
-    index += 1; //skip end of line character (assume single linefeed now)
-  } //for
+/// Reader function for the objects listed on the map of the current level,
+/// the player first.
+/// \return The objects to spawn, valid until the level changes.
 
-  m_vWorldSize = Vector2((float)m_nWidth, (float)m_nHeight)*m_fTileSize;
-  MakeBoundingBoxes();
+const std::vector<SSpawn>& CTileManager::GetSpawns() const{
+  return m_pLevel->m_vecSpawns;
+} //GetSpawns
 
-  delete [] buffer; //clean up
-} //LoadMap
+/// Reader function for the spawn records of the current level, which are
+/// made dormant again whenever a level is made current.
+/// \return The spawn table.
 
-/// Get positions of objects listed on map.
-/// \param turrets [out] Vector of turret positions
-/// \param player [out] Player position.
-/// \param spikes [out] Vector of spike positions
-/// \param doors [out] Vector of door positions (only want to use 1)
-
-void CTileManager::GetObjects(std::vector<Vector2>& turrets, Vector2& player, std::vector<Vector2>& spikes, std::vector<Vector2>& door, std::vector<Vector2>& star, std::vector<Vector2>& bat, std::vector<Vector2>& launchpad, std::vector<Vector2>& healthpack, std::vector<Vector2>& oneup){
-  turrets = m_vecTurrets;
-  player = m_vPlayer;
-  spikes = m_vecSpikes;
-  door = m_vDoor;
-  star = m_vStar;
-  bat = m_vBats;
-  launchpad = m_vLaunchPad;
-  healthpack = m_vHealthPack;
-  oneup = m_vOneUp;
-} //GetObjects
+CSpawnTable& CTileManager::GetSpawnTable(){
+  return m_cSpawnTable;
+} //GetSpawnTable
 
 /// This is for debug purposes so that you can verify that
 /// the collision shapes are in the right places.
 /// \param t Line sprite to be stretched to draw the line.
 
 void CTileManager::DrawBoundingBoxes(eSprite t){
-  for(auto& p: m_vecWalls)
-    m_pRenderer->DrawBoundingBox(t, p);
+  const float w = m_pRenderer->GetWidth(t); //line sprite width
+
+  for(auto& p: m_pLevel->m_vecWalls)
+    m_pDrawQueue->AddBoundingBox(t, p, w, eDrawLayer::Overlay);
 } //DrawBoundingBoxes
 
 /// Draw order is top-down, left-to-right so that the image
-/// agrees with the map text file viewed in NotePad.
+/// agrees with the map text file viewed in NotePad. Spikes and launch pads
+/// are drawn over the floor in the object layer, where they were drawn when
+/// they were objects.
 /// \param t Sprite type for a 3-frame sprite: 0 is floor, 1 is wall, 2 is an error tile.
  
 void CTileManager::Draw(eSprite t){
   LSpriteDesc2D desc; //sprite descriptor for tile
   desc.m_nSpriteIndex = (UINT)t; //sprite index for tile
 
+  LSpriteDesc2D item; //sprite descriptor for spike or launch pad
+
   const int w = (int)ceil(m_nWinWidth/m_fTileSize) + 2; //width of window in tiles, with 2 extra
   const int h = (int)ceil(m_nWinHeight/m_fTileSize) + 2; //height of window in tiles, with 2 extra
 
@@ -338,13 +117,34 @@ void CTileManager::Draw(eSprite t){
       switch(m_chMap[i][j]){ //select which frame of the tile sprite is to be drawn
         case 'F': desc.m_nCurrentFrame = 0; break; //floor
         case 'W': desc.m_nCurrentFrame = 1; break; //wall
+        case 'S': case 'L': desc.m_nCurrentFrame = 0; break; //floor under spike or launch pad
         default:  desc.m_nCurrentFrame = 2; break; //error tile
       } //switch
 
-      m_pRenderer->Draw(&desc); //finally we can draw a tile
+      m_pDrawQueue->Add(&desc, eDrawLayer::Background); //finally we can draw a tile
+
+      if(m_chMap[i][j] == 'S' || m_chMap[i][j] == 'L'){
+        item.m_nSpriteIndex = (UINT)(m_chMap[i][j] == 'S'? eSprite::Spike: eSprite::LaunchPad);
+        item.m_vPos = desc.m_vPos;
+        m_pDrawQueue->Add(&item, eDrawLayer::Objects, 0.5f*m_fTileSize);
+      } //if
     } //for
 } //Draw
 
+/// Rasterize a camera-centered observation of the map and a list of objects
+/// into a caller-provided buffer.
+/// \param raster The rasterizer, which knows the size of the observation.
+/// \param obj Array of objects.
+/// \param n Number of objects.
+/// \param out [out] Buffer of at least `raster.GetSize()` bytes.
+
+void CTileManager::Rasterize(const CObsRaster& raster, const SObsObject* obj,
+  size_t n, uint8_t* out) const
+{
+  const Vector3 campos = m_pRenderer->GetCameraPos(); //camera position
+  raster.Rasterize(m_chMap, m_nWidth, m_nHeight, m_fTileSize, campos.x, campos.y, obj, n, out);
+} //Rasterize
+
 /// Check whether a circle is visible from a point, that is, either the left
 /// or the right side of the object (from the perspective of the point)
 /// has no walls between it and the point. This gives some weird behavior
@@ -358,7 +158,7 @@ void CTileManager::Draw(eSprite t){
 const bool CTileManager::Visible(const Vector2& p0, const Vector2& p1, float r) const{
   bool visible = true;
 
-  for(auto i=m_vecWalls.begin(); i!=m_vecWalls.end() && visible; i++){
+  for(auto i=m_pLevel->m_vecWalls.begin(); i!=m_pLevel->m_vecWalls.end() && visible; i++){
     Vector2 direction = p0 - p1;
     direction.Normalize();
     const Vector2 norm = Vector2(-direction.y, direction.x);
@@ -380,6 +180,39 @@ const bool CTileManager::Visible(const Vector2& p0, const Vector2& p1, float r)
   return visible;
 } //Visible
 
+/// Forget the line of sight queries from the last frame. Call this before
+/// anything asks for visibility this frame.
+
+void CTileManager::BeginLosFrame(){
+  m_cLosBatch.Clear();
+} //BeginLosFrame
+
+/// Ask whether a circle is visible from a point, as `Visible()` does. The
+/// answer is ready after the next call to `EvaluateLos()`.
+/// \param p0 A point.
+/// \param p1 Center of circle.
+/// \param r Radius of circle.
+/// \return Index of the query, for getting the answer with `GetLos()`.
+
+const size_t CTileManager::AddLosQuery(const Vector2& p0, const Vector2& p1, float r){
+  return m_cLosBatch.Add(p0.x, p0.y, p1.x, p1.y, r);
+} //AddLosQuery
+
+/// Answer all of this frame's line of sight queries at once.
+
+void CTileManager::EvaluateLos(){
+  m_cLosBatch.Evaluate();
+} //EvaluateLos
+
+/// Reader function for the answer to a line of sight query.
+/// \param n Index of the query returned by `AddLosQuery()`.
+/// \return true if the circle is visible, false if not or there is no such
+/// query this frame.
+
+const bool CTileManager::GetLos(size_t n) const{
+  return m_cLosBatch.GetResult(n);
+} //GetLos
+
 /// Check whether a bounding sphere collides with one of the wall bounding boxes.
 /// If so, compute the collision normal and the overlap distance. 
 /// \param s Bounding sphere of object.
@@ -392,7 +225,7 @@ const bool CTileManager::CollideWithWall(
 {
   bool hit = false; //return result, true if there is a collision with a wall
 
-  for(auto i=m_vecWalls.begin(); i!=m_vecWalls.end() && !hit; i++){
+  for(auto i=m_pLevel->m_vecWalls.begin(); i!=m_pLevel->m_vecWalls.end() && !hit; i++){
     const BoundingBox& aabb = *i; //shorthand
 
     Vector3 corner[8]; //for corners of aabb
@@ -458,46 +291,192 @@ const bool CTileManager::CollideWithWall(
   return hit;
 } //CollideWithWall
 
-void CTileManager::LoadMapFromImageFile(char* filename) {
-    m_vecTurrets.clear(); //clear turrets from previous level
-
-    if (m_chMap != nullptr) { //unload any previous maps
-        for (int i = 0; i < m_nHeight; i++)
-            delete[] m_chMap[i];
-        delete[] m_chMap;
-    } //if
+/// Find the tiles with properties that a circle touches, by looking up the
+/// property flags of the tiles under it. Each counts as a circle the size
+/// of its sprite at the center of the tile, as spikes and launch pads did
+/// when they were objects.
+/// \param p Center of circle.
+/// \param r Radius of circle.
+/// \param out [out] The tiles touched, replacing anything there.
 
-    //read map file into a byte buffer 
+void CTileManager::TouchTiles(const Vector2& p, float r,
+  std::vector<STileTouch>& out) const
+{
+  out.clear();
+  if(m_pProps == nullptr)return; //no tiles with properties
+
+  const float reach = r + PROP_RADIUS; //furthest a tile center can be
+  const float t = m_fTileSize; //shorthand
+
+  const int left   = std::max(0, (int)floorf((p.x - reach)/t));
+  const int right  = std::min((int)m_nWidth - 1, (int)floorf((p.x + reach)/t));
+  const int top    = std::max(0, (int)m_nHeight - 1 - (int)floorf((p.y + reach)/t));
+  const int bottom = std::min((int)m_nHeight - 1, (int)m_nHeight - 1 - (int)floorf((p.y - reach)/t));
+
+  for(int i=top; i<=bottom; i++)
+    for(int j=left; j<=right; j++){
+      const uint8_t props = m_pProps[i*m_nWidth + j]; //shorthand
+      if(props == (uint8_t)eTileProp::None)continue;
+
+      const Vector2 c((j + 0.5f)*t, (m_nHeight - i - 0.5f)*t); //tile center
+      Vector2 vSep = p - c; //vector from tile to circle
+      const float d = reach - vSep.Length(); //overlap
+
+      if(d > 0.0f){
+        vSep.Normalize();
+
+        STileTouch touch;
+        touch.m_vNorm = vSep;
+        touch.m_fOverlap = d;
+        touch.m_nProps = props;
+        out.push_back(touch);
+      } //if
+    } //for
+} //TouchTiles
+
+/// Load a map from an image file on this thread and make it the current
+/// level.
+/// \param filename Name of the image file.
+
+void CTileManager::LoadMapFromImageFile(const char* filename){
+  std::shared_ptr<CLevelData> level = std::make_shared<CLevelData>(m_fTileSize);
+
+  if(!level->LoadFromImageFile(filename))
+    ABORT("%s", level->GetError().c_str()); //panic
+
+  SetLevel(level);
+} //LoadMapFromImageFile
+
+/// Move the target of the flow field to a position, usually the player's.
+/// The field is made again only if the position is in a different tile.
+/// \param pos Target position.
+
+void CTileManager::UpdateFlowField(const Vector2& pos){
+  m_cFlowField.Update(pos.x, pos.y);
+} //UpdateFlowField
+
+/// Get the direction of the next step from a position along the shortest
+/// path around the walls to the flow field target.
+/// \param pos Position.
+/// \param dir [out] Unit direction of the next step.
+/// \return true if there is a step to take, false if the position is in the
+/// target's tile or can't reach it.
+
+const bool CTileManager::GetFlowDirection(const Vector2& pos, Vector2& dir) const{
+  return m_cFlowField.GetDirection(pos.x, pos.y, dir.x, dir.y);
+} //GetFlowDirection
+
+/// Get the number of tiles along the shortest path around the walls from a
+/// position to the flow field target.
+/// \param pos Position.
+/// \return Number of steps, `UINT32_MAX` if the target can't be reached.
+
+const uint32_t CTileManager::GetFlowDistance(const Vector2& pos) const{
+  return m_cFlowField.GetDistance(pos.x, pos.y);
+} //GetFlowDistance
+
+/// Get the index of the tile at a position, counting row by row from the
+/// top left of the map.
+/// \param pos Position.
+/// \return Index of the tile, `SIZE_MAX` if it is off the map.
+
+const size_t CTileManager::GetTile(const Vector2& pos) const{
+  if(pos.x < 0.0f || pos.y < 0.0f)return SIZE_MAX;
+
+  const size_t j = (size_t)(pos.x/m_fTileSize); //column
+  const size_t k = (size_t)(pos.y/m_fTileSize); //row counting up
+  if(j >= m_nWidth || k >= m_nHeight)return SIZE_MAX;
+
+  return (m_nHeight - 1 - k)*m_nWidth + j;
+} //GetTile
+
+/// Start a new frame of path finding, which resets the number of searches
+/// that can be made before queries are deferred.
+
+void CTileManager::BeginPathFrame(){
+  m_cPathFinder.BeginFrame();
+} //BeginPathFrame
+
+/// Find a path around the walls from one position to another. The path goes
+/// through the centers of the tiles where it turns, starting with the center
+/// of the start tile and ending with the center of the goal tile, and it is
+/// safe to go in a straight line from each one to the next.
+/// \param from Start position.
+/// \param to Goal position.
+/// \param path [out] The path. Unchanged unless one was found.
+/// \return Whether a path was found, there is none, or the search was
+/// deferred to a later frame.
+
+const ePathResult CTileManager::FindPath(const Vector2& from, const Vector2& to,
+  std::vector<Vector2>& path)
+{
+  std::vector<uint32_t> tiles; //tiles where the path turns
+  const ePathResult result = m_cPathFinder.FindPath(GetTile(from), GetTile(to), tiles);
 
-    int channels = 0, w = 0, h = 0;
-    unsigned char* buffer = stbi_load(filename, &w, &h, &channels, 0);
-    m_nWidth = (size_t)w;
-    m_nHeight = (size_t)h;
+  if(result == ePathResult::Found){
+    path.resize(tiles.size());
 
-    //allocate space for the map 
+    for(size_t i=0; i<tiles.size(); i++){
+      const size_t row = tiles[i]/m_nWidth, col = tiles[i]%m_nWidth; //tile row and column
+      path[i] = m_fTileSize*Vector2(col + 0.5f, m_nHeight - row - 0.5f);
+    } //for
+  } //if
 
-    m_chMap = new char* [m_nHeight];
+  return result;
+} //FindPath
+
+/// Move the goal of the navigation route to a position, usually the
+/// player's, using the current level's navigation graph for a movement
+/// profile. The route is worked out again only if the goal is over a
+/// different standing place. If the level has no graph for the profile then
+/// there is no route.
+/// \param profile How the entities following the route move.
+/// \param pos Goal position.
+
+void CTileManager::UpdateNavRoute(const SNavProfile& profile, const Vector2& pos){
+  const CNavGraph* graph = m_pLevel->GetNavGraph(profile); //graph for profile
+
+  if(graph == nullptr)m_cNavRoute.Reset();
+  else m_cNavRoute.Update(*graph, GetTile(pos));
+} //UpdateNavRoute
+
+/// Get the next link to take along the navigation route from a position,
+/// and where it starts and ends. Jumps and launches start from the center
+/// of the tile, falls from its edge, and walks from anywhere in it.
+/// \param pos Position, which must be in a standing place.
+/// \param link [out] The link.
+/// \param start [out] Where to be when setting off along the link.
+/// \param dest [out] Center of the tile that the link ends at.
+/// \return true if there is a link to take, false if the position isn't in a
+/// standing place, is at the goal, or can't reach it.
+
+const bool CTileManager::GetNavLink(const Vector2& pos, SNavLink& link, Vector2& start,
+  Vector2& dest) const
+{
+  const size_t tile = GetTile(pos); //tile at position
+  if(tile == SIZE_MAX)return false;
 
-    for (int i = 0; i < m_nHeight; i++)
-        m_chMap[i] = new char[m_nWidth];
+  const SNavLink* next = m_cNavRoute.GetNext(tile); //link to take
+  if(next == nullptr)return false;
 
-    //load the map information from the buffer to the map
+  const size_t to = m_cNavRoute.GetGraph()->GetTile(next->m_nTo); //tile at end of link
 
-    int index = 0;
+  link = *next;
+  start = m_fTileSize*Vector2(tile%m_nWidth + 0.5f, m_nHeight - tile/m_nWidth - 0.5f);
 
-    for (int i = 0; i < m_nHeight; i++)
-        for (int j = 0; j < m_nWidth; j++) {
-            m_chMap[i][j] =
-                (buffer[index] == 0 && buffer[index + 1] == 0 && buffer[index + 2] == 0) ? 'W' : 'F'; //load character into map
-            if (buffer[index] == 0 && buffer[index + 1] == 255 && buffer[index + 2] == 0)
-                m_vecTurrets.push_back(Vector2((float)j, m_nHeight - (float)i) * m_fTileSize);
-            index += channels;
-        } //for
+  if(link.m_eType == eNavLink::Fall) //off the edge
+    start.x += link.m_fSpeedX > 0.0f? m_fTileSize/2: -m_fTileSize/2;
 
-      //finish up
+  dest = m_fTileSize*Vector2(to%m_nWidth + 0.5f, m_nHeight - to/m_nWidth - 0.5f);
+  return true;
+} //GetNavLink
 
-    m_vWorldSize = Vector2((float)m_nWidth, (float)m_nHeight) * m_fTileSize;
-    MakeBoundingBoxes();
+/// Get the cost of the navigation route from a position to the goal.
+/// \param pos Position.
+/// \return Time to the goal in seconds plus jump penalties, 0 at the goal,
+/// infinite if the position isn't in a standing place or can't reach it.
 
-    stbi_image_free(buffer);
-} //LoadMapFromImageFile
\ No newline at end of file
+const float CTileManager::GetNavCost(const Vector2& pos) const{
+  const size_t tile = GetTile(pos); //tile at position
+  return tile == SIZE_MAX? INFINITY: m_cNavRoute.GetCost(tile);
+} //GetNavCost
@@ -5,15 +5,45 @@
 #define __L4RC_GAME_TILEMANAGER_H__
 
 #include <vector>
+#include <memory>
 
 #include "Common.h"
 #include "Settings.h"
 #include "Sprite.h"
 #include "GameDefines.h"
+#include "ObsRaster.h"
+#include "LevelData.h"
+#include "FlowField.h"
+#include "PathFinder.h"
+#include "LosBatch.h"
+#include "SpawnTable.h"
+
+/// \brief A touched tile.
+///
+/// A tile with properties that a moving object is touching, with the
+/// collision normal and overlap distance of the object's bounding circle
+/// against the bounding circle of the thing drawn on the tile.
+
+struct STileTouch{
+  Vector2 m_vNorm; ///< Collision normal, from the tile to the object.
+  float m_fOverlap = 0.0f; ///< Overlap distance.
+  uint8_t m_nProps = 0; ///< The tile's `eTileProp` flags.
+}; //STileTouch
 
 /// \brief The tile manager.
 ///
-/// The tile manager is responsible for the tile-based background.
+/// The tile manager is responsible for the tile-based background. The map,
+/// walls, and object positions belong to the current level, a CLevelData
+/// that may have been loaded in the background, so that changing levels is
+/// just a matter of swapping pointers. It also keeps a flow field over the
+/// map that chasers follow to the player, a path finder for anything
+/// that needs a path of its own, and a route to the player through the
+/// current level's navigation graph for things that walk and jump. Line of
+/// sight queries made during a frame are answered together as a batch. The
+/// objects placed on the map, other than the player, are kept as spawn
+/// records until they are near enough to be made. Spikes and launch pads
+/// are tiles, drawn here and found under moving objects from the level's
+/// tile property flags.
 
 class CTileManager: 
   public CCommon, 
@@ -25,33 +55,48 @@ class CTileManager:
 
     float m_fTileSize = 0.0f; ///< Tile width and height.
 
-    char** m_chMap = nullptr; ///< The level map.
-
-    std::vector<BoundingBox> m_vecWalls; ///< AABBs for the walls.
-    std::vector<Vector2> m_vecTurrets; ///< Turret positions.
-    Vector2 m_vPlayer; ///< Player location.
-    std::vector<Vector2> m_vecSpikes; ///< Spike positions.
-    std::vector<Vector2> m_vDoor; ///< Door location.
-    std::vector<Vector2> m_vStar; ///< Star location.
-    std::vector<Vector2> m_vBats; ///< Bat loaction.
-    std::vector<Vector2> m_vLaunchPad; ///< Launch Pad location.
-    std::vector<Vector2> m_vHealthPack; ///< healthpack location
-    std::vector<Vector2> m_vOneUp;
+    std::shared_ptr<const CLevelData> m_pLevel; ///< The current level.
+    const char* const* m_chMap = nullptr; ///< The level map, rows of the current level.
+    const uint8_t* m_pProps = nullptr; ///< Tile property flags of the current level.
+    CFlowField m_cFlowField; ///< Routes from everywhere to the player.
+    CPathFinder m_cPathFinder; ///< Finds paths between tiles.
+    CNavRoute m_cNavRoute; ///< Route to the player for walkers and jumpers.
+    CLosBatch m_cLosBatch; ///< Line of sight queries for this frame.
+    CSpawnTable m_cSpawnTable; ///< Objects on the map, made or not.
 
-    void MakeBoundingBoxes(); ///< Make bounding boxes for walls.
+    const size_t GetTile(const Vector2&) const; ///< Get tile at position.
 
   public:
     CTileManager(size_t); ///< Constructor.
-    ~CTileManager(); ///< Destructor.
 
-    void LoadMap(char*); ///< Load a map.
+    void SetLevel(const std::shared_ptr<const CLevelData>&); ///< Make a level current.
+    void LoadMap(const char*); ///< Load a map.
     void Draw(eSprite); ///< Draw the map with a given tile.
     void DrawBoundingBoxes(eSprite); ///< Draw the bounding boxes.
-    void GetObjects(std::vector<Vector2>&, Vector2&, std::vector<Vector2>&, std::vector<Vector2>&, std::vector<Vector2>&, std::vector<Vector2>&, std::vector<Vector2>&, std::vector<Vector2>&, std::vector<Vector2>&); ///< Get objects.
-    void LoadMapFromImageFile(char*); ///< Load map.
+    const std::vector<SSpawn>& GetSpawns() const; ///< Get objects to spawn.
+    CSpawnTable& GetSpawnTable(); ///< Get spawn records.
+    void LoadMapFromImageFile(const char*); ///< Load map.
+    void Rasterize(const CObsRaster&, const SObsObject*, size_t, uint8_t*) const; ///< Rasterize an observation.
     
     const bool Visible(const Vector2&, const Vector2&, float) const; ///< Check visibility.
     const bool CollideWithWall(BoundingSphere, Vector2&, float&) const; ///< Object-wall collision test.
+    void TouchTiles(const Vector2&, float, std::vector<STileTouch>&) const; ///< Find tiles with properties under a circle.
+
+    void BeginLosFrame(); ///< Forget last frame's line of sight queries.
+    const size_t AddLosQuery(const Vector2&, const Vector2&, float); ///< Ask for visibility.
+    void EvaluateLos(); ///< Answer all line of sight queries.
+    const bool GetLos(size_t) const; ///< Get answer to a line of sight query.
+
+    void UpdateFlowField(const Vector2&); ///< Move the flow field target.
+    const bool GetFlowDirection(const Vector2&, Vector2&) const; ///< Get direction toward target.
+    const uint32_t GetFlowDistance(const Vector2&) const; ///< Get steps to target.
+
+    void BeginPathFrame(); ///< Start a new frame's path search budget.
+    const ePathResult FindPath(const Vector2&, const Vector2&, std::vector<Vector2>&); ///< Find a path.
+
+    void UpdateNavRoute(const SNavProfile&, const Vector2&); ///< Move the navigation route goal.
+    const bool GetNavLink(const Vector2&, SNavLink&, Vector2&, Vector2&) const; ///< Get next navigation link.
+    const float GetNavCost(const Vector2&) const; ///< Get navigation cost to goal.
 }; //CTileManager
 
 #endif //__L4RC_GAME_TILEMANAGER_H__
\ No newline at end of file
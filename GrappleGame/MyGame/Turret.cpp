@@ -9,22 +9,162 @@
 #include "Helpers.h"
 #include "Particle.h"
 #include "ParticleEngine.h"
+#include "SpawnTable.h"
+
+static const float RUN_SPEED = 300.0f; ///< Walking speed in pixels per second, the old patrol speed of 5 pixels per frame at 60 fps.
+static const float PLAYER_UNIT = 40.0f; ///< Pixels per second that `CPlayer::move` moves per unit of player velocity.
+static const float JUMP_SPEED = 20.0f*PLAYER_UNIT; ///< Upward speed at the start of a jump in pixels per second, that of the player's `JUMP_HEIGHT`.
+static const float GRAVITY = 1.5f*PLAYER_UNIT*PLAYER_UNIT; ///< Downward acceleration in pixels per second squared, that of the player's `PLAYER_GRAVITY`.
+static const float LAUNCH_SPEED = 35.0f*PLAYER_UNIT; ///< Upward speed off a launch pad in pixels per second, that of the player's `LAUNCHPAD_VELOCITY`.
+
+const SNavProfile CTurret::m_sNavProfile = {RUN_SPEED, JUMP_SPEED, GRAVITY, LAUNCH_SPEED};
 
 /// Create and initialize a turret object given its position.
 /// \param p Position of turret.
 
 CTurret::CTurret(const Vector2& p): CObject(eSprite::Turret, p){
   m_bStatic = false; //turrets are static
+  m_bThinks = true;
   t = m_pTimer->GetTime();
   tAir = m_pTimer->GetTime();
 } //constructor
 
-/// Rotate the turret and fire the gun at at the closest available target if
-/// there is one, and rotate the turret at a constant speed otherwise.
+/// Ask the tile manager whether the player can be seen. The answer is ready
+/// when the turret thinks.
+
+void CTurret::perceive(){
+  if(m_pPlayer){ //safety
+    const float r = ((CTurret*)m_pPlayer)->m_fRadius; //player radius
+    m_nLosQuery = m_pTileManager->AddLosQuery(m_vPos, m_pPlayer->m_vPos, r);
+  } //if
+
+  else m_nLosQuery = SIZE_MAX;
+} //perceive
+
+/// Remember whether the player could be seen, which holds until the AI
+/// scheduler next picks this turret to think.
+
+void CTurret::think(){
+  m_bSeesPlayer = m_pTileManager->GetLos(m_nLosQuery);
+} //think
+
+/// Keep the turret's position, orientation, and health in its spawn record
+/// when it is stored away.
+/// \param r [out] The spawn record.
+
+void CTurret::SaveSpawn(SSpawnRecord& r) const{
+  CObject::SaveSpawn(r);
+  r.m_nHealth = m_nHealth;
+  r.m_bChanged = m_nHealth != m_nMaxHealth;
+} //SaveSpawn
+
+/// Get back the turret's position, orientation, and health from its spawn
+/// record, reddened to match the health.
+/// \param r The spawn record.
+
+void CTurret::LoadSpawn(const SSpawnRecord& r){
+  CObject::LoadSpawn(r);
+
+  if(r.m_bChanged && r.m_nHealth > 0){
+    m_nHealth = r.m_nHealth;
+    const float f = 0.5f + 0.5f*(float)m_nHealth/m_nMaxHealth; //health fraction
+    m_f4Tint = XMFLOAT4(1.0f, f, f, 0); //redden the sprite to indicate damage
+  } //if
+} //LoadSpawn
+
+/// Move the turret along the navigation route to the player, or patrol if
+/// there is none, and fire the gun at the player if it was visible when the
+/// turret last thought and is in front.
 
 void CTurret::move(){
+    if(!FollowRoute())Patrol();
+
     Vector2 view = GetViewVector(); //view vector
-    Vector2 norm = VectorNormalCC(view); //normal to view vector
+    
+    if(m_pPlayer){ //safety
+    Vector2 direction = m_vPos - m_pPlayer->m_vPos;
+    direction.Normalize();
+    float dot = direction.Dot(view);
+
+
+    if (m_bSeesPlayer && m_pGunFireEvent->Triggered() && dot < 0.0f)
+    {//player visible
+      //RotateTowards(m_pPlayer->m_vPos);
+
+        m_pObjectManager->FireGun(this, eSprite::Bullet2);
+    }
+        //else m_fRotSpeed = 0.4f; //no target visible, so scan
+  } //if
+  //m_fRoll += 0.2f*m_fRotSpeed*XM_2PI*m_pTimer->GetFrameTime(); //rotate
+  //NormalizeAngle(m_fRoll); //normalize to [-pi, pi] for accuracy
+} //move
+
+/// Follow the navigation route to the player. Walk to where the next link
+/// sets off, then walk, jump, or fall along it, under gravity while in the
+/// air, until it comes down on the tile where the link ends. A turret that
+/// is already at the goal waits there.
+/// \return true if following the route, false if there is none from here.
+
+const bool CTurret::FollowRoute(){
+  if(!m_bOnLink){ //pick the next link
+    if(m_pTileManager->GetNavCost(m_vPos) == 0.0f)return true; //at the goal
+    if(!m_pTileManager->GetNavLink(m_vPos, m_sLink, m_vLinkStart, m_vLinkEnd))return false;
+
+    m_bOnLink = true;
+    m_bAirborne = false;
+    m_fLinkTime = 0.0f;
+  } //if
+
+  const float dt = m_pTimer->GetFrameTime(); //frame time
+  m_fLinkTime += dt;
+
+  if(m_fLinkTime > m_fMaxLinkTime){ //stuck, so give up on this link
+    m_bOnLink = m_bAirborne = false;
+    return false;
+  } //if
+
+  if(!m_bAirborne){ //on the ground
+    const bool walk = m_sLink.m_eType == eNavLink::Walk; //whether just a walk
+    const float x = walk? m_vLinkEnd.x: m_vLinkStart.x; //where to walk to
+    const float step = m_sNavProfile.m_fRunSpeed*dt; //distance this frame
+
+    if(fabsf(x - m_vPos.x) > step){ //not there yet
+      m_fRoll = x > m_vPos.x? 0.0f: M_PI;
+      m_vPos.x += x > m_vPos.x? step: -step;
+      return true;
+    } //if
+
+    m_vPos.x = x;
+
+    if(walk){ //done
+      m_bOnLink = false;
+      return true;
+    } //if
+
+    m_bAirborne = true; //set off
+    m_vVelocity = Vector2(m_sLink.m_fSpeedX, m_sLink.m_fSpeedY);
+    if(m_sLink.m_fSpeedX != 0.0f)m_fRoll = m_sLink.m_fSpeedX > 0.0f? 0.0f: M_PI;
+  } //if
+
+  m_vVelocity.y -= m_sNavProfile.m_fGravity*dt;
+  m_vPos += m_vVelocity*dt;
+
+  if(m_vVelocity.y < 0.0f && m_vPos.y <= m_vLinkEnd.y){ //landed
+    m_vPos.y = m_vLinkEnd.y;
+    m_vVelocity = Vector2::Zero;
+    m_bOnLink = m_bAirborne = false;
+  } //if
+
+  return true;
+} //FollowRoute
+
+/// Pace back and forth, turning around every second or on hitting a wall,
+/// and fall when not on the ground, at the same speed and under the same
+/// gravity as when following a route.
+
+void CTurret::Patrol(){
+    const float dt = m_pTimer->GetFrameTime(); //frame time
+
     if (m_pTimer->GetTime() - tAir > 0.1f)
     {
         inAir = true;
@@ -32,57 +172,39 @@ void CTurret::move(){
     }
     if(flip)
     {
-        m_vVelocity.x = moveRight;
+        m_vVelocity.x = RUN_SPEED;
         m_fRoll = 0.0f;
     }
     else
     {
-        m_vVelocity.x = moveLeft;
+        m_vVelocity.x = -RUN_SPEED;
         m_fRoll = M_PI;
     }
     if (inAir)
     {
-        m_vVelocity.y = gravity;
+        m_vVelocity.y -= GRAVITY*dt;
     }
     else
     {
         m_vVelocity.y = 0.0;
     }
     
-    if(m_pPlayer){ //safety
-    const float r = ((CTurret*)m_pPlayer)->m_fRadius; //player radius
-    Vector2 direction = m_vPos - m_pPlayer->m_vPos;
-    direction.Normalize();
-    float dot = direction.Dot(view);
-
-
-    if (m_pTileManager->Visible(m_vPos, m_pPlayer->m_vPos, r) && m_pGunFireEvent->Triggered() && dot < 0.0f)
-    {//player visible
-      //RotateTowards(m_pPlayer->m_vPos);
-
-        m_pObjectManager->FireGun(this, eSprite::Bullet2);
-    }
-        //else m_fRotSpeed = 0.4f; //no target visible, so scan
-  } //if
     if (m_pTimer->GetTime() - t > 1.0f)
     {
         if (flip)
         {
-            m_vVelocity.x = moveLeft;
+            m_vVelocity.x = -RUN_SPEED;
             m_fRoll = M_PI;
         }
         else {
-            m_vVelocity.x = moveRight;
+            m_vVelocity.x = RUN_SPEED;
             m_fRoll = 0.0f;
         }
         flip = !flip;
         t = m_pTimer->GetTime();
     }
-    m_vPos += Vector2(1,0) * m_vVelocity.x;
-    m_vPos += Vector2(0,-1) * m_vVelocity.y;
-  //m_fRoll += 0.2f*m_fRotSpeed*XM_2PI*m_pTimer->GetFrameTime(); //rotate
-  //NormalizeAngle(m_fRoll); //normalize to [-pi, pi] for accuracy
-} //move
+    m_vPos += m_vVelocity*dt;
+} //Patrol
 
 /// Rotate the turret towards a point and file the gun if it is facing
 /// sufficiently close to it.
@@ -109,6 +231,16 @@ void CTurret::RotateTowards(const Vector2& pos){
     m_pObjectManager->FireGun(this, eSprite::Bullet2);
 } //RotateTowards
 
+/// Stop falling on being pushed up out of the ground while patrolling or
+/// walking to a link. A turret in the air on a link lands where the link
+/// ends instead.
+/// \param norm Collision normal.
+
+void CTurret::Land(const Vector2& norm){
+  if(!m_bAirborne && norm.y > 0.0f && m_vVelocity.y < 0.0f)
+    m_vVelocity.y = 0.0f;
+} //Land
+
 /// Response to collision. 
 /// \param norm Collision normal.
 /// \param d Overlap distance.
@@ -132,13 +264,6 @@ void CTurret::CollisionResponse(const Vector2& norm, float d, CObject* pObj){
     } //else
   } //if
 
-  if (pObj && pObj->isSpike())
-  {
-      m_pAudio->play(eSound::Boom); //explosion
-      m_bDead = true; //flag for deletion from object list
-      DeathFX(); //particle effects
-  }
-
   if (pObj == nullptr)
   {
       if (!inAir)
@@ -154,9 +279,32 @@ void CTurret::CollisionResponse(const Vector2& norm, float d, CObject* pObj){
   }
   tAir = m_pTimer->GetTime();
 
+  if(!pObj)Land(norm);
   CObject::CollisionResponse(norm, d, pObj);
 } //CollisionResponse
 
+/// Response to touching a tile. A spike kills it outright. Like anything
+/// other than a wall, a tile doesn't count as ground to turn around on.
+/// \param norm Collision normal.
+/// \param d Overlap distance.
+/// \param props The tile's `eTileProp` flags.
+
+void CTurret::TileResponse(const Vector2& norm, float d, uint8_t props){
+  if(m_bDead)return; //already dead, bail out 
+
+  if(props & (uint8_t)eTileProp::Hazard){ //spike
+    m_pAudio->play(eSound::Boom); //explosion
+    m_bDead = true; //flag for deletion from object list
+    DeathFX(); //particle effects
+  } //if
+
+  inAir = true;
+  tAir = m_pTimer->GetTime();
+
+  Land(norm);
+  CObject::TileResponse(norm, d, props);
+} //TileResponse
+
 /// Perform a particle effect to mark the death of the turret.
 
 void CTurret::DeathFX(){
@@ -169,7 +317,7 @@ void CTurret::DeathFX(){
   d.m_fScaleInFrac = 0.5f;
   d.m_fFadeOutFrac = 0.8f;
   d.m_fScaleOutFrac = 0;
-  m_pParticleEngine->create(d);
+  m_pObjectManager->CreateParticle(d);
 
   d.m_nSpriteIndex = (UINT)eSprite::Spark;
   d.m_fLifeSpan = 0.5f;
@@ -178,5 +326,5 @@ void CTurret::DeathFX(){
   d.m_fScaleOutFrac = 0.3f;
   d.m_fFadeOutFrac = 0.5f;
   d.m_f4Tint = XMFLOAT4(Colors::Orange);
-  m_pParticleEngine->create(d);
+  m_pObjectManager->CreateParticle(d);
 } //DeathFX
\ No newline at end of file
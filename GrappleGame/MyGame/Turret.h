@@ -5,30 +5,50 @@
 #define __L4RC_GAME_TURRET_H__
 
 #include "Object.h"
+#include "NavGraph.h"
 
 
 /// \brief The turret object. 
 ///
-/// CTurret is the abstract representation of a turret object.
+/// CTurret is the abstract representation of a turret object. A turret
+/// walks, jumps, and falls along the navigation route to the player, and
+/// paces back and forth where there is no route.
 
 class CTurret: public CObject{
   protected:
     const UINT m_nMaxHealth = 3; ///< Maximum health.
     UINT m_nHealth = m_nMaxHealth; ///< Current health.
-    const float moveRight = 5.0;
-    const float moveLeft = -5.0;
-    const float gravity = 3.0;
-    
+    const float m_fMaxLinkTime = 5.0f; ///< Longest time to spend on one link.
+
+    SNavLink m_sLink; ///< Navigation link being followed.
+    Vector2 m_vLinkStart; ///< Where to set off along the link.
+    Vector2 m_vLinkEnd; ///< Where the link ends.
+    float m_fLinkTime = 0.0f; ///< Time spent on the link.
+    bool m_bOnLink = false; ///< Whether following a link.
+    bool m_bAirborne = false; ///< Whether in the air on a link.
+    size_t m_nLosQuery = SIZE_MAX; ///< Line of sight query to the player.
+    bool m_bSeesPlayer = false; ///< Whether the player was visible when it last thought.
+
     void RotateTowards(const Vector2&); ///< Swivel towards position.
     virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
+    virtual void TileResponse(const Vector2&, float, uint8_t); ///< Response to touching a tile.
     virtual void DeathFX(); ///< Death special effects.
+    const bool FollowRoute(); ///< Move along the navigation route.
+    void Patrol(); ///< Pace back and forth.
+    void Land(const Vector2&); ///< Stop falling on the ground.
     bool flip = true;
     float t;
     float tAir;
     bool start = true;
     bool inAir = true;
   public:
+    static const SNavProfile m_sNavProfile; ///< How turrets move.
+
     CTurret(const Vector2& p); ///< Constructor.
+    virtual void perceive(); ///< Look for the player.
+    virtual void think(); ///< Remember whether the player is visible.
+    virtual void SaveSpawn(SSpawnRecord&) const; ///< Keep state in a spawn record.
+    virtual void LoadSpawn(const SSpawnRecord&); ///< Get state from a spawn record.
     virtual void move(); ///< Move turret.
 }; //CBullet
 